@@ -127,12 +127,12 @@ int stripWaveHeader(QFile& fWave, size_t& waveDataSize)
 //------------------------------------------------------------------------------
 //! @brief      Writes a wave header.
 //!
-//! @param      wf         wave file
+//! @param      wf         wave output (file or buffer)
 //! @param[in]  byteCount  The byte count
 //!
 //! @return     0
 //------------------------------------------------------------------------------
-int writeWaveHeader(QFile &wf, size_t byteCount)
+int writeWaveHeader(QIODevice &wf, size_t byteCount)
 {
     wf.write("RIFF", 4);                // 0
     putNum(byteCount + 44 - 8, wf, 4);  // 4
@@ -76,12 +76,12 @@ namespace audio {
     //------------------------------------------------------------------------------
     //! @brief      Writes a wave header.
     //!
-    //! @param      wf         wave file
+    //! @param      wf         wave output (file or buffer)
     //! @param[in]  byteCount  The byte count
     //!
     //! @return     0
     //------------------------------------------------------------------------------
-    int writeWaveHeader(QFile &wf, size_t byteCount);
+    int writeWaveHeader(QIODevice &wf, size_t byteCount);
     
     //--------------------------------------------------------------------------
     //! @brief      forward file position to wave data
@@ -0,0 +1,571 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cartifactcache.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+#include <QtDebug>
+#include <algorithm>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CArtifactCache::CArtifactCache(QObject* parent)
+    : QObject(parent), mBudget(0), mbLoaded(false), mNextJob(0)
+{
+    mDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/artifacts";
+
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(INDEX_SAVE_DELAY_MS);
+    connect(&mSaveTimer, &QTimer::timeout, this, &CArtifactCache::saveIndex);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object (waits for running jobs, writes index).
+//--------------------------------------------------------------------------
+CArtifactCache::~CArtifactCache()
+{
+    for (const auto& j : mJobs)
+    {
+        // results can't be delivered anymore -> drop copied data
+        j.mpWatcher->waitForFinished();
+        QFile::remove(j.mbFetch ? (j.mFile + ".part") : (mDir + "/" + j.mFile));
+    }
+
+    if (mSaveTimer.isActive())
+    {
+        mSaveTimer.stop();
+        saveIndex();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set max. cache size
+//!
+//! @param[in]  bytes  budget in bytes (0 disables the cache)
+//--------------------------------------------------------------------------
+void CArtifactCache::setBudget(qint64 bytes)
+{
+    mBudget = bytes;
+
+    if (enabled())
+    {
+        loadIndex();
+        evict("");
+        indexChanged();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is cache in use
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CArtifactCache::enabled() const
+{
+    return mBudget > 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is key in cache
+//!
+//! @param[in]  key   The cache key
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CArtifactCache::contains(const QString& key) const
+{
+    return enabled() && !key.isEmpty() && mIndex.contains(key);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start copy of cached file to target; done() tells if
+//!             the entry was valid (target stays untouched if not)
+//!
+//! @param[in]  key     The cache key
+//! @param[in]  target  The target file name
+//!
+//! @return     job id, NO_JOB on cache miss
+//--------------------------------------------------------------------------
+int CArtifactCache::fetch(const QString& key, const QString& target)
+{
+    if (!contains(key) || mBusy.contains(key))
+    {
+        return NO_JOB;
+    }
+
+    // copy next to the target, it is replaced after the hash check
+    return startJob({true, key, target, false, nullptr}, mDir + "/" + mIndex.value(key).mFile, target + ".part");
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start copy of file into cache; done() tells if it was
+//!             stored and gives the content hash (also if not stored)
+//!
+//! @param[in]  key     The cache key
+//! @param[in]  source  The source file name
+//!
+//! @return     job id, NO_JOB if nothing is copied
+//--------------------------------------------------------------------------
+int CArtifactCache::store(const QString& key, const QString& source)
+{
+    if (!enabled() || key.isEmpty() || mBusy.contains(key))
+    {
+        return NO_JOB;
+    }
+
+    QString name = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    if (!QDir().mkpath(mDir))
+    {
+        qWarning() << "Can't create cache folder" << mDir;
+        return NO_JOB;
+    }
+
+    remove(key);
+    indexChanged();
+
+    return startJob({false, key, name, false, nullptr}, source, mDir + "/" + name);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      drop result of a running job (no done() signal, copied
+//!             data is removed when the job has finished)
+//!
+//! @param[in]  job   The job id
+//--------------------------------------------------------------------------
+void CArtifactCache::cancel(int job)
+{
+    auto it = mJobs.find(job);
+
+    if (it != mJobs.end())
+    {
+        it->mbCanceled = true;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove all cached files
+//--------------------------------------------------------------------------
+void CArtifactCache::clear()
+{
+    loadIndex();
+
+    for (const auto& k : mIndex.keys())
+    {
+        // files in use are dropped by their job
+        if (!mBusy.contains(k))
+        {
+            remove(k);
+        }
+    }
+
+    mSaveTimer.stop();
+    saveIndex();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create PCM key for a track
+//!
+//! @param[in]  tracks  all tracks (index 0 is the disc entry)
+//! @param[in]  idx     index of track in tracks
+//!
+//! @return     key or empty string
+//--------------------------------------------------------------------------
+QString CArtifactCache::pcmKey(const c2n::AudioTracks& tracks, int idx)
+{
+    if ((idx < 1) || (idx >= tracks.size()))
+    {
+        return QString();
+    }
+
+    const c2n::STrackInfo& t = tracks.at(idx);
+
+    if (tracks.listType() == c2n::AudioTracks::CD)
+    {
+        // disc identity is the TOC
+        QString toc = QString::number(tracks.at(0).mLbCount);
+
+        for (int i = 1; i < tracks.size(); i++)
+        {
+            toc += QString(":%1+%2").arg(tracks.at(i).mStartLba).arg(tracks.at(i).mLbCount);
+        }
+
+        return QString("pcm:cd:%1:%2:%3")
+                .arg(QString(QCryptographicHash::hash(toc.toUtf8(), QCryptographicHash::Sha1).toHex()))
+                .arg(t.mStartLba)
+                .arg(t.mLbCount);
+    }
+
+    QString fp = fileFingerprint(t.mFileName);
+
+    if (fp.isEmpty())
+    {
+        return QString();
+    }
+
+    return QString("pcm:file:%1:%2:%3:%4").arg(fp).arg(t.mStartLba).arg(t.mLbCount).arg(t.mConversion);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create ATRAC key
+//!
+//! @param[in]  pcmHash  content hash of the PCM source
+//! @param[in]  cmd      encoder command
+//! @param[in]  altEnc   alternate encoder in use
+//!
+//! @return     key or empty string
+//--------------------------------------------------------------------------
+QString CArtifactCache::atracKey(const QByteArray& pcmHash, CXEnc::XEncCmd cmd, bool altEnc)
+{
+    if (pcmHash.isEmpty() || (cmd == CXEnc::XEncCmd::NONE))
+    {
+        return QString();
+    }
+
+    return QString("atrac:%1:%2:%3")
+            .arg(QString(pcmHash.toHex()))
+            .arg(static_cast<int>(cmd))
+            .arg(altEnc ? "at3tool" : "atracdenc");
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start copy in thread pool
+//!
+//! @param[in]  job   job description
+//! @param[in]  src   The source
+//! @param[in]  dst   The destination
+//!
+//! @return     job id
+//--------------------------------------------------------------------------
+int CArtifactCache::startJob(const SJob& job, const QString& src, const QString& dst)
+{
+    int  id = mNextJob++;
+    SJob j  = job;
+
+    j.mpWatcher = new QFutureWatcher<SCopy>(this);
+    connect(j.mpWatcher, &QFutureWatcher<SCopy>::finished, this, [this, id]() { jobDone(id); });
+
+    mJobs.insert(id, j);
+    mBusy.insert(j.mKey);
+
+    j.mpWatcher->setFuture(QtConcurrent::run(&CArtifactCache::hashedCopy, src, dst));
+    return id;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      copy of a job has finished (GUI thread)
+//!
+//! @param[in]  id    The job id
+//--------------------------------------------------------------------------
+void CArtifactCache::jobDone(int id)
+{
+    if (!mJobs.contains(id))
+    {
+        return;
+    }
+
+    SJob  job = mJobs.take(id);
+    SCopy res = job.mpWatcher->result();
+    job.mpWatcher->deleteLater();
+    mBusy.remove(job.mKey);
+
+    if (job.mbFetch)
+    {
+        QString part = job.mFile + ".part";
+        auto    it   = mIndex.find(job.mKey);
+
+        if (job.mbCanceled)
+        {
+            QFile::remove(part);
+            return;
+        }
+
+        if ((it == mIndex.end()) || (res.mSize != it->mSize) || (res.mHash != it->mHash))
+        {
+            qWarning() << "Cache entry" << job.mKey << "is corrupt, dropping it!";
+            QFile::remove(part);
+            remove(job.mKey);
+            indexChanged();
+            emit done(id, false, QByteArray());
+            return;
+        }
+
+        QFile::remove(job.mFile);
+
+        if (!QFile::rename(part, job.mFile))
+        {
+            qWarning() << "Can't move" << part << "to" << job.mFile;
+            QFile::remove(part);
+            emit done(id, false, QByteArray());
+            return;
+        }
+
+        it->mLastUse = QDateTime::currentMSecsSinceEpoch();
+        indexChanged();
+
+        qInfo() << "Cache hit:" << job.mKey << "->" << job.mFile;
+        emit done(id, true, res.mHash);
+        return;
+    }
+
+    if (job.mbCanceled || !enabled() || (res.mSize <= 0))
+    {
+        QFile::remove(mDir + "/" + job.mFile);
+
+        if (!job.mbCanceled)
+        {
+            emit done(id, false, res.mHash);
+        }
+        return;
+    }
+
+    mIndex.insert(job.mKey, {job.mFile, res.mSize, res.mHash, QDateTime::currentMSecsSinceEpoch()});
+    evict(job.mKey);
+
+    // a single file bigger than the budget isn't worth it
+    if (res.mSize > mBudget)
+    {
+        remove(job.mKey);
+    }
+
+    indexChanged();
+
+    bool ok = mIndex.contains(job.mKey);
+
+    if (ok)
+    {
+        qInfo() << "Cached" << job.mKey;
+    }
+
+    emit done(id, ok, res.mHash);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      index has changed, write it a bit later
+//--------------------------------------------------------------------------
+void CArtifactCache::indexChanged()
+{
+    // collect changes of a whole run instead of writing on every hit
+    if (!mSaveTimer.isActive())
+    {
+        mSaveTimer.start();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      load index from cache folder
+//--------------------------------------------------------------------------
+void CArtifactCache::loadIndex()
+{
+    if (mbLoaded)
+    {
+        return;
+    }
+
+    mbLoaded = true;
+    QFile f(mDir + "/index.json");
+
+    if (f.open(QIODevice::ReadOnly))
+    {
+        QJsonObject idx = QJsonDocument::fromJson(f.readAll()).object();
+
+        for (auto it = idx.constBegin(); it != idx.constEnd(); it++)
+        {
+            QJsonObject o = it.value().toObject();
+            SEntry e = {
+                o["file"].toString(),
+                static_cast<qint64>(o["size"].toDouble()),
+                QByteArray::fromHex(o["hash"].toString().toLatin1()),
+                static_cast<qint64>(o["used"].toDouble())
+            };
+
+            // drop entries whose file is gone
+            if (QFileInfo(mDir + "/" + e.mFile).size() == e.mSize)
+            {
+                mIndex.insert(it.key(), e);
+            }
+        }
+        f.close();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write index to cache folder
+//--------------------------------------------------------------------------
+void CArtifactCache::saveIndex() const
+{
+    QJsonObject idx;
+
+    for (auto it = mIndex.constBegin(); it != mIndex.constEnd(); it++)
+    {
+        QJsonObject o;
+        o["file"] = it.value().mFile;
+        o["size"] = static_cast<double>(it.value().mSize);
+        o["hash"] = QString(it.value().mHash.toHex());
+        o["used"] = static_cast<double>(it.value().mLastUse);
+        idx[it.key()] = o;
+    }
+
+    QDir().mkpath(mDir);
+    QFile f(mDir + "/index.json");
+
+    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        f.write(QJsonDocument(idx).toJson(QJsonDocument::Compact));
+        f.close();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove least recently used entries until budget fits
+//!             (entries in use by a job are kept)
+//!
+//! @param[in]  keep  key which shouldn't be removed
+//--------------------------------------------------------------------------
+void CArtifactCache::evict(const QString& keep)
+{
+    qint64 total = 0;
+    QList<QPair<qint64, QString>> lru;
+
+    for (auto it = mIndex.constBegin(); it != mIndex.constEnd(); it++)
+    {
+        total += it.value().mSize;
+
+        if ((it.key() != keep) && !mBusy.contains(it.key()))
+        {
+            lru.append(qMakePair(it.value().mLastUse, it.key()));
+        }
+    }
+
+    std::sort(lru.begin(), lru.end());
+
+    for (const auto& l : lru)
+    {
+        if (total <= mBudget)
+        {
+            break;
+        }
+
+        qInfo() << "Evict cache entry" << l.second;
+        total -= mIndex.value(l.second).mSize;
+        remove(l.second);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove one entry
+//!
+//! @param[in]  key   The key
+//--------------------------------------------------------------------------
+void CArtifactCache::remove(const QString& key)
+{
+    if (mIndex.contains(key))
+    {
+        QFile::remove(mDir + "/" + mIndex.value(key).mFile);
+        mIndex.remove(key);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      copy file and create content hash on the fly
+//!             (runs in thread pool)
+//!
+//! @param[in]  src   The source
+//! @param[in]  dst   The destination (may be empty for hash only)
+//!
+//! @return     copied bytes (-1 on error) and content hash
+//--------------------------------------------------------------------------
+CArtifactCache::SCopy CArtifactCache::hashedCopy(const QString& src, const QString& dst)
+{
+    QFile in(src);
+    QFile out(dst);
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    qint64 sz = 0;
+
+    if (!in.open(QIODevice::ReadOnly))
+    {
+        return {-1, QByteArray()};
+    }
+
+    if (!dst.isEmpty() && !out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return {-1, QByteArray()};
+    }
+
+    while (!in.atEnd())
+    {
+        QByteArray chunk = in.read(COPY_CHUNK);
+
+        if (chunk.isEmpty())
+        {
+            return {-1, QByteArray()};
+        }
+
+        h.addData(chunk);
+
+        if (out.isOpen() && (out.write(chunk) != chunk.size()))
+        {
+            return {-1, QByteArray()};
+        }
+
+        sz += chunk.size();
+    }
+
+    return {sz, h.result()};
+}
+
+//--------------------------------------------------------------------------
+//! @brief      cheap identity of a source file
+//!
+//! @param[in]  fileName  The file name
+//!
+//! @return     fingerprint (hex) or empty string
+//--------------------------------------------------------------------------
+QString CArtifactCache::fileFingerprint(const QString& fileName)
+{
+    QFileInfo fi(fileName);
+    QFile     f(fileName);
+
+    if (fileName.isEmpty() || !f.open(QIODevice::ReadOnly))
+    {
+        return QString();
+    }
+
+    // size, modification time and head / tail content:
+    // hashing whole source files would cost more than decoding them
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(QString("%1:%2").arg(fi.size()).arg(fi.lastModified().toMSecsSinceEpoch()).toUtf8());
+    h.addData(f.read(FINGERPRINT_SZ));
+
+    if (fi.size() > FINGERPRINT_SZ)
+    {
+        f.seek(fi.size() - FINGERPRINT_SZ);
+        h.addData(f.read(FINGERPRINT_SZ));
+    }
+
+    f.close();
+    return h.result().toHex();
+}
@@ -0,0 +1,274 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QMap>
+#include <QSet>
+#include <QTimer>
+#include <QFutureWatcher>
+#include "defines.h"
+#include "cxenc.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Persistent store for ripped PCM and encoded ATRAC files.
+//!             PCM is keyed by source (disc TOC or file fingerprint) and
+//!             range, ATRAC by PCM content hash and encoder command.
+//!             Least recently used entries are evicted when the byte budget
+//!             is exceeded, content hashes are verified on every fetch.
+//!             Files are copied and hashed in the thread pool, the result
+//!             of a job is reported through the done() signal.
+//------------------------------------------------------------------------------
+class CArtifactCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// fetch() / store() didn't start a job
+    static constexpr int NO_JOB = -1;
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    CArtifactCache(QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object (waits for running jobs, writes index).
+    //--------------------------------------------------------------------------
+    ~CArtifactCache() override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set max. cache size
+    //!
+    //! @param[in]  bytes  budget in bytes (0 disables the cache)
+    //--------------------------------------------------------------------------
+    void setBudget(qint64 bytes);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is cache in use
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool enabled() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      is key in cache
+    //!
+    //! @param[in]  key   The cache key
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool contains(const QString& key) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      start copy of cached file to target; done() tells if
+    //!             the entry was valid (target stays untouched if not)
+    //!
+    //! @param[in]  key     The cache key
+    //! @param[in]  target  The target file name
+    //!
+    //! @return     job id, NO_JOB on cache miss
+    //--------------------------------------------------------------------------
+    int fetch(const QString& key, const QString& target);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start copy of file into cache; done() tells if it was
+    //!             stored and gives the content hash (also if not stored)
+    //!
+    //! @param[in]  key     The cache key
+    //! @param[in]  source  The source file name
+    //!
+    //! @return     job id, NO_JOB if nothing is copied
+    //--------------------------------------------------------------------------
+    int store(const QString& key, const QString& source);
+
+    //--------------------------------------------------------------------------
+    //! @brief      drop result of a running job (no done() signal, copied
+    //!             data is removed when the job has finished)
+    //!
+    //! @param[in]  job   The job id
+    //--------------------------------------------------------------------------
+    void cancel(int job);
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove all cached files
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create PCM key for a track
+    //!
+    //! @param[in]  tracks  all tracks (index 0 is the disc entry)
+    //! @param[in]  idx     index of track in tracks
+    //!
+    //! @return     key or empty string
+    //--------------------------------------------------------------------------
+    static QString pcmKey(const c2n::AudioTracks& tracks, int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      create ATRAC key
+    //!
+    //! @param[in]  pcmHash  content hash of the PCM source
+    //! @param[in]  cmd      encoder command
+    //! @param[in]  altEnc   alternate encoder in use
+    //!
+    //! @return     key or empty string
+    //--------------------------------------------------------------------------
+    static QString atracKey(const QByteArray& pcmHash, CXEnc::XEncCmd cmd, bool altEnc);
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      a fetch / store job has finished
+    //!
+    //! @param[in]  job   The job id
+    //! @param[in]  ok    cache hit (fetch) / file stored (store)
+    //! @param[in]  hash  content hash (empty if copy failed)
+    //--------------------------------------------------------------------------
+    void done(int job, bool ok, const QByteArray& hash);
+
+protected:
+    /// one cache entry
+    struct SEntry
+    {
+        QString    mFile;       ///< file name in cache folder
+        qint64     mSize;       ///< file size
+        QByteArray mHash;       ///< content hash
+        qint64     mLastUse;    ///< last use (ms since epoch)
+    };
+
+    /// result of a copy
+    struct SCopy
+    {
+        qint64     mSize;       ///< copied bytes, -1 on error
+        QByteArray mHash;       ///< content hash
+    };
+
+    /// one running job
+    struct SJob
+    {
+        bool                    mbFetch;    ///< fetch (true) or store (false)
+        QString                 mKey;       ///< cache key
+        QString                 mFile;      ///< fetch: target, store: name in cache folder
+        bool                    mbCanceled; ///< result isn't wanted anymore
+        QFutureWatcher<SCopy>*  mpWatcher;  ///< watches the copy
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      start copy in thread pool
+    //!
+    //! @param[in]  job   job description
+    //! @param[in]  src   The source
+    //! @param[in]  dst   The destination
+    //!
+    //! @return     job id
+    //--------------------------------------------------------------------------
+    int startJob(const SJob& job, const QString& src, const QString& dst);
+
+    //--------------------------------------------------------------------------
+    //! @brief      copy of a job has finished (GUI thread)
+    //!
+    //! @param[in]  id    The job id
+    //--------------------------------------------------------------------------
+    void jobDone(int id);
+
+    //--------------------------------------------------------------------------
+    //! @brief      index has changed, write it a bit later
+    //--------------------------------------------------------------------------
+    void indexChanged();
+
+    //--------------------------------------------------------------------------
+    //! @brief      load index from cache folder
+    //--------------------------------------------------------------------------
+    void loadIndex();
+
+    //--------------------------------------------------------------------------
+    //! @brief      write index to cache folder
+    //--------------------------------------------------------------------------
+    void saveIndex() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove least recently used entries until budget fits
+    //!             (entries in use by a job are kept)
+    //!
+    //! @param[in]  keep  key which shouldn't be removed
+    //--------------------------------------------------------------------------
+    void evict(const QString& keep);
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove one entry
+    //!
+    //! @param[in]  key   The key
+    //--------------------------------------------------------------------------
+    void remove(const QString& key);
+
+    //--------------------------------------------------------------------------
+    //! @brief      copy file and create content hash on the fly
+    //!             (runs in thread pool)
+    //!
+    //! @param[in]  src   The source
+    //! @param[in]  dst   The destination (may be empty for hash only)
+    //!
+    //! @return     copied bytes (-1 on error) and content hash
+    //--------------------------------------------------------------------------
+    static SCopy hashedCopy(const QString& src, const QString& dst);
+
+    //--------------------------------------------------------------------------
+    //! @brief      cheap identity of a source file
+    //!
+    //! @param[in]  fileName  The file name
+    //!
+    //! @return     fingerprint (hex) or empty string
+    //--------------------------------------------------------------------------
+    static QString fileFingerprint(const QString& fileName);
+
+private:
+    /// copy buffer size
+    static constexpr qint64 COPY_CHUNK = 1024 * 1024;
+
+    /// bytes read from head and tail of a source file for the fingerprint
+    static constexpr qint64 FINGERPRINT_SZ = 64 * 1024;
+
+    /// index changes are collected this long before it is written
+    static constexpr int INDEX_SAVE_DELAY_MS = 5000;
+
+    /// cache folder
+    QString mDir;
+
+    /// max. cache size
+    qint64 mBudget;
+
+    /// index was loaded
+    bool mbLoaded;
+
+    /// key -> entry
+    QMap<QString, SEntry> mIndex;
+
+    /// running jobs
+    QMap<int, SJob> mJobs;
+
+    /// keys in use by a running job
+    QSet<QString> mBusy;
+
+    /// next job id
+    int mNextJob;
+
+    /// writes the index after changes
+    QTimer mSaveTimer;
+};
@@ -0,0 +1,838 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cbatchrunner.h"
+#include "cueparser.h"
+#include "cnetmdsim.h"
+#include "audio.h"
+#include "helpers.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QFileInfo>
+#include <QDir>
+#include <QTimer>
+#include <QThread>
+#include <QtDebug>
+#include <cstdio>
+#include <cstring>
+
+//--------------------------------------------------------------------------
+//! @brief      check command line for batch mode switch
+//!
+//! @param[in]  argc  argument count
+//! @param      argv  arguments
+//!
+//! @return     true if batch mode is requested
+//--------------------------------------------------------------------------
+bool CBatchRunner::requested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--batch") || !strcmp(argv[i], "-b"))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CBatchRunner::CBatchRunner(QObject* parent)
+    : QObject(parent), mpRipper(nullptr), mpNetMD(nullptr), mpMirrors(nullptr),
+      mpPipeline(nullptr), mpImporter(nullptr), mbSourceReady(false),
+      mbDeviceReady(false), mDiscNo(0), mDiscCount(0), mTrkCount(0), mFreeSec(0.0),
+      mTransferred(0), mbQuit(false), mDiscStart(0)
+{
+    mOpt = {QStringList(), false, QString(), false, TransferMode::TM_TAO_SP, {8, false},
+            false, false, TitlePolicy::DISC, QString(), false, QString(), 1, 1,
+            CPipeline::DEF_QUEUE_LIMIT, 0, false, true, QString()};
+}
+
+//--------------------------------------------------------------------------
+//! @brief      parse command line
+//!
+//! @param[in]  args  The arguments
+//!
+//! @return     -1 to go on, else exit code
+//--------------------------------------------------------------------------
+int CBatchRunner::parse(const QStringList& args)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString("%1 batch mode: transfer a CD, cue sheet, file list or folder "
+                                             "to MD without GUI. Progress is written as JSON lines to stdout.")
+                                     .arg(c2n::PROGRAM_NAME));
+    parser.addHelpOption();
+    parser.addPositionalArgument("sources", "Audio files, one cue sheet or one folder.", "[sources...]");
+
+    QCommandLineOption optBatch({"b", "batch"}, "Run without GUI.");
+    QCommandLineOption optCD("cd", "Rip from CD drive.");
+    QCommandLineOption optCDDev("cd-device", "CD device (default: first audio drive).", "device");
+    QCommandLineOption optCDDB("cddb", "CDDB lookup if there is no CD-Text (first match wins).");
+    QCommandLineOption optMode({"m", "mode"}, "Transfer mode: TAO_SP, TAO_SP_MONO, TAO_LP2, TAO_LP4, "
+                                              "DAO_SP, DAO_SP_MONO, DAO_SP_PREENC, DAO_LP2, DAO_LP4.", "mode", "TAO_SP");
+    QCommandLineOption optParanoia("paranoia", "Enable CD paranoia mode.");
+    QCommandLineOption optSpeed("read-speed", "CD read speed.", "speed", "8");
+    QCommandLineOption optOtf("otf", "On-the-fly encoding on device (LP modes).");
+    QCommandLineOption optAutoOtf("auto-otf", "Let the placement policy choose on-the-fly or host encoding.");
+    QCommandLineOption optTitles("titles", "Title policy: none, tracks, disc.", "policy", "disc");
+    QCommandLineOption optDiscTitle("disc-title", "Disc title (default: from source).", "title");
+    QCommandLineOption optNoArtist("no-artist", "Don't add artist names to file track titles.");
+    QCommandLineOption optAt3Tool("at3tool", "Path to alternate encoder.", "path");
+    QCommandLineOption optDecoders("decoders", "Parallel decoders (file sources).", "count", "1");
+    QCommandLineOption optEncoders("encoders", "Parallel host encoders.", "count",
+                                   QString::number(qMax(1, QThread::idealThreadCount() / 2)));
+    QCommandLineOption optQueue("queue-limit", "Tracks waiting between two stages (0: unbounded).", "count",
+                                QString::number(CPipeline::DEF_QUEUE_LIMIT));
+    QCommandLineOption optCache("cache", "Artifact cache budget in MiB (0: off).", "mib", "0");
+    QCommandLineOption optDevReset("dev-reset", "Reset device after TOC edit.");
+    QCommandLineOption optNoSizeCheck("no-size-check", "Don't check free space on MD.");
+    QCommandLineOption optSim("sim", "Use simulated device, e.g. \"rate=352800,latency=20\".", "config");
+    QCommandLineOption optMirrors("mirrors", "Simulated recorders getting a copy of every transfer (tests), ';' separated: "
+                                             "\"sim:<config>\" or \"replay:<trace file>\".", "list");
+
+    parser.addOptions({optBatch, optCD, optCDDev, optCDDB, optMode, optParanoia, optSpeed, optOtf,
+                       optAutoOtf, optTitles, optDiscTitle, optNoArtist, optAt3Tool, optDecoders,
+                       optEncoders, optQueue, optCache, optDevReset, optNoSizeCheck, optSim, optMirrors});
+
+    if (!parser.parse(args))
+    {
+        fprintf(stderr, "%s\n", static_cast<const char*>(parser.errorText().toLocal8Bit()));
+        return EXIT_USAGE;
+    }
+
+    if (parser.isSet("help"))
+    {
+        fprintf(stdout, "%s", static_cast<const char*>(parser.helpText().toLocal8Bit()));
+        return EXIT_OK;
+    }
+
+    QString policy = parser.value(optTitles).toLower();
+    bool    ok     = true;
+    bool    okConv;
+
+    mOpt.mSources  = parser.positionalArguments();
+    mOpt.mCD       = parser.isSet(optCD) || parser.isSet(optCDDev);
+    mOpt.mCDDevice = parser.value(optCDDev);
+    mOpt.mCDDB     = parser.isSet(optCDDB);
+    mOpt.mMode     = modeFromName(parser.value(optMode));
+    mOpt.mParanoia = {parser.value(optSpeed).toInt(&okConv), parser.isSet(optParanoia)};
+    ok             = ok && okConv;
+    mOpt.mOtf      = parser.isSet(optOtf);
+    mOpt.mAutoOtf  = parser.isSet(optAutoOtf);
+    mOpt.mTitles   = (policy == "none") ? TitlePolicy::NONE : (policy == "tracks") ? TitlePolicy::TRACKS : TitlePolicy::DISC;
+    ok             = ok && ((policy == "none") || (policy == "tracks") || (policy == "disc"));
+    mOpt.mDiscTitle  = parser.value(optDiscTitle);
+    mOpt.mNoArtist   = parser.isSet(optNoArtist);
+    mOpt.mAt3Tool    = parser.value(optAt3Tool);
+    mOpt.mDecoders   = parser.value(optDecoders).toInt(&okConv);
+    ok               = ok && okConv;
+    mOpt.mEncoders   = parser.value(optEncoders).toInt(&okConv);
+    ok               = ok && okConv;
+    mOpt.mQueueLimit = parser.value(optQueue).toInt(&okConv);
+    ok               = ok && okConv;
+    mOpt.mCache      = parser.value(optCache).toLongLong(&okConv) * 1024 * 1024;
+    ok               = ok && okConv;
+    mOpt.mDevReset   = parser.isSet(optDevReset);
+    mOpt.mSizeCheck  = !parser.isSet(optNoSizeCheck);
+    mOpt.mSim        = parser.value(optSim);
+    mOpt.mMirrors    = parser.value(optMirrors);
+
+    if (!ok || !mOpt.mMode.isValid())
+    {
+        fprintf(stderr, "Invalid option value, see --help.\n");
+        return EXIT_USAGE;
+    }
+
+    if (mOpt.mCD == !mOpt.mSources.isEmpty())
+    {
+        fprintf(stderr, "Give either --cd or source files, see --help.\n");
+        return EXIT_USAGE;
+    }
+
+    return -1;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      load source and device, start first disc
+//--------------------------------------------------------------------------
+void CBatchRunner::start()
+{
+    mClock.start();
+
+    qInfo() << "Batch mode, mode:" << static_cast<const char*>(mOpt.mMode) << "sources:" << mOpt.mSources;
+
+    mpRipper   = new CJackTheRipper(this);
+    mpNetMD    = new CNetMD(this, mOpt.mSim.isEmpty() ? nullptr : new CNetMdSimDevice(CNetMdSimDevice::parseConfig(mOpt.mSim)));
+    mpMirrors  = new CNetMdMirrors(mOpt.mMirrors, this);
+    mpPipeline = new CPipeline(mpRipper, mpNetMD, mpMirrors, &mCache, &mPlacement, this);
+    mpImporter = new CCueImporter(this);
+
+    mpPipeline->setConcurrency(CPipeline::Stage::RIP, mOpt.mDecoders);
+    mpPipeline->setConcurrency(CPipeline::Stage::ENCODE, mOpt.mEncoders);
+    mpPipeline->setQueueLimit(mOpt.mQueueLimit);
+    mCache.setBudget(mOpt.mCache);
+
+    connect(mpRipper, &CJackTheRipper::match, this, [this](c2n::AudioTracks tracks) {
+        addDisc(tracks);
+        sourceDone();
+    });
+
+    connect(mpRipper->cddb(), &CCDDB::match, this, [this](c2n::AudioTracks tracks) {
+        addDisc(tracks);
+        sourceDone();
+    });
+
+    connect(mpRipper->cddb(), &CCDDB::entries, this, [this](QStringList l) {
+        // no one to ask
+        if (!l.isEmpty())
+        {
+            mpRipper->cddb()->getEntry(l.first().split('\t').at(0));
+        }
+    });
+
+    connect(mpRipper, &CJackTheRipper::parseCue, this, [this](QString fileName) {
+        CueParser parser(fileName);
+        mpRipper->setDeviceInfo(QString("%1 (cue)").arg(QFileInfo(fileName).fileName()));
+        addDisc(parser.audioTracks());
+        sourceDone();
+    });
+
+    connect(mpImporter, &CCueImporter::finished, this, [this](int) {
+        for (const auto& d : mpImporter->discs())
+        {
+            if (d.mResult == 0)
+            {
+                addDisc(d.mTracks);
+            }
+            else
+            {
+                qWarning() << "Skipping invalid cue sheet" << d.mCueFile;
+            }
+        }
+
+        if (mpImporter->discs().isEmpty())
+        {
+            // no cue sheets: audio files in folder
+            QDir dir(mOpt.mSources.first());
+            QStringList files;
+
+            for (const auto& f : dir.entryInfoList(QDir::Files | QDir::Readable, QDir::Name))
+            {
+                files.append(f.absoluteFilePath());
+            }
+
+            addDisc(probeFiles(files, dir.dirName()));
+        }
+
+        sourceDone();
+    });
+
+    connect(mpNetMD, &CNetMD::discOut, this, &CBatchRunner::discInfo);
+    connect(mpNetMD, &CNetMD::cmdDone, this, &CBatchRunner::cmdDone);
+
+    connect(mpPipeline, &CPipeline::stageStarted, this, [this](CPipeline::Stage stage, int idx) {
+        stageEvent(stage, idx, true);
+    });
+
+    connect(mpPipeline, &CPipeline::stageDone, this, [this](CPipeline::Stage stage, int idx) {
+        stageEvent(stage, idx, false);
+    });
+
+    connect(mpPipeline, &CPipeline::progress, this, [this](CPipeline::Stage stage, int percent) {
+        int s = static_cast<int>(stage);
+
+        // changes only
+        if (percent != mPercent[s])
+        {
+            mPercent[s] = percent;
+            report("progress", {{"stage", stageName(stage)}, {"percent", percent}});
+        }
+    });
+
+    connect(mpPipeline, &CPipeline::tocEditStarted, this, [this]() {
+        report("toc_edit");
+    });
+
+    connect(mpPipeline, &CPipeline::trackCommitted, this, [this](int idx) {
+        const c2n::SRipTrack& j = mpPipeline->queue().at(idx);
+        report("committed", {{"disc", mDiscNo}, {"track", idx + 1}, {"title", j.mTitle}, {"length", j.mLength}});
+    });
+
+    connect(mpPipeline, &CPipeline::finished, this, &CBatchRunner::transferDone);
+    connect(mpPipeline, &CPipeline::failed, this, [this](int ret) {
+        fail(EXIT_TRANSFER, (ret == CPipeline::RIP_FAILED) ? QString("rip / decode failed")
+                                                           : QString("transfer failed (%1)").arg(ret));
+    });
+
+    if (loadSource())
+    {
+        mpNetMD->start({CNetMD::NetMDCmd::DISCINFO});
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      load source given on command line
+//!
+//! @return     true if loading was started
+//--------------------------------------------------------------------------
+bool CBatchRunner::loadSource()
+{
+    if (mOpt.mCD)
+    {
+        mpRipper->init(mOpt.mCDDB, mOpt.mCDDevice);
+        return true;
+    }
+
+    QFileInfo fi(mOpt.mSources.first());
+
+    if ((mOpt.mSources.size() == 1) && fi.isDir())
+    {
+        mpImporter->start(fi.absoluteFilePath());
+        return true;
+    }
+
+    if ((mOpt.mSources.size() == 1) && !fi.suffix().compare("cue", Qt::CaseInsensitive))
+    {
+        CueParser parser(fi.absoluteFilePath());
+
+        if (!parser.isValid())
+        {
+            fail(EXIT_SOURCE, QString("can't parse cue sheet %1").arg(fi.absoluteFilePath()));
+            return false;
+        }
+
+        addDisc(parser.audioTracks());
+    }
+    else
+    {
+        addDisc(probeFiles(mOpt.mSources, fi.absoluteDir().dirName()));
+    }
+
+    sourceDone();
+    return !mbQuit;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create source list from audio files
+//!
+//! @param[in]  files      The files
+//! @param[in]  discTitle  disc title if there is no album tag
+//!
+//! @return     source list (disc at index 0), empty if no audio found
+//--------------------------------------------------------------------------
+c2n::AudioTracks CBatchRunner::probeFiles(const QStringList& files, const QString& discTitle) const
+{
+    long discLength = 0;
+    QString album;
+    QString tagAlbum;
+    c2n::STrackInfo trackInfo;
+    c2n::AudioTracks tracks;
+
+    tracks.setListType(c2n::AudioTracks::FILES);
+
+    for (const auto& f : files)
+    {
+        QString url = QFileInfo(f).absoluteFilePath();
+
+        if (probeAudioFile(url, mOpt.mNoArtist, trackInfo, &tagAlbum))
+        {
+            discLength += trackInfo.mLbCount;
+
+            if (album.isEmpty())
+            {
+                album = tagAlbum;
+            }
+
+            tracks.append(trackInfo);
+        }
+        else
+        {
+            qWarning() << "Skipping" << url << "(no audio)";
+        }
+    }
+
+    if (!tracks.isEmpty())
+    {
+        // disc "title"
+        trackInfo.mFileName = "";
+        trackInfo.mStartLba = 0;
+        trackInfo.mLbCount  = discLength;
+        trackInfo.mTitle    = album.isEmpty() ? discTitle : album;
+        trackInfo.mTType    = c2n::TrackType::DISC;
+        tracks.prepend(trackInfo);
+    }
+
+    return tracks;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      source list is ready
+//!
+//! @param[in]  tracks  source list (disc at index 0)
+//--------------------------------------------------------------------------
+void CBatchRunner::addDisc(c2n::AudioTracks tracks)
+{
+    // no data tracks
+    for (auto it = tracks.begin(); it != tracks.end();)
+    {
+        if (it->mTType == c2n::TrackType::DATA)
+        {
+            it = tracks.erase(it);
+        }
+        else
+        {
+            it ++;
+        }
+    }
+
+    if (tracks.size() > 1)
+    {
+        if (!mOpt.mDiscTitle.isEmpty())
+        {
+            tracks[0].mTitle = mOpt.mDiscTitle;
+        }
+        mDiscs.append(tracks);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      all sources are loaded
+//--------------------------------------------------------------------------
+void CBatchRunner::sourceDone()
+{
+    if (mbSourceReady || mbQuit)
+    {
+        return;
+    }
+
+    mbSourceReady = true;
+    mDiscCount    = mDiscs.size();
+
+    QJsonArray discs;
+
+    for (const auto& d : mDiscs)
+    {
+        discs.append(QJsonObject{{"title", d.at(0).mTitle}, {"tracks", d.size() - 1},
+                                 {"length", static_cast<double>(d.at(0).mLbCount) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC)}});
+    }
+
+    report("source", {{"discs", discs}, {"ms", mClock.elapsed()}});
+
+    if (mDiscs.isEmpty())
+    {
+        fail(EXIT_SOURCE, "no audio found");
+    }
+    else if ((mDiscs.size() > 1) && mOpt.mMode.tocManip())
+    {
+        fail(EXIT_USAGE, "TOC edit modes support one disc only");
+    }
+    else if (mbDeviceReady)
+    {
+        nextDisc();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disc info from device
+//!
+//! @param[in]  disc  The disc snapshot
+//--------------------------------------------------------------------------
+void CBatchRunner::discInfo(SDiscSnapshot disc)
+{
+    mDisc = disc;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      device command done
+//!
+//! @param[in]  cmd   The command
+//! @param[in]  ret   The result
+//--------------------------------------------------------------------------
+void CBatchRunner::cmdDone(CNetMD::NetMDCmd cmd, int ret)
+{
+    if (mbQuit)
+    {
+        return;
+    }
+
+    if (cmd == CNetMD::NetMDCmd::DISCINFO)
+    {
+        if ((ret < 0) || mDisc.mDevice.isEmpty())
+        {
+            fail(EXIT_DEVICE, "no NetMD device found");
+            return;
+        }
+
+        report("device", {{"name", mDisc.mDevice}, {"tracks", mDisc.mTrkCount}, {"free", mDisc.mFreeTime},
+                          {"otf", mDisc.mOtfEnc}, {"toc_manip", mDisc.mTocManip},
+                          {"sp_upload", mDisc.mSpUpload}, {"pcm2mono", mDisc.mPcm2Mono},
+                          {"ms", mClock.elapsed()}});
+
+        if (!(mDisc.mDiscFlags & eDiscFlags::WRITEABLE) || (mDisc.mDiscFlags & eDiscFlags::WRITE_LOCK))
+        {
+            fail(EXIT_DEVICE, "MD isn't writeable");
+            return;
+        }
+
+        if (!mOpt.mMode.supports(mDisc.mTocManip, mDisc.mSpUpload, mDisc.mPcm2Mono))
+        {
+            fail(EXIT_DEVICE, QString("mode %1 isn't supported by device").arg(static_cast<const char*>(mOpt.mMode)));
+            return;
+        }
+
+        if ((mOpt.mOtf || mOpt.mAutoOtf) && !mDisc.mOtfEnc)
+        {
+            qWarning() << "Device doesn't support on-the-fly encoding, using host encoder.";
+            mOpt.mOtf     = false;
+            mOpt.mAutoOtf = false;
+        }
+
+        mTrkCount     = mDisc.mTrkCount;
+        mFreeSec      = mDisc.mFreeTime;
+        mbDeviceReady = true;
+
+        if (mbSourceReady)
+        {
+            nextDisc();
+        }
+    }
+    else if (cmd == CNetMD::NetMDCmd::BULK_EDIT)
+    {
+        discDone(ret);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      transfer next disc (if any)
+//--------------------------------------------------------------------------
+void CBatchRunner::nextDisc()
+{
+    if (mDiscs.isEmpty())
+    {
+        quit(EXIT_OK);
+        return;
+    }
+
+    mTracks = mDiscs.takeFirst();
+    mDiscNo ++;
+
+    bool   isCD = (mTracks.listType() == c2n::AudioTracks::CD);
+    double secs = 0.0;
+    CPipeline::TransferQueue queue;
+
+    for (int i = 1; i < mTracks.size(); i++)
+    {
+        const c2n::STrackInfo& t = mTracks.at(i);
+        double length = static_cast<double>(t.mLbCount) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC);
+        secs += length;
+
+        queue.append({static_cast<int16_t>(isCD ? t.mCDTrackNo : i),
+                      (mOpt.mTitles == TitlePolicy::NONE) ? QString() : t.mTitle,
+                      QDir::tempPath() + tempFileName("/cd2netmd.XXXXXX.tmp"),
+                      length,
+                      c2n::WorkStep::NONE,
+                      isCD,
+                      t.mTStamp.toTime_t(),
+                      mOpt.mOtf,
+                      QString(),
+                      mOpt.mMode.isTao() ? CArtifactCache::pcmKey(mTracks, i) : QString(),
+                      QByteArray()});
+    }
+
+    secs /= mOpt.mMode.multi();
+
+    if (mOpt.mSizeCheck && (secs > mFreeSec))
+    {
+        fail(EXIT_NO_SPACE, QString("not enough space on MD for disc %1, need %2s more")
+             .arg(mDiscNo).arg(qRound(secs - mFreeSec)));
+        return;
+    }
+
+    mFreeSec -= secs;
+
+    if (mOpt.mAutoOtf && mOpt.mMode.isTao() && mOpt.mMode.isLP())
+    {
+        QVector<double> lengths;
+
+        for (const auto& j : queue)
+        {
+            lengths.append(j.mLength);
+        }
+
+        QVector<CPlacementPolicy::Route> routes = mPlacement.plan(mDisc.mDevice, mOpt.mMode, lengths);
+
+        for (int i = 0; i < queue.size(); i++)
+        {
+            queue[i].mOtf = (routes.at(i) == CPlacementPolicy::Route::DEVICE_OTF);
+        }
+    }
+
+    for (int s = 0; s < STAGES; s++)
+    {
+        mTimes[s] = {0, 0, -1, 0};
+        mStarted[s].clear();
+        mPercent[s] = -1;
+    }
+
+    mDiscStart = mClock.elapsed();
+
+    report("disc", {{"disc", mDiscNo}, {"of", mDiscCount}, {"title", mTracks.at(0).mTitle},
+                    {"tracks", queue.size()}, {"mode", static_cast<const char*>(mOpt.mMode)}});
+
+    mpPipeline->start(mTracks, queue, {mOpt.mMode, mOpt.mParanoia, mOpt.mAt3Tool,
+                                       mTracks.at(0).mTitle, mTracks.at(0).mLbCount,
+                                       mDisc.mDevice, mOpt.mDevReset});
+}
+
+//--------------------------------------------------------------------------
+//! @brief      pipeline is done with current disc
+//!
+//! @param[in]  ret     result of last device command
+//! @param[in]  tracks  number of transferred tracks
+//--------------------------------------------------------------------------
+void CBatchRunner::transferDone(int ret, int tracks)
+{
+    CNetMD::SBulkEdit edit;
+    QString title = mTracks.at(0).mTitle;
+    deUmlaut(title);
+    edit.clear();
+
+    mTransferred += tracks;
+
+    // titles are part of the TOC edit
+    if ((mOpt.mTitles == TitlePolicy::DISC) && !mOpt.mMode.tocManip())
+    {
+        if (mOpt.mMode.isLP() || (mDiscCount > 1))
+        {
+            // several discs on one MD -> one group each
+            edit.mNewGroups.append({title, static_cast<int16_t>(mTrkCount + 1), static_cast<int16_t>(mTrkCount + tracks)});
+        }
+        else
+        {
+            edit.mbDiscTitle = true;
+            edit.mDiscTitle  = title;
+        }
+    }
+
+    mTrkCount += tracks;
+
+    if (edit.count() > 0)
+    {
+        // discDone() follows on cmdDone()
+        mpNetMD->start(edit, mOpt.mDevReset);
+        mpMirrors->titleEdit(edit, mOpt.mDevReset);
+    }
+    else
+    {
+        discDone(ret);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      current disc is done (incl. titling)
+//!
+//! @param[in]  ret   result of last device command
+//--------------------------------------------------------------------------
+void CBatchRunner::discDone(int ret)
+{
+    qint64 wall = mClock.elapsed() - mDiscStart;
+    double secs = static_cast<double>(mTracks.at(0).mLbCount) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC);
+    QJsonObject stages;
+
+    for (int s = 0; s < STAGES; s++)
+    {
+        const SStageTime& t = mTimes[s];
+        stages[stageName(static_cast<CPipeline::Stage>(s))] = QJsonObject{
+            {"units", t.mTracks},
+            {"busy_ms", t.mBusyMs},
+            {"span_ms", (t.mFirstMs < 0) ? 0 : (t.mLastMs - t.mFirstMs)}
+        };
+    }
+
+    report("disc_done", {{"disc", mDiscNo}, {"ret", ret}, {"wall_ms", wall}, {"audio_s", secs},
+                         {"speed", (wall > 0) ? ((secs * 1000.0) / static_cast<double>(wall)) : 0.0},
+                         {"stages", stages}});
+
+    if (ret < 0)
+    {
+        fail(EXIT_EDIT, QString("titling failed (%1)").arg(ret));
+    }
+    else
+    {
+        nextDisc();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      pipeline stage started / finished a track
+//!
+//! @param[in]  stage    The stage
+//! @param[in]  idx      index in work queue
+//! @param[in]  started  true if started
+//--------------------------------------------------------------------------
+void CBatchRunner::stageEvent(CPipeline::Stage stage, int idx, bool started)
+{
+    int         s   = static_cast<int>(stage);
+    qint64      now = mClock.elapsed() - mDiscStart;
+    SStageTime& t   = mTimes[s];
+    QJsonObject data{{"stage", stageName(stage)}, {"track", idx + 1}, {"ms", now}};
+
+    if (started)
+    {
+        mStarted[s].insert(idx, now);
+        mPercent[s] = -1;
+
+        if (t.mFirstMs < 0)
+        {
+            t.mFirstMs = now;
+        }
+
+        data["state"] = "start";
+    }
+    else
+    {
+        // cache hits have no start
+        qint64 dur = mStarted[s].contains(idx) ? (now - mStarted[s].take(idx)) : 0;
+
+        if (t.mFirstMs < 0)
+        {
+            t.mFirstMs = now;
+        }
+
+        t.mTracks ++;
+        t.mBusyMs += dur;
+        t.mLastMs  = now;
+
+        data["state"]  = "done";
+        data["dur_ms"] = dur;
+    }
+
+    report("stage", data);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop with error
+//!
+//! @param[in]  code  exit code
+//! @param[in]  msg   error message
+//--------------------------------------------------------------------------
+void CBatchRunner::fail(int code, const QString& msg)
+{
+    qWarning() << "Batch failed:" << msg;
+    report("error", {{"code", code}, {"message", msg}});
+    quit(code);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      print summary, wait for device, send done()
+//!
+//! @param[in]  code  exit code
+//--------------------------------------------------------------------------
+void CBatchRunner::quit(int code)
+{
+    if (mbQuit)
+    {
+        return;
+    }
+
+    mbQuit = true;
+
+    report("summary", {{"code", code}, {"discs", mDiscNo}, {"tracks", mTransferred},
+                       {"wall_ms", mClock.elapsed()}});
+
+    mpImporter->cancel();
+
+    // device thread must be idle before objects go away
+    QTimer* pWait = new QTimer(this);
+    connect(pWait, &QTimer::timeout, this, [this, pWait, code]() {
+        if (!mpNetMD->busy() && !mpRipper->busy() && !mpMirrors->busy())
+        {
+            pWait->stop();
+            mpNetMD->wait();
+            emit done(code);
+        }
+    });
+    pWait->start(100);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write one JSON line to stdout
+//!
+//! @param[in]  event  event name
+//! @param[in]  data   event data
+//--------------------------------------------------------------------------
+void CBatchRunner::report(const QString& event, QJsonObject data)
+{
+    data["event"] = event;
+    fprintf(stdout, "%s\n", static_cast<const char*>(QJsonDocument(data).toJson(QJsonDocument::Compact)));
+    fflush(stdout);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      name of a stage
+//!
+//! @param[in]  stage  The stage
+//!
+//! @return     name
+//--------------------------------------------------------------------------
+QString CBatchRunner::stageName(CPipeline::Stage stage)
+{
+    switch (stage)
+    {
+    case CPipeline::Stage::RIP:
+        return "rip";
+    case CPipeline::Stage::ENCODE:
+        return "encode";
+    case CPipeline::Stage::TRANSFER:
+        return "transfer";
+    }
+    return QString();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      find transfer mode by name (e.g. "TAO_LP2")
+//!
+//! @param[in]  name  The name
+//!
+//! @return     transfer mode (invalid if unknown)
+//--------------------------------------------------------------------------
+TransferMode CBatchRunner::modeFromName(const QString& name)
+{
+    QString n = name.toUpper();
+
+    if (!n.startsWith("TM_"))
+    {
+        n.prepend("TM_");
+    }
+
+    for (int m = TransferMode::TM_TAO_START; m < TransferMode::TM_DAO_END; m++)
+    {
+        TransferMode tMode(m);
+
+        if (tMode.isValid() && (n == static_cast<const char*>(tMode)))
+        {
+            return tMode;
+        }
+    }
+
+    return TransferMode::TM_UNKNOWN;
+}
@@ -0,0 +1,336 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QVector>
+#include <QHash>
+#include "defines.h"
+#include "transfermode.h"
+#include "cjacktheripper.h"
+#include "cnetmd.h"
+#include "cnetmdmirrors.h"
+#include "cpipeline.h"
+#include "cplacementpolicy.h"
+#include "cartifactcache.h"
+#include "ccueimporter.h"
+#include "cdiscsnapshot.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Headless batch mode: loads a source (CD, cue sheet, file list
+//!             or folder), runs the pipeline for every disc found and
+//!             reports progress and stage timings as JSON lines on stdout.
+//!             Runs under QCoreApplication, no widgets are created.
+//------------------------------------------------------------------------------
+class CBatchRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// process exit codes
+    enum ExitCode : int
+    {
+        EXIT_OK       = 0,  ///< all discs transferred
+        EXIT_USAGE    = 1,  ///< bad command line
+        EXIT_SOURCE   = 2,  ///< source can't be loaded / is empty
+        EXIT_DEVICE   = 3,  ///< no device, disc not writeable or mode unsupported
+        EXIT_NO_SPACE = 4,  ///< not enough space on MD
+        EXIT_TRANSFER = 5,  ///< rip / encode / transfer failed
+        EXIT_EDIT     = 6   ///< tracks are on MD, titling / grouping failed
+    };
+
+    /// how titles are written
+    enum class TitlePolicy : uint8_t
+    {
+        NONE,   ///< no titles at all
+        TRACKS, ///< track titles only
+        DISC    ///< track titles and disc title (SP) / group (LP, several discs)
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      check command line for batch mode switch
+    //!
+    //! @param[in]  argc  argument count
+    //! @param      argv  arguments
+    //!
+    //! @return     true if batch mode is requested
+    //--------------------------------------------------------------------------
+    static bool requested(int argc, char* argv[]);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    explicit CBatchRunner(QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      parse command line
+    //!
+    //! @param[in]  args  The arguments
+    //!
+    //! @return     -1 to go on, else exit code
+    //--------------------------------------------------------------------------
+    int parse(const QStringList& args);
+
+    //--------------------------------------------------------------------------
+    //! @brief      load source and device, start first disc
+    //--------------------------------------------------------------------------
+    void start();
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      batch is done
+    //!
+    //! @param[in]  code  exit code
+    //--------------------------------------------------------------------------
+    void done(int code);
+
+protected:
+    /// disc flags (see MainWindow)
+    enum eDiscFlags
+    {
+        WRITEABLE  = (1 << 4),
+        WRITE_LOCK = (1 << 6)
+    };
+
+    /// command line settings
+    struct SOptions
+    {
+        QStringList               mSources;     ///< files, cue sheet or folder
+        bool                      mCD;          ///< rip from CD
+        QString                   mCDDevice;    ///< CD device (optional)
+        bool                      mCDDB;        ///< CDDB lookup (first entry wins)
+        TransferMode              mMode;        ///< transfer mode
+        CJackTheRipper::SParanoia mParanoia;    ///< CD paranoia settings
+        bool                      mOtf;         ///< on-the-fly encoding
+        bool                      mAutoOtf;     ///< placement policy decides
+        TitlePolicy               mTitles;      ///< title policy
+        QString                   mDiscTitle;   ///< disc title override
+        bool                      mNoArtist;    ///< no artist in file titles
+        QString                   mAt3Tool;     ///< alternate encoder
+        int                       mDecoders;    ///< parallel decoders
+        int                       mEncoders;    ///< parallel encoders
+        int                       mQueueLimit;  ///< tracks waiting between stages
+        qint64                    mCache;       ///< artifact cache budget
+        bool                      mDevReset;    ///< reset device after TOC edit
+        bool                      mSizeCheck;   ///< check free space
+        QString                   mSim;         ///< simulated device config
+        QString                   mMirrors;     ///< mirror recorder backends
+    };
+
+    /// timing of one stage
+    struct SStageTime
+    {
+        int    mTracks;     ///< finished work units
+        qint64 mBusyMs;     ///< sum of work unit durations
+        qint64 mFirstMs;    ///< first start (-1 -> not started)
+        qint64 mLastMs;     ///< last done
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      load source given on command line
+    //!
+    //! @return     true if loading was started
+    //--------------------------------------------------------------------------
+    bool loadSource();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create source list from audio files
+    //!
+    //! @param[in]  files      The files
+    //! @param[in]  discTitle  disc title if there is no album tag
+    //!
+    //! @return     source list (disc at index 0), empty if no audio found
+    //--------------------------------------------------------------------------
+    c2n::AudioTracks probeFiles(const QStringList& files, const QString& discTitle) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      source list is ready
+    //!
+    //! @param[in]  tracks  source list (disc at index 0)
+    //--------------------------------------------------------------------------
+    void addDisc(c2n::AudioTracks tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      all sources are loaded
+    //--------------------------------------------------------------------------
+    void sourceDone();
+
+    //--------------------------------------------------------------------------
+    //! @brief      disc info from device
+    //!
+    //! @param[in]  disc  The disc snapshot
+    //--------------------------------------------------------------------------
+    void discInfo(SDiscSnapshot disc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      device command done
+    //!
+    //! @param[in]  cmd   The command
+    //! @param[in]  ret   The result
+    //--------------------------------------------------------------------------
+    void cmdDone(CNetMD::NetMDCmd cmd, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      transfer next disc (if any)
+    //--------------------------------------------------------------------------
+    void nextDisc();
+
+    //--------------------------------------------------------------------------
+    //! @brief      pipeline is done with current disc
+    //!
+    //! @param[in]  ret     result of last device command
+    //! @param[in]  tracks  number of transferred tracks
+    //--------------------------------------------------------------------------
+    void transferDone(int ret, int tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      current disc is done (incl. titling)
+    //!
+    //! @param[in]  ret   result of last device command
+    //--------------------------------------------------------------------------
+    void discDone(int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      pipeline stage started / finished a track
+    //!
+    //! @param[in]  stage    The stage
+    //! @param[in]  idx      index in work queue
+    //! @param[in]  started  true if started
+    //--------------------------------------------------------------------------
+    void stageEvent(CPipeline::Stage stage, int idx, bool started);
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop with error
+    //!
+    //! @param[in]  code  exit code
+    //! @param[in]  msg   error message
+    //--------------------------------------------------------------------------
+    void fail(int code, const QString& msg);
+
+    //--------------------------------------------------------------------------
+    //! @brief      print summary, wait for device, send done()
+    //!
+    //! @param[in]  code  exit code
+    //--------------------------------------------------------------------------
+    void quit(int code);
+
+    //--------------------------------------------------------------------------
+    //! @brief      write one JSON line to stdout
+    //!
+    //! @param[in]  event  event name
+    //! @param[in]  data   event data
+    //--------------------------------------------------------------------------
+    void report(const QString& event, QJsonObject data = QJsonObject());
+
+    //--------------------------------------------------------------------------
+    //! @brief      name of a stage
+    //!
+    //! @param[in]  stage  The stage
+    //!
+    //! @return     name
+    //--------------------------------------------------------------------------
+    static QString stageName(CPipeline::Stage stage);
+
+    //--------------------------------------------------------------------------
+    //! @brief      find transfer mode by name (e.g. "TAO_LP2")
+    //!
+    //! @param[in]  name  The name
+    //!
+    //! @return     transfer mode (invalid if unknown)
+    //--------------------------------------------------------------------------
+    static TransferMode modeFromName(const QString& name);
+
+private:
+    /// number of pipeline stages
+    static constexpr int STAGES = 3;
+
+    /// command line settings
+    SOptions mOpt;
+
+    /// ripper / decoder
+    CJackTheRipper* mpRipper;
+
+    /// NetMD device
+    CNetMD* mpNetMD;
+
+    /// additional recorders
+    CNetMdMirrors* mpMirrors;
+
+    /// rip -> encode -> transfer engine
+    CPipeline* mpPipeline;
+
+    /// folder import
+    CCueImporter* mpImporter;
+
+    /// host encoder vs. on-the-fly decision
+    CPlacementPolicy mPlacement;
+
+    /// ripped / encoded tracks from earlier runs
+    CArtifactCache mCache;
+
+    /// discs to transfer (disc entry at index 0)
+    QVector<c2n::AudioTracks> mDiscs;
+
+    /// source list of current disc
+    c2n::AudioTracks mTracks;
+
+    /// disc info from device
+    SDiscSnapshot mDisc;
+
+    /// all sources are loaded
+    bool mbSourceReady;
+
+    /// device info is there
+    bool mbDeviceReady;
+
+    /// number of current disc (1-based)
+    int mDiscNo;
+
+    /// number of discs found
+    int mDiscCount;
+
+    /// tracks on MD before current disc
+    int mTrkCount;
+
+    /// free time on MD (s)
+    double mFreeSec;
+
+    /// transferred tracks
+    int mTransferred;
+
+    /// batch is stopping
+    bool mbQuit;
+
+    /// batch clock
+    QElapsedTimer mClock;
+
+    /// start of current disc
+    qint64 mDiscStart;
+
+    /// timings of current disc
+    SStageTime mTimes[STAGES];
+
+    /// start time per stage and queue index
+    QHash<int, qint64> mStarted[STAGES];
+
+    /// last reported percent per stage
+    int mPercent[STAGES];
+};
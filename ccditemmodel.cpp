@@ -30,8 +30,15 @@
 //--------------------------------------------------------------------------
 CCDItemModel::CCDItemModel(const c2n::AudioTracks &tracks,
                            QObject *parent)
-    :QAbstractTableModel(parent), mTracks(tracks)
+    :QAbstractTableModel(parent), mTracks(tracks), mIcon(":/view/audio"), mLength(0)
 {
+    mTimes.resize(mTracks.size());
+    mShown = qMin(mTracks.size(), static_cast<int>(FETCH_BATCH));
+
+    for (const auto& t : mTracks)
+    {
+        mLength += t.mLbCount;
+    }
 }
 
 CCDItemModel::~CCDItemModel()
@@ -42,7 +49,7 @@ CCDItemModel::~CCDItemModel()
 int CCDItemModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    return mTracks.size();
+    return mShown;
 }
 
 int CCDItemModel::columnCount(const QModelIndex &parent) const
@@ -63,17 +70,7 @@ QVariant CCDItemModel::data(const QModelIndex &index, int role) const
         case 0:
             return mTracks.at(row).mTitle;
         case 1:
-            {
-                float secs = static_cast<float>(mTracks.at(row).mLbCount) / static_cast<float>(CDIO_CD_FRAMES_PER_SEC);
-                int h = static_cast<int>(secs) / 3600;
-                int m = (static_cast<int>(secs) % 3600) / 60;
-
-                float fsec = secs - static_cast<float>(h * 3600 + m * 60);
-                return QString("%1:%2:%3")
-                    .arg(h, 1, 10, QChar('0'))
-                    .arg(m, 2, 10, QChar('0'))
-                    .arg(fsec, 5, 'f', 2, QChar('0'));
-            }
+            return timeString(row);
         default:
             return QVariant();
         }
@@ -84,7 +81,7 @@ QVariant CCDItemModel::data(const QModelIndex &index, int role) const
     }
     else if ((role == Qt::DecorationRole) && (col == 0))
     {
-        return QIcon(":/view/audio");
+        return mIcon;
     }
     else if ((role == Qt::UserRole) && (col == 1))
     {
@@ -108,7 +105,7 @@ bool CCDItemModel::setData(const QModelIndex &index, const QVariant &value, int
     {
         if (col == 0)
         {
-            mTracks[row].mTitle = value.toString();
+            setTitle(row, value.toString());
             return true;
         }
     }
@@ -188,22 +185,184 @@ bool CCDItemModel::removeRows(int row, int count, const QModelIndex &parent)
 {
     Q_UNUSED(parent)
 
-    if ((row > -1) && (row > -1))
+    if ((row > -1) && (count > 0) && ((row + count) <= mShown))
     {
         beginRemoveRows(parent, row, row + count - 1);
         for(int i = (count - 1); i >= 0; i--)
         {
-            if ((i + row) < mTracks.size())
-            {
-                mTracks.remove(i + row);
-            }
+            mLength -= mTracks.at(i + row).mLbCount;
         }
+        mTracks.remove(row, count);
+        mTimes.remove(row, count);
+        mShown -= count;
         endRemoveRows();
         return true;
     }
     return false;
 }
 
+//--------------------------------------------------------------------------
+//! @brief      are there rows not yet shown
+//!
+//! @param[in]  parent       parent modell index
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CCDItemModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && (mShown < mTracks.size());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      show next batch of rows
+//!
+//! @param[in]  parent       parent modell index
+//--------------------------------------------------------------------------
+void CCDItemModel::fetchMore(const QModelIndex &parent)
+{
+    int count = qMin(static_cast<int>(FETCH_BATCH), mTracks.size() - mShown);
+
+    if (parent.isValid() || (count <= 0))
+    {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), mShown, mShown + count - 1);
+    mShown += count;
+    endInsertRows();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      show all rows (e.g. before select all)
+//--------------------------------------------------------------------------
+void CCDItemModel::fetchAll()
+{
+    if (mShown < mTracks.size())
+    {
+        beginInsertRows(QModelIndex(), mShown, mTracks.size() - 1);
+        mShown = mTracks.size();
+        endInsertRows();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      append tracks (e.g. while probing dropped files)
+//!
+//! @param[in]  tracks  The tracks
+//--------------------------------------------------------------------------
+void CCDItemModel::appendTracks(const c2n::AudioTracks& tracks)
+{
+    for (const auto& t : tracks)
+    {
+        mLength += t.mLbCount;
+    }
+
+    mTracks += tracks;
+    mTimes.resize(mTracks.size());
+
+    // first batch is shown right away, more on demand
+    if (mShown < FETCH_BATCH)
+    {
+        int count = qMin(static_cast<int>(FETCH_BATCH), mTracks.size()) - mShown;
+
+        if (count > 0)
+        {
+            beginInsertRows(QModelIndex(), mShown, mShown + count - 1);
+            mShown += count;
+            endInsertRows();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set title of one track
+//!
+//! @param[in]  row    The row
+//! @param[in]  title  The title
+//--------------------------------------------------------------------------
+void CCDItemModel::setTitle(int row, const QString& title)
+{
+    if ((row < 0) || (row >= mTracks.size()) || (mTracks.at(row).mTitle == title))
+    {
+        return;
+    }
+
+    mTracks[row].mTitle = title;
+
+    if (row < mShown)
+    {
+        emit dataChanged(index(row, 0), index(row, 0));
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      take over titles if tracks match the shown ones
+//!
+//! @param[in]  tracks  The tracks
+//!
+//! @return     true if tracks matched
+//--------------------------------------------------------------------------
+bool CCDItemModel::updateTitles(const c2n::AudioTracks& tracks)
+{
+    if ((tracks.listType() != mTracks.listType()) || (tracks.size() != mTracks.size()))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < tracks.size(); i++)
+    {
+        if ((tracks.at(i).mFileName != mTracks.at(i).mFileName)
+            || (tracks.at(i).mStartLba != mTracks.at(i).mStartLba)
+            || (tracks.at(i).mLbCount != mTracks.at(i).mLbCount)
+            || (tracks.at(i).mCDTrackNo != mTracks.at(i).mCDTrackNo)
+            || (tracks.at(i).mTStamp != mTracks.at(i).mTStamp))
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < tracks.size(); i++)
+    {
+        setTitle(i, tracks.at(i).mTitle);
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get list type
+//!
+//! @return     list type
+//--------------------------------------------------------------------------
+c2n::AudioTracks::List_t CCDItemModel::listType() const
+{
+    return mTracks.listType();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      formatted track time (cached)
+//!
+//! @param[in]  row   The row
+//!
+//! @return     time string
+//--------------------------------------------------------------------------
+const QString& CCDItemModel::timeString(int row) const
+{
+    if (mTimes.at(row).isEmpty())
+    {
+        float secs = static_cast<float>(mTracks.at(row).mLbCount) / static_cast<float>(CDIO_CD_FRAMES_PER_SEC);
+        int h = static_cast<int>(secs) / 3600;
+        int m = (static_cast<int>(secs) % 3600) / 60;
+
+        float fsec = secs - static_cast<float>(h * 3600 + m * 60);
+        mTimes[row] = QString("%1:%2:%3")
+            .arg(h, 1, 10, QChar('0'))
+            .arg(m, 2, 10, QChar('0'))
+            .arg(fsec, 5, 'f', 2, QChar('0'));
+    }
+    return mTimes.at(row);
+}
+
 //--------------------------------------------------------------------------
 //! @brief      get length of audio in kist
 //!
@@ -211,12 +370,7 @@ bool CCDItemModel::removeRows(int row, int count, const QModelIndex &parent)
 //--------------------------------------------------------------------------
 long CCDItemModel::audioLength() const
 {
-    long length = 0;
-    for (const auto& t : mTracks)
-    {
-        length += t.mLbCount;
-    }
-    return length;
+    return mLength;
 }
 
 //--------------------------------------------------------------------------
@@ -297,7 +451,7 @@ bool CCDItemModel::dropMimeData(const QMimeData *data, Qt::DropAction action, in
     }
     else
     {
-        beginRow = rowCount(QModelIndex());
+        beginRow = mTracks.size();
     }
 
     QByteArray encodedData = data->data("application/vnd.text.list");
@@ -317,6 +471,7 @@ bool CCDItemModel::dropMimeData(const QMimeData *data, Qt::DropAction action, in
 
     // create temp audio tracks vector for sorting
     c2n::AudioTracks tmpTracks;
+    tmpTracks.setListType(mTracks.listType());
     bool tracksHandled = false;
 
     for (int i = 0; i < mTracks.size(); i++)
@@ -345,6 +500,9 @@ bool CCDItemModel::dropMimeData(const QMimeData *data, Qt::DropAction action, in
         }
     }
 
+    emit layoutAboutToBeChanged();
     mTracks = tmpTracks;
+    mTimes.fill(QString(), mTracks.size());
+    emit layoutChanged();
     return true;
 }
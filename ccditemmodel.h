@@ -20,6 +20,7 @@
 #include <QStringList>
 #include <QVector>
 #include <QVariant>
+#include <QIcon>
 #include "defines.h"
 
 //------------------------------------------------------------------------------
@@ -157,6 +158,58 @@ public:
     //--------------------------------------------------------------------------
     bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
 
+    //--------------------------------------------------------------------------
+    //! @brief      are there rows not yet shown
+    //!
+    //! @param[in]  parent       parent modell index
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      show next batch of rows
+    //!
+    //! @param[in]  parent       parent modell index
+    //--------------------------------------------------------------------------
+    void fetchMore(const QModelIndex &parent) override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      show all rows (e.g. before select all)
+    //--------------------------------------------------------------------------
+    void fetchAll();
+
+    //--------------------------------------------------------------------------
+    //! @brief      append tracks (e.g. while probing dropped files)
+    //!
+    //! @param[in]  tracks  The tracks
+    //--------------------------------------------------------------------------
+    void appendTracks(const c2n::AudioTracks& tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set title of one track
+    //!
+    //! @param[in]  row    The row
+    //! @param[in]  title  The title
+    //--------------------------------------------------------------------------
+    void setTitle(int row, const QString& title);
+
+    //--------------------------------------------------------------------------
+    //! @brief      take over titles if tracks match the shown ones
+    //!
+    //! @param[in]  tracks  The tracks
+    //!
+    //! @return     true if tracks matched
+    //--------------------------------------------------------------------------
+    bool updateTitles(const c2n::AudioTracks& tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get list type
+    //!
+    //! @return     list type
+    //--------------------------------------------------------------------------
+    c2n::AudioTracks::List_t listType() const;
+
     //--------------------------------------------------------------------------
     //! @brief      get length of audio in kist
     //!
@@ -172,6 +225,31 @@ public:
     c2n::AudioTracks audioTracks() const;
 
 protected:
+    //--------------------------------------------------------------------------
+    //! @brief      formatted track time (cached)
+    //!
+    //! @param[in]  row   The row
+    //!
+    //! @return     time string
+    //--------------------------------------------------------------------------
+    const QString& timeString(int row) const;
+
     /// backend data storage
     c2n::AudioTracks mTracks;
+
+    /// formatted track times (empty -> not yet formatted)
+    mutable QVector<QString> mTimes;
+
+    /// shared track icon
+    QIcon mIcon;
+
+    /// number of rows shown
+    int mShown;
+
+    /// audio length in blocks
+    long mLength;
+
+private:
+    /// rows made visible by one fetchMore()
+    static constexpr int FETCH_BATCH = 1000;
 };
@@ -14,12 +14,18 @@
  *
  * You should have received a copy of the GNU General Public License
  */
-#include <QRegExp>
+#include <QRegularExpression>
 #include "ccliprocess.h"
 #include "defines.h"
 
+#ifdef Q_OS_WIN
+    #include <windows.h>
+#else
+    #include <sys/resource.h>
+#endif // Q_OS_WIN
+
 CCliProcess::CCliProcess(QObject *parent)
-    :QProcess(parent)
+    :QProcess(parent), mbLowPrio(false)
 {
     QProcess::setProcessChannelMode(ProcessChannelMode::MergedChannels);
     QProcess::setReadChannel(ProcessChannel::StandardOutput);
@@ -37,7 +43,8 @@ CCliProcess::CCliProcess(QObject *parent)
 void CCliProcess::run(const QString &program, const QStringList &arguments,
                       QIODevice::OpenMode mode, const QString& nativeArgs)
 {
-    mLog.clear();
+    mLineBuf.clear();
+    mLogTail.clear();
     QProcess::setProgram(program);
     QStringList args = arguments;
 
@@ -49,8 +56,27 @@ void CCliProcess::run(const QString &program, const QStringList &arguments,
 #endif // Q_OS_WIN
 
     QProcess::setArguments(args);
+
+#ifdef Q_OS_WIN
+    bool low = mbLowPrio;
+    setCreateProcessArgumentsModifier([low](QProcess::CreateProcessArguments *args)
+    {
+        if (low)
+        {
+            args->flags |= BELOW_NORMAL_PRIORITY_CLASS;
+        }
+    });
+#endif // Q_OS_WIN
+
     QProcess::start(mode);
     waitForStarted();
+
+#ifndef Q_OS_WIN
+    if (mbLowPrio && (processId() > 0))
+    {
+        setpriority(PRIO_PROCESS, static_cast<id_t>(processId()), 10);
+    }
+#endif // Q_OS_WIN
 }
 
 bool CCliProcess::busy() const
@@ -58,25 +84,131 @@ bool CCliProcess::busy() const
     return state() != QProcess::NotRunning;
 }
 
-void CCliProcess::extractPercent()
+//--------------------------------------------------------------------------
+//! @brief      run following processes with lowered priority
+//!
+//! @param[in]  low   true -> low priority; false -> normal priority
+//--------------------------------------------------------------------------
+void CCliProcess::setLowPriority(bool low)
+{
+    mbLowPrio = low;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get the last lines of process output
+//!
+//! @return     output tail, lines separated by new line
+//--------------------------------------------------------------------------
+QString CCliProcess::logTail() const
+{
+    return mLogTail.join(QChar('\n'));
+}
+
+//--------------------------------------------------------------------------
+//! @brief      handle one complete output line (default: percent rule)
+//!
+//! @param[in]  line  The output line (without line break)
+//--------------------------------------------------------------------------
+void CCliProcess::parseLine(const QString& line)
 {
-    mLog += QString::fromUtf8(readAllStandardOutput());
-    int pos;
+    static const QRegularExpression rxPercent("([0-9]+)%");
+
+    int percent = -1;
+    QRegularExpressionMatchIterator it = rxPercent.globalMatch(line);
 
-    if ((pos = mLog.lastIndexOf(QChar('%'))) > 0)
+    // last value in line wins
+    while (it.hasNext())
     {
-        int startPos = mLog.lastIndexOf(QRegExp("[^0-9]+"), pos - 1);
+        percent = it.next().captured(1).toInt();
+    }
 
-        if (startPos > -1)
-        {
-            bool ok;
-            int length  = (pos - 1) - startPos;
-            int percent = mLog.mid(startPos + 1, length).toInt(&ok);
+    if (percent > -1)
+    {
+        emit progress(percent);
+    }
+}
 
-            if (ok)
+//--------------------------------------------------------------------------
+//! @brief      should overlong lines be cut at MAX_LINE_LENGTH?
+//!             (default: yes)
+//!
+//! @return     true -> cut lines; false -> collect until line break
+//--------------------------------------------------------------------------
+bool CCliProcess::capLines() const
+{
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      read pending output and handle a not terminated last line
+//!             (call when process has finished)
+//--------------------------------------------------------------------------
+void CCliProcess::flushOutput()
+{
+    extractPercent();
+
+    if (!mLineBuf.isEmpty())
+    {
+        consumeLine(mLineBuf);
+        mLineBuf.clear();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      read new output and feed complete lines to parser
+//--------------------------------------------------------------------------
+void CCliProcess::extractPercent()
+{
+    feedOutput(readAllStandardOutput());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add output data and feed complete lines to parser
+//!
+//! @param[in]  data  The output data
+//--------------------------------------------------------------------------
+void CCliProcess::feedOutput(const QByteArray& data)
+{
+    mLineBuf += data;
+    int from = 0;
+
+    for (int i = 0; i < mLineBuf.size(); i++)
+    {
+        // progress lines are often terminated by carriage return only
+        if ((mLineBuf.at(i) == '\n') || (mLineBuf.at(i) == '\r'))
+        {
+            if (i > from)
             {
-                emit progress(percent);
+                consumeLine(mLineBuf.mid(from, i - from));
             }
+            from = i + 1;
         }
     }
+
+    mLineBuf.remove(0, from);
+
+    if (capLines() && (mLineBuf.size() > MAX_LINE_LENGTH))
+    {
+        consumeLine(mLineBuf);
+        mLineBuf.clear();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      store line in log tail and hand it over to the parser
+//!
+//! @param[in]  raw   The raw line data
+//--------------------------------------------------------------------------
+void CCliProcess::consumeLine(const QByteArray& raw)
+{
+    QString line = QString::fromUtf8(raw);
+
+    mLogTail.append(line);
+
+    while (mLogTail.size() > LOG_TAIL_LINES)
+    {
+        mLogTail.removeFirst();
+    }
+
+    parseLine(line);
 }
@@ -17,6 +17,8 @@
 #pragma once
 #include <QObject>
 #include <QProcess>
+#include <QByteArray>
+#include <QStringList>
 
 //------------------------------------------------------------------------------
 //! @brief      This class describes a cli process.
@@ -24,6 +26,13 @@
 class CCliProcess : public QProcess
 {
     Q_OBJECT
+
+    /// number of output lines kept for the debug dump
+    static constexpr int LOG_TAIL_LINES = 200;
+
+    /// a line longer than this is cut (tools which never send a line break)
+    static constexpr int MAX_LINE_LENGTH = 4096;
+
 public:
     //--------------------------------------------------------------------------
     //! @brief      Constructs a new instance.
@@ -52,11 +61,54 @@ public:
     //--------------------------------------------------------------------------
     bool busy() const;
 
+    //--------------------------------------------------------------------------
+    //! @brief      run following processes with lowered priority
+    //!
+    //! @param[in]  low   true -> low priority; false -> normal priority
+    //--------------------------------------------------------------------------
+    void setLowPriority(bool low);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get the last lines of process output
+    //!
+    //! @return     output tail, lines separated by new line
+    //--------------------------------------------------------------------------
+    QString logTail() const;
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      handle one complete output line (default: percent rule)
+    //!
+    //! @param[in]  line  The output line (without line break)
+    //--------------------------------------------------------------------------
+    virtual void parseLine(const QString& line);
+
+    //--------------------------------------------------------------------------
+    //! @brief      should overlong lines be cut at MAX_LINE_LENGTH?
+    //!             (default: yes)
+    //!
+    //! @return     true -> cut lines; false -> collect until line break
+    //--------------------------------------------------------------------------
+    virtual bool capLines() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      read pending output and handle a not terminated last line
+    //!             (call when process has finished)
+    //--------------------------------------------------------------------------
+    void flushOutput();
+
+    //--------------------------------------------------------------------------
+    //! @brief      add output data and feed complete lines to parser
+    //!
+    //! @param[in]  data  The output data
+    //--------------------------------------------------------------------------
+    void feedOutput(const QByteArray& data);
+
 protected slots:
     //--------------------------------------------------------------------------
-    //! @brief      extract percentage from log file
+    //! @brief      read new output and feed complete lines to parser
     //--------------------------------------------------------------------------
-    virtual void extractPercent();
+    void extractPercent();
 
 signals:
     //--------------------------------------------------------------------------
@@ -66,8 +118,21 @@ signals:
     //--------------------------------------------------------------------------
     void progress(int);
 
-protected:
-    /// log content
-    QString mLog;
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      store line in log tail and hand it over to the parser
+    //!
+    //! @param[in]  raw   The raw line data
+    //--------------------------------------------------------------------------
+    void consumeLine(const QByteArray& raw);
+
+    /// not yet terminated output line
+    QByteArray mLineBuf;
+
+    /// last output lines
+    QStringList mLogTail;
+
+    /// start process with low priority
+    bool mbLowPrio;
 };
 
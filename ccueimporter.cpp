@@ -0,0 +1,192 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "ccueimporter.h"
+#include "cueparser.h"
+#include <QDirIterator>
+#include <QRunnable>
+#include <QThread>
+#include <QtDebug>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+    //--------------------------------------------------------------------------
+    //! @brief      parses one cue sheet on a pool thread
+    //--------------------------------------------------------------------------
+    class CParseJob : public QRunnable
+    {
+    public:
+        using Done = std::function<void(const CCueImporter::SDisc&)>;
+
+        CParseJob(const QString& cueFile, const Done& done)
+            : mCueFile(cueFile), mDone(done)
+        {
+        }
+
+        void run() override
+        {
+            CueParser parser;
+            CCueImporter::SDisc disc;
+            disc.mCueFile = mCueFile;
+            disc.mResult  = parser.parse(mCueFile);
+            disc.mTracks  = parser.audioTracks();
+            mDone(disc);
+        }
+
+    private:
+        QString mCueFile;
+        Done    mDone;
+    };
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CCueImporter::CCueImporter(QObject* parent)
+    : QObject(parent), mGeneration(0), mDone(0)
+{
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object (waits for running parsers)
+//--------------------------------------------------------------------------
+CCueImporter::~CCueImporter()
+{
+    mPool.clear();
+    mPool.waitForDone();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of parallel parsers
+//!
+//! @param[in]  count  The count (< 1 -> number of CPU cores)
+//--------------------------------------------------------------------------
+void CCueImporter::setSize(int count)
+{
+    mPool.setMaxThreadCount((count < 1) ? QThread::idealThreadCount() : count);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start import, a running import is canceled
+//!
+//! @param[in]  folder  The root folder
+//!
+//! @return     number of cue sheets found
+//--------------------------------------------------------------------------
+int CCueImporter::start(const QString& folder)
+{
+    cancel();
+
+    QStringList files;
+    QDirIterator it(folder, {"*.cue"}, QDir::Files | QDir::Readable, QDirIterator::Subdirectories);
+
+    while (it.hasNext())
+    {
+        files.append(it.next());
+    }
+
+    std::sort(files.begin(), files.end());
+
+    mDiscs.resize(files.size());
+    qInfo() << "Importing" << files.size() << "cue sheets from" << folder;
+
+    int generation = mGeneration;
+
+    for (int i = 0; i < files.size(); i++)
+    {
+        mDiscs[i] = {files.at(i), -1, {}};
+
+        // destructor waits for the pool, so 'this' outlives every job;
+        // results are handed over to the owner's thread
+        mPool.start(new CParseJob(files.at(i), [this, generation, i](const SDisc& disc) {
+            QMetaObject::invokeMethod(this, [this, generation, i, disc]() {
+                parsed(generation, i, disc);
+            }, Qt::QueuedConnection);
+        }));
+    }
+
+    if (files.isEmpty())
+    {
+        emit finished(0);
+    }
+
+    return files.size();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      cancel running import
+//--------------------------------------------------------------------------
+void CCueImporter::cancel()
+{
+    mPool.clear();
+    mGeneration++;
+    mDone = 0;
+    mDiscs.clear();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is import running
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CCueImporter::busy() const
+{
+    return mDone < mDiscs.size();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get imported cue sheets
+//!
+//! @return     all cue sheets found (sorted by file name)
+//--------------------------------------------------------------------------
+const QVector<CCueImporter::SDisc>& CCueImporter::discs() const
+{
+    return mDiscs;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      take result from worker
+//!
+//! @param[in]  generation  import run the result belongs to
+//! @param[in]  idx         index in discs()
+//! @param[in]  disc        The parsed disc
+//--------------------------------------------------------------------------
+void CCueImporter::parsed(int generation, int idx, const SDisc& disc)
+{
+    if ((generation != mGeneration) || (idx >= mDiscs.size()))
+    {
+        return;
+    }
+
+    mDiscs[idx] = disc;
+    mDone++;
+
+    emit discParsed(idx, mDone, mDiscs.size());
+
+    if (mDone == mDiscs.size())
+    {
+        int valid = std::count_if(mDiscs.cbegin(), mDiscs.cend(), [](const SDisc& d) {
+            return d.mResult == 0;
+        });
+
+        qInfo() << "Cue import done," << valid << "of" << mDiscs.size() << "sheets are valid";
+        emit finished(valid);
+    }
+}
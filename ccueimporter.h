@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QVector>
+#include <QThreadPool>
+#include "defines.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Imports a whole folder tree of cue sheets. Every sheet is
+//!             parsed (and its audio files probed) on a worker pool, results
+//!             are handed back in the GUI thread in sorted file order.
+//------------------------------------------------------------------------------
+class CCueImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// one imported cue sheet
+    struct SDisc
+    {
+        QString          mCueFile;  ///< cue sheet file name
+        int              mResult;   ///< parser result (0 -> ok)
+        c2n::AudioTracks mTracks;   ///< source list entries (disc at index 0)
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    explicit CCueImporter(QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object (waits for running parsers)
+    //--------------------------------------------------------------------------
+    ~CCueImporter();
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of parallel parsers
+    //!
+    //! @param[in]  count  The count (< 1 -> number of CPU cores)
+    //--------------------------------------------------------------------------
+    void setSize(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start import, a running import is canceled
+    //!
+    //! @param[in]  folder  The root folder
+    //!
+    //! @return     number of cue sheets found
+    //--------------------------------------------------------------------------
+    int start(const QString& folder);
+
+    //--------------------------------------------------------------------------
+    //! @brief      cancel running import
+    //--------------------------------------------------------------------------
+    void cancel();
+
+    //--------------------------------------------------------------------------
+    //! @brief      is import running
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool busy() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get imported cue sheets
+    //!
+    //! @return     all cue sheets found (sorted by file name)
+    //--------------------------------------------------------------------------
+    const QVector<SDisc>& discs() const;
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      one cue sheet was parsed
+    //!
+    //! @param[in]  idx    index in discs()
+    //! @param[in]  done   parsed sheets so far
+    //! @param[in]  count  all sheets
+    //--------------------------------------------------------------------------
+    void discParsed(int idx, int done, int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      import has finished
+    //!
+    //! @param[in]  valid  number of valid cue sheets
+    //--------------------------------------------------------------------------
+    void finished(int valid);
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      take result from worker
+    //!
+    //! @param[in]  generation  import run the result belongs to
+    //! @param[in]  idx         index in discs()
+    //! @param[in]  disc        The parsed disc
+    //--------------------------------------------------------------------------
+    void parsed(int generation, int idx, const SDisc& disc);
+
+private:
+    /// worker threads
+    QThreadPool mPool;
+
+    /// import run, results of canceled runs are dropped
+    int mGeneration;
+
+    /// parsed sheets of current run
+    int mDone;
+
+    /// all cue sheets
+    QVector<SDisc> mDiscs;
+};
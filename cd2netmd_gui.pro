@@ -1,4 +1,4 @@
-QT       += core gui network
+QT       += core gui network concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -78,7 +78,21 @@ SOURCES += \
     settingsdlg.cpp \
     audio.cpp \
     statuswidget.cpp \
-    ctranslit.cpp
+    ctranslit.cpp \
+    cplacementpolicy.cpp \
+    cartifactcache.cpp \
+    cdecoderpool.cpp \
+    cusbhotplug.cpp \
+    cnetmddevice.cpp \
+    cnetmdsim.cpp \
+    cnetmdtrace.cpp \
+    cnetmdmirrors.cpp \
+    cdisccache.cpp \
+    cdiscsnapshot.cpp \
+    ccueimporter.cpp \
+    cpipeline.cpp \
+    cbatchrunner.cpp \
+    cjobqueue.cpp
 
 HEADERS += \
     cdaoconfdlg.h \
@@ -107,7 +121,21 @@ HEADERS += \
     statuswidget.h \
     ctranslit.h \
     git_version.h \
-    transfermode.h
+    transfermode.h \
+    cplacementpolicy.h \
+    cartifactcache.h \
+    cdecoderpool.h \
+    cusbhotplug.h \
+    cnetmddevice.h \
+    cnetmdsim.h \
+    cnetmdtrace.h \
+    cnetmdmirrors.h \
+    cdisccache.h \
+    cdiscsnapshot.h \
+    ccueimporter.h \
+    cpipeline.h \
+    cbatchrunner.h \
+    cjobqueue.h
 
 FORMS += \
     caboutdialog.ui \
@@ -0,0 +1,265 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cdecoderpool.h"
+#include <QFile>
+#include <QtDebug>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CDecoderPool::CDecoderPool(QObject* parent)
+    : QObject(parent), mSize(1), mbLowPrio(false)
+{
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of parallel decoders
+//!
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CDecoderPool::setSize(int count)
+{
+    mSize = qMax(1, count);
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      run decoders with lowered priority
+//!
+//! @param[in]  low   true -> low priority
+//--------------------------------------------------------------------------
+void CDecoderPool::setLowPriority(bool low)
+{
+    mbLowPrio = low;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add job to queue
+//!
+//! @param[in]  job    The job
+//! @param[in]  front  if true, job is started before all pending ones
+//--------------------------------------------------------------------------
+void CDecoderPool::enqueue(const SJob& job, bool front)
+{
+    if (contains(job.mTarget))
+    {
+        return;
+    }
+
+    if (front)
+    {
+        mPending.prepend(job);
+    }
+    else
+    {
+        mPending.append(job);
+    }
+
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      move pending job to the front of the queue
+//!
+//! @param[in]  target  The target file name
+//--------------------------------------------------------------------------
+void CDecoderPool::promote(const QString& target)
+{
+    for (int i = 0; i < mPending.size(); i++)
+    {
+        if (mPending.at(i).mTarget == target)
+        {
+            mPending.move(i, 0);
+            break;
+        }
+    }
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is job known (pending, running or done)
+//!
+//! @param[in]  target  The target file name
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CDecoderPool::contains(const QString& target) const
+{
+    if (mDone.contains(target))
+    {
+        return true;
+    }
+
+    for (const auto& r : mRunning)
+    {
+        if (r == target)
+        {
+            return true;
+        }
+    }
+
+    for (const auto& p : mPending)
+    {
+        if (p.mTarget == target)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is job done
+//!
+//! @param[in]  target  The target file name
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CDecoderPool::done(const QString& target) const
+{
+    return mDone.contains(target);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      was job done successfully
+//!
+//! @param[in]  target  The target file name
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CDecoderPool::succeeded(const QString& target) const
+{
+    return mDone.value(target, false);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop decoders, remove incomplete files, forget jobs;
+//!             jobs of targets in keep go on (or stay done)
+//!
+//! @param[in]  keep  target file names to keep
+//--------------------------------------------------------------------------
+void CDecoderPool::cancel(const QStringList& keep)
+{
+    for (int i = mPending.size() - 1; i >= 0; i--)
+    {
+        if (!keep.contains(mPending.at(i).mTarget))
+        {
+            mPending.removeAt(i);
+        }
+    }
+
+    for (auto it = mRunning.begin(); it != mRunning.end();)
+    {
+        if (keep.contains(it.value()))
+        {
+            it++;
+            continue;
+        }
+
+        CFFMpeg* pDec = it.key();
+        disconnect(pDec, &CFFMpeg::fileDone, this, nullptr);
+        pDec->kill();
+        pDec->waitForFinished();
+
+        qInfo() << "Decoder canceled, removing" << it.value();
+        QFile::remove(it.value());
+        mIdle.append(pDec);
+        it = mRunning.erase(it);
+    }
+
+    for (auto it = mDone.begin(); it != mDone.end();)
+    {
+        if (keep.contains(it.key()))
+        {
+            it++;
+        }
+        else
+        {
+            it = mDone.erase(it);
+        }
+    }
+
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start pending jobs on free decoders
+//--------------------------------------------------------------------------
+void CDecoderPool::schedule()
+{
+    while (!mPending.isEmpty() && (mRunning.size() < mSize))
+    {
+        SJob job = mPending.takeFirst();
+        CFFMpeg* pDec;
+
+        if (!mIdle.isEmpty())
+        {
+            pDec = mIdle.takeFirst();
+        }
+        else
+        {
+            pDec = new CFFMpeg(this);
+            connect(pDec, &CFFMpeg::progress, [this, pDec](int percent) {
+                if (mRunning.contains(pDec))
+                {
+                    emit progress(mRunning.value(pDec), percent);
+                }
+            });
+        }
+
+        connect(pDec, &CFFMpeg::fileDone, this, [this, pDec](bool ok) { decoderDone(pDec, ok); });
+
+        mRunning.insert(pDec, job.mTarget);
+        pDec->setLowPriority(mbLowPrio);
+
+        if (job.mRange)
+        {
+            pDec->startRange(job.mSource, job.mTarget, job.mConversion, job.mStartSec, job.mLengthSec);
+        }
+        else
+        {
+            pDec->start(job.mSource, job.mTarget, job.mConversion);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      a decoder has finished
+//!
+//! @param      pDec  The decoder
+//! @param[in]  ok    true if decoded successfully
+//--------------------------------------------------------------------------
+void CDecoderPool::decoderDone(CFFMpeg* pDec, bool ok)
+{
+    disconnect(pDec, &CFFMpeg::fileDone, this, nullptr);
+
+    QString target = mRunning.take(pDec);
+    mIdle.append(pDec);
+    mDone.insert(target, ok);
+
+    if (!ok)
+    {
+        // don't leave a truncated wave file behind
+        QFile::remove(target);
+    }
+
+    schedule();
+    emit jobDone(target, ok);
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QStringList>
+#include "cffmpeg.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Runs several decoder processes at once. Jobs are identified
+//!             by their target file name and started in queue order.
+//------------------------------------------------------------------------------
+class CDecoderPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// one decode job
+    struct SJob
+    {
+        QString  mSource;       ///< source file
+        QString  mTarget;       ///< target wave file
+        uint32_t mConversion;   ///< conversion flags
+        double   mStartSec;     ///< range start (seconds)
+        double   mLengthSec;    ///< range length (seconds, <= 0 -> up to end)
+        bool     mRange;        ///< decode range only
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    explicit CDecoderPool(QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of parallel decoders
+    //!
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setSize(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      run decoders with lowered priority
+    //!
+    //! @param[in]  low   true -> low priority
+    //--------------------------------------------------------------------------
+    void setLowPriority(bool low);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add job to queue
+    //!
+    //! @param[in]  job    The job
+    //! @param[in]  front  if true, job is started before all pending ones
+    //--------------------------------------------------------------------------
+    void enqueue(const SJob& job, bool front = false);
+
+    //--------------------------------------------------------------------------
+    //! @brief      move pending job to the front of the queue
+    //!
+    //! @param[in]  target  The target file name
+    //--------------------------------------------------------------------------
+    void promote(const QString& target);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is job known (pending, running or done)
+    //!
+    //! @param[in]  target  The target file name
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool contains(const QString& target) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      is job done
+    //!
+    //! @param[in]  target  The target file name
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool done(const QString& target) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      was job done successfully
+    //!
+    //! @param[in]  target  The target file name
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool succeeded(const QString& target) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop decoders, remove incomplete files, forget jobs;
+    //!             jobs of targets in keep go on (or stay done)
+    //!
+    //! @param[in]  keep  target file names to keep
+    //--------------------------------------------------------------------------
+    void cancel(const QStringList& keep = QStringList());
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      a job has finished
+    //!
+    //! @param[in]  target  The target file name
+    //! @param[in]  ok      true if decoded successfully
+    //--------------------------------------------------------------------------
+    void jobDone(QString target, bool ok);
+
+    //--------------------------------------------------------------------------
+    //! @brief      progress of a running job
+    //!
+    //! @param[in]  target   The target file name
+    //! @param[in]  percent  The percent
+    //--------------------------------------------------------------------------
+    void progress(QString target, int percent);
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      start pending jobs on free decoders
+    //--------------------------------------------------------------------------
+    void schedule();
+
+    //--------------------------------------------------------------------------
+    //! @brief      a decoder has finished
+    //!
+    //! @param      pDec  The decoder
+    //! @param[in]  ok    true if decoded successfully
+    //--------------------------------------------------------------------------
+    void decoderDone(CFFMpeg* pDec, bool ok);
+
+private:
+    /// max. number of parallel decoders
+    int mSize;
+
+    /// low priority for decoders
+    bool mbLowPrio;
+
+    /// jobs not yet started
+    QList<SJob> mPending;
+
+    /// running decoders -> target file
+    QMap<CFFMpeg*, QString> mRunning;
+
+    /// finished jobs -> success
+    QMap<QString, bool> mDone;
+
+    /// idle decoders
+    QList<CFFMpeg*> mIdle;
+};
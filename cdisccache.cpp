@@ -0,0 +1,351 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cdisccache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QtDebug>
+#include <algorithm>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//--------------------------------------------------------------------------
+CDiscCache::CDiscCache()
+    : mPending{SDiscSnapshot(), 0}, mbPending(false), mExpect(-1)
+{
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create disc fingerprint
+//!
+//! @param[in]  title       disc title
+//! @param[in]  trackCount  track count
+//! @param[in]  recorded    recorded time (seconds)
+//! @param[in]  utoc        UTOC hash (empty if not readable)
+//!
+//! @return     fingerprint
+//--------------------------------------------------------------------------
+QByteArray CDiscCache::fingerprint(const QString& title, int trackCount, int recorded, const QByteArray& utoc)
+{
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(QString("%1:%2:").arg(trackCount).arg(recorded).toUtf8());
+    h.addData(title.toUtf8());
+    h.addData(utoc);
+    return h.result();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      make disc the current one
+//!
+//! @param[in]  fp          disc fingerprint
+//! @param[in]  trackCount  track count
+//!
+//! @return     number of leading tracks with title and mode in cache
+//--------------------------------------------------------------------------
+int CDiscCache::select(const QByteArray& fp, int trackCount)
+{
+    if (!mDiscs.contains(fp))
+    {
+        int cached = mPending.mDisc.mTracks.size();
+
+        if (mbPending && ((mExpect == trackCount) || ((mExpect < 0) && (trackCount >= cached))))
+        {
+            qInfo() << "Disc changed as expected, taking over" << cached << "cached tracks.";
+            mDiscs.insert(fp, mPending);
+        }
+        else
+        {
+            mDiscs.insert(fp, {SDiscSnapshot(), 0});
+        }
+    }
+
+    mbPending = false;
+    mPending.mDisc = SDiscSnapshot();
+    mCurrent  = fp;
+
+    SDisc& d  = mDiscs[fp];
+    d.mLastUse = QDateTime::currentMSecsSinceEpoch();
+
+    QVector<SDiscSnapshot::STrack>& tracks = d.mDisc.mTracks;
+
+    tracks.resize(qMin(tracks.size(), trackCount));
+
+    while (tracks.size() < trackCount)
+    {
+        tracks.append(SDiscSnapshot::emptyTrack(tracks.size()));
+    }
+
+    evict();
+
+    int known = 0;
+    const uint8_t need = SDiscSnapshot::TF_TITLE | SDiscSnapshot::TF_BITRATE;
+
+    while ((known < tracks.size()) && ((tracks.at(known).mFields & need) == need))
+    {
+        known++;
+    }
+
+    return known;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add cached track of current disc to batch
+//!
+//! @param[in]  no     track number (0-based)
+//! @param      batch  The batch
+//!
+//! @return     false if track isn't cached
+//--------------------------------------------------------------------------
+bool CDiscCache::track(int no, SDiscSnapshot& batch) const
+{
+    const SDisc* pDisc = current();
+
+    if ((pDisc == nullptr) || (no < 0) || (no >= pDisc->mDisc.mTracks.size()))
+    {
+        return false;
+    }
+
+    batch.appendTrack(pDisc->mDisc, pDisc->mDisc.mTracks.at(no));
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      are cached title / mode of track equal to given ones
+//!
+//! @param[in]  src   snapshot holding the track
+//! @param[in]  t     the track
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CDiscCache::sameTrack(const SDiscSnapshot& src, const SDiscSnapshot::STrack& t) const
+{
+    const SDisc* pDisc = current();
+
+    if ((pDisc == nullptr) || (t.mNo < 0) || (t.mNo >= pDisc->mDisc.mTracks.size()))
+    {
+        return false;
+    }
+
+    const SDiscSnapshot& d         = pDisc->mDisc;
+    const SDiscSnapshot::STrack& c = d.mTracks.at(t.mNo);
+
+    return (d.str(c.mName) == src.str(t.mName)) && (d.str(c.mBitrate) == src.str(t.mBitrate));
+}
+
+//--------------------------------------------------------------------------
+//! @brief      are protection / time of track in cache
+//!
+//! @param[in]  no    track number (0-based)
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CDiscCache::hasDetails(int no) const
+{
+    const SDisc* pDisc = current();
+
+    if ((pDisc == nullptr) || (no < 0) || (no >= pDisc->mDisc.mTracks.size()))
+    {
+        return false;
+    }
+
+    return !!(pDisc->mDisc.mTracks.at(no).mFields & SDiscSnapshot::TF_DETAILS);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      merge track data into current disc
+//!
+//! @param[in]  batch  snapshot holding (partial) tracks
+//--------------------------------------------------------------------------
+void CDiscCache::update(const SDiscSnapshot& batch)
+{
+    SDisc* pDisc = active();
+
+    if (pDisc == nullptr)
+    {
+        return;
+    }
+
+    for (const auto& t : batch.mTracks)
+    {
+        pDisc->mDisc.mergeTrack(batch, t);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      track was renamed
+//!
+//! @param[in]  no    track number (0-based)
+//! @param[in]  name  new name
+//--------------------------------------------------------------------------
+void CDiscCache::renameTrack(int no, const QString& name)
+{
+    SDisc* pDisc = active();
+
+    if (pDisc == nullptr)
+    {
+        return;
+    }
+
+    SDiscSnapshot& d = pDisc->mDisc;
+
+    if ((no >= 0) && (no < d.mTracks.size()))
+    {
+        d.mTracks[no].mName    = d.intern(name.isEmpty() ? QString("<untitled>") : name);
+        d.mTracks[no].mFields |= SDiscSnapshot::TF_TITLE;
+    }
+
+    titlesChanged();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disc, group or track titles changed (track list stays)
+//--------------------------------------------------------------------------
+void CDiscCache::titlesChanged()
+{
+    SDisc* pDisc = active();
+
+    // titles are part of the fingerprint; a pending expectation stays
+    if ((pDisc != nullptr) && !mbPending)
+    {
+        makePending(pDisc->mDisc.mTracks.size());
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      track was deleted (following tracks move up)
+//!
+//! @param[in]  no    track number (0-based)
+//--------------------------------------------------------------------------
+void CDiscCache::deleteTrack(int no)
+{
+    SDisc* pDisc = active();
+
+    if (pDisc == nullptr)
+    {
+        return;
+    }
+
+    QVector<SDiscSnapshot::STrack>& tracks = pDisc->mDisc.mTracks;
+
+    if ((no < 0) || (no >= tracks.size()))
+    {
+        forget();
+        return;
+    }
+
+    tracks.removeAt(no);
+
+    for (int i = no; i < tracks.size(); i++)
+    {
+        tracks[i].mNo = static_cast<int16_t>(i);
+    }
+
+    makePending(tracks.size());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disc was erased
+//--------------------------------------------------------------------------
+void CDiscCache::eraseDisc()
+{
+    SDisc* pDisc = active();
+
+    if (pDisc != nullptr)
+    {
+        pDisc->mDisc = SDiscSnapshot();
+        makePending(0);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      tracks were added at the end of the disc
+//--------------------------------------------------------------------------
+void CDiscCache::tracksAdded()
+{
+    if (active() != nullptr)
+    {
+        makePending(-1);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      drop current disc (content unknown after edit)
+//--------------------------------------------------------------------------
+void CDiscCache::forget()
+{
+    mDiscs.remove(mCurrent);
+    mCurrent.clear();
+    mbPending = false;
+    mPending.mDisc = SDiscSnapshot();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      move current disc to pending slot (fingerprint changes)
+//!
+//! @param[in]  expect  expected track count (-1 -> at least cached ones)
+//--------------------------------------------------------------------------
+void CDiscCache::makePending(int expect)
+{
+    if (!mbPending && mDiscs.contains(mCurrent))
+    {
+        mPending  = mDiscs.take(mCurrent);
+        mbPending = true;
+    }
+
+    mCurrent.clear();
+    mExpect = expect;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disc edits are applied to (pending or current one)
+//!
+//! @return     disc or nullptr if there is none
+//--------------------------------------------------------------------------
+CDiscCache::SDisc* CDiscCache::active()
+{
+    if (mbPending)
+    {
+        return &mPending;
+    }
+
+    auto it = mDiscs.find(mCurrent);
+    return (it == mDiscs.end()) ? nullptr : &it.value();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      current disc
+//!
+//! @return     disc or nullptr if there is none
+//--------------------------------------------------------------------------
+const CDiscCache::SDisc* CDiscCache::current() const
+{
+    auto it = mDiscs.constFind(mCurrent);
+    return (it == mDiscs.constEnd()) ? nullptr : &it.value();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      drop least recently used discs
+//--------------------------------------------------------------------------
+void CDiscCache::evict()
+{
+    while (mDiscs.size() > MAX_DISCS)
+    {
+        auto oldest = std::min_element(mDiscs.begin(), mDiscs.end(),
+            [](const SDisc& a, const SDisc& b) { return a.mLastUse < b.mLastUse; });
+
+        mDiscs.erase(oldest);
+    }
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QMap>
+#include "cdiscsnapshot.h"
+
+//------------------------------------------------------------------------------
+//! @brief      In-memory store of MD track lists, keyed by a cheap disc
+//!             fingerprint (title, track count, recorded time, UTOC hash).
+//!             Known edits are applied locally; the changed disc is taken
+//!             over by the next disc info request if its track count fits.
+//!             Worker thread only.
+//------------------------------------------------------------------------------
+class CDiscCache
+{
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //--------------------------------------------------------------------------
+    CDiscCache();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create disc fingerprint
+    //!
+    //! @param[in]  title       disc title
+    //! @param[in]  trackCount  track count
+    //! @param[in]  recorded    recorded time (seconds)
+    //! @param[in]  utoc        UTOC hash (empty if not readable)
+    //!
+    //! @return     fingerprint
+    //--------------------------------------------------------------------------
+    static QByteArray fingerprint(const QString& title, int trackCount, int recorded, const QByteArray& utoc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      make disc the current one
+    //!
+    //! @param[in]  fp          disc fingerprint
+    //! @param[in]  trackCount  track count
+    //!
+    //! @return     number of leading tracks with title and mode in cache
+    //--------------------------------------------------------------------------
+    int select(const QByteArray& fp, int trackCount);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add cached track of current disc to batch
+    //!
+    //! @param[in]  no     track number (0-based)
+    //! @param      batch  The batch
+    //!
+    //! @return     false if track isn't cached
+    //--------------------------------------------------------------------------
+    bool track(int no, SDiscSnapshot& batch) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      are cached title / mode of track equal to given ones
+    //!
+    //! @param[in]  src   snapshot holding the track
+    //! @param[in]  t     the track
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool sameTrack(const SDiscSnapshot& src, const SDiscSnapshot::STrack& t) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      are protection / time of track in cache
+    //!
+    //! @param[in]  no    track number (0-based)
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool hasDetails(int no) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      merge track data into current disc
+    //!
+    //! @param[in]  batch  snapshot holding (partial) tracks
+    //--------------------------------------------------------------------------
+    void update(const SDiscSnapshot& batch);
+
+    //--------------------------------------------------------------------------
+    //! @brief      track was renamed
+    //!
+    //! @param[in]  no    track number (0-based)
+    //! @param[in]  name  new name
+    //--------------------------------------------------------------------------
+    void renameTrack(int no, const QString& name);
+
+    //--------------------------------------------------------------------------
+    //! @brief      disc, group or track titles changed (track list stays)
+    //--------------------------------------------------------------------------
+    void titlesChanged();
+
+    //--------------------------------------------------------------------------
+    //! @brief      track was deleted (following tracks move up)
+    //!
+    //! @param[in]  no    track number (0-based)
+    //--------------------------------------------------------------------------
+    void deleteTrack(int no);
+
+    //--------------------------------------------------------------------------
+    //! @brief      disc was erased
+    //--------------------------------------------------------------------------
+    void eraseDisc();
+
+    //--------------------------------------------------------------------------
+    //! @brief      tracks were added at the end of the disc
+    //--------------------------------------------------------------------------
+    void tracksAdded();
+
+    //--------------------------------------------------------------------------
+    //! @brief      drop current disc (content unknown after edit)
+    //--------------------------------------------------------------------------
+    void forget();
+
+protected:
+    /// cached disc
+    struct SDisc
+    {
+        SDiscSnapshot mDisc;     ///< tracks as sent to GUI
+        qint64        mLastUse;  ///< last use (ms since epoch)
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      move current disc to pending slot (fingerprint changes)
+    //!
+    //! @param[in]  expect  expected track count (-1 -> at least cached ones)
+    //--------------------------------------------------------------------------
+    void makePending(int expect);
+
+    //--------------------------------------------------------------------------
+    //! @brief      disc edits are applied to (pending or current one)
+    //!
+    //! @return     disc or nullptr if there is none
+    //--------------------------------------------------------------------------
+    SDisc* active();
+
+    //--------------------------------------------------------------------------
+    //! @brief      current disc
+    //!
+    //! @return     disc or nullptr if there is none
+    //--------------------------------------------------------------------------
+    const SDisc* current() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      drop least recently used discs
+    //--------------------------------------------------------------------------
+    void evict();
+
+private:
+    /// number of discs kept
+    static constexpr int MAX_DISCS = 16;
+
+    /// fingerprint -> disc
+    QMap<QByteArray, SDisc> mDiscs;
+
+    /// fingerprint of current disc
+    QByteArray mCurrent;
+
+    /// locally changed disc waiting for its new fingerprint
+    SDisc mPending;
+
+    /// pending disc is valid
+    bool mbPending;
+
+    /// expected track count of pending disc (-1 -> at least cached ones)
+    int mExpect;
+};
@@ -0,0 +1,209 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cdiscsnapshot.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance (empty string has index 0).
+//--------------------------------------------------------------------------
+SDiscSnapshot::SDiscSnapshot()
+    : mTitle(0), mOtfEnc(false), mTocManip(false), mSpUpload(false), mPcm2Mono(false),
+      mTrkCount(0), mTotTime(0), mFreeTime(0), mUsedTime(0), mDiscFlags(0)
+{
+    intern(QString());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      snapshot shown if there is no device / disc
+//!
+//! @return     snapshot
+//--------------------------------------------------------------------------
+SDiscSnapshot SDiscSnapshot::noDisc()
+{
+    SDiscSnapshot disc;
+    disc.mTitle  = disc.intern("No disc / NetMD device found!");
+    disc.mDevice = "unknown";
+    return disc;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add string to pool (if not there)
+//!
+//! @param[in]  s     string
+//!
+//! @return     pool index
+//--------------------------------------------------------------------------
+uint32_t SDiscSnapshot::intern(const QString& s)
+{
+    auto it = mStringIdx.constFind(s);
+
+    if (it != mStringIdx.constEnd())
+    {
+        return it.value();
+    }
+
+    uint32_t idx = static_cast<uint32_t>(mStrings.size());
+    mStrings.append(s);
+    mStringIdx.insert(s, idx);
+    return idx;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get pooled string
+//!
+//! @param[in]  idx   pool index
+//!
+//! @return     string (empty for invalid index)
+//--------------------------------------------------------------------------
+const QString& SDiscSnapshot::str(uint32_t idx) const
+{
+    return (idx < static_cast<uint32_t>(mStrings.size())) ? mStrings.at(idx) : mStrings.at(0);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      empty track with given number
+//!
+//! @param[in]  no    track number (0-based)
+//!
+//! @return     track
+//--------------------------------------------------------------------------
+SDiscSnapshot::STrack SDiscSnapshot::emptyTrack(int no)
+{
+    return {static_cast<int16_t>(no), 0, 0, 0, 0, 0};
+}
+
+//--------------------------------------------------------------------------
+//! @brief      append track from other snapshot
+//!
+//! @param[in]  src   source snapshot
+//! @param[in]  t     track of source snapshot
+//--------------------------------------------------------------------------
+void SDiscSnapshot::appendTrack(const SDiscSnapshot& src, const STrack& t)
+{
+    mTracks.append(emptyTrack(t.mNo));
+    mergeTrack(src, t);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      merge set fields of a track from other snapshot
+//!
+//! @param[in]  src   source snapshot
+//! @param[in]  t     track of source snapshot
+//!
+//! @return     false if track number is out of range
+//--------------------------------------------------------------------------
+bool SDiscSnapshot::mergeTrack(const SDiscSnapshot& src, const STrack& t)
+{
+    STrack* pTrack = nullptr;
+
+    // batches are appended, disc tracks are indexed by number
+    if (!mTracks.isEmpty() && (mTracks.last().mNo == t.mNo))
+    {
+        pTrack = &mTracks.last();
+    }
+    else if ((t.mNo >= 0) && (t.mNo < mTracks.size()) && (mTracks.at(t.mNo).mNo == t.mNo))
+    {
+        pTrack = &mTracks[t.mNo];
+    }
+
+    if (pTrack == nullptr)
+    {
+        return false;
+    }
+
+    if (t.mFields & TF_TITLE)
+    {
+        pTrack->mName = intern(src.str(t.mName));
+    }
+
+    if (t.mFields & TF_BITRATE)
+    {
+        pTrack->mBitrate = intern(src.str(t.mBitrate));
+    }
+
+    if (t.mFields & TF_DETAILS)
+    {
+        pTrack->mProtect = intern(src.str(t.mProtect));
+        pTrack->mTime    = intern(src.str(t.mTime));
+    }
+
+    pTrack->mFields |= t.mFields;
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      export as JSON (logging / debugging)
+//!
+//! @return     indented JSON
+//--------------------------------------------------------------------------
+QByteArray SDiscSnapshot::toJson() const
+{
+    QJsonObject tree;
+    QJsonArray  groups;
+    QJsonArray  tracks;
+
+    tree.insert("title", str(mTitle));
+    tree.insert("device", mDevice);
+    tree.insert("otf_enc", mOtfEnc ? 1 : 0);
+    tree.insert("toc_manip", mTocManip ? 1 : 0);
+    tree.insert("sp_upload", mSpUpload ? 1 : 0);
+    tree.insert("pcm2mono", mPcm2Mono ? 1 : 0);
+    tree.insert("trk_count", mTrkCount);
+    tree.insert("t_total", mTotTime);
+    tree.insert("t_free", mFreeTime);
+    tree.insert("t_used", mUsedTime);
+    tree.insert("disc_flags", QString("0x%1").arg(mDiscFlags, 2, 16, QChar('0')));
+
+    for (const auto& g : mGroups)
+    {
+        QJsonObject group;
+        group.insert("name", str(g.mName));
+        group.insert("first", g.mFirst);
+        group.insert("last", g.mLast);
+        groups.append(group);
+    }
+
+    for (const auto& t : mTracks)
+    {
+        QJsonObject track;
+        track.insert("no", t.mNo);
+
+        if (t.mFields & TF_TITLE)
+        {
+            track.insert("name", str(t.mName));
+        }
+
+        if (t.mFields & TF_BITRATE)
+        {
+            track.insert("bitrate", str(t.mBitrate));
+        }
+
+        if (t.mFields & TF_DETAILS)
+        {
+            track.insert("protect", str(t.mProtect));
+            track.insert("time", str(t.mTime));
+        }
+        tracks.append(track);
+    }
+
+    tree.insert("groups", groups);
+    tree.insert("tracks", tracks);
+
+    return QJsonDocument(tree).toJson(QJsonDocument::Indented);
+}
@@ -0,0 +1,146 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+//! @brief      MD disc state as read on the worker thread and shown by the
+//!             tree model. Tracks and groups are plain structures, their
+//!             strings live once in a string pool. A snapshot which only
+//!             holds tracks is used to send track batches. JSON is an
+//!             export format only.
+//------------------------------------------------------------------------------
+struct SDiscSnapshot
+{
+    /// track fields which are set
+    enum TrackField : uint8_t
+    {
+        TF_TITLE   = (1 << 0),  ///< title
+        TF_BITRATE = (1 << 1),  ///< encoding / channels
+        TF_DETAILS = (1 << 2),  ///< protection / time
+        TF_ALL     = TF_TITLE | TF_BITRATE | TF_DETAILS
+    };
+
+    /// one track, strings are pool indices
+    struct STrack
+    {
+        int16_t  mNo;       ///< track number (0-based)
+        uint8_t  mFields;   ///< TrackField flags
+        uint32_t mName;     ///< title
+        uint32_t mBitrate;  ///< mode (e.g. "LP2", "SP Mono")
+        uint32_t mProtect;  ///< protection
+        uint32_t mTime;     ///< play time
+    };
+
+    /// one group, strings are pool indices
+    struct SGroup
+    {
+        uint32_t mName;     ///< group name
+        int16_t  mFirst;    ///< first track (1-based)
+        int16_t  mLast;     ///< last track (1-based)
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance (empty string has index 0).
+    //--------------------------------------------------------------------------
+    SDiscSnapshot();
+
+    //--------------------------------------------------------------------------
+    //! @brief      snapshot shown if there is no device / disc
+    //!
+    //! @return     snapshot
+    //--------------------------------------------------------------------------
+    static SDiscSnapshot noDisc();
+
+    //--------------------------------------------------------------------------
+    //! @brief      add string to pool (if not there)
+    //!
+    //! @param[in]  s     string
+    //!
+    //! @return     pool index
+    //--------------------------------------------------------------------------
+    uint32_t intern(const QString& s);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get pooled string
+    //!
+    //! @param[in]  idx   pool index
+    //!
+    //! @return     string (empty for invalid index)
+    //--------------------------------------------------------------------------
+    const QString& str(uint32_t idx) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      empty track with given number
+    //!
+    //! @param[in]  no    track number (0-based)
+    //!
+    //! @return     track
+    //--------------------------------------------------------------------------
+    static STrack emptyTrack(int no);
+
+    //--------------------------------------------------------------------------
+    //! @brief      append track from other snapshot
+    //!
+    //! @param[in]  src   source snapshot
+    //! @param[in]  t     track of source snapshot
+    //--------------------------------------------------------------------------
+    void appendTrack(const SDiscSnapshot& src, const STrack& t);
+
+    //--------------------------------------------------------------------------
+    //! @brief      merge set fields of a track from other snapshot
+    //!
+    //! @param[in]  src   source snapshot
+    //! @param[in]  t     track of source snapshot
+    //!
+    //! @return     false if track number is out of range
+    //--------------------------------------------------------------------------
+    bool mergeTrack(const SDiscSnapshot& src, const STrack& t);
+
+    //--------------------------------------------------------------------------
+    //! @brief      export as JSON (logging / debugging)
+    //!
+    //! @return     indented JSON
+    //--------------------------------------------------------------------------
+    QByteArray toJson() const;
+
+    uint32_t mTitle;     ///< disc title
+    QString  mDevice;    ///< device name
+    bool     mOtfEnc;    ///< on-the-fly encoding support
+    bool     mTocManip;  ///< TOC manipulation support
+    bool     mSpUpload;  ///< SP upload support
+    bool     mPcm2Mono;  ///< PCM to mono support
+    int      mTrkCount;  ///< track count
+    int      mTotTime;   ///< total disc time (s)
+    int      mFreeTime;  ///< free disc time (s)
+    int      mUsedTime;  ///< used disc time (s)
+    int      mDiscFlags; ///< disc flags
+
+    QVector<STrack> mTracks;   ///< tracks
+    QVector<SGroup> mGroups;   ///< groups
+
+private:
+    /// string pool
+    QVector<QString> mStrings;
+
+    /// string -> pool index
+    QHash<QString, uint32_t> mStringIdx;
+};
@@ -22,7 +22,7 @@
 #include <QXmlStreamReader>
 
 CDRUtil::CDRUtil(QObject *parent)
-    : CCliProcess(parent)
+    : CCliProcess(parent), mbInXml(false)
 {
     connect(this, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &CDRUtil::finish);
 }
@@ -30,7 +30,8 @@ CDRUtil::CDRUtil(QObject *parent)
 int CDRUtil::start()
 {
     QStringList params;
-    mLog.clear();
+    mXml.clear();
+    mbInXml = false;
 
     params << "cdtext";
 
@@ -44,27 +45,62 @@ void CDRUtil::finish(int exitCode, ExitStatus exitStatus)
     CDTextData cdtdata;
     if ((exitCode == 0) && (exitStatus == ExitStatus::NormalExit))
     {
-        mLog += QString::fromUtf8(readAllStandardOutput());
+        flushOutput();
 
-        // find xml start- and end marker
-        int start = mLog.indexOf("<?xml");
-        int end   = mLog.lastIndexOf("</plist>");
-
-        if ((start > -1) && (end > -1))
+        if (!mXml.isEmpty() && !mbInXml)
         {
-            QString content = mLog.mid(start, 8 + end - start);
-            parseXml(content, cdtdata);
+            parseXml(mXml, cdtdata);
         }
     }
 
-    if (!mLog.isEmpty())
+    QString log = logTail();
+
+    if (!log.isEmpty())
     {
-        qDebug() << static_cast<const char*>(mLog.toUtf8());
+        qDebug() << static_cast<const char*>(log.toUtf8());
     }
 
     emit fileDone(cdtdata);
 }
 
+//--------------------------------------------------------------------------
+//! @brief      collect xml part of drutil output
+//!
+//! @param[in]  line  The output line
+//--------------------------------------------------------------------------
+void CDRUtil::parseLine(const QString& line)
+{
+    int pos;
+
+    if (!mbInXml && ((pos = line.indexOf("<?xml")) > -1))
+    {
+        mbInXml = true;
+        mXml    = line.mid(pos);
+    }
+    else if (mbInXml)
+    {
+        mXml += QChar('\n') + line;
+    }
+
+    if (mbInXml && line.contains("</plist>"))
+    {
+        // end marker found -> cut trailing garbage
+        mXml.truncate(mXml.lastIndexOf("</plist>") + 8);
+        mbInXml = false;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      don't cut lines while collecting the xml document
+//!             (a cut would put a line break into an xml token)
+//!
+//! @return     true -> cut lines; false -> collect until line break
+//--------------------------------------------------------------------------
+bool CDRUtil::capLines() const
+{
+    return !mbInXml;
+}
+
 //--------------------------------------------------------------------------
 //! @brief      parse output of drutil (xml)
 //!
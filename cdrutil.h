@@ -81,4 +81,25 @@ protected:
     //! @return 0 -> ok; -1 -> error
     //--------------------------------------------------------------------------
     int parseXml(const QString& xmlData, CDTextData& cdtdata);
+
+    //--------------------------------------------------------------------------
+    //! @brief      collect xml part of drutil output
+    //!
+    //! @param[in]  line  The output line
+    //--------------------------------------------------------------------------
+    void parseLine(const QString& line) override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      don't cut lines while collecting the xml document
+    //!             (a cut would put a line break into an xml token)
+    //!
+    //! @return     true -> cut lines; false -> collect until line break
+    //--------------------------------------------------------------------------
+    bool capLines() const override;
+
+    /// xml document from drutil output
+    QString mXml;
+
+    /// are we inside the xml document?
+    bool mbInXml;
 };
@@ -17,10 +17,11 @@
 #include "cffmpeg.h"
 #include "helpers.h"
 #include <QApplication>
+#include <QRegularExpression>
 #include <audio.h>
 
 CFFMpeg::CFFMpeg(QObject *parent)
-    : CCliProcess(parent)
+    : CCliProcess(parent), mDuration(0), mbFixedDuration(false)
 {
     connect(this, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &CFFMpeg::finishCopy);
 }
@@ -37,7 +38,6 @@ CFFMpeg::CFFMpeg(QObject *parent)
 int CFFMpeg::start(const QString& srcFileName, const QString trgFileName, const uint32_t& conversion)
 {
     QStringList params;
-    mLog.clear();
 
     params << "-y" << "-i" << srcFileName;
 
@@ -61,6 +61,56 @@ int CFFMpeg::start(const QString& srcFileName, const QString trgFileName, const
     return start(params);
 }
 
+//--------------------------------------------------------------------------
+//! @brief      decode a time range only (seek in source)
+//!
+//! @param[in]  srcFileName  The source file name
+//! @param[in]  trgFileName  The target file name
+//! @param[in]  conversion   The conversion settings
+//! @param[in]  startSec     range start in seconds
+//! @param[in]  lengthSec    range length in seconds (<= 0 -> up to the end)
+//!
+//! @return     0 on success
+//--------------------------------------------------------------------------
+int CFFMpeg::startRange(const QString& srcFileName, const QString& trgFileName, const uint32_t& conversion,
+                        double startSec, double lengthSec)
+{
+    QStringList params;
+
+    // input options -> ffmpeg seeks instead of decoding from start
+    params << "-y" << "-ss" << QString::number(startSec, 'f', 6);
+
+    if (lengthSec > 0.0)
+    {
+        params << "-t" << QString::number(lengthSec, 'f', 6);
+    }
+
+    params << "-i" << srcFileName << "-acodec" << "pcm_s16le";
+
+    if (conversion & audio::CONV_SAMPLERATE)
+    {
+        params << "-ar" << "44100";
+    }
+
+    if (conversion & audio::CONV_CHANNELS)
+    {
+        params << "-ac" << "2";
+    }
+
+    params << "-f" << "wav" << "-map_metadata" << "-1" << trgFileName;
+
+    int ret = start(params);
+
+    // progress is relative to range
+    if (lengthSec > 0.0)
+    {
+        mDuration       = qMax(1, qRound(lengthSec));
+        mbFixedDuration = true;
+    }
+
+    return ret;
+}
+
 //--------------------------------------------------------------------------
 //! @brief      start encoder with params
 //!
@@ -71,6 +121,9 @@ int CFFMpeg::start(const QString& srcFileName, const QString trgFileName, const
 //--------------------------------------------------------------------------
 int CFFMpeg::start(const QStringList& params, const QString& nativeArgs)
 {
+    mDuration       = 0;
+    mbFixedDuration = false;
+
 #ifdef Q_OS_MAC
     // app folder
     QString sAppDir = QApplication::applicationDirPath();
@@ -146,60 +199,70 @@ int CFFMpeg::concatFiles(const QStringList& sources, const QString& target)
 
 void CFFMpeg::finishCopy(int exitCode, ExitStatus exitStatus)
 {
-    if ((exitCode == 0) && (exitStatus == ExitStatus::NormalExit))
+    bool ok = (exitCode == 0) && (exitStatus == ExitStatus::NormalExit);
+
+    if (ok)
     {
         qInfo() << "File successfully decoded!";
     }
+    else
+    {
+        qWarning() << "Decoder failed, exit code:" << exitCode;
+    }
+
+    flushOutput();
 
-    mLog += QString::fromUtf8(readAllStandardOutput());
+    QString log = logTail();
 
-    if (!mLog.isEmpty())
+    if (!log.isEmpty())
     {
-        qDebug().noquote() << Qt::endl << static_cast<const char*>(mLog.toUtf8());
+        qDebug().noquote() << Qt::endl << static_cast<const char*>(log.toUtf8());
     }
 
-    emit fileDone();
+    emit fileDone(ok);
 }
 
 //--------------------------------------------------------------------------
-//! @brief      extract percentage from log file
+//! @brief      parse one ffmpeg output line (duration and position)
+//!
+//! @param[in]  line  The output line
 //--------------------------------------------------------------------------
-void CFFMpeg::extractPercent()
+void CFFMpeg::parseLine(const QString& line)
 {
-    mLog += QString::fromUtf8(readAllStandardOutput());
-    int length = 0, currPos = 0, from = 0;
+    static const QRegularExpression rxDuration("Duration:\\s+([0-9]+):([0-9]+):([0-9]+)");
+    static const QRegularExpression rxPosition("time=([0-9]+):([0-9]+):([0-9]+)");
 
-    QRegExp rxDuration("Duration:\\s+([0-9]+):([0-9]+):([0-9]+)");
-    QRegExp rxPosition("time=([0-9]+):([0-9]+):([0-9]+)");
+    QRegularExpressionMatch match;
 
-    while ((from = mLog.indexOf(rxDuration, from)) > -1)
+    // each input reports its own duration (concat)
+    if ((match = rxDuration.match(line)).hasMatch())
     {
-        from += rxDuration.matchedLength();
-
-        // hours
-        length += rxDuration.cap(1).toInt() * 3600;
-
-        // minutes
-        length += rxDuration.cap(2).toInt() * 60;
-
-        // seconds
-        length += rxDuration.cap(3).toInt();
+        if (!mbFixedDuration)
+        {
+            mDuration += toSeconds(match.capturedRef(1), match.capturedRef(2), match.capturedRef(3));
+        }
     }
-
-    if (mLog.lastIndexOf(rxPosition) > -1)
+    else if ((match = rxPosition.match(line)).hasMatch())
     {
-        // hours
-        currPos += rxPosition.cap(1).toInt() * 3600;
+        int currPos = toSeconds(match.capturedRef(1), match.capturedRef(2), match.capturedRef(3));
 
-        // minutes
-        currPos += rxPosition.cap(2).toInt() * 60;
-
-        // seconds
-        currPos += rxPosition.cap(3).toInt();
+        if ((currPos != 0) && (mDuration != 0))
+        {
+            emit progress((currPos * 100) / mDuration);
+        }
     }
+}
 
-    if ((currPos != 0) && (length != 0))
-    {
-        emit progress((currPos * 100) / length);
-    }
+//--------------------------------------------------------------------------
+//! @brief      convert time captures (h, m, s) into seconds
+//!
+//! @param[in]  h     hours
+//! @param[in]  m     minutes
+//! @param[in]  s     seconds
+//!
+//! @return     seconds
+//--------------------------------------------------------------------------
+int CFFMpeg::toSeconds(const QStringRef& h, const QStringRef& m, const QStringRef& s)
+{
+    return h.toInt() * 3600 + m.toInt() * 60 + s.toInt();
 }
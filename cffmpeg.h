@@ -54,6 +54,20 @@ public:
     //--------------------------------------------------------------------------
     int start(const QString& srcFileName, const QString trgFileName, const uint32_t& conversion);
 
+    //--------------------------------------------------------------------------
+    //! @brief      decode a time range only (seek in source)
+    //!
+    //! @param[in]  srcFileName  The source file name
+    //! @param[in]  trgFileName  The target file name
+    //! @param[in]  conversion   The conversion settings
+    //! @param[in]  startSec     range start in seconds
+    //! @param[in]  lengthSec    range length in seconds (<= 0 -> up to the end)
+    //!
+    //! @return     0 on success
+    //--------------------------------------------------------------------------
+    int startRange(const QString& srcFileName, const QString& trgFileName, const uint32_t& conversion,
+                   double startSec, double lengthSec);
+
     //--------------------------------------------------------------------------
     //! @brief      start encoder with params
     //!
@@ -83,16 +97,36 @@ private slots:
     //--------------------------------------------------------------------------
     void finishCopy(int exitCode, ExitStatus exitStatus);
 
+signals:
     //--------------------------------------------------------------------------
-    //! @brief      extract percentage from log file
+    //! @brief      signals that current file was handled
+    //!
+    //! @param[in]  ok    true if decoded successfully
     //--------------------------------------------------------------------------
-    void extractPercent() override;
+    void fileDone(bool ok);
 
-signals:
+protected:
     //--------------------------------------------------------------------------
-    //! @brief      signals that current file was handled
+    //! @brief      parse one ffmpeg output line (duration and position)
+    //!
+    //! @param[in]  line  The output line
+    //--------------------------------------------------------------------------
+    void parseLine(const QString& line) override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      convert time captures (h, m, s) into seconds
+    //!
+    //! @param[in]  h     hours
+    //! @param[in]  m     minutes
+    //! @param[in]  s     seconds
     //!
-    //! @param[in]  <unnamed>  false
+    //! @return     seconds
     //--------------------------------------------------------------------------
-    void fileDone();
+    static int toSeconds(const QStringRef& h, const QStringRef& m, const QStringRef& s);
+
+    /// summed up duration of all inputs in seconds
+    int mDuration;
+
+    /// duration is given by range (don't use input duration)
+    bool mbFixedDuration;
 };
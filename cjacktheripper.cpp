@@ -31,19 +31,22 @@ CJackTheRipper::CJackTheRipper(QObject *parent)
     : QObject(parent), mpCDIO(nullptr), mpCDAudio(nullptr),
       mpCDParanoia(nullptr), mpRipThread(nullptr),
       mpCddb(nullptr), mBusy(false), mbCDDB(false),
-      mpFFMpeg(nullptr), miFlacTrack(-99)
+      mpFFMpeg(nullptr), mpPool(nullptr), miFlacTrack(-99), mbAbort(false)
 #ifdef Q_OS_MAC
       , mpDrUtil(nullptr)
 #endif
 {
     mpCddb   = new CCDDB(this);
     mpFFMpeg = new CFFMpeg(this);
+    mpPool   = new CDecoderPool(this);
 #ifdef Q_OS_MAC
     mpDrUtil = new CDRUtil(this);
     connect(mpDrUtil, &CDRUtil::fileDone, this, &CJackTheRipper::macCDText);
 #endif
     connect(mpFFMpeg, &CFFMpeg::fileDone, this, &CJackTheRipper::extractDone);
     connect(mpFFMpeg, &CFFMpeg::progress, this, &CJackTheRipper::getProgress);
+    connect(mpPool, &CDecoderPool::jobDone, this, &CJackTheRipper::poolDone);
+    connect(mpPool, &CDecoderPool::progress, this, &CJackTheRipper::poolProgress);
 }
 
 ///
@@ -62,14 +65,14 @@ CJackTheRipper::~CJackTheRipper()
 //!
 //! @return     0 -> ok
 //--------------------------------------------------------------------------
-int CJackTheRipper::init(bool cddb)
+int CJackTheRipper::init(bool cddb, const QString& device)
 {
     mbCDDB   = cddb;
     mAudioTracks.clear();
 
     cleanup();
 
-    CCDInitThread *pInit = new CCDInitThread(this, &mpCDIO, &mpCDAudio, &mpCDParanoia);
+    CCDInitThread *pInit = new CCDInitThread(this, &mpCDIO, &mpCDAudio, &mpCDParanoia, device);
 
     if (pInit)
     {
@@ -132,9 +135,33 @@ int CJackTheRipper::extractTrack(int trackNo, const QString &fName, const SParan
     }
     else
     {
+        CDecoderPool::SJob job;
         miFlacTrack = trackNo;
         mFlacFName  = fName;
-        extractWave();
+        mBusy       = true;
+
+        if (decoderJob(trackNo, fName, job))
+        {
+            if (mpPool->done(fName))
+            {
+                // decoded in background already
+                bool ok = mpPool->succeeded(fName);
+                QTimer::singleShot(0, this, [this, fName, ok]() { poolDone(fName, ok); });
+            }
+            else if (mpPool->contains(fName))
+            {
+                // wait for it
+                mpPool->promote(fName);
+            }
+            else
+            {
+                mpPool->enqueue(job, true);
+            }
+        }
+        else
+        {
+            extractWave();
+        }
         return 0;
     }
     return -1;
@@ -279,10 +306,21 @@ int CJackTheRipper::ripThread(int track, const QString &fName, const SParanoia*
 
             while (read < trkSz)
             {
+                if (mbAbort)
+                {
+                    f.close();
+                    f.remove();
+                    throw std::runtime_error("Rip canceled!");
+                }
+
                 if((pRAWFrame = cdio_paranoia_read(mpCDParanoia, nullptr)) != nullptr)
                 {
                     read += CDIO_CD_FRAMESIZE_RAW;
-                    f.write(reinterpret_cast<char*>(pRAWFrame), CDIO_CD_FRAMESIZE_RAW);
+
+                    if (f.write(reinterpret_cast<char*>(pRAWFrame), CDIO_CD_FRAMESIZE_RAW) != CDIO_CD_FRAMESIZE_RAW)
+                    {
+                        throw std::runtime_error("Can't write wave file!");
+                    }
 
                     curPercent = (read * 100) / trkSz;
 
@@ -296,32 +334,84 @@ int CJackTheRipper::ripThread(int track, const QString &fName, const SParanoia*
 
             f.close();
         }
-
+        else
+        {
+            throw std::runtime_error("Can't open wave file!");
+        }
     }
     catch (const std::exception& e)
     {
         qWarning() << e.what();
         ret = -1;
     }
+
+    if (ret != 0)
+    {
+        // partial wave file is useless
+        QFile::remove(fName);
+    }
     noBusy();
-    emit finished();
+
+    if (!mbAbort)
+    {
+        emit finished(ret == 0);
+    }
     return ret;
 }
 
 //--------------------------------------------------------------------------
 //! @brief      copy shop thread ended
+//!
+//! @param[in]  ok    true if wave file was written
 //--------------------------------------------------------------------------
-void CJackTheRipper::copyDone()
+void CJackTheRipper::copyDone(bool ok)
 {
     noBusy();
-    emit finished();
+    emit finished(ok);
 }
 
 //--------------------------------------------------------------------------
 //! @brief      flac extract done
+//!
+//! @param[in]  ok    true if decoded successfully
 //--------------------------------------------------------------------------
-void CJackTheRipper::extractDone()
+void CJackTheRipper::extractDone(bool ok)
 {
+    if (mbAbort)
+    {
+        // decoder was killed -> drop incomplete wave file
+        if ((miFlacTrack > 0) && (miFlacTrack < mAudioTracks.size()))
+        {
+            c2n::STrackInfo& ci = mAudioTracks[miFlacTrack];
+            if (ci.mWaveFileName != ci.mFileName)
+            {
+                QFile::remove(ci.mWaveFileName);
+                ci.mWaveFileName.clear();
+            }
+        }
+        else if (miFlacTrack == -1)
+        {
+            mAudioTracks[0].mConversion = 0;
+        }
+        return;
+    }
+
+    if (!ok)
+    {
+        // nothing to cut from
+        if ((miFlacTrack > 0) && (miFlacTrack < mAudioTracks.size()))
+        {
+            c2n::STrackInfo& ci = mAudioTracks[miFlacTrack];
+            QFile::remove(ci.mWaveFileName);
+            ci.mWaveFileName.clear();
+        }
+        else if (miFlacTrack == -1)
+        {
+            mAudioTracks[0].mConversion = 0;
+        }
+        copyDone(false);
+        return;
+    }
     extractWave();
 }
 
@@ -367,7 +457,7 @@ void CJackTheRipper::extractWave()
             mAudioTracks[0].mConversion = 0;
             noBusy();
             getProgress(100);
-            emit finished();
+            emit finished(true);
 
             // over and out
             return;
@@ -433,6 +523,7 @@ void CJackTheRipper::startCopyShop()
     CCopyShopThread* pCopyShop = new CCopyShopThread(this, mAudioTracks, miFlacTrack, mFlacFName);
     if (pCopyShop != nullptr)
     {
+        mpCopyShop = pCopyShop;
         connect(pCopyShop, &CCopyShopThread::finished, pCopyShop, &QObject::deleteLater);
         connect(pCopyShop, &CCopyShopThread::finished, this, &CJackTheRipper::copyDone);
         connect(pCopyShop, &CCopyShopThread::progress, this, &CJackTheRipper::getProgress);
@@ -661,6 +752,166 @@ void CJackTheRipper::setDeviceInfo(const QString &info)
     mDevInfo = info;
 }
 
+//--------------------------------------------------------------------------
+//! @brief      cancel running extraction (blocks until stopped);
+//!             no finished signal will be sent for the canceled job;
+//!             background decodes are dropped unless kept
+//!
+//! @param[in]  keep  target file names of background decodes to keep
+//--------------------------------------------------------------------------
+void CJackTheRipper::cancel(const QStringList& keep)
+{
+    // drop background decodes in any case
+    mpPool->cancel(keep);
+
+    if (!mBusy)
+    {
+        return;
+    }
+
+    qInfo() << "Cancel running extraction.";
+    mbAbort = true;
+
+    if (mpRipThread != nullptr)
+    {
+        mpRipThread->join();
+        delete mpRipThread;
+        mpRipThread = nullptr;
+    }
+
+    if (mpFFMpeg->busy())
+    {
+        mpFFMpeg->kill();
+        mpFFMpeg->waitForFinished();
+    }
+
+    if (!mpCopyShop.isNull())
+    {
+        disconnect(mpCopyShop, &CCopyShopThread::finished, this, &CJackTheRipper::copyDone);
+        mpCopyShop->wait();
+    }
+
+    mbAbort = false;
+    noBusy();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      run decoder with lowered priority
+//!
+//! @param[in]  low   true -> low priority
+//--------------------------------------------------------------------------
+void CJackTheRipper::setLowPriority(bool low)
+{
+    mpFFMpeg->setLowPriority(low);
+    mpPool->setLowPriority(low);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of parallel decoders (file / cue sources)
+//!
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CJackTheRipper::setDecoderCount(int count)
+{
+    mpPool->setSize(count);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      decode upcoming tracks in background (file / cue sources
+//!             which need conversion); extractTrack() for such a track
+//!             only waits for the result
+//!
+//! @param[in]  jobs  track number and target file name (queue order)
+//--------------------------------------------------------------------------
+void CJackTheRipper::prefetch(const QVector<QPair<int, QString>>& jobs)
+{
+    CDecoderPool::SJob job;
+
+    for (const auto& j : jobs)
+    {
+        if (decoderJob(j.first, j.second, job))
+        {
+            mpPool->enqueue(job);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is track decoded (or being decoded) in background
+//!
+//! @param[in]  fName  target file name
+//!
+//! @return     true if so (failed decodes don't count)
+//--------------------------------------------------------------------------
+bool CJackTheRipper::prefetched(const QString& fName) const
+{
+    return mpPool->contains(fName) && (!mpPool->done(fName) || mpPool->succeeded(fName));
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create decoder job for a track
+//!
+//! @param[in]  track   The track index
+//! @param[in]  target  The target file name
+//! @param[out] job     The job
+//!
+//! @return     true if track needs the decoder
+//--------------------------------------------------------------------------
+bool CJackTheRipper::decoderJob(int track, const QString& target, CDecoderPool::SJob& job) const
+{
+    if ((mAudioTracks.listType() == c2n::AudioTracks::CD) || (track < 1) || (track >= mAudioTracks.size()))
+    {
+        return false;
+    }
+
+    const c2n::STrackInfo& ci = mAudioTracks.at(track);
+
+    if (!ci.mConversion)
+    {
+        // wave source -> cut by copy shop
+        return false;
+    }
+
+    // last track of a file is decoded up to its end
+    bool last = ((track + 1) >= mAudioTracks.size()) || (mAudioTracks.at(track + 1).mFileName != ci.mFileName);
+
+    job.mSource     = ci.mFileName;
+    job.mTarget     = target;
+    job.mConversion = ci.mConversion;
+    job.mStartSec   = static_cast<double>(ci.mStartLba) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC);
+    job.mLengthSec  = last ? 0.0 : static_cast<double>(ci.mLbCount) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC);
+    job.mRange      = (mAudioTracks.listType() == c2n::AudioTracks::CUE_SHEET);
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      decoder pool finished a job
+//!
+//! @param[in]  target  The target file name
+//! @param[in]  ok      true if decoded successfully
+//--------------------------------------------------------------------------
+void CJackTheRipper::poolDone(QString target, bool ok)
+{
+    if (mBusy && (target == mFlacFName))
+    {
+        copyDone(ok);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      decoder pool progress
+//!
+//! @param[in]  target   The target file name
+//! @param[in]  percent  The percent
+//--------------------------------------------------------------------------
+void CJackTheRipper::poolProgress(QString target, int percent)
+{
+    if (mBusy && (target == mFlacFName))
+    {
+        emit progress(percent);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 
 //--------------------------------------------------------------------------
@@ -670,22 +921,28 @@ void CJackTheRipper::setDeviceInfo(const QString &info)
 //! @param      ppCDIO        The pp cdio
 //! @param      ppCDAudio     The pp cd audio
 //! @param      ppCDParanoia  The pp cd paranoia
+//! @param[in]  device        CD device (first audio drive if empty)
 //--------------------------------------------------------------------------
 CCDInitThread::CCDInitThread(QObject* parent, CdIo_t** ppCDIO, cdrom_drive_t** ppCDAudio,
-                             cdrom_paranoia_t** ppCDParanoia)
-    :QThread(parent), mppCDIO(ppCDIO), mppCDAudio(ppCDAudio), mppCDParanoia(ppCDParanoia)
+                             cdrom_paranoia_t** ppCDParanoia, const QString& device)
+    :QThread(parent), mppCDIO(ppCDIO), mppCDAudio(ppCDAudio), mppCDParanoia(ppCDParanoia),
+      mDevice(device)
 {
 }
 
 void CCDInitThread::run()
 {
     char **ppsz_cd_drives = nullptr;
-    QString devName;
-    ppsz_cd_drives = cdio_get_devices_with_cap(nullptr, CDIO_FS_AUDIO, false);
-    if (ppsz_cd_drives && *ppsz_cd_drives)
+    QString devName = mDevice;
+
+    if (devName.isEmpty())
     {
-        devName = *ppsz_cd_drives;
-        cdio_free_device_list(ppsz_cd_drives);
+        ppsz_cd_drives = cdio_get_devices_with_cap(nullptr, CDIO_FS_AUDIO, false);
+        if (ppsz_cd_drives && *ppsz_cd_drives)
+        {
+            devName = *ppsz_cd_drives;
+            cdio_free_device_list(ppsz_cd_drives);
+        }
     }
 
     if (!devName.isEmpty())
@@ -745,6 +1002,8 @@ void CCopyShopThread::updPercent()
 //--------------------------------------------------------------------------
 void CCopyShopThread::run()
 {
+    bool ok = false;
+
     if (mTrack == -1)
     {
         // DAO
@@ -757,7 +1016,7 @@ void CCopyShopThread::run()
                 {
                     QFile::remove(mName);
                 }
-                QFile::copy(t.mWaveFileName, mName);
+                ok = QFile::copy(t.mWaveFileName, mName);
                 break;
             }
         }
@@ -770,6 +1029,10 @@ void CCopyShopThread::run()
         {
             qInfo() << "Can't extract wave data.";
         }
+        else
+        {
+            ok = true;
+        }
     }
     else
     {
@@ -777,5 +1040,5 @@ void CCopyShopThread::run()
     }
 
     emit progress(100);
-    emit finished();
+    emit finished(ok);
 }
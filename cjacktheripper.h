@@ -21,7 +21,9 @@
 #include <QString>
 #include <QFile>
 #include <QThread>
+#include <QPointer>
 #include <thread>
+#include <atomic>
 #include <cdio/cdio.h>
 #include <cdio/logging.h>
 #include <cdio/cd_types.h>
@@ -31,6 +33,7 @@
     #include "cdrutil.h"
 #endif // Q_OS_MAC
 #include "cffmpeg.h"
+#include "cdecoderpool.h"
 #include "ccddb.h"
 #include "audio.h"
 #include "settingsdlg.h"
@@ -61,11 +64,12 @@ public:
     //--------------------------------------------------------------------------
     //! @brief      Initializes from CD image / CD drive
     //!
-    //! @param[in]  cddb if true, do cddb request
+    //! @param[in]  cddb    if true, do cddb request
+    //! @param[in]  device  optional CD device (first audio drive if empty)
     //!
     //! @return     0 -> ok
     //--------------------------------------------------------------------------
-    int init(bool cddb);
+    int init(bool cddb, const QString& device = QString());
     
     //--------------------------------------------------------------------------
     //! @brief      cleanup time
@@ -147,6 +151,47 @@ public:
     //--------------------------------------------------------------------------
     void setDeviceInfo(const QString& info);
 
+    //--------------------------------------------------------------------------
+    //! @brief      cancel running extraction (blocks until stopped);
+    //!             no finished signal will be sent for the canceled job;
+    //!             background decodes are dropped unless kept
+    //!
+    //! @param[in]  keep  target file names of background decodes to keep
+    //--------------------------------------------------------------------------
+    void cancel(const QStringList& keep = QStringList());
+
+    //--------------------------------------------------------------------------
+    //! @brief      run decoder with lowered priority
+    //!
+    //! @param[in]  low   true -> low priority
+    //--------------------------------------------------------------------------
+    void setLowPriority(bool low);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of parallel decoders (file / cue sources)
+    //!
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setDecoderCount(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      decode upcoming tracks in background (file / cue sources
+    //!             which need conversion); extractTrack() for such a track
+    //!             only waits for the result
+    //!
+    //! @param[in]  jobs  track number and target file name (queue order)
+    //--------------------------------------------------------------------------
+    void prefetch(const QVector<QPair<int, QString>>& jobs);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is track decoded (or being decoded) in background
+    //!
+    //! @param[in]  fName  target file name
+    //!
+    //! @return     true if so (failed decodes don't count)
+    //--------------------------------------------------------------------------
+    bool prefetched(const QString& fName) const;
+
 public slots:
     
     //--------------------------------------------------------------------------
@@ -170,13 +215,33 @@ public slots:
 
     //--------------------------------------------------------------------------
     //! @brief      copy shop thread ended
+    //!
+    //! @param[in]  ok    true if wave file was written
     //--------------------------------------------------------------------------
-    void copyDone();
+    void copyDone(bool ok);
 
     //--------------------------------------------------------------------------
     //! @brief      flac extract done
+    //!
+    //! @param[in]  ok    true if decoded successfully
+    //--------------------------------------------------------------------------
+    void extractDone(bool ok);
+
+    //--------------------------------------------------------------------------
+    //! @brief      decoder pool finished a job
+    //!
+    //! @param[in]  target  The target file name
+    //! @param[in]  ok      true if decoded successfully
+    //--------------------------------------------------------------------------
+    void poolDone(QString target, bool ok);
+
+    //--------------------------------------------------------------------------
+    //! @brief      decoder pool progress
+    //!
+    //! @param[in]  target   The target file name
+    //! @param[in]  percent  The percent
     //--------------------------------------------------------------------------
-    void extractDone();
+    void poolProgress(QString target, int percent);
 
 #ifdef Q_OS_MAC
 private slots:
@@ -199,6 +264,17 @@ protected:
     //--------------------------------------------------------------------------
     void startCopyShop();
 
+    //--------------------------------------------------------------------------
+    //! @brief      create decoder job for a track
+    //!
+    //! @param[in]  track   The track index
+    //! @param[in]  target  The target file name
+    //! @param[out] job     The job
+    //!
+    //! @return     true if track needs the decoder
+    //--------------------------------------------------------------------------
+    bool decoderJob(int track, const QString& target, CDecoderPool::SJob& job) const;
+
     //--------------------------------------------------------------------------
     //! @brief      create cddbp query and start request
     //--------------------------------------------------------------------------
@@ -230,9 +306,11 @@ signals:
     void match(c2n::AudioTracks tracks);
     
     //--------------------------------------------------------------------------
-    //! @brief      thread finished
+    //! @brief      rip / extraction finished
+    //!
+    //! @param[in]  ok    true if the wave file is complete
     //--------------------------------------------------------------------------
-    void finished();
+    void finished(bool ok);
 
     //--------------------------------------------------------------------------
     //! @brief      tell main window to parse cue file
@@ -250,10 +328,13 @@ private:
     QString mImgFile;
     driver_id_t mDrvId = DRIVER_UNKNOWN;
     CFFMpeg* mpFFMpeg;
+    CDecoderPool* mpPool;           ///< parallel decoders for TAO tracks
     int miFlacTrack;
     QString mFlacFName;
     c2n::AudioTracks mAudioTracks;
     QString mDevInfo;
+    std::atomic<bool> mbAbort;      ///< cancel running extraction
+    QPointer<CCopyShopThread> mpCopyShop; ///< running copy shop thread
 #ifdef Q_OS_MAC
     CDRUtil* mpDrUtil;
 #endif
@@ -274,11 +355,13 @@ public:
     //! @param      ppCDIO        The pp cdio
     //! @param      ppCDAudio     The pp cd audio
     //! @param      ppCDParanoia  The pp cd paranoia
+    //! @param[in]  device        CD device (first audio drive if empty)
     //--------------------------------------------------------------------------
     CCDInitThread(QObject* parent,
                   CdIo_t** ppCDIO,
                   cdrom_drive_t** ppCDAudio,
-                  cdrom_paranoia_t** ppCDParanoia);
+                  cdrom_paranoia_t** ppCDParanoia,
+                  const QString& device = QString());
     
     //--------------------------------------------------------------------------
     //! @brief      thread function
@@ -289,6 +372,7 @@ protected:
     CdIo_t** mppCDIO;
     cdrom_drive_t** mppCDAudio;
     cdrom_paranoia_t** mppCDParanoia;
+    QString mDevice;
 
 signals:
     //--------------------------------------------------------------------------
@@ -329,8 +413,10 @@ public:
 signals:
     //--------------------------------------------------------------------------
     //! @brief      thread finished
+    //!
+    //! @param[in]  ok    true if wave file was written
     //--------------------------------------------------------------------------
-    void finished();
+    void finished(bool ok);
 
     //--------------------------------------------------------------------------
     //! @brief      progress in percent
@@ -0,0 +1,1312 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cjobqueue.h"
+#include "helpers.h"
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QThread>
+#include <QTimer>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QtDebug>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      pNetMD      The NetMD device
+//! @param      pMirrors    additional recorders (may be nullptr)
+//! @param      pCache      artifact cache
+//! @param      pPlacement  placement policy
+//! @param[in]  store       file the queue is kept in (empty: not persistent)
+//! @param      parent      The parent
+//--------------------------------------------------------------------------
+CJobQueue::CJobQueue(CNetMD* pNetMD, CNetMdMirrors* pMirrors, CArtifactCache* pCache,
+                     CPlacementPolicy* pPlacement, const QString& store, QObject* parent)
+    : QObject(parent), mpNetMD(pNetMD), mpMirrors(pMirrors), mpCache(pCache),
+      mpPlacement(pPlacement), mStore(store), mNextId(1), mLookAhead(DEF_LOOK_AHEAD),
+      mEncBudget(qMax(1, QThread::idealThreadCount() / 2)), mDecoders(1),
+      mbSizeCheck(true), mbRunning(false), mDisc(SDiscSnapshot::noDisc()),
+      mCdWait(-1), mbDiscInfo(false), mTitling(-1)
+{
+    connect(mpNetMD, &CNetMD::discOut, this, &CJobQueue::setDisc);
+    connect(mpNetMD, &CNetMD::cmdDone, this, &CJobQueue::cmdDone);
+    load();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object (stops all lanes)
+//--------------------------------------------------------------------------
+CJobQueue::~CJobQueue()
+{
+    // unfinished jobs resume next time
+    save();
+
+    for (auto& l : mLanes)
+    {
+        if (l.mpPipeline->preparing())
+        {
+            l.mpPipeline->stop();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      default location of the persistent queue
+//!
+//! @return     file name
+//--------------------------------------------------------------------------
+QString CJobQueue::defaultStore()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/jobs.json";
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add job to the end of the queue
+//!
+//! @param[in]  tracks     source tracks (disc at index 0)
+//! @param[in]  queue      work queue
+//! @param[in]  cfg        pipeline settings
+//! @param[in]  group      create group after LP transfer
+//! @param[in]  discTitle  set disc title after SP transfer
+//! @param[in]  target     target MD label (empty: choose by free space)
+//!
+//! @return     job id
+//--------------------------------------------------------------------------
+int CJobQueue::add(const c2n::AudioTracks& tracks, const TransferQueue& queue, const CPipeline::SConfig& cfg,
+                   bool group, bool discTitle, const QString& target)
+{
+    SJob job = {mNextId++, target, State::WAITING, RES_OK, tracks, queue, cfg, group, discTitle, 0};
+
+    for (int i = 0; i < job.mQueue.size(); i++)
+    {
+        c2n::SRipTrack& j = job.mQueue[i];
+        j.mStep = c2n::WorkStep::NONE;
+
+        // the lane adopts its background work by key
+        if (j.mKey.isEmpty())
+        {
+            j.mKey = QString("job%1:%2").arg(job.mId).arg(i);
+        }
+    }
+
+    if (job.mTarget.isEmpty())
+    {
+        job.mTarget = this->target(mdTime(job), cfg.mMode);
+    }
+
+    qInfo() << "Queue job" << job.mId << job.mTracks.at(0).mTitle << "->" << job.mTarget
+            << "mode:" << static_cast<const char*>(cfg.mMode);
+
+    mJobs.append(job);
+    save();
+    emit changed();
+    schedule();
+    return job.mId;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove job which isn't on the recorder
+//!
+//! @param[in]  id    job id
+//!
+//! @return     true if removed
+//--------------------------------------------------------------------------
+bool CJobQueue::remove(int id)
+{
+    int idx = indexOf(id);
+
+    if ((idx == -1) || (mJobs.at(idx).mState == State::TRANSFER) || (mJobs.at(idx).mState == State::TITLING))
+    {
+        return false;
+    }
+
+    if (mCdWait == id)
+    {
+        mCdWait = -1;
+    }
+
+    dropLane(id);
+    mJobs.remove(idx);
+    save();
+    emit changed();
+    schedule();
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove finished and failed jobs
+//--------------------------------------------------------------------------
+void CJobQueue::clearFinished()
+{
+    for (auto it = mJobs.begin(); it != mJobs.end();)
+    {
+        if ((it->mState == State::DONE) || (it->mState == State::FAILED))
+        {
+            it = mJobs.erase(it);
+        }
+        else
+        {
+            it ++;
+        }
+    }
+
+    save();
+    emit changed();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get all jobs (queue order)
+//!
+//! @return     jobs
+//--------------------------------------------------------------------------
+const QVector<CJobQueue::SJob>& CJobQueue::jobs() const
+{
+    return mJobs;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of jobs which aren't finished
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CJobQueue::pending() const
+{
+    return mJobs.size() - count(State::DONE) - count(State::FAILED);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of jobs in a state
+//!
+//! @param[in]  state  The state
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CJobQueue::count(State state) const
+{
+    int ret = 0;
+
+    for (const auto& j : mJobs)
+    {
+        if (j.mState == state)
+        {
+            ret ++;
+        }
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of jobs prepared ahead of the head job
+//!
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CJobQueue::setLookAhead(int count)
+{
+    mLookAhead = qMax(0, count);
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of encoders all lanes share
+//!
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CJobQueue::setEncoderBudget(int count)
+{
+    mEncBudget = qMax(1, count);
+    balance();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of parallel decoders per lane (file sources)
+//!
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CJobQueue::setDecoderCount(int count)
+{
+    mDecoders = qMax(1, count);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      check free space before a job is transferred
+//!
+//! @param[in]  check  true -> check
+//--------------------------------------------------------------------------
+void CJobQueue::setSizeCheck(bool check)
+{
+    mbSizeCheck = check;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start / pause processing (running work is finished)
+//!
+//! @param[in]  run   true -> run
+//--------------------------------------------------------------------------
+void CJobQueue::setRunning(bool run)
+{
+    if (run != mbRunning)
+    {
+        qInfo() << "Job queue" << (run ? "started" : "paused");
+        mbRunning = run;
+
+        if (run)
+        {
+            // ask again for what was canceled before
+            if (mCdWait != -1)
+            {
+                cdReady();
+            }
+
+            if (!mMdWait.isEmpty())
+            {
+                mdReady();
+            }
+        }
+
+        emit changed();
+        schedule();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is processing enabled
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CJobQueue::running() const
+{
+    return mbRunning;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is a resource in use by the queue
+//!
+//! @param[in]  res   The resource
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CJobQueue::holds(Resource res) const
+{
+    if (res == Resource::RECORDER)
+    {
+        return (count(State::TRANSFER) > 0) || (count(State::TITLING) > 0) || mbDiscInfo;
+    }
+
+    for (const auto& l : mLanes)
+    {
+        if (l.mbDrive)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      current MD content (from disc info)
+//!
+//! @param[in]  disc  The disc snapshot
+//--------------------------------------------------------------------------
+void CJobQueue::setDisc(const SDiscSnapshot& disc)
+{
+    mDisc = disc;
+
+    if (mDisc.mDevice.isEmpty())
+    {
+        // no idea what will be inserted next
+        mLoadedTarget.clear();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      operator inserted the requested MD
+//--------------------------------------------------------------------------
+void CJobQueue::mdReady()
+{
+    if (!mMdWait.isEmpty() && !mbDiscInfo)
+    {
+        mbDiscInfo = true;
+        mpNetMD->start({CNetMD::NetMDCmd::DISCINFO});
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      operator inserted the requested CD
+//--------------------------------------------------------------------------
+void CJobQueue::cdReady()
+{
+    int id = mCdWait;
+    mCdWait = -1;
+
+    if (mLanes.contains(id))
+    {
+        SLane& l = mLanes[id];
+        l.mbInit = true;
+        l.mpRipper->init(false);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      readable job state
+//!
+//! @param[in]  state  The state
+//!
+//! @return     name
+//--------------------------------------------------------------------------
+QString CJobQueue::stateName(State state)
+{
+    switch (state)
+    {
+    case State::WAITING:
+        return tr("waiting");
+    case State::PREPARING:
+        return tr("preparing");
+    case State::TRANSFER:
+        return tr("transfer");
+    case State::TITLING:
+        return tr("titling");
+    case State::DONE:
+        return tr("done");
+    case State::FAILED:
+        return tr("failed");
+    }
+    return QString();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      hand out resources, start / continue lanes
+//--------------------------------------------------------------------------
+void CJobQueue::schedule()
+{
+    int h = head();
+
+    if (!mbRunning || (h == -1))
+    {
+        return;
+    }
+
+    // recorder first: the head job shouldn't start as background work
+    scheduleRecorder(h);
+
+    // then the jobs behind it, queue order
+    int lanes = 0;
+
+    for (int i = h; (i < mJobs.size()) && (lanes <= mLookAhead); i++)
+    {
+        if ((mJobs.at(i).mState != State::DONE) && (mJobs.at(i).mState != State::FAILED))
+        {
+            scheduleLane(i, i == h);
+            lanes ++;
+        }
+    }
+
+    balance();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      put head job on the recorder (if possible)
+//!
+//! @param[in]  idx   index of head job
+//--------------------------------------------------------------------------
+void CJobQueue::scheduleRecorder(int idx)
+{
+    SJob& job = mJobs[idx];
+    bool  isCD = (job.mTracks.listType() == c2n::AudioTracks::CD);
+
+    if ((job.mState == State::TRANSFER) || (job.mState == State::TITLING)
+        || mbDiscInfo || !mMdWait.isEmpty() || (mTitling != -1) || mDisc.mDevice.isEmpty())
+    {
+        return;
+    }
+
+    // CD jobs need their disc in the drive first
+    if (isCD && (!mLanes.contains(job.mId) || !mLanes.value(job.mId).mbCdOk))
+    {
+        return;
+    }
+
+    if (mLoadedTarget.isEmpty() && writeable() && (job.mCommitted == 0))
+    {
+        // the MD in the recorder is the first target (a resumed job
+        // asks for the MD which has its first tracks)
+        mLoadedTarget = job.mTarget;
+    }
+
+    if ((job.mTarget != mLoadedTarget) || !writeable())
+    {
+        // other jobs keep preparing while the operator swaps the MD
+        qInfo() << "Job" << job.mId << "waits for MD" << job.mTarget;
+        mMdWait = job.mTarget;
+        emit mdRequest(job.mTarget);
+        emit changed();
+        return;
+    }
+
+    if (!job.mCfg.mMode.supports(mDisc.mTocManip, mDisc.mSpUpload, mDisc.mPcm2Mono))
+    {
+        qWarning() << "Job" << job.mId << ": mode" << static_cast<const char*>(job.mCfg.mMode) << "isn't supported by device";
+        finish(job.mId, RES_MODE);
+        return;
+    }
+
+    double secs = mdTime(job, job.mCommitted);
+
+    if (mbSizeCheck && (secs > mDisc.mFreeTime))
+    {
+        if (((mDisc.mTotTime > 0) && (secs > mDisc.mTotTime)) || (job.mCommitted > 0))
+        {
+            // a resumed job can't move to another MD
+            qWarning() << "Job" << job.mId << "doesn't fit on" << ((job.mCommitted > 0) ? "its MD" : "any MD");
+            finish(job.mId, RES_NO_SPACE);
+            return;
+        }
+
+        // move this and all later jobs of the full MD to a new one
+        QString full = job.mTarget;
+        QString next = nextTarget();
+
+        for (int i = idx; i < mJobs.size(); i++)
+        {
+            if ((mJobs.at(i).mTarget == full) && (mJobs.at(i).mState != State::DONE) && (mJobs.at(i).mState != State::FAILED))
+            {
+                mJobs[i].mTarget = next;
+            }
+        }
+
+        qInfo() << "MD" << full << "is full, job" << job.mId << "moves to" << next;
+        save();
+        mMdWait = next;
+        emit mdRequest(next);
+        emit changed();
+        return;
+    }
+
+    job.mCfg.mDevice = mDisc.mDevice;
+
+    if (!mDisc.mOtfEnc)
+    {
+        for (auto& j : job.mQueue)
+        {
+            j.mOtf = false;
+        }
+    }
+
+    SLane& l = lane(job.mId);
+    l.mbStarted = true;
+    l.mFirst    = mDisc.mTrkCount - job.mCommitted + 1;
+    setState(idx, State::TRANSFER);
+
+    qInfo() << "Job" << job.mId << "goes to MD" << job.mTarget;
+
+    if (job.mCommitted > 0)
+    {
+        qInfo() << "Job" << job.mId << "resumes after" << job.mCommitted << "track(s) on the MD";
+    }
+
+    if (job.mCommitted >= job.mQueue.size())
+    {
+        // all tracks are on the MD, titling is left
+        laneDone(job.mId, RES_OK, 0);
+    }
+    else if (!l.mpPipeline->start(job.mTracks, job.mQueue.mid(job.mCommitted), job.mCfg))
+    {
+        finish(job.mId, RES_OK);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start lane work for a job (if resources allow)
+//!
+//! @param[in]  idx   job index
+//! @param[in]  head  true for the head job
+//--------------------------------------------------------------------------
+void CJobQueue::scheduleLane(int idx, bool head)
+{
+    const SJob& job  = mJobs.at(idx);
+    bool        isCD = (job.mTracks.listType() == c2n::AudioTracks::CD);
+    bool        prep = job.mCfg.mMode.isTao();
+
+    if ((job.mState != State::WAITING) && (job.mState != State::PREPARING))
+    {
+        return;
+    }
+
+    if (!mLanes.contains(job.mId))
+    {
+        // DAO isn't prepared in background, one CD job at a time
+        if ((!head && !prep) || (isCD && holds(Resource::DRIVE)))
+        {
+            return;
+        }
+
+        SLane& l = lane(job.mId);
+        setState(idx, State::PREPARING);
+
+        if (isCD)
+        {
+            qInfo() << "Job" << job.mId << "gets the CD drive";
+            l.mbDrive = true;
+            l.mbInit  = true;
+            l.mpRipper->init(false);
+            return;
+        }
+    }
+
+    SLane& l = mLanes[job.mId];
+
+    if (l.mbStarted || (isCD && !l.mbCdOk) || !prep)
+    {
+        return;
+    }
+
+    l.mbStarted = l.mpPipeline->prepare(job.mTracks, job.mQueue.mid(job.mCommitted), job.mCfg);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      split encoder budget among the lanes
+//--------------------------------------------------------------------------
+void CJobQueue::balance()
+{
+    QList<CPipeline*> prep;
+    CPipeline* pRun = nullptr;
+
+    for (const auto& l : mLanes)
+    {
+        if (l.mpPipeline->preparing())
+        {
+            prep.append(l.mpPipeline);
+        }
+        else if (l.mpPipeline->busy())
+        {
+            pRun = l.mpPipeline;
+        }
+    }
+
+    if (pRun != nullptr)
+    {
+        // transfer comes first, background lanes get one encoder each
+        pRun->setConcurrency(CPipeline::Stage::ENCODE, qMax(1, mEncBudget - prep.size()));
+
+        for (auto* p : prep)
+        {
+            p->setConcurrency(CPipeline::Stage::ENCODE, 1);
+        }
+    }
+    else if (!prep.isEmpty())
+    {
+        for (auto* p : prep)
+        {
+            p->setConcurrency(CPipeline::Stage::ENCODE, qMax(1, mEncBudget / prep.size()));
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create lane for a job
+//!
+//! @param[in]  id    job id
+//!
+//! @return     lane
+//--------------------------------------------------------------------------
+CJobQueue::SLane& CJobQueue::lane(int id)
+{
+    if (mLanes.contains(id))
+    {
+        return mLanes[id];
+    }
+
+    SLane l = {new CJackTheRipper(this), nullptr, false, false, false, false, false, 0, 0};
+    l.mpPipeline = new CPipeline(l.mpRipper, mpNetMD, mpMirrors, mpCache, mpPlacement, this);
+    l.mpPipeline->setConcurrency(CPipeline::Stage::RIP, mDecoders);
+
+    connect(l.mpRipper, &CJackTheRipper::match, this, [this, id](c2n::AudioTracks tracks) {
+        cdRead(id, tracks);
+    });
+
+    connect(l.mpPipeline, &CPipeline::stageStarted, this, [this, id](CPipeline::Stage stage, int idx) {
+        laneStage(id, stage, idx, true);
+    });
+
+    connect(l.mpPipeline, &CPipeline::stageDone, this, [this, id](CPipeline::Stage stage, int idx) {
+        laneStage(id, stage, idx, false);
+    });
+
+    connect(l.mpPipeline, &CPipeline::progress, this, [this, id](CPipeline::Stage stage, int percent) {
+        emit progress(id, stage, percent);
+    });
+
+    connect(l.mpPipeline, &CPipeline::trackCommitted, this, [this, id](int) {
+        trackCommitted(id);
+    });
+
+    connect(l.mpPipeline, &CPipeline::finished, this, [this, id](int ret, int tracks) {
+        laneDone(id, ret, tracks);
+    });
+
+    connect(l.mpPipeline, &CPipeline::failed, this, [this, id](int ret) {
+        finish(id, ret);
+    });
+
+    return mLanes.insert(id, l).value();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop lane and delete it
+//!
+//! @param[in]  id    job id
+//--------------------------------------------------------------------------
+void CJobQueue::dropLane(int id)
+{
+    if (!mLanes.contains(id))
+    {
+        return;
+    }
+
+    if (mLanes.value(id).mbInit)
+    {
+        // init thread works on ripper members
+        mLanes[id].mbDrop = true;
+        return;
+    }
+
+    SLane l = mLanes.take(id);
+
+    if (l.mpPipeline->preparing())
+    {
+        l.mpPipeline->stop();
+    }
+
+    disconnect(l.mpPipeline, nullptr, this, nullptr);
+    disconnect(l.mpRipper, nullptr, this, nullptr);
+
+    l.mpPipeline->deleteLater();
+    l.mpRipper->deleteLater();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      CD of a lane was read
+//!
+//! @param[in]  id      job id
+//! @param[in]  tracks  tracks on CD
+//--------------------------------------------------------------------------
+void CJobQueue::cdRead(int id, c2n::AudioTracks tracks)
+{
+    int idx = indexOf(id);
+
+    if (!mLanes.contains(id) || !mLanes.value(id).mbInit)
+    {
+        return;
+    }
+
+    mLanes[id].mbInit = false;
+
+    if (mLanes.value(id).mbDrop || (idx == -1))
+    {
+        dropLane(id);
+        schedule();
+        return;
+    }
+
+    // the TOC tells if it's the right disc
+    const SJob& job = mJobs.at(idx);
+    bool match = true;
+
+    for (int i = 1; match && (i < job.mTracks.size()); i++)
+    {
+        const c2n::STrackInfo& want = job.mTracks.at(i);
+        match = false;
+
+        for (const auto& got : tracks)
+        {
+            if ((got.mTType == c2n::TrackType::AUDIO) && (got.mCDTrackNo == want.mCDTrackNo)
+                && (got.mStartLba == want.mStartLba) && (got.mLbCount == want.mLbCount))
+            {
+                match = true;
+                break;
+            }
+        }
+    }
+
+    if (!match)
+    {
+        qInfo() << "Job" << id << "waits for CD" << job.mTracks.at(0).mTitle;
+        mCdWait = id;
+        emit cdRequest(id, job.mTracks.at(0).mTitle);
+        emit changed();
+        return;
+    }
+
+    mLanes[id].mbCdOk = true;
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      lane stage event
+//!
+//! @param[in]  id       job id
+//! @param[in]  stage    The stage
+//! @param[in]  idx      index in work queue
+//! @param[in]  started  true if started
+//--------------------------------------------------------------------------
+void CJobQueue::laneStage(int id, CPipeline::Stage stage, int idx, bool started)
+{
+    emit stageEvent(id, stage, idx, started);
+
+    if (started || (stage != CPipeline::Stage::RIP) || !mLanes.contains(id))
+    {
+        return;
+    }
+
+    SLane& l = mLanes[id];
+
+    if (l.mbDrive && (l.mpPipeline->done(stage) >= l.mpPipeline->total(stage)))
+    {
+        // all ripped: next CD job may use the drive
+        qInfo() << "Job" << id << "releases the CD drive";
+        l.mbDrive = false;
+        CJackTheRipper* pRipper = l.mpRipper;
+        QTimer::singleShot(0, pRipper, [pRipper]() { pRipper->cleanup(); });
+        QTimer::singleShot(0, this, &CJobQueue::schedule);
+        emit changed();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      lane has transferred its job
+//!
+//! @param[in]  id      job id
+//! @param[in]  ret     result of last device command
+//! @param[in]  tracks  number of transferred tracks
+//--------------------------------------------------------------------------
+void CJobQueue::laneDone(int id, int ret, int tracks)
+{
+    int idx = indexOf(id);
+
+    if ((idx == -1) || !mLanes.contains(id))
+    {
+        return;
+    }
+
+    const SJob& job = mJobs.at(idx);
+    mLanes[id].mTracks = tracks;
+
+    if (job.mCfg.mMode.tocManip())
+    {
+        // MD has to be re-inserted after a TOC edit
+        mLoadedTarget.clear();
+        finish(id, ret);
+        return;
+    }
+
+    CNetMD::SBulkEdit edit;
+    QString title = job.mTracks.at(0).mTitle;
+    bool shared = false;
+    edit.clear();
+
+    for (const auto& j : mJobs)
+    {
+        if ((j.mId != id) && (j.mTarget == job.mTarget) && (j.mState != State::FAILED))
+        {
+            shared = true;
+            break;
+        }
+    }
+
+    if ((job.mCfg.mMode.isLP() && job.mGroup) || (!job.mCfg.mMode.isLP() && job.mDiscTitle && shared))
+    {
+        // several sources on one MD -> one group each (incl. tracks
+        // transferred before a resume)
+        int first = mLanes.value(id).mFirst;
+        deUmlaut(title);
+        edit.mNewGroups.append({title, static_cast<int16_t>(first),
+                                static_cast<int16_t>(first + job.mCommitted - 1)});
+    }
+    else if (!job.mCfg.mMode.isLP() && job.mDiscTitle)
+    {
+        edit.mbDiscTitle = true;
+        edit.mDiscTitle  = title;
+    }
+
+    mTitling = id;
+    setState(idx, State::TITLING);
+
+    if (edit.count() > 0)
+    {
+        // disc info follows on cmdDone()
+        mpNetMD->start(edit, job.mCfg.mDevReset);
+
+        if (mpMirrors != nullptr)
+        {
+            mpMirrors->titleEdit(edit, job.mCfg.mDevReset);
+        }
+    }
+    else
+    {
+        mbDiscInfo = true;
+        mpNetMD->start({CNetMD::NetMDCmd::DISCINFO});
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      lane has put a track on the MD
+//!
+//! @param[in]  id    job id
+//--------------------------------------------------------------------------
+void CJobQueue::trackCommitted(int id)
+{
+    int idx = indexOf(id);
+
+    if (idx != -1)
+    {
+        // tracks reach the MD in queue order
+        mJobs[idx].mCommitted ++;
+        save();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      job is finished
+//!
+//! @param[in]  id    job id
+//! @param[in]  ret   result
+//--------------------------------------------------------------------------
+void CJobQueue::finish(int id, int ret)
+{
+    int idx    = indexOf(id);
+    int tracks = mLanes.contains(id) ? mLanes.value(id).mTracks : 0;
+
+    dropLane(id);
+
+    if (idx != -1)
+    {
+        mJobs[idx].mResult = ret;
+        setState(idx, (ret < 0) ? State::FAILED : State::DONE);
+    }
+
+    qInfo() << "Job" << id << "finished, ret:" << ret << "tracks:" << tracks;
+
+    if (ret < 0)
+    {
+        // operator has to check the MD first
+        mbRunning = false;
+    }
+
+    emit jobDone(id, ret, tracks);
+    emit changed();
+
+    if (pending() == 0)
+    {
+        emit idle();
+    }
+
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      device command done
+//!
+//! @param[in]  cmd   The command
+//! @param[in]  ret   The result
+//--------------------------------------------------------------------------
+void CJobQueue::cmdDone(CNetMD::NetMDCmd cmd, int ret)
+{
+    if ((cmd == CNetMD::NetMDCmd::BULK_EDIT) && (mTitling != -1) && !mbDiscInfo)
+    {
+        if (ret < 0)
+        {
+            // tracks are on the MD anyway
+            qWarning() << "Titling of job" << mTitling << "failed:" << ret;
+        }
+
+        mbDiscInfo = true;
+        mpNetMD->start({CNetMD::NetMDCmd::DISCINFO});
+    }
+    else if ((cmd == CNetMD::NetMDCmd::DISCINFO) && mbDiscInfo)
+    {
+        mbDiscInfo = false;
+
+        if (mTitling != -1)
+        {
+            int id = mTitling;
+            mTitling = -1;
+            finish(id, RES_OK);
+            return;
+        }
+
+        if (!mMdWait.isEmpty())
+        {
+            if ((ret < 0) || mDisc.mDevice.isEmpty() || !writeable())
+            {
+                // still not the right one
+                emit mdRequest(mMdWait);
+                return;
+            }
+
+            mLoadedTarget = mMdWait;
+            mMdWait.clear();
+            emit changed();
+        }
+
+        schedule();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      choose target MD for a new job
+//!
+//! @param[in]  secs  MD time needed
+//! @param[in]  mode  transfer mode
+//!
+//! @return     target label
+//--------------------------------------------------------------------------
+QString CJobQueue::target(double secs, const TransferMode& mode) const
+{
+    QString last;
+    bool    lastToc = false;
+
+    for (auto it = mJobs.crbegin(); it != mJobs.crend(); it++)
+    {
+        if (it->mState != State::FAILED)
+        {
+            last    = it->mTarget;
+            lastToc = it->mCfg.mMode.tocManip();
+            break;
+        }
+    }
+
+    if (last.isEmpty())
+    {
+        return mLoadedTarget.isEmpty() ? nextTarget() : mLoadedTarget;
+    }
+
+    // a TOC edit needs the whole MD
+    if (lastToc || mode.tocManip())
+    {
+        return nextTarget();
+    }
+
+    // done jobs / tracks on the loaded MD are part of its free time already
+    double free = (last == mLoadedTarget) ? mDisc.mFreeTime : mDisc.mTotTime;
+
+    for (const auto& j : mJobs)
+    {
+        if ((j.mTarget == last) && (j.mState != State::FAILED)
+            && ((last != mLoadedTarget) || (j.mState != State::DONE)))
+        {
+            free -= mdTime(j, (last == mLoadedTarget) ? j.mCommitted : 0);
+        }
+    }
+
+    return ((secs <= free) || (mDisc.mTotTime <= 0)) ? last : nextTarget();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      new target label
+//!
+//! @return     label
+//--------------------------------------------------------------------------
+QString CJobQueue::nextTarget() const
+{
+    QRegularExpression rx("^MD (\\d+)$");
+    int no = 0;
+
+    QStringList labels(mLoadedTarget);
+
+    for (const auto& j : mJobs)
+    {
+        labels.append(j.mTarget);
+    }
+
+    for (const auto& l : labels)
+    {
+        QRegularExpressionMatch m = rx.match(l);
+
+        if (m.hasMatch())
+        {
+            no = qMax(no, m.captured(1).toInt());
+        }
+    }
+
+    return QString("MD %1").arg(no + 1);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      MD time a job needs
+//!
+//! @param[in]  job    The job
+//! @param[in]  first  first work queue entry to count
+//!
+//! @return     seconds
+//--------------------------------------------------------------------------
+double CJobQueue::mdTime(const SJob& job, int first)
+{
+    double secs = 0.0;
+
+    for (int i = first; i < job.mQueue.size(); i++)
+    {
+        secs += job.mQueue.at(i).mLength;
+    }
+
+    return secs / job.mCfg.mMode.multi();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is current MD writeable
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CJobQueue::writeable() const
+{
+    return (mDisc.mDiscFlags & eDiscFlags::WRITEABLE) && !(mDisc.mDiscFlags & eDiscFlags::WRITE_LOCK);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      index of first unfinished job
+//!
+//! @return     index or -1
+//--------------------------------------------------------------------------
+int CJobQueue::head() const
+{
+    for (int i = 0; i < mJobs.size(); i++)
+    {
+        if ((mJobs.at(i).mState != State::DONE) && (mJobs.at(i).mState != State::FAILED))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      index of job
+//!
+//! @param[in]  id    job id
+//!
+//! @return     index or -1
+//--------------------------------------------------------------------------
+int CJobQueue::indexOf(int id) const
+{
+    for (int i = 0; i < mJobs.size(); i++)
+    {
+        if (mJobs.at(i).mId == id)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set job state, save queue
+//!
+//! @param[in]  idx    job index
+//! @param[in]  state  The state
+//--------------------------------------------------------------------------
+void CJobQueue::setState(int idx, State state)
+{
+    mJobs[idx].mState = state;
+    save();
+    emit changed();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      load queue from store
+//--------------------------------------------------------------------------
+void CJobQueue::load()
+{
+    QFile f(mStore);
+
+    if (mStore.isEmpty() || !f.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+    f.close();
+
+    mNextId = qMax(1, root["next"].toInt());
+
+    for (const auto& v : root["jobs"].toArray())
+    {
+        QJsonObject o = v.toObject();
+        QJsonObject c = o["config"].toObject();
+        SJob job;
+
+        job.mId        = o["id"].toInt();
+        job.mTarget    = o["target"].toString();
+        job.mState     = static_cast<State>(o["state"].toInt());
+        job.mResult    = o["result"].toInt();
+        job.mGroup     = o["group"].toBool();
+        job.mDiscTitle = o["disc_title"].toBool();
+        job.mCommitted = o["committed"].toInt();
+        job.mCfg       = {TransferMode(c["mode"].toInt()),
+                          {c["read_speed"].toInt(), c["paranoia"].toBool()},
+                          c["at3tool"].toString(),
+                          c["title"].toString(),
+                          static_cast<long>(c["blocks"].toDouble()),
+                          c["device"].toString(),
+                          c["dev_reset"].toBool()};
+
+        job.mTracks.setListType(static_cast<c2n::AudioTracks::List_t>(o["list"].toInt()));
+
+        for (const auto& tv : o["tracks"].toArray())
+        {
+            QJsonObject t = tv.toObject();
+            job.mTracks.append({t["title"].toString(),
+                                t["file"].toString(),
+                                "",
+                                t["cd_track"].toInt(),
+                                static_cast<long>(t["lba"].toDouble()),
+                                static_cast<long>(t["blocks"].toDouble()),
+                                static_cast<uint32_t>(t["conversion"].toDouble()),
+                                static_cast<c2n::TrackType>(t["type"].toInt()),
+                                QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(t["time"].toDouble()))});
+        }
+
+        for (const auto& qv : o["queue"].toArray())
+        {
+            QJsonObject j = qv.toObject();
+
+            // temp. files of the last session are gone
+            job.mQueue.append({static_cast<int16_t>(j["track"].toInt()),
+                               j["title"].toString(),
+                               QDir::tempPath() + tempFileName("/cd2netmd.XXXXXX.tmp"),
+                               j["length"].toDouble(),
+                               c2n::WorkStep::NONE,
+                               j["cd"].toBool(),
+                               static_cast<std::time_t>(j["time"].toDouble()),
+                               j["otf"].toBool(),
+                               j["key"].toString(),
+                               j["pcm_key"].toString(),
+                               QByteArray()});
+        }
+
+        bool onMd = (job.mState == State::TRANSFER) || (job.mState == State::TITLING);
+
+        if (onMd && (job.mCfg.mMode.isDao() || (job.mState == State::TITLING)))
+        {
+            // DAO / TOC edit and titling can't be resumed safely
+            qWarning() << "Job" << job.mId << "was interrupted on the recorder, check MD" << job.mTarget;
+            job.mState  = State::FAILED;
+            job.mResult = RES_INTERRUPTED;
+        }
+        else if ((job.mState != State::DONE) && (job.mState != State::FAILED))
+        {
+            // interrupted work starts over behind the tracks on the MD
+            job.mState     = State::WAITING;
+            job.mCommitted = qBound(0, job.mCommitted, job.mQueue.size());
+        }
+
+        if ((job.mTracks.size() > 1) && !job.mQueue.isEmpty())
+        {
+            mNextId = qMax(mNextId, job.mId + 1);
+            mJobs.append(job);
+        }
+    }
+
+    qInfo() << "Loaded" << mJobs.size() << "job(s)," << pending() << "pending";
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write queue to store
+//--------------------------------------------------------------------------
+void CJobQueue::save() const
+{
+    if (mStore.isEmpty())
+    {
+        return;
+    }
+
+    QJsonArray jobs;
+
+    for (const auto& job : mJobs)
+    {
+        QJsonObject o;
+        QJsonObject c;
+        QJsonArray  tracks;
+        QJsonArray  queue;
+
+        c["mode"]       = static_cast<int>(static_cast<TransferMode::ETransferMode>(job.mCfg.mMode));
+        c["read_speed"] = job.mCfg.mParanoia.mReadSpeed;
+        c["paranoia"]   = job.mCfg.mParanoia.mEnaParanoia;
+        c["at3tool"]    = job.mCfg.mAt3Tool;
+        c["title"]      = job.mCfg.mDiscTitle;
+        c["blocks"]     = static_cast<double>(job.mCfg.mDiscBlocks);
+        c["device"]     = job.mCfg.mDevice;
+        c["dev_reset"]  = job.mCfg.mDevReset;
+
+        for (const auto& t : job.mTracks)
+        {
+            QJsonObject to;
+            to["title"]      = t.mTitle;
+            to["file"]       = t.mFileName;
+            to["cd_track"]   = t.mCDTrackNo;
+            to["lba"]        = static_cast<double>(t.mStartLba);
+            to["blocks"]     = static_cast<double>(t.mLbCount);
+            to["conversion"] = static_cast<double>(t.mConversion);
+            to["type"]       = static_cast<int>(t.mTType);
+            to["time"]       = static_cast<double>(t.mTStamp.toMSecsSinceEpoch());
+            tracks.append(to);
+        }
+
+        for (const auto& j : job.mQueue)
+        {
+            QJsonObject jo;
+            jo["track"]   = j.mCDTrackNo;
+            jo["title"]   = j.mTitle;
+            jo["length"]  = j.mLength;
+            jo["cd"]      = j.mIsCD;
+            jo["time"]    = static_cast<double>(j.mUxTStamp);
+            jo["otf"]     = j.mOtf;
+            jo["key"]     = j.mKey;
+            jo["pcm_key"] = j.mPcmKey;
+            queue.append(jo);
+        }
+
+        o["id"]         = job.mId;
+        o["target"]     = job.mTarget;
+        o["state"]      = static_cast<int>(job.mState);
+        o["result"]     = job.mResult;
+        o["group"]      = job.mGroup;
+        o["disc_title"] = job.mDiscTitle;
+        o["committed"]  = job.mCommitted;
+        o["list"]       = static_cast<int>(job.mTracks.listType());
+        o["config"]     = c;
+        o["tracks"]     = tracks;
+        o["queue"]      = queue;
+        jobs.append(o);
+    }
+
+    QJsonObject root;
+    root["next"] = mNextId;
+    root["jobs"] = jobs;
+
+    QDir().mkpath(QFileInfo(mStore).absolutePath());
+    QFile f(mStore);
+
+    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        f.close();
+    }
+}
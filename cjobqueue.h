@@ -0,0 +1,541 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QVector>
+#include <QMap>
+#include <QString>
+#include "defines.h"
+#include "transfermode.h"
+#include "cjacktheripper.h"
+#include "cnetmd.h"
+#include "cnetmdmirrors.h"
+#include "cartifactcache.h"
+#include "cplacementpolicy.h"
+#include "cpipeline.h"
+#include "cdiscsnapshot.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Persistent queue of transfer jobs (CD, cue sheet or file set
+//!             -> target MD). Every active job runs in its own lane (ripper +
+//!             pipeline), so work overlaps across jobs: the next jobs are
+//!             ripped and encoded in the background while the head job is
+//!             transferred or the operator swaps discs. A job only waits for
+//!             the resource it needs right now: the CD drive (one CD job at a
+//!             time), the encoder budget (shared by all lanes) or the
+//!             recorder (head job only, jobs reach the MDs in queue order).
+//------------------------------------------------------------------------------
+class CJobQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    using TransferQueue = c2n::TransferQueue;
+
+    /// job state
+    enum class State : uint8_t
+    {
+        WAITING,    ///< waiting for a lane (look ahead / CD drive)
+        PREPARING,  ///< rip / encode in background
+        TRANSFER,   ///< on the recorder
+        TITLING,    ///< group / disc title is written
+        DONE,       ///< finished
+        FAILED      ///< failed (see result)
+    };
+
+    /// shared resources
+    enum class Resource : uint8_t
+    {
+        DRIVE,      ///< CD drive
+        RECORDER    ///< NetMD device
+    };
+
+    /// job results besides device errors
+    enum Result : int
+    {
+        RES_OK       =     0,   ///< fine
+        RES_NO_SPACE    = -1000,   ///< doesn't fit on an empty MD
+        RES_MODE        = -1001,   ///< transfer mode not supported by device
+        RES_INTERRUPTED = -1002    ///< interrupted, can't be resumed (check MD)
+    };
+
+    /// one job
+    struct SJob
+    {
+        int                mId;         ///< unique id
+        QString            mTarget;     ///< target MD label
+        State              mState;      ///< state
+        int                mResult;     ///< result of last device command
+        c2n::AudioTracks   mTracks;     ///< source tracks (disc at index 0)
+        TransferQueue      mQueue;      ///< work queue
+        CPipeline::SConfig mCfg;        ///< pipeline settings
+        bool               mGroup;      ///< create group after LP transfer
+        bool               mDiscTitle;  ///< set disc title after SP transfer
+        int                mCommitted;  ///< tracks on the MD (resume point)
+    };
+
+    /// default number of jobs prepared ahead of the head job
+    static constexpr int DEF_LOOK_AHEAD = 2;
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      pNetMD      The NetMD device
+    //! @param      pMirrors    additional recorders (may be nullptr)
+    //! @param      pCache      artifact cache
+    //! @param      pPlacement  placement policy
+    //! @param[in]  store       file the queue is kept in (empty: not persistent)
+    //! @param      parent      The parent
+    //--------------------------------------------------------------------------
+    CJobQueue(CNetMD* pNetMD, CNetMdMirrors* pMirrors, CArtifactCache* pCache,
+              CPlacementPolicy* pPlacement, const QString& store, QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object (stops all lanes)
+    //--------------------------------------------------------------------------
+    ~CJobQueue();
+
+    //--------------------------------------------------------------------------
+    //! @brief      default location of the persistent queue
+    //!
+    //! @return     file name
+    //--------------------------------------------------------------------------
+    static QString defaultStore();
+
+    //--------------------------------------------------------------------------
+    //! @brief      add job to the end of the queue
+    //!
+    //! @param[in]  tracks     source tracks (disc at index 0)
+    //! @param[in]  queue      work queue
+    //! @param[in]  cfg        pipeline settings
+    //! @param[in]  group      create group after LP transfer
+    //! @param[in]  discTitle  set disc title after SP transfer
+    //! @param[in]  target     target MD label (empty: choose by free space)
+    //!
+    //! @return     job id
+    //--------------------------------------------------------------------------
+    int add(const c2n::AudioTracks& tracks, const TransferQueue& queue, const CPipeline::SConfig& cfg,
+            bool group, bool discTitle, const QString& target = QString());
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove job which isn't on the recorder
+    //!
+    //! @param[in]  id    job id
+    //!
+    //! @return     true if removed
+    //--------------------------------------------------------------------------
+    bool remove(int id);
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove finished and failed jobs
+    //--------------------------------------------------------------------------
+    void clearFinished();
+
+    //--------------------------------------------------------------------------
+    //! @brief      get all jobs (queue order)
+    //!
+    //! @return     jobs
+    //--------------------------------------------------------------------------
+    const QVector<SJob>& jobs() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of jobs which aren't finished
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int pending() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of jobs in a state
+    //!
+    //! @param[in]  state  The state
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int count(State state) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of jobs prepared ahead of the head job
+    //!
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setLookAhead(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of encoders all lanes share
+    //!
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setEncoderBudget(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of parallel decoders per lane (file sources)
+    //!
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setDecoderCount(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      check free space before a job is transferred
+    //!
+    //! @param[in]  check  true -> check
+    //--------------------------------------------------------------------------
+    void setSizeCheck(bool check);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start / pause processing (running work is finished)
+    //!
+    //! @param[in]  run   true -> run
+    //--------------------------------------------------------------------------
+    void setRunning(bool run);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is processing enabled
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool running() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      is a resource in use by the queue
+    //!
+    //! @param[in]  res   The resource
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool holds(Resource res) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      current MD content (from disc info)
+    //!
+    //! @param[in]  disc  The disc snapshot
+    //--------------------------------------------------------------------------
+    void setDisc(const SDiscSnapshot& disc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      operator inserted the requested MD
+    //--------------------------------------------------------------------------
+    void mdReady();
+
+    //--------------------------------------------------------------------------
+    //! @brief      operator inserted the requested CD
+    //--------------------------------------------------------------------------
+    void cdReady();
+
+    //--------------------------------------------------------------------------
+    //! @brief      readable job state
+    //!
+    //! @param[in]  state  The state
+    //!
+    //! @return     name
+    //--------------------------------------------------------------------------
+    static QString stateName(State state);
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      jobs or their states changed
+    //--------------------------------------------------------------------------
+    void changed();
+
+    //--------------------------------------------------------------------------
+    //! @brief      head job needs another MD, call mdReady() when inserted
+    //!
+    //! @param[in]  target  target MD label
+    //--------------------------------------------------------------------------
+    void mdRequest(QString target);
+
+    //--------------------------------------------------------------------------
+    //! @brief      CD job needs its disc in the drive, call cdReady() when
+    //!             inserted
+    //!
+    //! @param[in]  id     job id
+    //! @param[in]  title  disc title
+    //--------------------------------------------------------------------------
+    void cdRequest(int id, QString title);
+
+    //--------------------------------------------------------------------------
+    //! @brief      a lane started / finished a track
+    //!
+    //! @param[in]  id       job id
+    //! @param[in]  stage    The stage
+    //! @param[in]  idx      index in work queue
+    //! @param[in]  started  true if started
+    //--------------------------------------------------------------------------
+    void stageEvent(int id, CPipeline::Stage stage, int idx, bool started);
+
+    //--------------------------------------------------------------------------
+    //! @brief      progress of a lane
+    //!
+    //! @param[in]  id       job id
+    //! @param[in]  stage    The stage
+    //! @param[in]  percent  The percent
+    //--------------------------------------------------------------------------
+    void progress(int id, CPipeline::Stage stage, int percent);
+
+    //--------------------------------------------------------------------------
+    //! @brief      a job has finished (processing is paused on error)
+    //!
+    //! @param[in]  id      job id
+    //! @param[in]  ret     result (< 0 -> error)
+    //! @param[in]  tracks  number of transferred tracks
+    //--------------------------------------------------------------------------
+    void jobDone(int id, int ret, int tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      nothing left to do
+    //--------------------------------------------------------------------------
+    void idle();
+
+protected:
+    /// disc flags (see MainWindow)
+    enum eDiscFlags
+    {
+        WRITEABLE  = (1 << 4),
+        WRITE_LOCK = (1 << 6)
+    };
+
+    /// one active job
+    struct SLane
+    {
+        CJackTheRipper* mpRipper;   ///< ripper / decoder of this job
+        CPipeline*      mpPipeline; ///< pipeline of this job
+        bool            mbDrive;    ///< holds the CD drive
+        bool            mbInit;     ///< CD is read (ripper init running)
+        bool            mbCdOk;     ///< CD in drive matches (CD jobs)
+        bool            mbStarted;  ///< rip / encode was started
+        bool            mbDrop;     ///< drop lane when CD was read
+        int             mTracks;    ///< transferred tracks
+        int             mFirst;     ///< MD track number of first job track
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      hand out resources, start / continue lanes
+    //--------------------------------------------------------------------------
+    void schedule();
+
+    //--------------------------------------------------------------------------
+    //! @brief      put head job on the recorder (if possible)
+    //!
+    //! @param[in]  idx   index of head job
+    //--------------------------------------------------------------------------
+    void scheduleRecorder(int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start lane work for a job (if resources allow)
+    //!
+    //! @param[in]  idx   job index
+    //! @param[in]  head  true for the head job
+    //--------------------------------------------------------------------------
+    void scheduleLane(int idx, bool head);
+
+    //--------------------------------------------------------------------------
+    //! @brief      split encoder budget among the lanes
+    //--------------------------------------------------------------------------
+    void balance();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create lane for a job
+    //!
+    //! @param[in]  id    job id
+    //!
+    //! @return     lane
+    //--------------------------------------------------------------------------
+    SLane& lane(int id);
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop lane and delete it
+    //!
+    //! @param[in]  id    job id
+    //--------------------------------------------------------------------------
+    void dropLane(int id);
+
+    //--------------------------------------------------------------------------
+    //! @brief      CD of a lane was read
+    //!
+    //! @param[in]  id      job id
+    //! @param[in]  tracks  tracks on CD
+    //--------------------------------------------------------------------------
+    void cdRead(int id, c2n::AudioTracks tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      lane stage event
+    //!
+    //! @param[in]  id       job id
+    //! @param[in]  stage    The stage
+    //! @param[in]  idx      index in work queue
+    //! @param[in]  started  true if started
+    //--------------------------------------------------------------------------
+    void laneStage(int id, CPipeline::Stage stage, int idx, bool started);
+
+    //--------------------------------------------------------------------------
+    //! @brief      lane has transferred its job
+    //!
+    //! @param[in]  id      job id
+    //! @param[in]  ret     result of last device command
+    //! @param[in]  tracks  number of transferred tracks
+    //--------------------------------------------------------------------------
+    void laneDone(int id, int ret, int tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      lane has put a track on the MD
+    //!
+    //! @param[in]  id    job id
+    //--------------------------------------------------------------------------
+    void trackCommitted(int id);
+
+    //--------------------------------------------------------------------------
+    //! @brief      job is finished
+    //!
+    //! @param[in]  id    job id
+    //! @param[in]  ret   result
+    //--------------------------------------------------------------------------
+    void finish(int id, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      device command done
+    //!
+    //! @param[in]  cmd   The command
+    //! @param[in]  ret   The result
+    //--------------------------------------------------------------------------
+    void cmdDone(CNetMD::NetMDCmd cmd, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      choose target MD for a new job
+    //!
+    //! @param[in]  secs  MD time needed
+    //! @param[in]  mode  transfer mode
+    //!
+    //! @return     target label
+    //--------------------------------------------------------------------------
+    QString target(double secs, const TransferMode& mode) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      new target label
+    //!
+    //! @return     label
+    //--------------------------------------------------------------------------
+    QString nextTarget() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      MD time a job needs
+    //!
+    //! @param[in]  job    The job
+    //! @param[in]  first  first work queue entry to count
+    //!
+    //! @return     seconds
+    //--------------------------------------------------------------------------
+    static double mdTime(const SJob& job, int first = 0);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is current MD writeable
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool writeable() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      index of first unfinished job
+    //!
+    //! @return     index or -1
+    //--------------------------------------------------------------------------
+    int head() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      index of job
+    //!
+    //! @param[in]  id    job id
+    //!
+    //! @return     index or -1
+    //--------------------------------------------------------------------------
+    int indexOf(int id) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set job state, save queue
+    //!
+    //! @param[in]  idx    job index
+    //! @param[in]  state  The state
+    //--------------------------------------------------------------------------
+    void setState(int idx, State state);
+
+    //--------------------------------------------------------------------------
+    //! @brief      load queue from store
+    //--------------------------------------------------------------------------
+    void load();
+
+    //--------------------------------------------------------------------------
+    //! @brief      write queue to store
+    //--------------------------------------------------------------------------
+    void save() const;
+
+private:
+    /// NetMD device
+    CNetMD* mpNetMD;
+
+    /// additional recorders (may be nullptr)
+    CNetMdMirrors* mpMirrors;
+
+    /// artifact cache
+    CArtifactCache* mpCache;
+
+    /// placement policy
+    CPlacementPolicy* mpPlacement;
+
+    /// queue file
+    QString mStore;
+
+    /// all jobs (queue order)
+    QVector<SJob> mJobs;
+
+    /// active jobs -> lane
+    QMap<int, SLane> mLanes;
+
+    /// next job id
+    int mNextId;
+
+    /// jobs prepared ahead
+    int mLookAhead;
+
+    /// encoders shared by all lanes
+    int mEncBudget;
+
+    /// decoders per lane
+    int mDecoders;
+
+    /// check free space
+    bool mbSizeCheck;
+
+    /// processing enabled
+    bool mbRunning;
+
+    /// current MD
+    SDiscSnapshot mDisc;
+
+    /// label of inserted MD (empty: not known)
+    QString mLoadedTarget;
+
+    /// MD was requested from operator
+    QString mMdWait;
+
+    /// CD was requested from operator (job id, -1: none)
+    int mCdWait;
+
+    /// disc info was requested, recorder waits for it
+    bool mbDiscInfo;
+
+    /// job waiting for its title edit (-1: none)
+    int mTitling;
+};
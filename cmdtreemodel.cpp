@@ -16,18 +16,20 @@
  */
 #include "cmdtreemodel.h"
 #include <QIcon>
+#include <QVector>
 #include <string>
 #include "helpers.h"
 #include "defines.h"
 
-CMDTreeModel::CMDTreeModel(const QString& jsonContent, QObject *parent)
-    :QAbstractItemModel(parent)
+CMDTreeModel::CMDTreeModel(const SDiscSnapshot& disc, QObject *parent)
+    :QAbstractItemModel(parent), mDisc(disc), mReqFirst(-1), mReqLast(-1)
 {
-    mMDJson   = nlohmann::json::parse(jsonContent.toStdString());
-    mRootData = nlohmann::json::parse(R"(["Name", "Mode", "Time"])");
+    mReqTimer.setSingleShot(true);
+    mReqTimer.setInterval(DETAILS_DELAY_MS);
+    connect(&mReqTimer, &QTimer::timeout, this, &CMDTreeModel::sendDetailRequest);
 
     // root item with column names
-    mpTreeRoot = new CTreeItem(ItemRole::ROOT, mRootData);
+    mpTreeRoot = new CTreeItem(ItemRole::ROOT, &mDisc);
     setupModelData();
 }
 
@@ -104,184 +106,380 @@ void CMDTreeModel::increaseTracks(int tracks)
     mDiscConf.mTrkCount += tracks;
 }
 
-nlohmann::json CMDTreeModel::exportJson() const
+const SDiscSnapshot& CMDTreeModel::snapshot() const
 {
-    return mMDJson;
+    return mDisc;
 }
 
 void CMDTreeModel::setupModelData()
 {
     // fill mDiscConf structure
-    if (mMDJson.find("sp_upload") != mMDJson.end())
-    {
-        mDiscConf.mSPUpload = mMDJson["sp_upload"].get<int>();
-    }
-    else
-    {
-        mDiscConf.mSPUpload = 0;
-    }
+    mDiscConf.mSPUpload  = mDisc.mSpUpload ? 1 : 0;
+    mDiscConf.mTocManip  = mDisc.mTocManip ? 1 : 0;
+    mDiscConf.mOTFEnc    = mDisc.mOtfEnc ? 1 : 0;
+    mDiscConf.mPcm2Mono  = mDisc.mPcm2Mono ? 1 : 0;
+    mDiscConf.mTrkCount  = mDisc.mTrkCount;
+    mDiscConf.mTotTime   = mDisc.mTotTime;
+    mDiscConf.mFreeTime  = mDisc.mFreeTime;
+    mDiscConf.mUsedTime  = mDisc.mUsedTime;
+    mDiscConf.mDiscFlags = mDisc.mDiscFlags;
+    mDiscConf.mDevice    = mDisc.mDevice.isEmpty() ? QString("No device fetected!") : mDisc.mDevice;
 
-    if (mMDJson.find("toc_manip") != mMDJson.end())
+    // tracks still to come are shown as placeholders
+    while (mDisc.mTracks.size() < mDiscConf.mTrkCount)
     {
-        mDiscConf.mTocManip = mMDJson["toc_manip"].get<int>();
-    }
-    else
-    {
-        mDiscConf.mTocManip = 0;
+        mDisc.mTracks.append(SDiscSnapshot::emptyTrack(mDisc.mTracks.size()));
     }
 
-    if (mMDJson.find("otf_enc") != mMDJson.end())
-    {
-        mDiscConf.mOTFEnc = mMDJson["otf_enc"].get<int>();
-    }
-    else
-    {
-        mDiscConf.mOTFEnc = 0;
-    }
+    mTrackItems.fill(nullptr, mDisc.mTracks.size());
+    mRequested.fill(false, mTrackItems.size());
+    indexGroups();
 
-    if (mMDJson.find("pcm2mono") != mMDJson.end())
-    {
-        mDiscConf.mPcm2Mono = mMDJson["pcm2mono"].get<int>();
-    }
-    else
+    // create Disc node
+    CTreeItem*  pDisc  = new CTreeItem(ItemRole::DISC, &mDisc, -1, -1, mpTreeRoot);
+    CTreeItem*  pGroup = nullptr;
+    int currGrp = -1;
+    int groupNo = 0;
+
+    for (int i = 0; i < mDisc.mTracks.size(); i++)
     {
-        mDiscConf.mPcm2Mono = 0;
+        CTreeItem*  pTrack;
+        int trackNumber = mDisc.mTracks.at(i).mNo + 1;
+        int trackGroup  = group(trackNumber);
+
+        if (trackGroup == -1)
+        {
+            currGrp = trackGroup;
+
+            if (pGroup != nullptr)
+            {
+                pDisc->appendChild(pGroup);
+                pGroup = nullptr;
+            }
+
+            pTrack = new CTreeItem(ItemRole::TRACK, &mDisc, i, -1, pDisc);
+
+            pDisc->appendChild(pTrack);
+        }
+        else
+        {
+            if (trackGroup != currGrp)
+            {
+                if (pGroup != nullptr)
+                {
+                    pDisc->appendChild(pGroup);
+                }
+
+                currGrp = trackGroup;
+
+                // group number is needed on group rename
+                pGroup = new CTreeItem(ItemRole::GROUP, &mDisc, trackGroup, groupNo++, pDisc);
+            }
+
+            pTrack = new CTreeItem(ItemRole::TRACK, &mDisc, i, -1, pGroup);
+            pGroup->appendChild(pTrack);
+        }
+
+        if ((trackNumber > 0) && (trackNumber <= mTrackItems.size()))
+        {
+            mTrackItems[trackNumber - 1] = pTrack;
+        }
     }
 
-    if (mMDJson.find("trk_count") != mMDJson.end())
+    if (pGroup != nullptr)
     {
-        mDiscConf.mTrkCount = mMDJson["trk_count"].get<int>();
+        pDisc->appendChild(pGroup);
     }
-    else
+
+    mpTreeRoot->appendChild(pDisc);
+}
+
+void CMDTreeModel::rebuild()
+{
+    beginResetModel();
+    delete mpTreeRoot;
+    mpTreeRoot = new CTreeItem(ItemRole::ROOT, &mDisc);
+    setupModelData();
+    endResetModel();
+}
+
+void CMDTreeModel::indexGroups()
+{
+    mGroupIdx.clear();
+
+    for (int i = 0; i < mDisc.mGroups.size(); i++)
     {
-        mDiscConf.mTrkCount = 0;
+        mGroupIdx.insert(mDisc.mGroups.at(i).mFirst, i);
     }
+}
 
-    if (mMDJson.find("t_total") != mMDJson.end())
+void CMDTreeModel::renumberGroups()
+{
+    CTreeItem* pDisc = discItem();
+    int groupNo      = 0;
+
+    for (int r = 0; (pDisc != nullptr) && (r < pDisc->childCount()); r++)
     {
-        mDiscConf.mTotTime = mMDJson["t_total"].get<int>();
+        if (pDisc->child(r)->itemRole() == ItemRole::GROUP)
+        {
+            pDisc->child(r)->setNumber(groupNo++);
+        }
     }
-    else
+}
+
+CTreeItem* CMDTreeModel::discItem() const
+{
+    return mpTreeRoot->child(0);
+}
+
+int CMDTreeModel::group(int track) const
+{
+    // last group starting at or before track
+    QMap<int, int>::const_iterator it = mGroupIdx.upperBound(track);
+
+    if (it != mGroupIdx.constBegin())
     {
-        mDiscConf.mTotTime = 0;
+        --it;
+        int first = mDisc.mGroups.at(it.value()).mFirst;
+        int last  = mDisc.mGroups.at(it.value()).mLast;
+
+        if (last == -1)
+        {
+            last = first;
+        }
+
+        if ((track >= first) && (track <= last))
+        {
+            return it.value();
+        }
     }
 
-    if (mMDJson.find("t_free") != mMDJson.end())
+    return -1;
+}
+
+void CMDTreeModel::updateTracks(const SDiscSnapshot& batch)
+{
+    for (const auto& track : batch.mTracks)
     {
-        mDiscConf.mFreeTime = mMDJson["t_free"].get<int>();
+        int no = track.mNo;
+
+        if ((no < 0) || (no >= mTrackItems.size()) || (mTrackItems.at(no) == nullptr)
+            || !mDisc.mergeTrack(batch, track))
+        {
+            continue;
+        }
+
+        CTreeItem* item = mTrackItems.at(no);
+        emit dataChanged(createIndex(item->row(), 0, item), createIndex(item->row(), 2, item));
     }
-    else
+}
+
+void CMDTreeModel::insertTrack(int number, const QString& title, const QString& mode,
+                               const QString& time, int used)
+{
+    CTreeItem* pDisc = discItem();
+
+    if ((pDisc == nullptr) || (number < 0))
     {
-        mDiscConf.mFreeTime = 0;
+        return;
     }
 
-    if (mMDJson.find("t_used") != mMDJson.end())
+    SDiscSnapshot::STrack trk = SDiscSnapshot::emptyTrack(number);
+    trk.mFields  = SDiscSnapshot::TF_ALL;
+    trk.mName    = mDisc.intern(title);
+    trk.mBitrate = mDisc.intern(mode);
+    trk.mTime    = mDisc.intern(time);
+
+    mDiscConf.mTrkCount++;
+    mDiscConf.mUsedTime += used;
+    mDiscConf.mFreeTime -= used;
+    mDisc.mTrkCount      = mDiscConf.mTrkCount;
+    mDisc.mUsedTime      = mDiscConf.mUsedTime;
+    mDisc.mFreeTime      = mDiscConf.mFreeTime;
+
+    if ((number < mTrackItems.size()) && (mTrackItems.at(number) != nullptr))
     {
-        mDiscConf.mUsedTime = mMDJson["t_used"].get<int>();
+        // placeholder is there already
+        CTreeItem* item = mTrackItems.at(number);
+        mDisc.mTracks[item->index()] = trk;
+        emit dataChanged(createIndex(item->row(), 0, item), createIndex(item->row(), 2, item));
+        return;
     }
-    else
+
+    int row = pDisc->childCount();
+    mDisc.mTracks.append(trk);
+
+    if (number >= mTrackItems.size())
     {
-        mDiscConf.mUsedTime = 0;
+        mTrackItems.resize(number + 1);
+        mRequested.resize(number + 1);
     }
 
-    if (mMDJson.find("disc_flags") != mMDJson.end())
+    beginInsertRows(createIndex(pDisc->row(), 0, pDisc), row, row);
+    mTrackItems[number] = new CTreeItem(ItemRole::TRACK, &mDisc, mDisc.mTracks.size() - 1, -1, pDisc);
+    pDisc->appendChild(mTrackItems.at(number));
+    endInsertRows();
+}
+
+QModelIndex CMDTreeModel::insertGroup(const QString& title, int16_t first, int16_t last)
+{
+    CTreeItem* pDisc = discItem();
+
+    if ((pDisc == nullptr) || (first < 1))
     {
-        mDiscConf.mDiscFlags = std::stoi(mMDJson["disc_flags"].get<std::string>(), nullptr, 16);
+        return QModelIndex();
     }
-    else
+
+    int count = ((last < first) ? first : last) - first + 1;
+    int row   = -1;
+
+    // tracks have to be ungrouped disc children in a row
+    for (int i = 0; i < count; i++)
     {
-        mDiscConf.mDiscFlags = 0;
+        int no = first - 1 + i;
+        CTreeItem* pTrack = (no < mTrackItems.size()) ? mTrackItems.at(no) : nullptr;
+
+        if ((pTrack == nullptr) || (pTrack->parentItem() != pDisc)
+            || ((i > 0) && (pTrack->row() != row + i)))
+        {
+            row = -1;
+            break;
+        }
+
+        if (i == 0)
+        {
+            row = pTrack->row();
+        }
     }
 
-    if (mMDJson.find("device") != mMDJson.end())
+    mDisc.mGroups.append({mDisc.intern(title), first, static_cast<int16_t>((first == last) ? -1 : last)});
+    mGroupIdx.insert(first, mDisc.mGroups.size() - 1);
+
+    if (row == -1)
     {
-        mDiscConf.mDevice = QString::fromStdString(mMDJson["device"].get<std::string>());
+        rebuild();
+        return QModelIndex();
     }
-    else
+
+    QModelIndex discIdx = createIndex(pDisc->row(), 0, pDisc);
+    CTreeItem*  pGroup  = new CTreeItem(ItemRole::GROUP, &mDisc, mDisc.mGroups.size() - 1, -1, pDisc);
+
+    beginInsertRows(discIdx, row, row);
+    pDisc->insertChild(row, pGroup);
+    endInsertRows();
+
+    QModelIndex grpIdx = createIndex(row, 0, pGroup);
+
+    // move tracks into the group
+    beginMoveRows(discIdx, row + 1, row + count, grpIdx, 0);
+    for (int i = 0; i < count; i++)
     {
-        mDiscConf.mDevice = "No device fetected!";
+        CTreeItem* pTrack = pDisc->takeChild(row + 1);
+        pTrack->setParentItem(pGroup);
+        pGroup->appendChild(pTrack);
     }
+    endMoveRows();
 
-    // create Disc node
-    CTreeItem*  pDisc  = new CTreeItem(ItemRole::DISC, mMDJson, mpTreeRoot);
-    CTreeItem*  pGroup = nullptr;
-    nlohmann::json currGrp;
-    int groupNo = 0;
+    renumberGroups();
+    return grpIdx;
+}
 
-    if ((mMDJson.find("tracks") != mMDJson.end())
-        && mMDJson["tracks"].is_array())
+void CMDTreeModel::removeGroup(int number)
+{
+    CTreeItem* pDisc = discItem();
+
+    for (int r = 0; (pDisc != nullptr) && (r < pDisc->childCount()); r++)
     {
-        for (auto& track : mMDJson["tracks"])
+        CTreeItem* pGroup = pDisc->child(r);
+
+        if ((pGroup->itemRole() != ItemRole::GROUP) || (pGroup->trackNumber() != (number + 1)))
         {
-            CTreeItem*  pTrack;
-            int trackNumber            = track["no"].get<int>() + 1;
-            nlohmann::json& trackGroup = group(trackNumber);
+            continue;
+        }
+
+        QModelIndex discIdx = createIndex(pDisc->row(), 0, pDisc);
+        int count           = pGroup->childCount();
+        int grpIdx          = pGroup->index();
 
-            if (trackGroup.empty())
+        // move tracks back to the disc
+        if (count > 0)
+        {
+            beginMoveRows(createIndex(r, 0, pGroup), 0, count - 1, discIdx, r + 1);
+            for (int i = 0; i < count; i++)
             {
-                currGrp = trackGroup;
+                CTreeItem* pTrack = pGroup->takeChild(0);
+                pTrack->setParentItem(pDisc);
+                pDisc->insertChild(r + 1 + i, pTrack);
+            }
+            endMoveRows();
+        }
 
-                if (pGroup != nullptr)
-                {
-                    pDisc->appendChild(pGroup);
-                    pGroup = nullptr;
-                }
+        beginRemoveRows(discIdx, r, r);
+        delete pDisc->takeChild(r);
+        endRemoveRows();
 
-                pTrack = new CTreeItem(ItemRole::TRACK, track, pDisc);
+        mDisc.mGroups.remove(grpIdx);
 
-                pDisc->appendChild(pTrack);
-            }
-            else
+        for (int i = 0; i < pDisc->childCount(); i++)
+        {
+            CTreeItem* pItem = pDisc->child(i);
+            if ((pItem->itemRole() == ItemRole::GROUP) && (pItem->index() > grpIdx))
             {
-                if (trackGroup != currGrp)
-                {
-                    if (pGroup != nullptr)
-                    {
-                        pDisc->appendChild(pGroup);
-                    }
+                pItem->setIndex(pItem->index() - 1);
+            }
+        }
 
-                    // add group number (we might need on group rename)
-                    trackGroup["no"] = groupNo++;
+        indexGroups();
+        renumberGroups();
+        break;
+    }
+}
 
-                    currGrp = trackGroup;
+void CMDTreeModel::setTitle(const QString& title)
+{
+    CTreeItem* pDisc = discItem();
+    mDisc.mTitle     = mDisc.intern(title);
 
-                    pGroup = new CTreeItem(ItemRole::GROUP, trackGroup, pDisc);
-                }
-                if (pGroup != nullptr)
-                {
-                    pTrack = new CTreeItem(ItemRole::TRACK, track, pGroup);
-                    pGroup->appendChild(pTrack);
-                }
-            }
-        }
+    if (pDisc != nullptr)
+    {
+        emit dataChanged(createIndex(pDisc->row(), 0, pDisc), createIndex(pDisc->row(), 0, pDisc));
     }
+}
 
-    if (pGroup != nullptr)
+void CMDTreeModel::requestDetails(int track) const
+{
+    if ((track < 0) || (track >= mRequested.size()) || mRequested.at(track))
     {
-        pDisc->appendChild(pGroup);
+        return;
     }
 
-    mpTreeRoot->appendChild(pDisc);
+    mRequested[track] = true;
+
+    if (mReqFirst < 0)
+    {
+        mReqFirst = mReqLast = track;
+    }
+    else
+    {
+        mReqFirst = qMin(mReqFirst, track);
+        mReqLast  = qMax(mReqLast, track);
+    }
+
+    // rows are painted one by one -> send one request for all of them
+    if (!mReqTimer.isActive())
+    {
+        mReqTimer.start();
+    }
 }
 
-nlohmann::json& CMDTreeModel::group(int track)
+void CMDTreeModel::sendDetailRequest()
 {
-    if ((mMDJson.find("groups") != mMDJson.end())
-        && mMDJson["groups"].is_array())
+    if (mReqFirst >= 0)
     {
-        for (auto& grp : mMDJson["groups"])
-        {
-            int first = grp["first"].get<int>();
-            int last  = grp["last"].get<int>();
-            if (last == -1) last = first;
-            if ((track >= first) && (track <= last))
-            {
-                return grp;
-            }
-        }
+        emit detailsNeeded(mReqFirst, mReqLast);
     }
 
-    return mEmpty;
+    mReqFirst = mReqLast = -1;
 }
 
 QVariant CMDTreeModel::data(const QModelIndex &index, int role) const
@@ -316,9 +514,19 @@ QVariant CMDTreeModel::data(const QModelIndex &index, int role) const
     {
         if ((item->itemRole() == ItemRole::TRACK) && (index.column() == 0))
         {
-            return QString("%1. %2").arg(item->trackNumber(), 2).arg(item->data(index.column()).toString());
+            QVariant name = item->data(index.column());
+            return QString("%1. %2").arg(item->trackNumber(), 2)
+                    .arg(name.isValid() ? name.toString() : tr("loading ..."));
         }
-        return item->data(index.column());
+
+        QVariant val = item->data(index.column());
+
+        if ((item->itemRole() == ItemRole::TRACK) && (index.column() == 2) && !val.isValid())
+        {
+            // row is shown but details not yet read
+            requestDetails(item->trackNumber() - 1);
+        }
+        return val;
     }
 
     return QVariant();
@@ -342,12 +550,16 @@ bool CMDTreeModel::setData(const QModelIndex &index, const QVariant &value, int
         switch(item->itemRole())
         {
         case ItemRole::GROUP:
+            mDisc.mGroups[item->index()].mName = mDisc.intern(name);
+            changed = true;
+            break;
         case ItemRole::TRACK:
-            item->rawData()["name"] = name.toStdString();
+            mDisc.mTracks[item->index()].mName    = mDisc.intern(name);
+            mDisc.mTracks[item->index()].mFields |= SDiscSnapshot::TF_TITLE;
             changed = true;
             break;
         case ItemRole::DISC:
-            item->rawData()["title"] = name.toStdString();
+            mDisc.mTitle = mDisc.intern(name);
             changed = true;
             break;
         default:
@@ -368,8 +580,11 @@ Qt::ItemFlags CMDTreeModel::flags(const QModelIndex &index) const
     if (!index.isValid())
         return Qt::NoItemFlags;
 
-    // name is editable
-    if (index.column() == 0)
+    CTreeItem *item = static_cast<CTreeItem*>(index.internalPointer());
+
+    // name is editable (as soon as it is there)
+    if ((index.column() == 0)
+        && ((item->itemRole() != ItemRole::TRACK) || item->data(0).isValid()))
     {
         return QAbstractItemModel::flags(index) | Qt::ItemIsEditable;
     }
@@ -388,8 +603,8 @@ QVariant CMDTreeModel::headerData(int section, Qt::Orientation orientation,
 
 //////////////////////////////////////////////////////////////////////////
 
-CTreeItem::CTreeItem(CMDTreeModel::ItemRole role, nlohmann::json &data, CTreeItem *parentItem)
-    :mItemData(data), m_parentItem(parentItem), mItRole(role)
+CTreeItem::CTreeItem(CMDTreeModel::ItemRole role, SDiscSnapshot *pDisc, int idx, int no, CTreeItem *parentItem)
+    :mpDisc(pDisc), mIdx(idx), mNo(no), m_parentItem(parentItem), mItRole(role)
 {
 }
 
@@ -403,6 +618,20 @@ void CTreeItem::appendChild(CTreeItem *item)
     m_childItems.append(item);
 }
 
+void CTreeItem::insertChild(int row, CTreeItem *child)
+{
+    m_childItems.insert(row, child);
+}
+
+CTreeItem *CTreeItem::takeChild(int row)
+{
+    if ((row < 0) || (row >= m_childItems.size()))
+    {
+        return nullptr;
+    }
+    return m_childItems.takeAt(row);
+}
+
 CTreeItem *CTreeItem::child(int row)
 {
     if ((row < 0) || (row >= m_childItems.size()))
@@ -437,41 +666,45 @@ QVariant CTreeItem::data(int column) const
 {
     if (mItRole == CMDTreeModel::ItemRole::ROOT)
     {
-        if ((column >= 0) && (column < static_cast<int>(mItemData.size())))
+        switch(column)
         {
-            return QString::fromStdString(mItemData.at(column).get<std::string>());
+        case 0:
+            return QString("Name");
+        case 1:
+            return QString("Mode");
+        case 2:
+            return QString("Time");
         }
     }
     else if (mItRole == CMDTreeModel::ItemRole::DISC)
     {
         if (column == 0)
         {
-            if (mItemData.find("title") != mItemData.end())
-            {
-                return QString::fromStdString(mItemData["title"].get<std::string>());
-            }
+            return mpDisc->str(mpDisc->mTitle);
         }
     }
     else if (mItRole == CMDTreeModel::ItemRole::TRACK)
     {
+        const SDiscSnapshot::STrack& track = mpDisc->mTracks.at(mIdx);
+
         switch(column)
         {
         case 0:
-            if (mItemData.find("name") != mItemData.end())
+            if (track.mFields & SDiscSnapshot::TF_TITLE)
             {
-                return QString::fromStdString(mItemData["name"].get<std::string>());
+                return mpDisc->str(track.mName);
             }
             break;
         case 1:
-            if (mItemData.find("bitrate") != mItemData.end())
+            if (track.mFields & SDiscSnapshot::TF_BITRATE)
             {
-                return QString::fromStdString(mItemData["bitrate"].get<std::string>());
+                return mpDisc->str(track.mBitrate);
             }
             break;
         case 2:
-            if (mItemData.find("time") != mItemData.end())
+            if (track.mFields & SDiscSnapshot::TF_DETAILS)
             {
-                return QString::fromStdString(mItemData["time"].get<std::string>());
+                return mpDisc->str(track.mTime);
             }
             break;
         }
@@ -480,10 +713,7 @@ QVariant CTreeItem::data(int column) const
     {
         if (column == 0)
         {
-            if (mItemData.find("name") != mItemData.end())
-            {
-                return QString::fromStdString(mItemData["name"].get<std::string>());
-            }
+            return mpDisc->str(mpDisc->mGroups.at(mIdx).mName);
         }
     }
 
@@ -495,21 +725,40 @@ CTreeItem *CTreeItem::parentItem()
     return m_parentItem;
 }
 
+void CTreeItem::setParentItem(CTreeItem *parentItem)
+{
+    m_parentItem = parentItem;
+}
+
 CMDTreeModel::ItemRole CTreeItem::itemRole() const
 {
     return mItRole;
 }
 
-nlohmann::json &CTreeItem::rawData()
+int CTreeItem::index() const
+{
+    return mIdx;
+}
+
+void CTreeItem::setIndex(int idx)
 {
-    return mItemData;
+    mIdx = idx;
+}
+
+void CTreeItem::setNumber(int no)
+{
+    mNo = no;
 }
 
 int CTreeItem::trackNumber() const
 {
-    if (mItemData.find("no") != mItemData.end())
+    if (mItRole == CMDTreeModel::ItemRole::TRACK)
+    {
+        return mpDisc->mTracks.at(mIdx).mNo + 1;
+    }
+    else if (mItRole == CMDTreeModel::ItemRole::GROUP)
     {
-        return mItemData["no"].get<int>() + 1;
+        return mNo + 1;
     }
     return -1;
 }
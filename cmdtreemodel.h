@@ -17,7 +17,10 @@
 #pragma once
 #include <QObject>
 #include <QAbstractItemModel>
-#include <json.hpp>
+#include <QTimer>
+#include <QVector>
+#include <QMap>
+#include "cdiscsnapshot.h"
 
 class CTreeItem;
 
@@ -55,10 +58,10 @@ public:
     //--------------------------------------------------------------------------
     //! @brief      Constructs a new instance.
     //!
-    //! @param[in]  jsonContent  The json content
-    //! @param      parent       The parent
+    //! @param[in]  disc    The disc snapshot
+    //! @param      parent  The parent
     //--------------------------------------------------------------------------
-    explicit CMDTreeModel(const QString& jsonContent, QObject *parent = nullptr);
+    explicit CMDTreeModel(const SDiscSnapshot& disc, QObject *parent = nullptr);
     
     //--------------------------------------------------------------------------
     //! @brief      Destroys the object.
@@ -168,21 +171,64 @@ public:
     void increaseTracks(int tracks);
     
     //--------------------------------------------------------------------------
-    //! @brief      export json data
+    //! @brief      disc data shown by the model
     //!
-    //! @return     json data
+    //! @return     disc snapshot
     //--------------------------------------------------------------------------
-    nlohmann::json exportJson() const;
+    const SDiscSnapshot& snapshot() const;
     
     //--------------------------------------------------------------------------
     //! @brief      get track group
     //!
-    //! @param[in]  track  The track
+    //! @param[in]  track  The track (1-based)
     //!
-    //! @return     group of track
+    //! @return     index of group in snapshot; -1 if not grouped
     //--------------------------------------------------------------------------
-    nlohmann::json& group(int track);
+    int group(int track) const;
 
+    //--------------------------------------------------------------------------
+    //! @brief      merge track batch into model (disc info is sent in parts)
+    //!
+    //! @param[in]  batch  snapshot holding (partial) tracks
+    //--------------------------------------------------------------------------
+    void updateTracks(const SDiscSnapshot& batch);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add track (e.g. after transfer) without rebuilding the model
+    //!
+    //! @param[in]  number  track number (0-based)
+    //! @param[in]  title   track title
+    //! @param[in]  mode    track mode (e.g. "LP2")
+    //! @param[in]  time    play time string
+    //! @param[in]  used    used disc time (s)
+    //--------------------------------------------------------------------------
+    void insertTrack(int number, const QString& title, const QString& mode,
+                     const QString& time, int used);
+
+    //--------------------------------------------------------------------------
+    //! @brief      group tracks without rebuilding the model
+    //!
+    //! @param[in]  title  group name
+    //! @param[in]  first  first track (1-based)
+    //! @param[in]  last   last track (1-based)
+    //!
+    //! @return     index of new group; invalid if the model was reset
+    //--------------------------------------------------------------------------
+    QModelIndex insertGroup(const QString& title, int16_t first, int16_t last);
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove group, tracks are moved back to the disc
+    //!
+    //! @param[in]  number  group number (0-based, in track order)
+    //--------------------------------------------------------------------------
+    void removeGroup(int number);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set disc title
+    //!
+    //! @param[in]  title  The title
+    //--------------------------------------------------------------------------
+    void setTitle(const QString& title);
 
 signals:
     //--------------------------------------------------------------------------
@@ -194,26 +240,82 @@ signals:
     //--------------------------------------------------------------------------
     void editTitle(ItemRole role, QString title, int no);
 
+    //--------------------------------------------------------------------------
+    //! @brief      protection / time of shown tracks are missing
+    //!
+    //! @param[in]  first  first track (0-based)
+    //! @param[in]  last   last track (0-based)
+    //--------------------------------------------------------------------------
+    void detailsNeeded(int first, int last);
+
 protected:
     //--------------------------------------------------------------------------
-    //! @brief      initialize model from json data
+    //! @brief      initialize model from disc snapshot
     //--------------------------------------------------------------------------
     void setupModelData();
+
+    //--------------------------------------------------------------------------
+    //! @brief      rebuild whole model (fallback for non-trivial changes)
+    //--------------------------------------------------------------------------
+    void rebuild();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create interval index for group lookup
+    //--------------------------------------------------------------------------
+    void indexGroups();
+
+    //--------------------------------------------------------------------------
+    //! @brief      number groups in track order
+    //--------------------------------------------------------------------------
+    void renumberGroups();
+
+    //--------------------------------------------------------------------------
+    //! @brief      get disc item
+    //!
+    //! @return     disc item; nullptr if not there
+    //--------------------------------------------------------------------------
+    CTreeItem* discItem() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      remember track for detail request (sent delayed)
+    //!
+    //! @param[in]  track  The track (0-based)
+    //--------------------------------------------------------------------------
+    void requestDetails(int track) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      send collected detail requests
+    //--------------------------------------------------------------------------
+    void sendDetailRequest();
     
-    /// json data
-    nlohmann::json mMDJson;
+    /// disc data
+    SDiscSnapshot mDisc;
     
     /// root item
     CTreeItem*  mpTreeRoot;
-    
-    /// root json data
-    nlohmann::json mRootData;
-    
-    /// empty object
-    nlohmann::json mEmpty;
 
     /// disc config
     SDiscConf mDiscConf;
+
+    /// first track (1-based) -> group index; groups don't overlap
+    QMap<int, int> mGroupIdx;
+
+    /// track items by track number (0-based)
+    QVector<CTreeItem*> mTrackItems;
+
+    /// details were requested for track
+    mutable QVector<bool> mRequested;
+
+    /// requested range
+    mutable int mReqFirst;
+    mutable int mReqLast;
+
+    /// collects detail requests while the view paints
+    mutable QTimer mReqTimer;
+
+private:
+    /// delay for detail requests
+    static constexpr int DETAILS_DELAY_MS = 50;
 };
 
 //------------------------------------------------------------------------------
@@ -226,10 +328,13 @@ public:
     //! @brief      Constructs a new instance.
     //!
     //! @param[in]  role        The role
-    //! @param      data        The data
+    //! @param      pDisc       The disc data
+    //! @param[in]  idx         index of track / group in disc data
+    //! @param[in]  no          number shown to the user (groups only)
     //! @param      parentItem  The parent item
     //--------------------------------------------------------------------------
-    explicit CTreeItem(CMDTreeModel::ItemRole role, nlohmann::json& data, CTreeItem *parentItem = nullptr);
+    explicit CTreeItem(CMDTreeModel::ItemRole role, SDiscSnapshot* pDisc, int idx = -1,
+                       int no = -1, CTreeItem *parentItem = nullptr);
     
     //--------------------------------------------------------------------------
     //! @brief      Destroys the object.
@@ -243,6 +348,23 @@ public:
     //--------------------------------------------------------------------------
     void appendChild(CTreeItem *child);
 
+    //--------------------------------------------------------------------------
+    //! @brief      Inserts a child.
+    //!
+    //! @param[in]  row    The row
+    //! @param      child  The child
+    //--------------------------------------------------------------------------
+    void insertChild(int row, CTreeItem *child);
+
+    //--------------------------------------------------------------------------
+    //! @brief      remove child from item (caller takes ownership)
+    //!
+    //! @param[in]  row   The row
+    //!
+    //! @return     child pointer
+    //--------------------------------------------------------------------------
+    CTreeItem *takeChild(int row);
+
     //--------------------------------------------------------------------------
     //! @brief      get the child
     //!
@@ -288,6 +410,13 @@ public:
     //! @return     parent item
     //--------------------------------------------------------------------------
     CTreeItem *parentItem();
+
+    //--------------------------------------------------------------------------
+    //! @brief      set parent item
+    //!
+    //! @param      parentItem  The parent item
+    //--------------------------------------------------------------------------
+    void setParentItem(CTreeItem *parentItem);
     
     //--------------------------------------------------------------------------
     //! @brief      get item role
@@ -297,11 +426,25 @@ public:
     CMDTreeModel::ItemRole itemRole() const;
     
     //--------------------------------------------------------------------------
-    //! @brief      get raw (json) data
+    //! @brief      index of track / group in disc data
     //!
-    //! @return     json data
+    //! @return     index; -1 for disc / root
     //--------------------------------------------------------------------------
-    nlohmann::json &rawData();
+    int index() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set index of track / group in disc data
+    //!
+    //! @param[in]  idx   The index
+    //--------------------------------------------------------------------------
+    void setIndex(int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set group number
+    //!
+    //! @param[in]  no    The number (0-based)
+    //--------------------------------------------------------------------------
+    void setNumber(int no);
     
     //--------------------------------------------------------------------------
     //! @brief      get track number
@@ -314,8 +457,14 @@ private:
     /// child items
     QVector<CTreeItem*> m_childItems;
     
-    /// json item data 
-    nlohmann::json& mItemData;
+    /// disc data
+    SDiscSnapshot* mpDisc;
+
+    /// index of track / group in disc data
+    int mIdx;
+
+    /// group number
+    int mNo;
     
     /// parent item
     CTreeItem *m_parentItem;
@@ -170,7 +170,7 @@ void CMDTreeView::slotAddGroup()
                 if (i.column() == 0)
                 {
                     item = static_cast<CTreeItem*>(i.internalPointer());
-                    if (!pModel->group(item->trackNumber()).empty())
+                    if (pModel->group(item->trackNumber()) != -1)
                     {
                         throw tr("Please select ungrouped tracks only!");
                     }
@@ -14,55 +14,223 @@
  *
  * You should have received a copy of the GNU General Public License
  */
-#include <QDir>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QJsonValue>
 #include <QTextCodec>
-#include <iomanip>
 #include "cnetmd.h"
+#include "cnetmdsim.h"
+#include "cnetmdtrace.h"
 #include "defines.h"
 #include "helpers.h"
 
-CNetMD::CNetMD(QObject *parent)
-    : QThread(parent), mCurrJob(NetMDCmd::UNKNWON),
-      mpApi(nullptr), mMono(false)
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//--------------------------------------------------------------------------
+CNetMDLogBuf::CNetMDLogBuf()
+    : std::streambuf(), mPercent(-1)
 {
-    mpApi = new netmd::netmd_pp;
-    mNameFLog  = QString("%1/cd2netmd_transfer_log.tmp").arg(QDir::tempPath());
-    mTReadLog.setInterval(1000);
-    mTReadLog.setSingleShot(false);
-    mfLog.setFileName(mNameFLog);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      last progress value found in log (thread safe)
+//!
+//! @return     percent; -1 if there was none
+//--------------------------------------------------------------------------
+int CNetMDLogBuf::percent() const
+{
+    return mPercent.load();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get (and clear) the log tail
+//!
+//! @return     last log lines, separated by new line
+//--------------------------------------------------------------------------
+QString CNetMDLogBuf::takeTail()
+{
+    QMutexLocker lock(&mMtx);
 
-    if ((mLogStream = std::ofstream(mNameFLog.toStdString(), std::ios_base::out | std::ios_base::trunc)))
+    if (!mLine.empty())
     {
-        qInfo() << "Log File / Stream" << mNameFLog << "created.";
-        mpApi->setLogStream(mLogStream);
+        endLine();
     }
-    else
+
+    QString tail = mTail.join(QChar('\n'));
+    mTail.clear();
+    return tail;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      forget progress and log
+//--------------------------------------------------------------------------
+void CNetMDLogBuf::reset()
+{
+    QMutexLocker lock(&mMtx);
+    mLine.clear();
+    mTail.clear();
+    mPercent = -1;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write one character
+//!
+//! @param[in]  c     character
+//!
+//! @return     c or eof
+//--------------------------------------------------------------------------
+CNetMDLogBuf::int_type CNetMDLogBuf::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
     {
-        qCritical() << "Can't open Log File / Stream";
+        QMutexLocker lock(&mMtx);
+        put(traits_type::to_char_type(c));
     }
+    return traits_type::not_eof(c);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write a character sequence
+//!
+//! @param[in]  s     sequence
+//! @param[in]  n     length
+//!
+//! @return     written characters
+//--------------------------------------------------------------------------
+std::streamsize CNetMDLogBuf::xsputn(const char* s, std::streamsize n)
+{
+    QMutexLocker lock(&mMtx);
 
-    if (!mfLog.open(QIODevice::ReadOnly | QIODevice::Text))
+    for (std::streamsize i = 0; i < n; i++)
     {
-        qCritical() << "Can't share Log File / Stream";
+        put(s[i]);
     }
+    return n;
+}
 
-    connect(&mTReadLog, &QTimer::timeout, this, &CNetMD::extractPercent);
-    connect(this, &CNetMD::finished, this, &CNetMD::procEnded);
+//--------------------------------------------------------------------------
+//! @brief      handle one character (mutex must be locked)
+//!
+//! @param[in]  c     character
+//--------------------------------------------------------------------------
+void CNetMDLogBuf::put(char c)
+{
+    if ((c == '\n') || (c == '\r'))
+    {
+        if (!mLine.empty())
+        {
+            endLine();
+        }
+        return;
+    }
+
+    if (c == '%')
+    {
+        // digits right before the percent sign
+        std::size_t pos = mLine.size();
+
+        while ((pos > 0) && (mLine[pos - 1] >= '0') && (mLine[pos - 1] <= '9'))
+        {
+            pos--;
+        }
+
+        if ((pos < mLine.size()) && ((mLine.size() - pos) <= 3))
+        {
+            int val = std::stoi(mLine.substr(pos));
+
+            if (val <= 100)
+            {
+                mPercent = val;
+            }
+        }
+    }
+
+    if (mLine.size() >= MAX_LINE_LENGTH)
+    {
+        endLine();
+    }
+
+    mLine += c;
 }
 
-CNetMD::~CNetMD()
+//--------------------------------------------------------------------------
+//! @brief      move current line into tail (mutex must be locked)
+//--------------------------------------------------------------------------
+void CNetMDLogBuf::endLine()
 {
-    mTReadLog.stop();
-    mfLog.close();
+    mTail.append(QString::fromStdString(mLine));
+    mLine.clear();
 
-    if (mLogStream)
+    while (mTail.size() > TAIL_LINES)
     {
-        mLogStream.close();
+        mTail.removeFirst();
     }
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+
+CNetMD::CNetMD(QObject *parent, CNetMdDevice* dev)
+    : QThread(parent), mCurrJob(NetMDCmd::UNKNWON), mbWorking(false),
+      mbCurrent(false), mLogStream(&mLogBuf),
+      mLastPercent(-1), mpApi(dev), mbSessionOk(false), mbUtocScan(true),
+      mCaps{false, false, false, false}, mpHotplug(nullptr)
+{
+    // no backend given: chosen through environment
+    if (mpApi == nullptr)
+    {
+        QByteArray sim    = qgetenv("NETMD_WIZARD_SIM");
+        QByteArray replay = qgetenv("NETMD_WIZARD_REPLAY");
+        QByteArray record = qgetenv("NETMD_WIZARD_RECORD");
+
+        // replay of a recorded session, timing can be scaled
+        // with NETMD_WIZARD_REPLAY_SCALE (0 -> as fast as possible)
+        if (!replay.isEmpty())
+        {
+            bool   ok;
+            double scale = qgetenv("NETMD_WIZARD_REPLAY_SCALE").toDouble(&ok);
+            mpApi = new CNetMdReplayDevice(QString::fromLocal8Bit(replay), ok ? scale : 1.0);
+        }
+        // simulated device for tests without hardware, e.g.
+        // NETMD_WIZARD_SIM="rate=352800,latency=20,usberr=0.01,tracks=5"
+        else if (!sim.isEmpty())
+        {
+            qInfo() << "Using simulated NetMD device:" << sim;
+            mpApi = new CNetMdSimDevice(CNetMdSimDevice::parseConfig(QString::fromUtf8(sim)));
+        }
+        else
+        {
+            mpApi = new CNetMdHwDevice;
+        }
+
+        // record all device calls into a trace file
+        if (!record.isEmpty())
+        {
+            mpApi = new CNetMdRecorder(mpApi, QString::fromLocal8Bit(record));
+        }
+    }
+
+    mTReadLog.setInterval(200);
+    mTReadLog.setSingleShot(false);
+    mpApi->setLogStream(mLogStream);
+
+    mpHotplug = new CUsbHotplug(this);
+
+    // hotplug signals come from the libusb event thread
+    connect(mpHotplug, &CUsbHotplug::deviceArrived, this, [this]() {
+        invalidateSession();
+        emit deviceArrived();
+    });
+
+    connect(mpHotplug, &CUsbHotplug::deviceLeft, this, [this]() {
+        invalidateSession();
+        emit deviceLeft();
+    });
+
+    connect(&mTReadLog, &QTimer::timeout, this, &CNetMD::extractPercent);
+    connect(this, &QThread::finished, this, &CNetMD::procEnded);
+}
+
+CNetMD::~CNetMD()
+{
+    mTReadLog.stop();
+    mpHotplug->stopWatching();
 
     if (mpApi != nullptr)
     {
@@ -70,16 +238,18 @@ CNetMD::~CNetMD()
     }
 }
 
+//--------------------------------------------------------------------------
+//! @brief      queue command, start thread if needed
+//!
+//! @param[in]  startup  The startup structure
+//--------------------------------------------------------------------------
 void CNetMD::start(NetMDStartup startup)
 {
-    mLog.clear();
-    mCurrJob = startup;
-    mTReadLog.start();
-    QThread::start();
+    enqueue({startup, TocData(), false, SBulkEdit()});
 }
 
 //--------------------------------------------------------------------------
-//! @brief      store data, start thread
+//! @brief      queue TOC manipulation, start thread if needed
 //!
 //! @param[in]  tocData  TOC data for manipulation
 //! @param[in]  resetDev reset device after TOC edit
@@ -87,19 +257,146 @@ void CNetMD::start(NetMDStartup startup)
 //--------------------------------------------------------------------------
 void CNetMD::start(const TocData& tocData, bool resetDev, bool mono)
 {
-    mLog.clear();
-    mTocData = tocData;
-    mCurrJob.mCmd = NetMDCmd::TOC_MANIP;
-    mCurrJob.miFirst = resetDev ? 1 : 0;
-    mMono = mono;
-    mTReadLog.start();
-    QThread::start();
+    NetMDStartup startup(NetMDCmd::TOC_MANIP);
+    startup.miFirst = resetDev ? 1 : 0;
+    enqueue({startup, tocData, mono, SBulkEdit()});
+}
+
+//--------------------------------------------------------------------------
+//! @brief      queue staged edits, start thread if needed
+//!
+//! @param[in]  edit      staged edits
+//! @param[in]  resetDev  device may be reset after TOC edit
+//--------------------------------------------------------------------------
+void CNetMD::start(const SBulkEdit& edit, bool resetDev)
+{
+    NetMDStartup startup(NetMDCmd::BULK_EDIT);
+    startup.miFirst = resetDev ? 1 : 0;
+    enqueue({startup, TocData(), false, edit});
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add job to queue (behind all jobs with same or higher prio)
+//!
+//! @param[in]  job   The job
+//--------------------------------------------------------------------------
+void CNetMD::enqueue(const SJob& job)
+{
+    QMutexLocker lock(&mQueueMtx);
+    Prio prio = priority(job.mStartup.mCmd);
+    int  pos  = mQueue.size();
+
+    for (int i = 0; i < mQueue.size(); i++)
+    {
+        if (priority(mQueue.at(i).mStartup.mCmd) > prio)
+        {
+            pos = i;
+            break;
+        }
+    }
+
+    mQueue.insert(pos, job);
+
+    if (!mbWorking)
+    {
+        mbWorking = true;
+        lock.unlock();
+
+        // worker might still be on its way out
+        wait();
+
+        mLastPercent = -1;
+        mTReadLog.start();
+        QThread::start();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      take next job from queue (worker thread)
+//!
+//! @param[out] job   The job
+//!
+//! @return     false if queue is empty (worker ends)
+//--------------------------------------------------------------------------
+bool CNetMD::nextJob(SJob& job)
+{
+    QMutexLocker lock(&mQueueMtx);
+    mbCurrent = false;
+
+    if (mQueue.isEmpty())
+    {
+        mbWorking = false;
+        return false;
+    }
+
+    job       = mQueue.takeFirst();
+    mCurrJob  = job.mStartup;
+    mbCurrent = true;
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      queue priority of a command
+//!
+//! @param[in]  cmd   The command
+//!
+//! @return     priority
+//--------------------------------------------------------------------------
+CNetMD::Prio CNetMD::priority(NetMDCmd cmd)
+{
+    switch (cmd)
+    {
+    case NetMDCmd::ADD_GROUP:
+    case NetMDCmd::RENAME_DISC:
+    case NetMDCmd::RENAME_TRACK:
+    case NetMDCmd::RENAME_GROUP:
+    case NetMDCmd::DEL_GROUP:
+    case NetMDCmd::BULK_EDIT:
+    case NetMDCmd::TRACK_DETAILS:
+        return Prio::HIGH;
+    case NetMDCmd::SCAN_DETAILS:
+    case NetMDCmd::VERIFY_TRACKS:
+        return Prio::LOW;
+    default:
+        return Prio::NORMAL;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      watch USB bus for NetMD devices
+//!
+//! @return     0 -> ok; -1 -> hotplug not supported
+//--------------------------------------------------------------------------
+int CNetMD::watchDevices()
+{
+    return mpHotplug->startWatching();
 }
 
 //--------------------------------------------------------------------------
-//! @brief init the NetMD device
+//! @brief      force re-init of device before next command (thread safe)
 //--------------------------------------------------------------------------
-void CNetMD::initNetMdDevice()
+void CNetMD::invalidateSession()
+{
+    mbSessionOk = false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      allow UTOC scan on disc load (thread safe, default: on);
+//!             the scan only reads and always leaves TOC edit mode
+//!
+//! @param[in]  ena   enable / disable
+//--------------------------------------------------------------------------
+void CNetMD::setUtocScan(bool ena)
+{
+    mbUtocScan = ena;
+}
+
+//--------------------------------------------------------------------------
+//! @brief init the NetMD device (if there is no open session)
+//!
+//! @return 0 -> success; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::initNetMdDevice()
 {
     // set log level for netmd++
     switch(g_LogFilter)
@@ -119,8 +416,36 @@ void CNetMD::initNetMdDevice()
         break;
     }
 
-    mpApi->initDevice();
+    if (mbSessionOk)
+    {
+        return 0;
+    }
+
+    int ret;
+
+    if ((ret = mpApi->initDevice()) != netmd::NETMDERR_NO_ERROR)
+    {
+        qWarning() << "Can't open NetMD device:" << ret;
+        mDevName.clear();
+        return ret;
+    }
+
     mDevName = QString::fromStdString(mpApi->getDeviceName());
+
+    if (!mCapsCache.contains(mDevName))
+    {
+        SDevCaps caps;
+        caps.mOtfEnc   = mpApi->otfEncodeSupported();
+        caps.mTocManip = mpApi->tocManipSupported();
+        caps.mSpUpload = mpApi->spUploadSupported();
+        caps.mPcm2Mono = mpApi->pcm2MonoSupported();
+        mCapsCache.insert(mDevName, caps);
+    }
+
+    mCaps = mCapsCache.value(mDevName);
+    mbSessionOk = true;
+    qInfo() << "NetMD session opened on" << mDevName;
+    return 0;
 }
 
 //--------------------------------------------------------------------------
@@ -133,18 +458,45 @@ int CNetMD::getDiscInfo()
     using namespace netmd;
 
     qInfo() << "getting MD disc / device info ...";
-    initNetMdDevice();
-    int i;
+    int i   = -1;
+    int ret = initNetMdDevice();
     uint16_t tc = 0;
 
+    {
+        // background scan of the former disc is stale
+        QMutexLocker lock(&mQueueMtx);
+
+        for (int j = mQueue.size() - 1; j >= 0; j--)
+        {
+            if (priority(mQueue.at(j).mStartup.mCmd) == Prio::LOW)
+            {
+                mQueue.removeAt(j);
+            }
+        }
+    }
+
+    mDetailsDone.clear();
+
+    if ((ret == 0) && ((i = mpApi->trackCount()) < 0))
+    {
+        // session went stale (disc change, device reset, ...) -> re-open once
+        invalidateSession();
+
+        if ((ret = initNetMdDevice()) == 0)
+        {
+            i = mpApi->trackCount();
+        }
+    }
+
+    if (ret != 0)
+    {
+        emit discOut(SDiscSnapshot::noDisc());
+        return 0;
+    }
+
     std::string s;
-    std::ostringstream os;
-    
-    // helper function to clear std::ostringstream
-    auto clrOs = [&]()->void{os.clear(); os.str("");};
 
-    // Construct JSON object
-    QJsonObject tree;
+    SDiscSnapshot disc;
 
     if (mpApi->discTitle(s) == NETMDERR_NO_ERROR)
     {
@@ -152,118 +504,432 @@ int CNetMD::getDiscInfo()
         {
             s = "<untitled>";
         }
-        tree.insert("title", mdToUtf8(s.c_str()));
+        disc.mTitle = disc.intern(mdToUtf8(s.c_str()));
     }
-    tree.insert("otf_enc", mpApi->otfEncodeSupported() ? 1 : 0);
-    tree.insert("toc_manip", mpApi->tocManipSupported() ? 1 : 0);
-    tree.insert("device", mpApi->getDeviceName().c_str());
-    tree.insert("sp_upload", mpApi->spUploadSupported() ? 1 : 0);
-    tree.insert("pcm2mono", mpApi->pcm2MonoSupported() ? 1 : 0);
+    disc.mOtfEnc   = mCaps.mOtfEnc;
+    disc.mTocManip = mCaps.mTocManip;
+    disc.mDevice   = mDevName;
+    disc.mSpUpload = mCaps.mSpUpload;
+    disc.mPcm2Mono = mCaps.mPcm2Mono;
 
-    if ((i = mpApi->trackCount()) > -1)
+    if (i > -1)
     {
-        tree.insert("trk_count", i);
+        disc.mTrkCount = i;
         tc = i;
     }
 
-    if ((i = mpApi->discFlags()) > -1)
+    if ((i = mpApi->discFlags()) > -1)
+    {
+        disc.mDiscFlags = i;
+    }
+
+    DiscCapacity capacity;
+    int recorded = -1;
+    if (mpApi->discCapacity(capacity) == NETMDERR_NO_ERROR)
+    {
+        recorded        = toSec(&capacity.recorded);
+        disc.mUsedTime  = recorded;
+        disc.mTotTime   = toSec(&capacity.total);
+        disc.mFreeTime  = toSec(&capacity.available);
+    }
+
+    Groups mdGroups = mpApi->groups();
+    for (const auto& g : mdGroups)
+    {
+        if (g.mFirst > 0)
+        {
+            int16_t first = g.mFirst;
+            int16_t last  = (g.mLast == -1) ? first : g.mLast;
+            disc.mGroups.append({disc.intern(mdToUtf8(g.mName.c_str())), first, last});
+        }
+    }
+
+    // header first, tree can be shown while tracks are read
+    emit discOut(disc);
+    qInfo() << static_cast<const char*>(disc.toJson());
+
+    // read-only UTOC scan (TOC edit mode is left afterwards); one scan
+    // gives the hash for the fingerprint and the data of all tracks
+    CTocManip::ScanVector scan;
+    QByteArray utoc;
+    bool scanned = false;
+
+    if (mCaps.mTocManip && mbUtocScan)
+    {
+        CTocManip manip(mpApi);
+
+        if (!(scanned = (manip.scanDisc(scan, &utoc) == NETMDERR_NO_ERROR)))
+        {
+            qInfo() << "UTOC scan not possible, using track queries.";
+            utoc.clear();
+        }
+    }
+
+    // known disc? (UTOC hash makes the fingerprint reliable)
+    int known = mDiscCache.select(CDiscCache::fingerprint(disc.str(disc.mTitle), tc, recorded, utoc), tc);
+
+    TrackVector trackData;
+    SDiscSnapshot batch;
+    mDetailsDone.fill(false, tc);
+
+    // UTOC scan costs the same for 1 or 254 tracks
+    if ((known < tc) && scanned && (scanTracks(tc, scan, trackData) == 0))
+    {
+        for (i = 0; i < trackData.size(); i++)
+        {
+            addTrack(batch, i, trackData.at(i), SDiscSnapshot::TF_ALL);
+        }
+
+        mDetailsDone.fill(true);
+        emitTracks(batch);
+        return 0;
+    }
+
+    if (known > 0)
+    {
+        qInfo() << "Disc known," << known << "of" << tc << "tracks taken from cache.";
+
+        for (i = 0; i < known; i++)
+        {
+            mDiscCache.track(i, batch);
+            mDetailsDone[i] = mDiscCache.hasDetails(i);
+
+            if (batch.mTracks.size() == TRACK_BATCH)
+            {
+                emitTracks(batch);
+            }
+        }
+
+        emitTracks(batch);
+    }
+
+    // errors show up as missing titles, disc info as such is there
+    if (queryTracks(known, tc) != 0)
+    {
+        return 0;
+    }
+
+    if ((known > 0) && utoc.isEmpty())
+    {
+        // weak fingerprint -> confirm cached titles in background
+        NetMDStartup startup(NetMDCmd::VERIFY_TRACKS);
+        startup.miFirst = 0;
+        startup.miLast  = known - 1;
+        enqueue({startup, TocData(), false, SBulkEdit()});
+    }
+
+    if (mDetailsDone.contains(false))
+    {
+        NetMDStartup startup(NetMDCmd::SCAN_DETAILS);
+        startup.miFirst = 0;
+        startup.miLast  = tc - 1;
+        enqueue({startup, TocData(), false, SBulkEdit()});
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get titles and modes through per track queries (sent in
+//!             batches)
+//!
+//! @param[in]  first first track to query (0-based)
+//! @param[in]  tc    track count
+//!
+//! @return     0 -> success; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::queryTracks(int first, int tc)
+{
+    SDiscSnapshot batch;
+    int ret = 0;
+
+    for (int i = first; i < tc; i++)
+    {
+        STrackData td = {std::string(), netmd::AudioEncoding::UNKNOWN, 0,
+                         netmd::TrackProtection::UNKNOWN, {0, 0, 0}};
+
+        if (((ret = mpApi->trackTitle(i, td.mTitle)) < 0)
+            || ((ret = mpApi->trackBitRate(i, td.mEnc, td.mChannel)) < 0))
+        {
+            break;
+        }
+
+        addTrack(batch, i, td, SDiscSnapshot::TF_TITLE | SDiscSnapshot::TF_BITRATE);
+
+        if (batch.mTracks.size() == TRACK_BATCH)
+        {
+            emitTracks(batch);
+        }
+    }
+
+    emitTracks(batch);
+    return (ret < 0) ? ret : 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      compare cached titles / modes with device, send changes
+//!
+//! @param[in]  first  first track (0-based)
+//! @param[in]  last   last track (0-based)
+//!
+//! @return     0 -> success; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::verifyTracks(int first, int last)
+{
+    SDiscSnapshot changed;
+    int ret = 0;
+
+    for (int i = qMax(0, first); (i <= last) && (i < mDetailsDone.size()); i++)
+    {
+        STrackData td = {std::string(), netmd::AudioEncoding::UNKNOWN, 0,
+                         netmd::TrackProtection::UNKNOWN, {0, 0, 0}};
+
+        if (((ret = mpApi->trackTitle(i, td.mTitle)) < 0)
+            || ((ret = mpApi->trackBitRate(i, td.mEnc, td.mChannel)) < 0))
+        {
+            break;
+        }
+
+        addTrack(changed, i, td, SDiscSnapshot::TF_TITLE | SDiscSnapshot::TF_BITRATE);
+
+        if (mDiscCache.sameTrack(changed, changed.mTracks.last()))
+        {
+            changed.mTracks.removeLast();
+        }
+        else
+        {
+            qInfo() << "Cached track" << i << "is outdated.";
+
+            // re-read details as well
+            mDetailsDone[i] = false;
+        }
+
+        if (((i - first) % TRACK_BATCH) == (TRACK_BATCH - 1))
+        {
+            emitTracks(changed);
+
+            if ((i < last) && jobsPending())
+            {
+                // let waiting commands run, go on afterwards
+                NetMDStartup startup(NetMDCmd::VERIFY_TRACKS);
+                startup.miFirst = i + 1;
+                startup.miLast  = last;
+                enqueue({startup, TocData(), false, SBulkEdit()});
+                break;
+            }
+        }
+    }
+
+    emitTracks(changed);
+
+    if (mDetailsDone.contains(false))
+    {
+        NetMDStartup startup(NetMDCmd::SCAN_DETAILS);
+        startup.miFirst = 0;
+        startup.miLast  = mDetailsDone.size() - 1;
+        enqueue({startup, TocData(), false, SBulkEdit()});
+    }
+
+    return (ret < 0) ? ret : 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      read protection / time of tracks not read so far
+//!
+//! @param[in]  first       first track (0-based)
+//! @param[in]  last        last track (0-based)
+//! @param[in]  background  yield to other jobs after each batch
+//!
+//! @return     0 -> success; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::trackDetails(int first, int last, bool background)
+{
+    SDiscSnapshot batch;
+    int ret = 0;
+
+    for (int i = qMax(0, first); (i <= last) && (i < mDetailsDone.size()); i++)
+    {
+        if (mDetailsDone.at(i))
+        {
+            continue;
+        }
+
+        STrackData td = {std::string(), netmd::AudioEncoding::UNKNOWN, 0,
+                         netmd::TrackProtection::UNKNOWN, {0, 0, 0}};
+
+        if (((ret = mpApi->trackFlags(i, td.mProt)) < 0)
+            || ((ret = mpApi->trackTime(i, td.mTime)) < 0))
+        {
+            break;
+        }
+
+        mDetailsDone[i] = true;
+        addTrack(batch, i, td, SDiscSnapshot::TF_DETAILS);
+
+        if (batch.mTracks.size() == TRACK_BATCH)
+        {
+            emitTracks(batch);
+
+            if (background && (i < last) && jobsPending())
+            {
+                // let waiting commands run, go on afterwards
+                NetMDStartup startup(NetMDCmd::SCAN_DETAILS);
+                startup.miFirst = i + 1;
+                startup.miLast  = last;
+                enqueue({startup, TocData(), false, SBulkEdit()});
+                break;
+            }
+        }
+    }
+
+    emitTracks(batch);
+    return (ret < 0) ? ret : 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add track to batch
+//!
+//! @param      batch   The batch
+//! @param[in]  no      track number (0-based)
+//! @param[in]  td      track data
+//! @param[in]  fields  fields to add (SDiscSnapshot::TrackField flags)
+//--------------------------------------------------------------------------
+void CNetMD::addTrack(SDiscSnapshot& batch, int no, const STrackData& td, int fields)
+{
+    SDiscSnapshot::STrack track = SDiscSnapshot::emptyTrack(no);
+    std::ostringstream os;
+
+    track.mFields = static_cast<uint8_t>(fields);
+
+    if (fields & SDiscSnapshot::TF_TITLE)
+    {
+        std::string s = td.mTitle;
+
+        if (s.empty())
+        {
+            s = "<untitled>";
+        }
+        else if (s.find("LP:") == 0)
+        {
+            s = s.substr(3);
+        }
+
+        track.mName = batch.intern(mdToUtf8(s.c_str()));
+    }
+
+    if (fields & SDiscSnapshot::TF_BITRATE)
     {
-        clrOs();
-        os << "0x" << std::hex << std::setw(2) << std::setfill('0') << i;
-        tree.insert("disc_flags", os.str().c_str());
+        os << td.mEnc;
+        if (td.mChannel == 1)
+        {
+            os << " Mono";
+        }
+        track.mBitrate = batch.intern(QString::fromStdString(os.str()));
     }
 
-    DiscCapacity capacity;
-    if (mpApi->discCapacity(capacity) == NETMDERR_NO_ERROR)
+    if (fields & SDiscSnapshot::TF_DETAILS)
     {
-        tree.insert("t_used", toSec(&capacity.recorded));
-        tree.insert("t_total", toSec(&capacity.total));
-        tree.insert("t_free", toSec(&capacity.available));
+        os.clear();
+        os.str("");
+        os << td.mProt;
+        track.mProtect = batch.intern(QString::fromStdString(os.str()));
+
+        os.clear();
+        os.str("");
+        os << td.mTime;
+        track.mTime = batch.intern(QString::fromStdString(os.str()));
     }
 
-    Groups mdGroups = mpApi->groups();
-    QJsonArray groups;
-    for (const auto& g : mdGroups)
+    batch.mTracks.append(track);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      send track batch (if not empty) and start a new one
+//!
+//! @param      batch  The batch
+//--------------------------------------------------------------------------
+void CNetMD::emitTracks(SDiscSnapshot& batch)
+{
+    if (!batch.mTracks.isEmpty())
     {
-        if (g.mFirst > 0)
-        {
-            int first = g.mFirst;
-            int last  = (g.mLast == -1) ? first : g.mLast;
-            QJsonObject group;
-            group.insert("name", mdToUtf8(g.mName.c_str()));
-            group.insert("first", first);
-            group.insert("last", last);
-            groups.append(group);
-        }
+        mDiscCache.update(batch);
+        emit tracksOut(batch);
+        batch = SDiscSnapshot();
     }
-    tree.insert("groups", groups);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get track data from UTOC scan
+//!
+//! @param[in]  tc          track count
+//! @param[in]  scan        tracks found in UTOC
+//! @param[out] trackData   track data
+//!
+//! @return     0 -> success; else -> error (use queryTracks())
+//--------------------------------------------------------------------------
+int CNetMD::scanTracks(int tc, const CTocManip::ScanVector& scan, TrackVector& trackData)
+{
+    using namespace netmd;
 
-    QJsonArray tracks;
-    AudioEncoding aenc;
-    TrackProtection tprot;
-    TrackTime ttime;
-    uint8_t channel;
+    trackData.clear();
 
-    for(i = 0; i < tc; i++)
+    if (scan.size() != tc)
     {
-        QJsonObject track;
-        s = "";
-        tprot = TrackProtection::UNKNOWN;
-        aenc  = AudioEncoding::UNKNOWN;
-        ttime = {0, 0, 0};
-        mpApi->trackTitle(i, s);
-        mpApi->trackBitRate(i, aenc, channel);
-        mpApi->trackFlags(i, tprot);
-        mpApi->trackTime(i, ttime);
-
-        // Create JSON track object and add to array
-        track.insert("no", i);
+        qWarning() << "UTOC track count" << scan.size() << "doesn't match" << tc << "- using track queries.";
+        return -1;
+    }
 
-        // protection
-        clrOs();
-        os << tprot;
-        track.insert("protect", os.str().c_str());
+    for (int i = 0; i < scan.size(); i++)
+    {
+        const CTocManip::TrackScan& ts = scan.at(i);
+        STrackData td = {ts.mTitle, AudioEncoding::SP, 2, TrackProtection::UNPROTECTED, {0, 0, 0}};
+        double factor = 1.0;
 
-        // bitrate
-        clrOs();
-        os << aenc;
-        if (channel == 1)
+        if ((ts.mTitle.find("LP:") == 0) || !(ts.mMode & CTocManip::MODE_AUDIO))
         {
-            os << " Mono";
+            // LP2 / LP4 isn't stored in UTOC
+            mpApi->trackBitRate(i, td.mEnc, td.mChannel);
+            factor = (td.mEnc == AudioEncoding::LP4) ? 4.0 : 2.0;
         }
-        track.insert("bitrate", os.str().c_str());
-
-        // time
-        clrOs();
-        os << ttime;
-        track.insert("time", os.str().c_str());
-
-        // title
-        if (s.empty())
+        else if (!(ts.mMode & CTocManip::MODE_STEREO))
         {
-            s = "<untitled>";
+            td.mChannel = 1;
+            factor      = 2.0;
         }
-        else if (s.find("LP:") == 0)
+
+        if (!(ts.mMode & CTocManip::MODE_WRITABLE))
         {
-            s = s.substr(3);
+            td.mProt = TrackProtection::PROTECTED;
         }
 
-        track.insert("name", mdToUtf8(s.c_str()));
-        tracks.append(track);
+        int hSecs     = qRound(ts.mSoundGroups * factor * 100.0 / CTocManip::SOUND_GROUPS_PER_SEC);
+        td.mTime      = {hSecs / 6000, (hSecs / 100) % 60, hSecs % 100};
+        trackData.append(td);
     }
-    tree.insert("tracks", tracks);
-
-    QJsonDocument jdoc(tree);
-    QByteArray ba = jdoc.toJson(QJsonDocument::Indented);
 
-    if (ba.isEmpty())
+    // cross check first track with device answer
+    if (!trackData.isEmpty())
     {
-        ba = EMPTY_JSON_RESP;
+        std::string     title;
+        AudioEncoding   enc   = AudioEncoding::UNKNOWN;
+        uint8_t         chan  = 0;
+        TrackProtection prot  = TrackProtection::UNKNOWN;
+        const STrackData& td  = trackData.at(0);
+
+        mpApi->trackTitle(0, title);
+        mpApi->trackBitRate(0, enc, chan);
+        mpApi->trackFlags(0, prot);
+
+        if ((title != td.mTitle) || (enc != td.mEnc)
+            || ((chan == 1) != (td.mChannel == 1)) || (prot != td.mProt))
+        {
+            qWarning() << "UTOC data doesn't match device data - using track queries.";
+            trackData.clear();
+            return -1;
+        }
     }
 
-    emit jsonOut(static_cast<const char*>(ba));
-    qInfo() << static_cast<const char*>(ba);
-
+    qInfo() << "Disc scanned through UTOC," << tc << "tracks.";
     return 0;
 }
 
@@ -427,17 +1093,267 @@ int CNetMD::delTrack(int trackNo)
 //!
 //! @return 0 -> success; else -> error
 //--------------------------------------------------------------------------
-int CNetMD::doTocManip(bool devReset)
+int CNetMD::doTocManip(const TocData& tocData, bool devReset, bool mono)
+{
+    CTocManip manip(mpApi);
+    return manip.manipulateTOC(tocData, devReset, mono);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      commit staged edits: many edits through one UTOC rewrite
+//!             (if possible), else through single API calls
+//!
+//! @param[in]  edit      staged edits
+//! @param[in]  resetDev  device may be reset after TOC edit
+//!
+//! @return     0 -> success; TOCMANIP_DEV_RESET; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::bulkEdit(const SBulkEdit& edit, bool resetDev)
+{
+    qInfo() << "commit" << edit.count() << "MD edits on" << mDevName;
+
+    // UTOC rewrite needs a device reset to become visible,
+    // so it only pays off for many edits and an idle queue
+    if (mCaps.mTocManip && resetDev && (edit.count() >= BULK_UTOC_MIN)
+        && edit.mGroupNames.isEmpty() && !jobsPending())
+    {
+        bool written = false;
+        int  ret     = bulkEditUtoc(edit, resetDev, written);
+
+        if ((ret >= 0) || written)
+        {
+            return ret;
+        }
+
+        qInfo() << "UTOC title rewrite not possible, using single edits.";
+    }
+
+    int ret = 0;
+    int r;
+
+    if (edit.mbDiscTitle && ((r = renameDisc(edit.mDiscTitle)) < 0))
+    {
+        ret = r;
+    }
+
+    for (const auto& g : edit.mNewGroups)
+    {
+        if ((r = addGroup(g.mName, g.mFirst, g.mLast)) < 0)
+        {
+            ret = r;
+        }
+    }
+
+    for (auto it = edit.mGroupNames.constBegin(); it != edit.mGroupNames.constEnd(); it++)
+    {
+        if ((r = renameGroup(it.value(), it.key())) < 0)
+        {
+            ret = r;
+        }
+    }
+
+    for (auto it = edit.mTracks.constBegin(); it != edit.mTracks.constEnd(); it++)
+    {
+        if ((r = renameTrack(it.value(), it.key())) < 0)
+        {
+            ret = r;
+        }
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write staged edits through UTOC title sector
+//!
+//! @param[in]  edit      staged edits
+//! @param[in]  resetDev  reset device after TOC edit
+//! @param[out] written   true if UTOC was written
+//!
+//! @return     0 -> success; TOCMANIP_DEV_RESET; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::bulkEditUtoc(const SBulkEdit& edit, bool resetDev, bool& written)
 {
     CTocManip manip(mpApi);
-    return manip.manipulateTOC(mTocData, devReset, mMono);
+    CTocManip::ScanVector scan;
+    CTocManip::RawTitles  titles;
+    std::string s;
+    int ret;
+
+    written = false;
+
+    if ((ret = manip.scanDisc(scan)) != netmd::NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    // make sure we understand the title sector
+    if (!scan.isEmpty() && ((mpApi->trackTitle(0, s) != netmd::NETMDERR_NO_ERROR) || (s != scan.at(0).mTitle)))
+    {
+        qWarning() << "UTOC titles don't match device titles!";
+        return -1;
+    }
+
+    // disc title with group header
+    std::string header;
+
+    if (edit.mbDiscTitle)
+    {
+        header = utf8ToMd(edit.mDiscTitle).toStdString();
+    }
+    else
+    {
+        mpApi->discTitle(header);
+    }
+
+    std::ostringstream groups;
+
+    for (const auto& g : mpApi->groups())
+    {
+        if (g.mFirst > 0)
+        {
+            groups << g.mFirst;
+            if (g.mLast > g.mFirst)
+            {
+                groups << "-" << g.mLast;
+            }
+            groups << ";" << g.mName << "//";
+        }
+    }
+
+    for (const auto& g : edit.mNewGroups)
+    {
+        groups << g.mFirst;
+        if (g.mLast > g.mFirst)
+        {
+            groups << "-" << g.mLast;
+        }
+        groups << ";" << utf8ToMd(g.mName).toStdString() << "//";
+    }
+
+    if (!groups.str().empty())
+    {
+        header = "0;" + header + "//" + groups.str();
+    }
+
+    titles.push_back(header);
+
+    for (int i = 0; i < scan.size(); i++)
+    {
+        s = scan.at(i).mTitle;
+
+        if (edit.mTracks.contains(i))
+        {
+            // keep LP marker
+            s = ((s.find("LP:") == 0) ? "LP:" : "") + utf8ToMd(edit.mTracks.value(i)).toStdString();
+        }
+
+        titles.push_back(s);
+    }
+
+    ret = manip.rewriteTitles(titles, resetDev, written);
+
+    if ((ret == netmd::NETMDERR_NO_ERROR) && written && resetDev)
+    {
+        ret = TOCMANIP_DEV_RESET;
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      remove all queued normal priority commands
+//!             (the running one isn't affected)
+//!
+//! @return     number of removed commands
+//--------------------------------------------------------------------------
+int CNetMD::dropPending()
+{
+    QMutexLocker lock(&mQueueMtx);
+    int count = 0;
+
+    for (int i = mQueue.size() - 1; i >= 0; i--)
+    {
+        if (priority(mQueue.at(i).mStartup.mCmd) == Prio::NORMAL)
+        {
+            mQueue.removeAt(i);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      are more jobs queued (background jobs don't count)
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CNetMD::jobsPending()
+{
+    QMutexLocker lock(&mQueueMtx);
+
+    for (const auto& j : mQueue)
+    {
+        if (priority(j.mStartup.mCmd) != Prio::LOW)
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
+//--------------------------------------------------------------------------
+//! @brief      thread function: works off the command queue
+//--------------------------------------------------------------------------
 void CNetMD::run()
+{
+    SJob job = {NetMDStartup(NetMDCmd::UNKNWON), TocData(), false, SBulkEdit()};
+
+    while (nextJob(job))
+    {
+        mLogBuf.reset();
+
+        int ret = execute(job);
+
+        // flush log stream
+        mLogStream << std::flush;
+
+        QString log = mLogBuf.takeTail();
+
+        if (!log.isEmpty())
+        {
+            qInfo().noquote() << Qt::endl << static_cast<const char*>(log.toUtf8());
+        }
+
+        if (priority(job.mStartup.mCmd) == Prio::NORMAL)
+        {
+            emit finished(false, ret);
+        }
+
+        emit cmdDone(job.mStartup.mCmd, ret);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      execute one job (worker thread)
+//!
+//! @param[in]  job   The job
+//!
+//! @return     0 -> success; else -> error
+//--------------------------------------------------------------------------
+int CNetMD::execute(const SJob& job)
 {
     int ret = 0;
+    const NetMDStartup& cmd = job.mStartup;
+
+    if ((cmd.mCmd != NetMDCmd::DISCINFO) && ((ret = initNetMdDevice()) != 0))
+    {
+        return ret;
+    }
 
-    switch(mCurrJob.mCmd)
+    switch(cmd.mCmd)
     {
     case NetMDCmd::DISCINFO:
         ret = getDiscInfo();
@@ -448,23 +1364,23 @@ void CNetMD::run()
     case NetMDCmd::WRITE_TRACK_SP_PREENC:
     case NetMDCmd::WRITE_TRACK_LP2:
     case NetMDCmd::WRITE_TRACK_LP4:
-        ret = writeTrack(mCurrJob.mCmd, mCurrJob.msTrack, mCurrJob.msTitle);
+        ret = writeTrack(cmd.mCmd, cmd.msTrack, cmd.msTitle);
         break;
 
     case NetMDCmd::ADD_GROUP:
-        ret = addGroup(mCurrJob.msGroup, mCurrJob.miFirst, mCurrJob.miLast);
+        ret = addGroup(cmd.msGroup, cmd.miFirst, cmd.miLast);
         break;
 
     case NetMDCmd::RENAME_DISC:
-        ret = renameDisc(mCurrJob.msTitle);
+        ret = renameDisc(cmd.msTitle);
         break;
 
     case NetMDCmd::RENAME_TRACK:
-        ret = renameTrack(mCurrJob.msTrack, mCurrJob.miFirst - 1);
+        ret = renameTrack(cmd.msTrack, cmd.miFirst - 1);
         break;
 
     case NetMDCmd::RENAME_GROUP:
-        ret = renameGroup(mCurrJob.msGroup, mCurrJob.miGroup);
+        ret = renameGroup(cmd.msGroup, cmd.miGroup);
         break;
 
     case NetMDCmd::ERASE_DISC:
@@ -472,15 +1388,28 @@ void CNetMD::run()
         break;
 
     case NetMDCmd::DEL_GROUP:
-        ret = delGroup(mCurrJob.miGroup);
+        ret = delGroup(cmd.miGroup);
         break;
 
     case NetMDCmd::DEL_TRACK:
-        ret = delTrack(mCurrJob.miFirst);
+        ret = delTrack(cmd.miFirst);
+        break;
+
+    case NetMDCmd::BULK_EDIT:
+        ret = bulkEdit(job.mEdit, !!cmd.miFirst);
+        break;
+
+    case NetMDCmd::TRACK_DETAILS:
+    case NetMDCmd::SCAN_DETAILS:
+        ret = trackDetails(cmd.miFirst, cmd.miLast, cmd.mCmd == NetMDCmd::SCAN_DETAILS);
+        break;
+
+    case NetMDCmd::VERIFY_TRACKS:
+        ret = verifyTracks(cmd.miFirst, cmd.miLast);
         break;
 
     case NetMDCmd::TOC_MANIP:
-        if (((ret = doTocManip(!!mCurrJob.miFirst)) == 0) && !!mCurrJob.miFirst)
+        if (((ret = doTocManip(job.mTocData, !!cmd.miFirst, job.mMono)) == 0) && !!cmd.miFirst)
         {
             ret = TOCMANIP_DEV_RESET;
         }
@@ -494,64 +1423,150 @@ void CNetMD::run()
     if (ret < 0)
     {
         qCritical() << "libnetmd action returned with error: " << ret;
+
+        // re-open device before next command
+        invalidateSession();
+    }
+    else if (ret == TOCMANIP_DEV_RESET)
+    {
+        // device was reset and re-enumerated
+        invalidateSession();
     }
 
-    if ((mCurrJob.mCmd == NetMDCmd::ERASE_DISC)
-        || (mCurrJob.mCmd == NetMDCmd::DEL_TRACK)
+    cacheEdit(job, ret);
+
+    // cached disc was changed locally, this only confirms it
+    if ((cmd.mCmd == NetMDCmd::ERASE_DISC)
+        || (cmd.mCmd == NetMDCmd::DEL_TRACK)
         || (ret == TOCMANIP_DEV_RESET)) // TOC edit successful, dev reset done
     {
         getDiscInfo();
     }
 
-    emit finished(false, ret);
+    return ret;
 }
 
-bool CNetMD::busy()
+//--------------------------------------------------------------------------
+//! @brief      apply finished edit to disc cache
+//!
+//! @param[in]  job   The job
+//! @param[in]  ret   return value of job
+//--------------------------------------------------------------------------
+void CNetMD::cacheEdit(const SJob& job, int ret)
 {
-    return QThread::isRunning();
+    const NetMDStartup& cmd = job.mStartup;
+
+    switch(cmd.mCmd)
+    {
+    case NetMDCmd::DISCINFO:
+    case NetMDCmd::TRACK_DETAILS:
+    case NetMDCmd::SCAN_DETAILS:
+    case NetMDCmd::VERIFY_TRACKS:
+        return;
+    default:
+        break;
+    }
+
+    if (ret != 0)
+    {
+        // failed edit or UTOC rewrite -> content unknown
+        mDiscCache.forget();
+        return;
+    }
+
+    switch(cmd.mCmd)
+    {
+    case NetMDCmd::WRITE_TRACK_SP:
+    case NetMDCmd::WRITE_TRACK_SP_MONO:
+    case NetMDCmd::WRITE_TRACK_SP_PREENC:
+    case NetMDCmd::WRITE_TRACK_LP2:
+    case NetMDCmd::WRITE_TRACK_LP4:
+        mDiscCache.tracksAdded();
+        break;
+
+    case NetMDCmd::RENAME_TRACK:
+        mDiscCache.renameTrack(cmd.miFirst - 1, cmd.msTrack);
+        break;
+
+    case NetMDCmd::BULK_EDIT:
+        for (auto it = job.mEdit.mTracks.constBegin(); it != job.mEdit.mTracks.constEnd(); it++)
+        {
+            mDiscCache.renameTrack(it.key(), it.value());
+        }
+        mDiscCache.titlesChanged();
+        break;
+
+    case NetMDCmd::ADD_GROUP:
+    case NetMDCmd::RENAME_DISC:
+    case NetMDCmd::RENAME_GROUP:
+    case NetMDCmd::DEL_GROUP:
+        // groups are stored in disc title
+        mDiscCache.titlesChanged();
+        break;
+
+    case NetMDCmd::DEL_TRACK:
+        mDiscCache.deleteTrack(cmd.miFirst);
+        break;
+
+    case NetMDCmd::ERASE_DISC:
+        mDiscCache.eraseDisc();
+        break;
+
+    default:
+        mDiscCache.forget();
+        break;
+    }
 }
 
-void CNetMD::extractPercent()
+//--------------------------------------------------------------------------
+//! @brief      is a normal priority command running or queued
+//!             (pending edits don't count)
+//!
+//! @return     true if busy
+//--------------------------------------------------------------------------
+bool CNetMD::busy()
 {
-    if (mfLog.isOpen())
+    QMutexLocker lock(&mQueueMtx);
+
+    if (!mbWorking)
     {
-        mLog += QString::fromUtf8(mfLog.readAll());
-        int pos;
+        return false;
+    }
 
-        if ((pos = mLog.lastIndexOf(QChar('%'))) > 0)
-        {
-            int startPos = mLog.lastIndexOf(QRegExp("[^0-9]+"), pos - 1);
+    if (mbCurrent && (priority(mCurrJob.mCmd) == Prio::NORMAL))
+    {
+        return true;
+    }
 
-            if (startPos > -1)
-            {
-                bool ok;
-                int length  = (pos - 1) - startPos;
-                int percent = mLog.mid(startPos + 1, length).toInt(&ok);
-
-                if (ok)
-                {
-                    emit progress(percent);
-                }
-            }
+    for (const auto& j : mQueue)
+    {
+        if (priority(j.mStartup.mCmd) == Prio::NORMAL)
+        {
+            return true;
         }
     }
+
+    return false;
 }
 
-void CNetMD::procEnded(bool, int)
+void CNetMD::extractPercent()
 {
-    mTReadLog.stop();
+    int percent = mLogBuf.percent();
 
-    // flush log stream
-    mLogStream << std::flush;
-
-    // read all content from log
-    if (mfLog.isOpen())
+    if ((percent > -1) && (percent != mLastPercent))
     {
-        mLog += QString::fromUtf8(mfLog.readAll());
+        mLastPercent = percent;
+        emit progress(percent);
     }
+}
+
+void CNetMD::procEnded()
+{
+    extractPercent();
 
-    if (!mLog.isEmpty())
+    // worker might have been restarted already
+    if (!isRunning())
     {
-        qInfo().noquote() << Qt::endl << static_cast<const char*>(mLog.toUtf8());
+        mTReadLog.stop();
     }
 }
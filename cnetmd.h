@@ -16,13 +16,107 @@
  */
 #pragma once
 #include <QThread>
-#include <QFile>
 #include <cstdio>
 #include <QTimer>
 #include <QByteArray>
+#include <QMutex>
+#include <QStringList>
+#include <QMap>
+#include <QList>
+#include <QVector>
 #include <netmd++.h>
-#include <fstream>
+#include <streambuf>
+#include <ostream>
+#include <string>
+#include <atomic>
 #include "ctocmanip.h"
+#include "cnetmddevice.h"
+#include "cdisccache.h"
+#include "cdiscsnapshot.h"
+#include "cusbhotplug.h"
+
+//------------------------------------------------------------------------------
+//! @brief      stream buffer for libnetmd++ logging: scans written data for
+//!             progress values and keeps the last lines in memory
+//------------------------------------------------------------------------------
+class CNetMDLogBuf : public std::streambuf
+{
+    /// number of lines kept for the log dump
+    static constexpr int TAIL_LINES = 200;
+
+    /// a line longer than this is cut
+    static constexpr std::size_t MAX_LINE_LENGTH = 4096;
+
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //--------------------------------------------------------------------------
+    CNetMDLogBuf();
+
+    //--------------------------------------------------------------------------
+    //! @brief      last progress value found in log (thread safe)
+    //!
+    //! @return     percent; -1 if there was none
+    //--------------------------------------------------------------------------
+    int percent() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get (and clear) the log tail
+    //!
+    //! @return     last log lines, separated by new line
+    //--------------------------------------------------------------------------
+    QString takeTail();
+
+    //--------------------------------------------------------------------------
+    //! @brief      forget progress and log
+    //--------------------------------------------------------------------------
+    void reset();
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      write one character
+    //!
+    //! @param[in]  c     character
+    //!
+    //! @return     c or eof
+    //--------------------------------------------------------------------------
+    int_type overflow(int_type c) override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      write a character sequence
+    //!
+    //! @param[in]  s     sequence
+    //! @param[in]  n     length
+    //!
+    //! @return     written characters
+    //--------------------------------------------------------------------------
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      handle one character (mutex must be locked)
+    //!
+    //! @param[in]  c     character
+    //--------------------------------------------------------------------------
+    void put(char c);
+
+    //--------------------------------------------------------------------------
+    //! @brief      move current line into tail (mutex must be locked)
+    //--------------------------------------------------------------------------
+    void endLine();
+
+    /// last progress value
+    std::atomic<int> mPercent;
+
+    /// current (not terminated) line
+    std::string mLine;
+
+    /// last lines
+    QStringList mTail;
+
+    /// guards line and tail
+    QMutex mMtx;
+};
 
 //------------------------------------------------------------------------------
 //! @brief      This class describes net md handling.
@@ -31,25 +125,24 @@ class CNetMD : public QThread
 {
     Q_OBJECT
 public:
-    static constexpr const char* EMPTY_JSON_RESP = R"({
-    "device": "unknown",
-    "disc_flags": "0x00",
-    "groups": [],
-    "otf_enc": 0,
-    "sp_upload": 0,
-    "toc_manip": 0,
-    "pcm2mono": 0,
-    "t_free": 0,
-    "t_total": 0,
-    "t_used": 0,
-    "title": "No disc / NetMD device found!",
-    "tracks": [],
-    "trk_count": 0
-})";
-
     /// special marker for TOC edit done + device reset done
     static constexpr int TOCMANIP_DEV_RESET = 999;
 
+    /// bulk edits with at least this many changes are written through UTOC
+    static constexpr int BULK_UTOC_MIN = 8;
+
+    /// tracks sent per batch while disc info is loaded
+    static constexpr int TRACK_BATCH = 16;
+
+    /// device capabilities (probed once per device)
+    struct SDevCaps
+    {
+        bool mOtfEnc;       ///< on-the-fly encoding
+        bool mTocManip;     ///< TOC manipulation
+        bool mSpUpload;     ///< SP upload
+        bool mPcm2Mono;     ///< PCM to mono patch
+    };
+
     using TocData = CTocManip::TitleVector;
 
     /// actions to be done on NetMD
@@ -69,9 +162,21 @@ public:
         ERASE_DISC,            ///< erase disc
         DEL_TRACK,             ///< delete track
         TOC_MANIP,             ///< TOC manipulation
+        BULK_EDIT,             ///< staged title / group edits
+        TRACK_DETAILS,         ///< protection / time of some tracks (shown rows)
+        SCAN_DETAILS,          ///< protection / time of all tracks (background)
+        VERIFY_TRACKS,         ///< re-read titles / modes of cached tracks (background)
         UNKNWON                ///< something different
     };
 
+    /// command priority in queue
+    enum class Prio : uint8_t
+    {
+        HIGH,       ///< short interactive edits, run before pending transfers
+        NORMAL,     ///< transfers and other long running commands
+        LOW         ///< background work, runs if nothing else is queued
+    };
+
     //--------------------------------------------------------------------------
     //! @brief      startup data structure
     //--------------------------------------------------------------------------
@@ -104,12 +209,76 @@ public:
         int16_t  miGroup;   ///< group id
     };
 
+    /// track data as shown in disc info
+    struct STrackData
+    {
+        std::string            mTitle;     ///< raw title
+        netmd::AudioEncoding   mEnc;       ///< encoding
+        uint8_t                mChannel;   ///< channel count (1 -> mono)
+        netmd::TrackProtection mProt;      ///< protection
+        netmd::TrackTime       mTime;      ///< play time
+    };
+
+    /// all tracks on disc
+    using TrackVector = QVector<STrackData>;
+
+    /// group to be created
+    struct SGroupAdd
+    {
+        QString mName;      ///< group name
+        int16_t mFirst;     ///< first track (1 based)
+        int16_t mLast;      ///< last track (1 based)
+    };
+
+    /// staged MD edits, committed in one go
+    struct SBulkEdit
+    {
+        bool               mbDiscTitle;  ///< disc title changed
+        QString            mDiscTitle;   ///< new disc title
+        QMap<int, QString> mTracks;      ///< track number (0 based) -> new title
+        QMap<int, QString> mGroupNames;  ///< group number -> new name
+        QVector<SGroupAdd> mNewGroups;   ///< groups to create
+
+        //----------------------------------------------------------------------
+        //! @brief      number of staged changes
+        //!
+        //! @return     change count
+        //----------------------------------------------------------------------
+        int count() const
+        {
+            return (mbDiscTitle ? 1 : 0) + mTracks.size() + mGroupNames.size() + mNewGroups.size();
+        }
+
+        //----------------------------------------------------------------------
+        //! @brief      drop all staged changes
+        //----------------------------------------------------------------------
+        void clear()
+        {
+            mbDiscTitle = false;
+            mDiscTitle.clear();
+            mTracks.clear();
+            mGroupNames.clear();
+            mNewGroups.clear();
+        }
+    };
+
+    /// queued command
+    struct SJob
+    {
+        NetMDStartup mStartup;  ///< command and its parameters
+        TocData      mTocData;  ///< data for TOC manipulation
+        bool         mMono;     ///< mono flag for TOC manipulation
+        SBulkEdit    mEdit;     ///< staged edits
+    };
+
     //--------------------------------------------------------------------------
     //! @brief      Constructs a new instance.
     //!
     //! @param      parent  The parent
+    //! @param      dev     device backend (optional, CNetMD takes ownership;
+    //!                     chosen through environment if not given)
     //--------------------------------------------------------------------------
-    explicit CNetMD(QObject *parent = nullptr);
+    explicit CNetMD(QObject *parent = nullptr, CNetMdDevice* dev = nullptr);
     
     //--------------------------------------------------------------------------
     //! @brief      Destroys the object.
@@ -117,14 +286,14 @@ public:
     virtual ~CNetMD();
 
     //--------------------------------------------------------------------------
-    //! @brief      store data, start thread
+    //! @brief      queue command, start thread if needed
     //!
     //! @param[in]  startup  The startup structure
     //--------------------------------------------------------------------------
     void start(NetMDStartup startup);
 
     //--------------------------------------------------------------------------
-    //! @brief      store data, start thread
+    //! @brief      queue TOC manipulation, start thread if needed
     //!
     //! @param[in]  tocData  TOC data for manipulation
     //! @param[in]  resetDev reset device after TOC edit
@@ -133,47 +302,105 @@ public:
     void start(const TocData& tocData, bool resetDev, bool mono = false);
 
     //--------------------------------------------------------------------------
-    //! @brief      thread function
+    //! @brief      queue staged edits, start thread if needed
+    //!
+    //! @param[in]  edit      staged edits
+    //! @param[in]  resetDev  device may be reset after TOC edit
+    //--------------------------------------------------------------------------
+    void start(const SBulkEdit& edit, bool resetDev);
+
+    //--------------------------------------------------------------------------
+    //! @brief      thread function: works off the command queue
     //--------------------------------------------------------------------------
     void run() override;
 
     //--------------------------------------------------------------------------
-    //! @brief      is thread running
+    //! @brief      is a normal priority command running or queued
+    //!             (pending edits don't count)
     //!
-    //! @return     true if running (busy)
+    //! @return     true if busy
     //--------------------------------------------------------------------------
     bool busy();
 
+    //--------------------------------------------------------------------------
+    //! @brief      remove all queued normal priority commands
+    //!             (the running one isn't affected)
+    //!
+    //! @return     number of removed commands
+    //--------------------------------------------------------------------------
+    int dropPending();
+
+    //--------------------------------------------------------------------------
+    //! @brief      queue priority of a command
+    //!
+    //! @param[in]  cmd   The command
+    //!
+    //! @return     priority
+    //--------------------------------------------------------------------------
+    static Prio priority(NetMDCmd cmd);
+
+    //--------------------------------------------------------------------------
+    //! @brief      watch USB bus for NetMD devices
+    //!
+    //! @return     0 -> ok; -1 -> hotplug not supported
+    //--------------------------------------------------------------------------
+    int watchDevices();
+
+    //--------------------------------------------------------------------------
+    //! @brief      force re-init of device before next command (thread safe)
+    //--------------------------------------------------------------------------
+    void invalidateSession();
+
+    //--------------------------------------------------------------------------
+    //! @brief      allow UTOC scan on disc load (thread safe, default: on);
+    //!             the scan only reads and always leaves TOC edit mode
+    //!
+    //! @param[in]  ena   enable / disable
+    //--------------------------------------------------------------------------
+    void setUtocScan(bool ena);
+
 private slots:
     //--------------------------------------------------------------------------
     //! @brief      the thread ended
-    //!
-    //! @param[in]  <unnamed>
-    //! @param[in]  <unnamed>
     //--------------------------------------------------------------------------
-    void procEnded(bool, int);
+    void procEnded();
     
     //--------------------------------------------------------------------------
-    //! @brief      extract percent from log
+    //! @brief      sample progress from log buffer
     //--------------------------------------------------------------------------
     void extractPercent();
 
 signals:
     
     //--------------------------------------------------------------------------
-    //! @brief      signal json data
+    //! @brief      signal disc info (header and groups, tracks follow)
     //!
-    //! @param[in]  <unnamed>  json data as string
+    //! @param[in]  <unnamed>  disc snapshot
+    //--------------------------------------------------------------------------
+    void discOut(SDiscSnapshot);
+
     //--------------------------------------------------------------------------
-    void jsonOut(QString);
+    //! @brief      signal track data (sent in batches after discOut())
+    //!
+    //! @param[in]  <unnamed>  snapshot holding (partial) tracks only
+    //--------------------------------------------------------------------------
+    void tracksOut(SDiscSnapshot);
     
     //--------------------------------------------------------------------------
-    //! @brief      signal that thread finished
+    //! @brief      signal that a normal priority command finished
     //!
     //! @param[in]  <unnamed>  false 
     //! @param[in]  <unnamed>  return value of last action
     //--------------------------------------------------------------------------
     void finished(bool, int);
+
+    //--------------------------------------------------------------------------
+    //! @brief      signal that a command (any priority) finished
+    //!
+    //! @param[in]  cmd   The command
+    //! @param[in]  ret   return value of command
+    //--------------------------------------------------------------------------
+    void cmdDone(CNetMD::NetMDCmd cmd, int ret);
     
     //--------------------------------------------------------------------------
     //! @brief      signal thread progress in percent
@@ -182,12 +409,24 @@ signals:
     //--------------------------------------------------------------------------
     void progress(int);
 
+    //--------------------------------------------------------------------------
+    //! @brief      NetMD device was plugged in
+    //--------------------------------------------------------------------------
+    void deviceArrived();
+
+    //--------------------------------------------------------------------------
+    //! @brief      NetMD device was removed
+    //--------------------------------------------------------------------------
+    void deviceLeft();
+
 protected:
 
     //--------------------------------------------------------------------------
-    //! @brief init the NetMD device
+    //! @brief init the NetMD device (if there is no open session)
+    //!
+    //! @return 0 -> success; else -> error
     //--------------------------------------------------------------------------
-    void initNetMdDevice();
+    int initNetMdDevice();
 
     //--------------------------------------------------------------------------
     //! @brief      get MD disc info
@@ -196,6 +435,66 @@ protected:
     //--------------------------------------------------------------------------
     int getDiscInfo();
 
+    //--------------------------------------------------------------------------
+    //! @brief      get titles and modes through per track queries (sent in
+    //!             batches)
+    //!
+    //! @param[in]  first first track to query (0-based)
+    //! @param[in]  tc    track count
+    //!
+    //! @return     0 -> success; else -> error
+    //--------------------------------------------------------------------------
+    int queryTracks(int first, int tc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      compare cached titles / modes with device, send changes
+    //!
+    //! @param[in]  first  first track (0-based)
+    //! @param[in]  last   last track (0-based)
+    //!
+    //! @return     0 -> success; else -> error
+    //--------------------------------------------------------------------------
+    int verifyTracks(int first, int last);
+
+    //--------------------------------------------------------------------------
+    //! @brief      read protection / time of tracks not read so far
+    //!
+    //! @param[in]  first       first track (0-based)
+    //! @param[in]  last        last track (0-based)
+    //! @param[in]  background  yield to other jobs after each batch
+    //!
+    //! @return     0 -> success; else -> error
+    //--------------------------------------------------------------------------
+    int trackDetails(int first, int last, bool background);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add track to batch
+    //!
+    //! @param      batch   The batch
+    //! @param[in]  no      track number (0-based)
+    //! @param[in]  td      track data
+    //! @param[in]  fields  fields to add (SDiscSnapshot::TrackField flags)
+    //--------------------------------------------------------------------------
+    static void addTrack(SDiscSnapshot& batch, int no, const STrackData& td, int fields);
+
+    //--------------------------------------------------------------------------
+    //! @brief      send track batch (if not empty) and start a new one
+    //!
+    //! @param      batch  The batch
+    //--------------------------------------------------------------------------
+    void emitTracks(SDiscSnapshot& batch);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track data from UTOC scan
+    //!
+    //! @param[in]  tc          track count
+    //! @param[in]  scan        tracks found in UTOC
+    //! @param[out] trackData   track data
+    //!
+    //! @return     0 -> success; else -> error (use queryTracks())
+    //--------------------------------------------------------------------------
+    int scanTracks(int tc, const CTocManip::ScanVector& scan, TrackVector& trackData);
+
     //--------------------------------------------------------------------------
     //! @brief write audio track to MD
     //!
@@ -275,11 +574,75 @@ protected:
     //--------------------------------------------------------------------------
     //! @brief do TOC manipulation
     //!
+    //! @param[in]  tocData  TOC data for manipulation
     //! @param[in]  resetDev reset device after TOC edit
+    //! @param[in]  mono     mono flag for TOC edit
     //!
     //! @return 0 -> success; else -> error
     //--------------------------------------------------------------------------
-    int doTocManip(bool devReset);
+    int doTocManip(const TocData& tocData, bool devReset, bool mono);
+
+    //--------------------------------------------------------------------------
+    //! @brief      commit staged edits: many edits through one UTOC rewrite
+    //!             (if possible), else through single API calls
+    //!
+    //! @param[in]  edit      staged edits
+    //! @param[in]  resetDev  device may be reset after TOC edit
+    //!
+    //! @return     0 -> success; TOCMANIP_DEV_RESET; else -> error
+    //--------------------------------------------------------------------------
+    int bulkEdit(const SBulkEdit& edit, bool resetDev);
+
+    //--------------------------------------------------------------------------
+    //! @brief      write staged edits through UTOC title sector
+    //!
+    //! @param[in]  edit      staged edits
+    //! @param[in]  resetDev  reset device after TOC edit
+    //! @param[out] written   true if UTOC was written
+    //!
+    //! @return     0 -> success; TOCMANIP_DEV_RESET; else -> error
+    //--------------------------------------------------------------------------
+    int bulkEditUtoc(const SBulkEdit& edit, bool resetDev, bool& written);
+
+    //--------------------------------------------------------------------------
+    //! @brief      apply finished edit to disc cache
+    //!
+    //! @param[in]  job   The job
+    //! @param[in]  ret   return value of job
+    //--------------------------------------------------------------------------
+    void cacheEdit(const SJob& job, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      are more jobs queued (background jobs don't count)
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool jobsPending();
+
+    //--------------------------------------------------------------------------
+    //! @brief      add job to queue (behind all jobs with same or higher prio)
+    //!
+    //! @param[in]  job   The job
+    //--------------------------------------------------------------------------
+    void enqueue(const SJob& job);
+
+    //--------------------------------------------------------------------------
+    //! @brief      take next job from queue (worker thread)
+    //!
+    //! @param[out] job   The job
+    //!
+    //! @return     false if queue is empty (worker ends)
+    //--------------------------------------------------------------------------
+    bool nextJob(SJob& job);
+
+    //--------------------------------------------------------------------------
+    //! @brief      execute one job (worker thread)
+    //!
+    //! @param[in]  job   The job
+    //!
+    //! @return     0 -> success; else -> error
+    //--------------------------------------------------------------------------
+    int execute(const SJob& job);
 
     //--------------------------------------------------------------------------
     //! @brief netmd_time to time_t
@@ -296,30 +659,54 @@ protected:
     /// current job description
     NetMDStartup mCurrJob;
 
-    /// data for TOC manipulation
-    TocData mTocData;
-    
-    /// log file name
-    QString mNameFLog;
-    
-    /// log file pointer
-    std::ofstream mLogStream;
-    
-    /// log file
-    QFile mfLog;
-    
-    /// log content
-    QString mLog;
-    
-    /// cyclic log parce trigger
+    /// pending jobs
+    QList<SJob> mQueue;
+
+    /// guards queue and worker state
+    QMutex mQueueMtx;
+
+    /// worker thread works off the queue
+    bool mbWorking;
+
+    /// a job is executed right now
+    bool mbCurrent;
+
+    /// protection / time read for track (worker thread only)
+    QVector<bool> mDetailsDone;
+
+    /// track lists of known discs (worker thread only)
+    CDiscCache mDiscCache;
+
+    /// receives libnetmd++ log output
+    CNetMDLogBuf mLogBuf;
+
+    /// log stream on top of log buffer
+    std::ostream mLogStream;
+
+    /// cyclic progress sample trigger
     QTimer mTReadLog;
 
+    /// last signaled progress
+    int mLastPercent;
+
     /// NetMD device name
     QString mDevName;
 
-    /// NetMD API
-    netmd::netmd_pp* mpApi;
+    /// NetMD device (real or simulated)
+    CNetMdDevice* mpApi;
+
+    /// device session is open and usable
+    std::atomic<bool> mbSessionOk;
+
+    /// UTOC scan on disc load enabled
+    std::atomic<bool> mbUtocScan;
+
+    /// capabilities of current device
+    SDevCaps mCaps;
+
+    /// device name -> capabilities
+    QMap<QString, SDevCaps> mCapsCache;
 
-    /// mono flag
-    bool mMono;
+    /// USB hotplug watcher
+    CUsbHotplug* mpHotplug;
 };
@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cnetmddevice.h"
+
+using namespace netmd;
+
+// Plain forwarders to libnetmd++, see CNetMdDevice for documentation.
+
+void CNetMdHwDevice::setLogStream(std::ostream& os)
+{
+    netmd_pp::setLogStream(os);
+}
+
+void CNetMdHwDevice::setLogLevel(int severity)
+{
+    netmd_pp::setLogLevel(severity);
+}
+
+int CNetMdHwDevice::initDevice()
+{
+    return mApi.initDevice();
+}
+
+std::string CNetMdHwDevice::getDeviceName() const
+{
+    return mApi.getDeviceName();
+}
+
+int CNetMdHwDevice::trackCount()
+{
+    return mApi.trackCount();
+}
+
+int CNetMdHwDevice::discFlags()
+{
+    return mApi.discFlags();
+}
+
+int CNetMdHwDevice::eraseDisc()
+{
+    return mApi.eraseDisc();
+}
+
+int CNetMdHwDevice::trackTime(int trackNo, TrackTime& trackTime)
+{
+    return mApi.trackTime(trackNo, trackTime);
+}
+
+int CNetMdHwDevice::discTitle(std::string& title)
+{
+    return mApi.discTitle(title);
+}
+
+int CNetMdHwDevice::setDiscTitle(const std::string& title)
+{
+    return mApi.setDiscTitle(title);
+}
+
+int CNetMdHwDevice::setGroupTitle(uint16_t group, const std::string& title)
+{
+    return mApi.setGroupTitle(group, title);
+}
+
+int CNetMdHwDevice::createGroup(const std::string& title, int first, int last)
+{
+    return mApi.createGroup(title, first, last);
+}
+
+int CNetMdHwDevice::deleteGroup(int group)
+{
+    return mApi.deleteGroup(group);
+}
+
+int CNetMdHwDevice::deleteTrack(uint16_t track)
+{
+    return mApi.deleteTrack(track);
+}
+
+int CNetMdHwDevice::trackBitRate(uint16_t track, AudioEncoding& encoding, uint8_t& channel)
+{
+    return mApi.trackBitRate(track, encoding, channel);
+}
+
+int CNetMdHwDevice::trackFlags(uint16_t track, TrackProtection& flags)
+{
+    return mApi.trackFlags(track, flags);
+}
+
+int CNetMdHwDevice::trackTitle(uint16_t track, std::string& title)
+{
+    return mApi.trackTitle(track, title);
+}
+
+bool CNetMdHwDevice::spUploadSupported()
+{
+    return mApi.spUploadSupported();
+}
+
+bool CNetMdHwDevice::otfEncodeSupported()
+{
+    return mApi.otfEncodeSupported();
+}
+
+bool CNetMdHwDevice::tocManipSupported()
+{
+    return mApi.tocManipSupported();
+}
+
+bool CNetMdHwDevice::pcm2MonoSupported()
+{
+    return mApi.pcm2MonoSupported();
+}
+
+int CNetMdHwDevice::enablePcm2Mono()
+{
+    return mApi.enablePcm2Mono();
+}
+
+void CNetMdHwDevice::disablePcm2Mono()
+{
+    mApi.disablePcm2Mono();
+}
+
+int CNetMdHwDevice::sendAudioFile(const std::string& filename, const std::string& title, DiskFormat otf)
+{
+    return mApi.sendAudioFile(filename, title, otf);
+}
+
+int CNetMdHwDevice::setTrackTitle(uint16_t trackNo, const std::string& title)
+{
+    return mApi.setTrackTitle(trackNo, title);
+}
+
+int CNetMdHwDevice::discCapacity(DiscCapacity& dcap)
+{
+    return mApi.discCapacity(dcap);
+}
+
+Groups CNetMdHwDevice::groups()
+{
+    return mApi.groups();
+}
+
+int CNetMdHwDevice::prepareTOCManip()
+{
+    return mApi.prepareTOCManip();
+}
+
+NetMDByteVector CNetMdHwDevice::readUTOCSector(UTOCSector s)
+{
+    return mApi.readUTOCSector(s);
+}
+
+int CNetMdHwDevice::writeUTOCSector(UTOCSector s, const NetMDByteVector& data)
+{
+    return mApi.writeUTOCSector(s, data);
+}
+
+int CNetMdHwDevice::finalizeTOC(bool reset, uint8_t resetWait)
+{
+    return mApi.finalizeTOC(reset, resetWait);
+}
@@ -0,0 +1,315 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <netmd++.h>
+#include <ostream>
+#include <string>
+
+//------------------------------------------------------------------------------
+//! @brief      Abstract NetMD device. Mirrors the part of the libnetmd++ API
+//!             used by this program, so the real device can be replaced by
+//!             a simulator (or anything else talking the same language).
+//------------------------------------------------------------------------------
+class CNetMdDevice
+{
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object.
+    //--------------------------------------------------------------------------
+    virtual ~CNetMdDevice() {}
+
+    //--------------------------------------------------------------------------
+    //! @brief      set log stream for device / library messages
+    //!
+    //! @param      os    The output stream
+    //--------------------------------------------------------------------------
+    virtual void setLogStream(std::ostream& os) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set log level
+    //!
+    //! @param[in]  severity  The severity (netmd::typelog)
+    //--------------------------------------------------------------------------
+    virtual void setLogLevel(int severity) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      open / initialize device
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int initDevice() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get device name
+    //!
+    //! @return     device name
+    //--------------------------------------------------------------------------
+    virtual std::string getDeviceName() const = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get number of tracks
+    //!
+    //! @return     < 0 -> NetMdErr; else -> track count
+    //--------------------------------------------------------------------------
+    virtual int trackCount() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get disc flags
+    //!
+    //! @return     < 0 -> NetMdErr; else -> flags
+    //--------------------------------------------------------------------------
+    virtual int discFlags() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      erase disc
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int eraseDisc() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track time
+    //!
+    //! @param[in]  trackNo    The track number (0-based)
+    //! @param[out] trackTime  The track time
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int trackTime(int trackNo, netmd::TrackTime& trackTime) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get disc title (without group header)
+    //!
+    //! @param[out] title  The title
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int discTitle(std::string& title) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set disc title
+    //!
+    //! @param[in]  title  The title
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int setDiscTitle(const std::string& title) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set group title
+    //!
+    //! @param[in]  group  The group number
+    //! @param[in]  title  The title
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int setGroupTitle(uint16_t group, const std::string& title) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      create group
+    //!
+    //! @param[in]  title  The title
+    //! @param[in]  first  The first track
+    //! @param[in]  last   The last track
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int createGroup(const std::string& title, int first, int last) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      delete group
+    //!
+    //! @param[in]  group  The group number
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int deleteGroup(int group) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      delete track
+    //!
+    //! @param[in]  track  The track number (0-based)
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int deleteTrack(uint16_t track) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track encoding
+    //!
+    //! @param[in]  track     The track number (0-based)
+    //! @param[out] encoding  The encoding
+    //! @param[out] channel   The channel count
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int trackBitRate(uint16_t track, netmd::AudioEncoding& encoding, uint8_t& channel) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track protection flags
+    //!
+    //! @param[in]  track  The track number (0-based)
+    //! @param[out] flags  The flags
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int trackFlags(uint16_t track, netmd::TrackProtection& flags) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track title
+    //!
+    //! @param[in]  track  The track number (0-based)
+    //! @param[out] title  The title
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int trackTitle(uint16_t track, std::string& title) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      device capabilities
+    //!
+    //! @return     true if supported
+    //--------------------------------------------------------------------------
+    virtual bool spUploadSupported() = 0;
+    virtual bool otfEncodeSupported() = 0;
+    virtual bool tocManipSupported() = 0;
+    virtual bool pcm2MonoSupported() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      enable / disable PCM to mono conversion
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int enablePcm2Mono() = 0;
+    virtual void disablePcm2Mono() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      send audio file to device
+    //!
+    //! @param[in]  filename  The file name
+    //! @param[in]  title     The track title
+    //! @param[in]  otf       on-the-fly encoding format
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int sendAudioFile(const std::string& filename, const std::string& title, netmd::DiskFormat otf) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set track title
+    //!
+    //! @param[in]  trackNo  The track number (0-based)
+    //! @param[in]  title    The title
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int setTrackTitle(uint16_t trackNo, const std::string& title) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get disc capacity
+    //!
+    //! @param[out] dcap  The capacity
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int discCapacity(netmd::DiscCapacity& dcap) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get groups (entry with first track 0 is the disc)
+    //!
+    //! @return     groups
+    //--------------------------------------------------------------------------
+    virtual netmd::Groups groups() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      prepare UTOC access
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int prepareTOCManip() = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      read UTOC sector
+    //!
+    //! @param[in]  s     The sector
+    //!
+    //! @return     sector data (empty on error)
+    //--------------------------------------------------------------------------
+    virtual netmd::NetMDByteVector readUTOCSector(netmd::UTOCSector s) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      write UTOC sector
+    //!
+    //! @param[in]  s     The sector
+    //! @param[in]  data  The data
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int writeUTOCSector(netmd::UTOCSector s, const netmd::NetMDByteVector& data) = 0;
+
+    //--------------------------------------------------------------------------
+    //! @brief      finalize UTOC edit
+    //!
+    //! @param[in]  reset      reset device
+    //! @param[in]  resetWait  wait time after reset (seconds)
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    virtual int finalizeTOC(bool reset = false, uint8_t resetWait = 15) = 0;
+};
+
+//------------------------------------------------------------------------------
+//! @brief      The real thing: NetMD device accessed through libnetmd++
+//------------------------------------------------------------------------------
+class CNetMdHwDevice : public CNetMdDevice
+{
+public:
+    void setLogStream(std::ostream& os) override;
+    void setLogLevel(int severity) override;
+    int initDevice() override;
+    std::string getDeviceName() const override;
+    int trackCount() override;
+    int discFlags() override;
+    int eraseDisc() override;
+    int trackTime(int trackNo, netmd::TrackTime& trackTime) override;
+    int discTitle(std::string& title) override;
+    int setDiscTitle(const std::string& title) override;
+    int setGroupTitle(uint16_t group, const std::string& title) override;
+    int createGroup(const std::string& title, int first, int last) override;
+    int deleteGroup(int group) override;
+    int deleteTrack(uint16_t track) override;
+    int trackBitRate(uint16_t track, netmd::AudioEncoding& encoding, uint8_t& channel) override;
+    int trackFlags(uint16_t track, netmd::TrackProtection& flags) override;
+    int trackTitle(uint16_t track, std::string& title) override;
+    bool spUploadSupported() override;
+    bool otfEncodeSupported() override;
+    bool tocManipSupported() override;
+    bool pcm2MonoSupported() override;
+    int enablePcm2Mono() override;
+    void disablePcm2Mono() override;
+    int sendAudioFile(const std::string& filename, const std::string& title, netmd::DiskFormat otf) override;
+    int setTrackTitle(uint16_t trackNo, const std::string& title) override;
+    int discCapacity(netmd::DiscCapacity& dcap) override;
+    netmd::Groups groups() override;
+    int prepareTOCManip() override;
+    netmd::NetMDByteVector readUTOCSector(netmd::UTOCSector s) override;
+    int writeUTOCSector(netmd::UTOCSector s, const netmd::NetMDByteVector& data) override;
+    int finalizeTOC(bool reset = false, uint8_t resetWait = 15) override;
+
+private:
+    /// libnetmd++ API
+    netmd::netmd_pp mApi;
+};
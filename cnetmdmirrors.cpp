@@ -0,0 +1,401 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cnetmdmirrors.h"
+#include "cnetmdsim.h"
+#include "cnetmdtrace.h"
+#include <QFile>
+#include <QtDebug>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param[in]  spec    ';' separated mirror backends (empty: no mirrors)
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CNetMdMirrors::CNetMdMirrors(const QString& spec, QObject* parent)
+    : QObject(parent)
+{
+    // libnetmd++ only talks to the first NetMD device found,
+    // so mirrors use software backends for now
+    for (const auto& m : spec.split(';', QString::SkipEmptyParts))
+    {
+        QString        type = m.section(':', 0, 0).trimmed().toLower();
+        QString        arg  = m.section(':', 1);
+        CNetMdDevice*  pDev = nullptr;
+
+        if (type == "sim")
+        {
+            pDev = new CNetMdSimDevice(CNetMdSimDevice::parseConfig(arg));
+        }
+        else if (type == "replay")
+        {
+            bool   ok;
+            double scale = qgetenv("NETMD_WIZARD_REPLAY_SCALE").toDouble(&ok);
+            pDev = new CNetMdReplayDevice(arg, ok ? scale : 1.0);
+        }
+        else
+        {
+            qWarning() << "Unknown mirror backend" << m;
+            continue;
+        }
+
+        int      idx = mMirrors.size();
+        CNetMD*  pMd = new CNetMD(this, pDev);
+
+        connect(pMd, &CNetMD::progress, this, [this, idx](int percent) {
+            emit progress(idx, percent);
+        });
+
+        connect(pMd, &CNetMD::finished, this, [this, idx](bool, int ret) {
+            jobDone(idx, ret);
+        });
+
+        // title edits are high priority commands without finished()
+        connect(pMd, &CNetMD::cmdDone, this, [this, idx](CNetMD::NetMDCmd cmd, int ret) {
+            if (cmd == CNetMD::NetMDCmd::BULK_EDIT)
+            {
+                editDone(idx, ret);
+            }
+        });
+
+        CNetMD::SBulkEdit edit;
+        edit.clear();
+        mMirrors.append({pMd, false, QStringList(), edit, false, false});
+        qInfo() << "Mirror recorder" << idx << "uses" << m;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object.
+//--------------------------------------------------------------------------
+CNetMdMirrors::~CNetMdMirrors()
+{
+    for (auto& m : mMirrors)
+    {
+        m.mpNetMD->dropPending();
+        m.mpNetMD->wait();
+
+        for (const auto& f : m.mJobs)
+        {
+            release(f);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of mirrors
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CNetMdMirrors::count() const
+{
+    return mMirrors.size();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      queue track transfer on all working mirrors
+//!
+//! @param[in]  startup  transfer command as sent to the main recorder
+//--------------------------------------------------------------------------
+void CNetMdMirrors::transfer(const CNetMD::NetMDStartup& startup)
+{
+    int users = 0;
+
+    for (const auto& m : mMirrors)
+    {
+        if (!m.mbFailed)
+        {
+            users++;
+        }
+    }
+
+    if (users == 0)
+    {
+        return;
+    }
+
+    QString copy = share(startup.msTrack, users);
+
+    for (int i = 0; i < mMirrors.size(); i++)
+    {
+        SMirror& m = mMirrors[i];
+
+        if (m.mbFailed)
+        {
+            continue;
+        }
+
+        if (copy.isEmpty())
+        {
+            // without file the mirror would miss a track
+            drop(i, netmd::NETMDERR_OTHER);
+            continue;
+        }
+
+        CNetMD::NetMDStartup s = startup;
+        s.msTrack = copy;
+        m.mJobs.append(copy);
+        m.mpNetMD->start(s);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      queue TOC edit on all working mirrors
+//!             (runs after the mirror's own transfer)
+//!
+//! @param[in]  tocData   TOC data for manipulation
+//! @param[in]  resetDev  reset device after TOC edit
+//! @param[in]  mono      mono flag for TOC edit
+//--------------------------------------------------------------------------
+void CNetMdMirrors::tocEdit(const CNetMD::TocData& tocData, bool resetDev, bool mono)
+{
+    for (auto& m : mMirrors)
+    {
+        if (!m.mbFailed)
+        {
+            m.mJobs.append(QString());
+            m.mpNetMD->start(tocData, resetDev, mono);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      queue disc title / group edits on all working mirrors
+//!             (sent when the mirror's own transfers are done)
+//!
+//! @param[in]  edit      staged edits as sent to the main recorder
+//! @param[in]  resetDev  device may be reset after TOC edit
+//--------------------------------------------------------------------------
+void CNetMdMirrors::titleEdit(const CNetMD::SBulkEdit& edit, bool resetDev)
+{
+    if (edit.count() == 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < mMirrors.size(); i++)
+    {
+        SMirror& m = mMirrors[i];
+
+        if (m.mbFailed)
+        {
+            continue;
+        }
+
+        // edits are high priority, they mustn't overtake the transfers
+        if (edit.mbDiscTitle)
+        {
+            m.mEdit.mbDiscTitle = true;
+            m.mEdit.mDiscTitle  = edit.mDiscTitle;
+        }
+
+        for (auto it = edit.mTracks.constBegin(); it != edit.mTracks.constEnd(); it++)
+        {
+            m.mEdit.mTracks.insert(it.key(), it.value());
+        }
+
+        for (auto it = edit.mGroupNames.constBegin(); it != edit.mGroupNames.constEnd(); it++)
+        {
+            m.mEdit.mGroupNames.insert(it.key(), it.value());
+        }
+
+        m.mEdit.mNewGroups += edit.mNewGroups;
+        m.mbResetDev        = resetDev;
+
+        if (m.mJobs.isEmpty())
+        {
+            idle(i);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      has any mirror queued work
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CNetMdMirrors::busy() const
+{
+    for (const auto& m : mMirrors)
+    {
+        if (!m.mJobs.isEmpty() || m.mbEditing || (m.mEdit.count() > 0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      a mirror job has finished
+//!
+//! @param[in]  idx   mirror index
+//! @param[in]  ret   return value
+//--------------------------------------------------------------------------
+void CNetMdMirrors::jobDone(int idx, int ret)
+{
+    SMirror& m = mMirrors[idx];
+
+    if (!m.mJobs.isEmpty())
+    {
+        release(m.mJobs.takeFirst());
+    }
+
+    if (m.mbFailed)
+    {
+        // job which was running when the mirror was dropped
+        return;
+    }
+
+    if (ret < 0)
+    {
+        drop(idx, ret);
+    }
+    else if (m.mJobs.isEmpty())
+    {
+        idle(idx);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      a mirror title edit has finished
+//!
+//! @param[in]  idx   mirror index
+//! @param[in]  ret   return value
+//--------------------------------------------------------------------------
+void CNetMdMirrors::editDone(int idx, int ret)
+{
+    SMirror& m = mMirrors[idx];
+
+    if (!m.mbEditing || m.mbFailed)
+    {
+        return;
+    }
+
+    m.mbEditing = false;
+
+    if (ret < 0)
+    {
+        drop(idx, ret);
+    }
+    else if (m.mJobs.isEmpty())
+    {
+        idle(idx);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      send waiting title edits if no other job is queued,
+//!             signal done if nothing is left
+//!
+//! @param[in]  idx   mirror index
+//--------------------------------------------------------------------------
+void CNetMdMirrors::idle(int idx)
+{
+    SMirror& m = mMirrors[idx];
+
+    if (m.mbEditing)
+    {
+        return;
+    }
+
+    if (m.mEdit.count() > 0)
+    {
+        m.mbEditing = true;
+        m.mpNetMD->start(m.mEdit, m.mbResetDev);
+        m.mEdit.clear();
+    }
+    else
+    {
+        emit done(idx);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      drop failed mirror
+//!
+//! @param[in]  idx   mirror index
+//! @param[in]  ret   error code
+//--------------------------------------------------------------------------
+void CNetMdMirrors::drop(int idx, int ret)
+{
+    SMirror& m = mMirrors[idx];
+
+    qWarning() << "Mirror recorder" << idx << "failed with error" << ret << "- dropping it!";
+    m.mbFailed  = true;
+    m.mbEditing = false;
+    m.mpNetMD->dropPending();
+
+    for (const auto& f : m.mJobs)
+    {
+        release(f);
+    }
+
+    m.mJobs.clear();
+    m.mEdit.clear();
+    emit failed(idx, ret);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      copy transfer file for mirrors, the main recorder's
+//!             clean-up doesn't have to wait for the slowest mirror
+//!
+//! @param[in]  file   The file
+//! @param[in]  users  number of mirrors using the copy
+//!
+//! @return     name of copy, empty on error
+//--------------------------------------------------------------------------
+QString CNetMdMirrors::share(const QString& file, int users)
+{
+    QString copy = file + ".mirror";
+
+    if (mRefs.contains(copy))
+    {
+        mRefs[copy] += users;
+        return copy;
+    }
+
+    QFile::remove(copy);
+
+    if (!QFile::copy(file, copy))
+    {
+        qWarning() << "Can't copy" << file << "for mirror recorders!";
+        return QString();
+    }
+
+    mRefs.insert(copy, users);
+    return copy;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      mirror is done with file, delete it when unused
+//!
+//! @param[in]  file  The file
+//--------------------------------------------------------------------------
+void CNetMdMirrors::release(const QString& file)
+{
+    if (file.isEmpty() || !mRefs.contains(file))
+    {
+        return;
+    }
+
+    if (--mRefs[file] <= 0)
+    {
+        mRefs.remove(file);
+        QFile::remove(file);
+    }
+}
@@ -0,0 +1,186 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+#include <QMap>
+#include "cnetmd.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Additional recorders which get a copy of every transfer of
+//!             the main recorder. Each mirror has its own CNetMD worker, so
+//!             transfers overlap; a failing mirror is dropped without
+//!             affecting the others. Mirrors are given as a ';' separated
+//!             list of backends ("sim:<simulator config>" or
+//!             "replay:<trace file>"), see batch option --mirrors.
+//!             libnetmd++ only opens the first NetMD device found, so
+//!             mirrors are simulated recorders for tests; the GUI doesn't
+//!             use them. Track numbers of title edits are the main recorder's,
+//!             mirrors are expected to hold the same content.
+//------------------------------------------------------------------------------
+class CNetMdMirrors : public QObject
+{
+    Q_OBJECT
+
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param[in]  spec    ';' separated mirror backends (empty: no mirrors)
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    explicit CNetMdMirrors(const QString& spec, QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object.
+    //--------------------------------------------------------------------------
+    ~CNetMdMirrors();
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of mirrors
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int count() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      queue track transfer on all working mirrors
+    //!
+    //! @param[in]  startup  transfer command as sent to the main recorder
+    //--------------------------------------------------------------------------
+    void transfer(const CNetMD::NetMDStartup& startup);
+
+    //--------------------------------------------------------------------------
+    //! @brief      queue TOC edit on all working mirrors
+    //!             (runs after the mirror's own transfer)
+    //!
+    //! @param[in]  tocData   TOC data for manipulation
+    //! @param[in]  resetDev  reset device after TOC edit
+    //! @param[in]  mono      mono flag for TOC edit
+    //--------------------------------------------------------------------------
+    void tocEdit(const CNetMD::TocData& tocData, bool resetDev, bool mono);
+
+    //--------------------------------------------------------------------------
+    //! @brief      queue disc title / group edits on all working mirrors
+    //!             (sent when the mirror's own transfers are done)
+    //!
+    //! @param[in]  edit      staged edits as sent to the main recorder
+    //! @param[in]  resetDev  device may be reset after TOC edit
+    //--------------------------------------------------------------------------
+    void titleEdit(const CNetMD::SBulkEdit& edit, bool resetDev);
+
+    //--------------------------------------------------------------------------
+    //! @brief      has any mirror queued work
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool busy() const;
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      transfer progress of one mirror
+    //!
+    //! @param[in]  idx      mirror index
+    //! @param[in]  percent  The percent
+    //--------------------------------------------------------------------------
+    void progress(int idx, int percent);
+
+    //--------------------------------------------------------------------------
+    //! @brief      mirror failed and was dropped
+    //!
+    //! @param[in]  idx   mirror index
+    //! @param[in]  ret   error code
+    //--------------------------------------------------------------------------
+    void failed(int idx, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      mirror has done all queued work
+    //!
+    //! @param[in]  idx   mirror index
+    //--------------------------------------------------------------------------
+    void done(int idx);
+
+protected:
+    /// one mirror
+    struct SMirror
+    {
+        CNetMD*           mpNetMD;    ///< worker
+        bool              mbFailed;   ///< dropped after error
+        QStringList       mJobs;      ///< files of queued jobs (empty for TOC edits)
+        CNetMD::SBulkEdit mEdit;      ///< title edits waiting for queued jobs
+        bool              mbResetDev; ///< device may be reset after title edit
+        bool              mbEditing;  ///< title edit running
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      a mirror job has finished
+    //!
+    //! @param[in]  idx   mirror index
+    //! @param[in]  ret   return value
+    //--------------------------------------------------------------------------
+    void jobDone(int idx, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      a mirror title edit has finished
+    //!
+    //! @param[in]  idx   mirror index
+    //! @param[in]  ret   return value
+    //--------------------------------------------------------------------------
+    void editDone(int idx, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      send waiting title edits if no other job is queued,
+    //!             signal done if nothing is left
+    //!
+    //! @param[in]  idx   mirror index
+    //--------------------------------------------------------------------------
+    void idle(int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      drop failed mirror
+    //!
+    //! @param[in]  idx   mirror index
+    //! @param[in]  ret   error code
+    //--------------------------------------------------------------------------
+    void drop(int idx, int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      copy transfer file for mirrors, the main recorder's
+    //!             clean-up doesn't have to wait for the slowest mirror
+    //!
+    //! @param[in]  file   The file
+    //! @param[in]  users  number of mirrors using the copy
+    //!
+    //! @return     name of copy, empty on error
+    //--------------------------------------------------------------------------
+    QString share(const QString& file, int users);
+
+    //--------------------------------------------------------------------------
+    //! @brief      mirror is done with file, delete it when unused
+    //!
+    //! @param[in]  file  The file
+    //--------------------------------------------------------------------------
+    void release(const QString& file);
+
+private:
+    /// all mirrors
+    QVector<SMirror> mMirrors;
+
+    /// shared file -> number of mirrors using it
+    QMap<QString, int> mRefs;
+};
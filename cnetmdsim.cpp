@@ -0,0 +1,1068 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cnetmdsim.h"
+#include "ctocmanip.h"
+#include <QThread>
+#include <QStringList>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+
+using namespace netmd;
+
+//--------------------------------------------------------------------------
+//! @brief      parse configuration string, e.g.
+//!             "rate=600000,latency=5,usberr=0.01,disconnect=0.001"
+//!
+//! @param[in]  spec  comma separated key=value pairs
+//!
+//! @return     configuration (defaults for missing keys)
+//--------------------------------------------------------------------------
+CNetMdSimDevice::SConfig CNetMdSimDevice::parseConfig(const QString& spec)
+{
+    SConfig cfg = {352800.0, 20, 0.0, 0.0, 3000, 1, "Simulated NetMD",
+                   true, true, false, false, 80, 0};
+
+    for (const auto& kv : spec.split(',', QString::SkipEmptyParts))
+    {
+        QString key = kv.section('=', 0, 0).trimmed().toLower();
+        QString val = kv.section('=', 1).trimmed();
+
+        if (key == "rate")
+        {
+            cfg.mBytesPerSec = qMax(1.0, val.toDouble());
+        }
+        else if (key == "latency")
+        {
+            cfg.mLatencyMs = qMax(0, val.toInt());
+        }
+        else if (key == "usberr")
+        {
+            cfg.mUsbErrRate = val.toDouble();
+        }
+        else if (key == "disconnect")
+        {
+            cfg.mDisconnRate = val.toDouble();
+        }
+        else if (key == "reconnect")
+        {
+            cfg.mReconnectMs = qMax(0, val.toInt());
+        }
+        else if (key == "seed")
+        {
+            cfg.mSeed = val.toUInt();
+        }
+        else if (key == "name")
+        {
+            cfg.mName = val.toStdString();
+        }
+        else if (key == "otf")
+        {
+            cfg.mOtfEnc = val.toInt() != 0;
+        }
+        else if (key == "toc")
+        {
+            cfg.mTocManip = val.toInt() != 0;
+        }
+        else if (key == "sp")
+        {
+            cfg.mSpUpload = val.toInt() != 0;
+        }
+        else if (key == "mono")
+        {
+            cfg.mPcm2Mono = val.toInt() != 0;
+        }
+        else if (key == "minutes")
+        {
+            cfg.mDiscMinutes = qBound(1, val.toInt(), 99);
+        }
+        else if (key == "tracks")
+        {
+            cfg.mTracks = qBound(0, val.toInt(), 254);
+        }
+    }
+
+    return cfg;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param[in]  cfg   The configuration
+//--------------------------------------------------------------------------
+CNetMdSimDevice::CNetMdSimDevice(const SConfig& cfg)
+    : mCfg(cfg), mpLog(nullptr), mLogLevel(INFO), mbOpen(false), mbMono(false),
+      mBackAt(std::chrono::steady_clock::now()), mRnd(cfg.mSeed)
+{
+    // 3 minute SP tracks as long as they fit
+    uint32_t trkSg = static_cast<uint32_t>(180 * CTocManip::SOUND_GROUPS_PER_SEC);
+    uint32_t discSg = static_cast<uint32_t>(mCfg.mDiscMinutes * 60 * CTocManip::SOUND_GROUPS_PER_SEC);
+
+    for (int i = 0; (i < mCfg.mTracks) && ((usedSoundGroups() + trkSg) <= discSg); i++)
+    {
+        mTracks.push_back({"Track " + std::to_string(i + 1), AudioEncoding::SP, 2,
+                           TrackProtection::UNPROTECTED, trkSg});
+    }
+
+    if (!mTracks.empty())
+    {
+        mDiscTitle = "Simulated Disc";
+    }
+}
+
+void CNetMdSimDevice::setLogStream(std::ostream& os)
+{
+    mpLog = &os;
+}
+
+void CNetMdSimDevice::setLogLevel(int severity)
+{
+    mLogLevel = severity;
+}
+
+int CNetMdSimDevice::initDevice()
+{
+    QThread::msleep(mCfg.mLatencyMs);
+
+    if (std::chrono::steady_clock::now() < mBackAt)
+    {
+        log(WARN, "No NetMD device found!");
+        mbOpen = false;
+        return NETMDERR_USB;
+    }
+
+    log(INFO, "Found " + mCfg.mName);
+    mbOpen = true;
+    return NETMDERR_NO_ERROR;
+}
+
+std::string CNetMdSimDevice::getDeviceName() const
+{
+    return mCfg.mName;
+}
+
+int CNetMdSimDevice::trackCount()
+{
+    int ret = command("trackCount");
+    return (ret == NETMDERR_NO_ERROR) ? static_cast<int>(mTracks.size()) : ret;
+}
+
+int CNetMdSimDevice::discFlags()
+{
+    int ret = command("discFlags");
+    return (ret == NETMDERR_NO_ERROR) ? 0 : ret;
+}
+
+int CNetMdSimDevice::eraseDisc()
+{
+    int ret = command("eraseDisc");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        mTracks.clear();
+        mGroups.clear();
+        mDiscTitle.clear();
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::trackTime(int trackNo, TrackTime& trackTime)
+{
+    int ret = command("trackTime");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!validTrack(trackNo))
+        {
+            return NETMDERR_PARAM;
+        }
+
+        const STrack& trk = mTracks.at(trackNo);
+        int hSecs = static_cast<int>(std::lround(trk.mSoundGroups * 100.0 * timeFactor(trk)
+                                                 / CTocManip::SOUND_GROUPS_PER_SEC));
+        trackTime = {hSecs / 6000, (hSecs / 100) % 60, hSecs % 100};
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::discTitle(std::string& title)
+{
+    int ret = command("discTitle");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        title = mDiscTitle;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::setDiscTitle(const std::string& title)
+{
+    int ret = command("setDiscTitle");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        mDiscTitle = title;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::setGroupTitle(uint16_t group, const std::string& title)
+{
+    int ret = command("setGroupTitle");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if ((group < 1) || (group > mGroups.size()))
+        {
+            return NETMDERR_PARAM;
+        }
+        mGroups[group - 1].mName = title;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::createGroup(const std::string& title, int first, int last)
+{
+    int ret = command("createGroup");
+
+    if (ret != NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    if ((first < 1) || (last < first) || (last > static_cast<int>(mTracks.size())))
+    {
+        return NETMDERR_PARAM;
+    }
+
+    for (const auto& g : mGroups)
+    {
+        int gLast = (g.mLast == -1) ? g.mFirst : g.mLast;
+
+        if ((first <= gLast) && (last >= g.mFirst))
+        {
+            log(WARN, "Group overlaps existing group " + g.mName);
+            return NETMDERR_PARAM;
+        }
+    }
+
+    Groups::iterator it = mGroups.begin();
+
+    while ((it != mGroups.end()) && (it->mFirst < first))
+    {
+        it++;
+    }
+
+    Group grp = {0, static_cast<int16_t>(first), static_cast<int16_t>((last == first) ? -1 : last), title};
+    mGroups.insert(it, grp);
+
+    for (std::size_t i = 0; i < mGroups.size(); i++)
+    {
+        mGroups[i].mGid = static_cast<int>(i + 1);
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::deleteGroup(int group)
+{
+    int ret = command("deleteGroup");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if ((group < 1) || (group > static_cast<int>(mGroups.size())))
+        {
+            return NETMDERR_PARAM;
+        }
+
+        mGroups.erase(mGroups.begin() + group - 1);
+
+        for (std::size_t i = 0; i < mGroups.size(); i++)
+        {
+            mGroups[i].mGid = static_cast<int>(i + 1);
+        }
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::deleteTrack(uint16_t track)
+{
+    int ret = command("deleteTrack");
+
+    if (ret != NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    if (!validTrack(track))
+    {
+        return NETMDERR_PARAM;
+    }
+
+    mTracks.erase(mTracks.begin() + track);
+
+    // fix group ranges (1-based)
+    int    no = track + 1;
+    Groups groups;
+
+    for (auto g : mGroups)
+    {
+        int last = (g.mLast == -1) ? g.mFirst : g.mLast;
+
+        if ((g.mFirst == no) && (last == no))
+        {
+            continue;
+        }
+
+        if (no < g.mFirst)
+        {
+            g.mFirst--;
+            last--;
+        }
+        else if (no <= last)
+        {
+            last--;
+        }
+
+        g.mLast = static_cast<int16_t>((last == g.mFirst) ? -1 : last);
+        g.mGid  = static_cast<int>(groups.size() + 1);
+        groups.push_back(g);
+    }
+
+    mGroups = groups;
+    return ret;
+}
+
+int CNetMdSimDevice::trackBitRate(uint16_t track, AudioEncoding& encoding, uint8_t& channel)
+{
+    int ret = command("trackBitRate");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!validTrack(track))
+        {
+            return NETMDERR_PARAM;
+        }
+        encoding = mTracks.at(track).mEnc;
+        channel  = mTracks.at(track).mChannels;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::trackFlags(uint16_t track, TrackProtection& flags)
+{
+    int ret = command("trackFlags");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!validTrack(track))
+        {
+            return NETMDERR_PARAM;
+        }
+        flags = mTracks.at(track).mProt;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::trackTitle(uint16_t track, std::string& title)
+{
+    int ret = command("trackTitle");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!validTrack(track))
+        {
+            return NETMDERR_PARAM;
+        }
+        title = mTracks.at(track).mTitle;
+    }
+
+    return ret;
+}
+
+bool CNetMdSimDevice::spUploadSupported()
+{
+    return mCfg.mSpUpload;
+}
+
+bool CNetMdSimDevice::otfEncodeSupported()
+{
+    return mCfg.mOtfEnc;
+}
+
+bool CNetMdSimDevice::tocManipSupported()
+{
+    return mCfg.mTocManip;
+}
+
+bool CNetMdSimDevice::pcm2MonoSupported()
+{
+    return mCfg.mPcm2Mono;
+}
+
+int CNetMdSimDevice::enablePcm2Mono()
+{
+    int ret = command("enablePcm2Mono");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!mCfg.mPcm2Mono)
+        {
+            return NETMDERR_NOT_SUPPORTED;
+        }
+        mbMono = true;
+    }
+
+    return ret;
+}
+
+void CNetMdSimDevice::disablePcm2Mono()
+{
+    mbMono = false;
+}
+
+int CNetMdSimDevice::sendAudioFile(const std::string& filename, const std::string& title, DiskFormat otf)
+{
+    int ret = command("sendAudioFile");
+
+    if (ret != NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    SWaveInfo wi   = {0, 0, 0, 0, 0};
+    int64_t   size = readWaveInfo(filename, wi);
+
+    if (size < 0)
+    {
+        log(CRITICAL, "Can't open audio file " + filename);
+        return NETMDERR_PARAM;
+    }
+
+    STrack trk;
+
+    if ((ret = prepareTrack(wi, size, title, otf, trk)) != NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    // one progress line each 100ms (at most 100 lines)
+    double duration = size / mCfg.mBytesPerSec;
+    int    steps    = qBound(1, static_cast<int>(duration * 10.0), 100);
+
+    for (int i = 1; i <= steps; i++)
+    {
+        QThread::msleep(static_cast<unsigned long>(duration * 1000.0 / steps));
+
+        if ((ret = command("sendAudioFile", false)) != NETMDERR_NO_ERROR)
+        {
+            log(CRITICAL, "Transfer aborted!");
+            return ret;
+        }
+
+        logProgress(size * i / steps, size);
+    }
+
+    mTracks.push_back(trk);
+    log(INFO, "Track " + std::to_string(mTracks.size()) + " written.");
+    return NETMDERR_NO_ERROR;
+}
+
+int CNetMdSimDevice::setTrackTitle(uint16_t trackNo, const std::string& title)
+{
+    int ret = command("setTrackTitle");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        if (!validTrack(trackNo))
+        {
+            return NETMDERR_PARAM;
+        }
+        mTracks[trackNo].mTitle = title;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::discCapacity(DiscCapacity& dcap)
+{
+    int ret = command("discCapacity");
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        auto toTime = [](double secs)->NetMdTime {
+            int s = static_cast<int>(secs);
+            return {static_cast<uint16_t>(s / 3600), static_cast<uint8_t>((s / 60) % 60),
+                    static_cast<uint8_t>(s % 60), 0};
+        };
+
+        double total = mCfg.mDiscMinutes * 60.0;
+        double used  = usedSoundGroups() / CTocManip::SOUND_GROUPS_PER_SEC;
+
+        dcap.recorded  = toTime(used);
+        dcap.total     = toTime(total);
+        dcap.available = toTime((total > used) ? (total - used) : 0.0);
+    }
+
+    return ret;
+}
+
+Groups CNetMdSimDevice::groups()
+{
+    Groups groups;
+
+    if (command("groups") == NETMDERR_NO_ERROR)
+    {
+        groups.push_back({0, 0, 0, mDiscTitle});
+        groups.insert(groups.end(), mGroups.begin(), mGroups.end());
+    }
+
+    return groups;
+}
+
+int CNetMdSimDevice::prepareTOCManip()
+{
+    int ret = command("prepareTOCManip");
+    return ((ret == NETMDERR_NO_ERROR) && !mCfg.mTocManip) ? NETMDERR_NOT_SUPPORTED : ret;
+}
+
+NetMDByteVector CNetMdSimDevice::readUTOCSector(UTOCSector s)
+{
+    if ((command("readUTOCSector") != NETMDERR_NO_ERROR) || !mCfg.mTocManip)
+    {
+        return NetMDByteVector();
+    }
+
+    NetMDByteVector sec(CTocManip::SECTOR_SIZE, 0);
+
+    if (s == UTOCSector::POS_ADDR)
+    {
+        uint32_t pos  = AUDIO_START;
+        uint32_t end  = AUDIO_START + static_cast<uint32_t>(mCfg.mDiscMinutes * 60 * CTocManip::SOUND_GROUPS_PER_SEC);
+        std::size_t cell = 1;
+
+        sec[CTocManip::LAST_TNO] = static_cast<uint8_t>(mTracks.size());
+
+        // one part per track, written back to back
+        for (std::size_t t = 0; t < mTracks.size(); t++, cell++)
+        {
+            const STrack& trk = mTracks.at(t);
+            uint8_t*      p   = &sec[CTocManip::CELL_TABLE + cell * 8];
+
+            CTocManip::address(pos, &p[0]);
+            CTocManip::address(pos + trk.mSoundGroups - 1, &p[4]);
+            p[3] = ((trk.mProt == TrackProtection::UNPROTECTED) ? CTocManip::MODE_WRITABLE : 0)
+                 | ((trk.mEnc == AudioEncoding::SP) ? CTocManip::MODE_AUDIO : 0)
+                 | ((trk.mChannels == 2) ? CTocManip::MODE_STEREO : 0);
+
+            sec[CTocManip::TRACK_PTR + t] = static_cast<uint8_t>(cell);
+            pos += trk.mSoundGroups;
+        }
+
+        if (pos < end)
+        {
+            uint8_t* p = &sec[CTocManip::CELL_TABLE + cell * 8];
+            CTocManip::address(pos, &p[0]);
+            CTocManip::address(end - 1, &p[4]);
+            sec[CTocManip::FREE_AREA_PTR] = static_cast<uint8_t>(cell++);
+        }
+
+        // chain unused cells
+        sec[CTocManip::EMPTY_PTR] = (cell < 256) ? static_cast<uint8_t>(cell) : 0;
+
+        for (; cell < 256; cell++)
+        {
+            sec[CTocManip::CELL_TABLE + cell * 8 + 7] = (cell < 255) ? static_cast<uint8_t>(cell + 1) : 0;
+        }
+    }
+    else if (s == UTOCSector::HW_TITLES)
+    {
+        CTocManip::RawTitles titles = {rawDiscTitle()};
+
+        for (const auto& t : mTracks)
+        {
+            titles.push_back(t.mTitle);
+        }
+
+        CTocManip::encodeTitles(titles, sec);
+    }
+    else if ((s == UTOCSector::TSTAMPS) && (mTStamps.size() == CTocManip::SECTOR_SIZE))
+    {
+        sec = mTStamps;
+    }
+
+    return sec;
+}
+
+int CNetMdSimDevice::writeUTOCSector(UTOCSector s, const NetMDByteVector& data)
+{
+    int ret = command("writeUTOCSector");
+
+    if (ret != NETMDERR_NO_ERROR)
+    {
+        return ret;
+    }
+
+    if (!mCfg.mTocManip)
+    {
+        return NETMDERR_NOT_SUPPORTED;
+    }
+
+    if (data.size() != CTocManip::SECTOR_SIZE)
+    {
+        return NETMDERR_PARAM;
+    }
+
+    if (s == UTOCSector::POS_ADDR)
+    {
+        std::vector<STrack> tracks;
+
+        for (int t = 0; t < data.at(CTocManip::LAST_TNO); t++)
+        {
+            STrack  trk   = {std::string(), AudioEncoding::SP, 2, TrackProtection::UNPROTECTED, 0};
+            uint8_t cell  = data.at(CTocManip::TRACK_PTR + t);
+            int     parts = 0;
+
+            if (t < static_cast<int>(mTracks.size()))
+            {
+                trk = mTracks.at(t);
+                trk.mSoundGroups = 0;
+            }
+
+            while ((cell != 0) && (parts < 255))
+            {
+                const uint8_t* p = &data.at(CTocManip::CELL_TABLE + cell * 8);
+                uint32_t start   = CTocManip::soundGroup(&p[0]);
+                uint32_t end     = CTocManip::soundGroup(&p[4]);
+
+                if (end < start)
+                {
+                    return NETMDERR_PARAM;
+                }
+
+                if (parts++ == 0)
+                {
+                    trk.mProt     = (p[3] & CTocManip::MODE_WRITABLE) ? TrackProtection::UNPROTECTED : TrackProtection::PROTECTED;
+                    trk.mChannels = (p[3] & CTocManip::MODE_STEREO) ? 2 : 1;
+
+                    if (p[3] & CTocManip::MODE_AUDIO)
+                    {
+                        trk.mEnc = AudioEncoding::SP;
+                    }
+                    else if (trk.mEnc == AudioEncoding::SP)
+                    {
+                        trk.mEnc = AudioEncoding::LP2;
+                    }
+                }
+
+                trk.mSoundGroups += end - start + 1;
+                cell = p[7];
+            }
+
+            if ((cell != 0) || (parts == 0))
+            {
+                log(CRITICAL, "Broken parts chain in UTOC sector 0!");
+                return NETMDERR_PARAM;
+            }
+
+            tracks.push_back(trk);
+        }
+
+        mTracks = tracks;
+    }
+    else if (s == UTOCSector::HW_TITLES)
+    {
+        parseDiscTitle(CTocManip::cellTitle(data, data.at(CTocManip::DISC_TITLE_PTR)));
+
+        for (std::size_t t = 0; t < mTracks.size(); t++)
+        {
+            mTracks[t].mTitle = CTocManip::cellTitle(data, data.at(CTocManip::TRACK_PTR + t));
+        }
+    }
+    else if (s == UTOCSector::TSTAMPS)
+    {
+        mTStamps = data;
+    }
+
+    return ret;
+}
+
+int CNetMdSimDevice::finalizeTOC(bool reset, uint8_t resetWait)
+{
+    Q_UNUSED(resetWait)
+    int ret = command("finalizeTOC");
+
+    if ((ret == NETMDERR_NO_ERROR) && reset)
+    {
+        log(INFO, "Resetting device ...");
+        disconnect(mCfg.mReconnectMs);
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      simulate latency and injected faults for one command
+//!
+//! @param[in]  what   command name for the log
+//! @param[in]  delay  add command latency
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CNetMdSimDevice::command(const char* what, bool delay)
+{
+    if (delay)
+    {
+        QThread::msleep(mCfg.mLatencyMs);
+    }
+
+    if (!mbOpen)
+    {
+        log(WARN, std::string(what) + ": no device!");
+        return NETMDERR_USB;
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    if (dist(mRnd) < mCfg.mDisconnRate)
+    {
+        log(CRITICAL, std::string(what) + ": device disconnected (simulated)!");
+        disconnect(mCfg.mReconnectMs);
+        return NETMDERR_USB;
+    }
+
+    if (dist(mRnd) < mCfg.mUsbErrRate)
+    {
+        log(WARN, std::string(what) + ": USB error (simulated)!");
+        return NETMDERR_USB;
+    }
+
+    return NETMDERR_NO_ERROR;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      device goes away for a while
+//!
+//! @param[in]  ms    time until device is back
+//--------------------------------------------------------------------------
+void CNetMdSimDevice::disconnect(int ms)
+{
+    mbOpen  = false;
+    mbMono  = false;
+    mBackAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write log line
+//!
+//! @param[in]  severity  The severity
+//! @param[in]  msg       The message
+//--------------------------------------------------------------------------
+void CNetMdSimDevice::log(int severity, const std::string& msg)
+{
+    static const char* names[] = {"DEBUG", "INFO", "WARN", "CRITICAL", "CAPTURE"};
+
+    if ((mpLog != nullptr) && (severity >= mLogLevel) && (severity >= DEBUG) && (severity <= CAPTURE))
+    {
+        *mpLog << "[" << names[severity] << "] " << msg << std::endl;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      check track number
+//!
+//! @param[in]  track  The track (0-based)
+//!
+//! @return     true if valid
+//--------------------------------------------------------------------------
+bool CNetMdSimDevice::validTrack(int track) const
+{
+    return (track >= 0) && (track < static_cast<int>(mTracks.size()));
+}
+
+//--------------------------------------------------------------------------
+//! @brief      used disc space
+//!
+//! @return     sound groups
+//--------------------------------------------------------------------------
+uint32_t CNetMdSimDevice::usedSoundGroups() const
+{
+    uint32_t sg = 0;
+
+    for (const auto& t : mTracks)
+    {
+        sg += t.mSoundGroups;
+    }
+
+    return sg;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      raw disc title with group header (if there are groups)
+//!
+//! @return     raw title
+//--------------------------------------------------------------------------
+std::string CNetMdSimDevice::rawDiscTitle() const
+{
+    if (mGroups.empty())
+    {
+        return mDiscTitle;
+    }
+
+    std::ostringstream os;
+    os << "0;" << mDiscTitle << "//";
+
+    for (const auto& g : mGroups)
+    {
+        os << g.mFirst;
+        if (g.mLast > g.mFirst)
+        {
+            os << "-" << g.mLast;
+        }
+        os << ";" << g.mName << "//";
+    }
+
+    return os.str();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      split raw disc title into disc title and groups
+//!
+//! @param[in]  raw   The raw title
+//--------------------------------------------------------------------------
+void CNetMdSimDevice::parseDiscTitle(const std::string& raw)
+{
+    mGroups.clear();
+
+    if ((raw.compare(0, 2, "0;") != 0) || (raw.find("//") == std::string::npos))
+    {
+        mDiscTitle = raw;
+        return;
+    }
+
+    std::size_t pos = 2;
+    std::size_t end;
+    bool        disc = true;
+
+    while ((end = raw.find("//", pos)) != std::string::npos)
+    {
+        std::string item = raw.substr(pos, end - pos);
+        pos = end + 2;
+
+        if (disc)
+        {
+            mDiscTitle = item;
+            disc       = false;
+            continue;
+        }
+
+        std::size_t semi = item.find(';');
+        int first = 0, last = -1;
+
+        if ((semi == std::string::npos) || (std::sscanf(item.c_str(), "%d-%d", &first, &last) < 1) || (first < 1))
+        {
+            continue;
+        }
+
+        mGroups.push_back({static_cast<int>(mGroups.size() + 1), static_cast<int16_t>(first),
+                           static_cast<int16_t>((last > first) ? last : -1), item.substr(semi + 1)});
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create track entry for audio data and check disc space
+//!
+//! @param[in]  wi     wave info of the data
+//! @param[in]  size   data size (incl. header)
+//! @param[in]  title  The title
+//! @param[in]  otf    on-the-fly encoding format
+//! @param[out] trk    The track
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CNetMdSimDevice::prepareTrack(const SWaveInfo& wi, int64_t size, const std::string& title,
+                                  DiskFormat otf, STrack& trk)
+{
+    if ((otf != NO_ONTHEFLY_CONVERSION) && !mCfg.mOtfEnc)
+    {
+        log(CRITICAL, "On-the-fly encoding not supported!");
+        return NETMDERR_NOT_SUPPORTED;
+    }
+
+    trk = {title, AudioEncoding::SP, 2, TrackProtection::UNPROTECTED, 0};
+    double secs;
+
+    if (wi.mByteRate == 0)
+    {
+        // no wave file: raw SP data
+        secs = size / SP_BYTES_PER_SEC;
+    }
+    else
+    {
+        secs = static_cast<double>(wi.mDataSize) / wi.mByteRate;
+
+        if (otf == NETMD_DISKFORMAT_LP2)
+        {
+            trk.mEnc = AudioEncoding::LP2;
+        }
+        else if (otf == NETMD_DISKFORMAT_LP4)
+        {
+            trk.mEnc = AudioEncoding::LP4;
+        }
+        else if (otf == NETMD_DISKFORMAT_SP_MONO)
+        {
+            trk.mChannels = 1;
+        }
+        else if (wi.mFormat == WAVE_FORMAT_ATRAC3)
+        {
+            trk.mEnc = (wi.mBlockAlign == 192) ? AudioEncoding::LP4 : AudioEncoding::LP2;
+        }
+        else if (mbMono || (wi.mChannels == 1))
+        {
+            trk.mChannels = 1;
+        }
+    }
+
+    trk.mSoundGroups = static_cast<uint32_t>(std::ceil(secs * CTocManip::SOUND_GROUPS_PER_SEC / timeFactor(trk)));
+
+    if ((mTracks.size() >= 254) || (trk.mSoundGroups == 0)
+        || ((usedSoundGroups() + trk.mSoundGroups) > (mCfg.mDiscMinutes * 60 * CTocManip::SOUND_GROUPS_PER_SEC)))
+    {
+        log(CRITICAL, "Not enough space on disc for " + title);
+        return NETMDERR_OTHER;
+    }
+
+    return NETMDERR_NO_ERROR;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write transfer progress line (as libnetmd++ does)
+//!
+//! @param[in]  sent  bytes sent
+//! @param[in]  size  bytes total
+//--------------------------------------------------------------------------
+void CNetMdSimDevice::logProgress(int64_t sent, int64_t size)
+{
+    std::ostringstream os;
+    os << "Sending " << sent << " of " << size << " bytes: " << (sent * 100 / size) << "%";
+    log(CAPTURE, os.str());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      read wave header
+//!
+//! @param[in]  filename  The file name
+//! @param[out] info      The wave information
+//!
+//! @return     file size, -1 on error
+//--------------------------------------------------------------------------
+int64_t CNetMdSimDevice::readWaveInfo(const std::string& filename, SWaveInfo& info)
+{
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+
+    if (!f.is_open())
+    {
+        return -1;
+    }
+
+    int64_t size = f.tellg();
+    f.seekg(0);
+    parseWaveInfo(f, info);
+    return size;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      parse wave header
+//!
+//! @param      is    input positioned at the start of the header
+//! @param[out] info  The wave information (untouched if no wave)
+//--------------------------------------------------------------------------
+void CNetMdSimDevice::parseWaveInfo(std::istream& is, SWaveInfo& info)
+{
+    auto le16 = [](const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); };
+    auto le32 = [](const uint8_t* p) { return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24)); };
+
+    uint8_t hdr[12];
+
+    if (!is.read(reinterpret_cast<char*>(hdr), sizeof(hdr))
+        || (std::string(reinterpret_cast<char*>(hdr), 4) != "RIFF")
+        || (std::string(reinterpret_cast<char*>(hdr) + 8, 4) != "WAVE"))
+    {
+        return;
+    }
+
+    uint8_t chunk[8];
+
+    while (is.read(reinterpret_cast<char*>(chunk), sizeof(chunk)))
+    {
+        std::string id(reinterpret_cast<char*>(chunk), 4);
+        uint32_t    len = le32(&chunk[4]);
+
+        if (id == "fmt ")
+        {
+            uint8_t fmt[16];
+
+            if ((len < sizeof(fmt)) || !is.read(reinterpret_cast<char*>(fmt), sizeof(fmt)))
+            {
+                break;
+            }
+
+            info.mFormat     = le16(&fmt[0]);
+            info.mChannels   = le16(&fmt[2]);
+            info.mByteRate   = le32(&fmt[8]);
+            info.mBlockAlign = le16(&fmt[12]);
+            len -= sizeof(fmt);
+        }
+        else if (id == "data")
+        {
+            info.mDataSize = len;
+            break;
+        }
+
+        is.seekg(len + (len & 1), std::ios::cur);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      time factor for encoding (LP2 stores twice as long ...)
+//!
+//! @param[in]  trk   The track
+//!
+//! @return     factor
+//--------------------------------------------------------------------------
+int CNetMdSimDevice::timeFactor(const STrack& trk)
+{
+    switch (trk.mEnc)
+    {
+    case AudioEncoding::LP2:
+        return 2;
+    case AudioEncoding::LP4:
+        return 4;
+    default:
+        return (trk.mChannels == 1) ? 2 : 1;
+    }
+}
@@ -0,0 +1,269 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QString>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <istream>
+#include "cnetmddevice.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Software NetMD device with an in-memory disc. Transfers run
+//!             at a configurable speed and write the same progress log as
+//!             libnetmd++, USB errors and disconnects can be injected.
+//!             UTOC sectors 0 and 1 are built from (and parsed back into)
+//!             the disc model, so TOC edits work as on a real device.
+//------------------------------------------------------------------------------
+class CNetMdSimDevice : public CNetMdDevice
+{
+public:
+    /// simulator configuration
+    struct SConfig
+    {
+        double      mBytesPerSec;   ///< transfer speed
+        int         mLatencyMs;     ///< latency per command
+        double      mUsbErrRate;    ///< probability of an USB error per command
+        double      mDisconnRate;   ///< probability of a disconnect per command
+        int         mReconnectMs;   ///< device is gone that long after a disconnect / reset
+        uint32_t    mSeed;          ///< random seed for fault injection
+        std::string mName;          ///< device name
+        bool        mOtfEnc;        ///< on-the-fly encoding supported
+        bool        mTocManip;      ///< TOC manipulation supported
+        bool        mSpUpload;      ///< SP upload supported
+        bool        mPcm2Mono;      ///< PCM to mono supported
+        int         mDiscMinutes;   ///< disc capacity (SP stereo)
+        int         mTracks;        ///< pre-recorded tracks on disc
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      parse configuration string, e.g.
+    //!             "rate=600000,latency=5,usberr=0.01,disconnect=0.001"
+    //!
+    //! @param[in]  spec  comma separated key=value pairs
+    //!
+    //! @return     configuration (defaults for missing keys)
+    //--------------------------------------------------------------------------
+    static SConfig parseConfig(const QString& spec);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param[in]  cfg   The configuration
+    //--------------------------------------------------------------------------
+    explicit CNetMdSimDevice(const SConfig& cfg);
+
+    void setLogStream(std::ostream& os) override;
+    void setLogLevel(int severity) override;
+    int initDevice() override;
+    std::string getDeviceName() const override;
+    int trackCount() override;
+    int discFlags() override;
+    int eraseDisc() override;
+    int trackTime(int trackNo, netmd::TrackTime& trackTime) override;
+    int discTitle(std::string& title) override;
+    int setDiscTitle(const std::string& title) override;
+    int setGroupTitle(uint16_t group, const std::string& title) override;
+    int createGroup(const std::string& title, int first, int last) override;
+    int deleteGroup(int group) override;
+    int deleteTrack(uint16_t track) override;
+    int trackBitRate(uint16_t track, netmd::AudioEncoding& encoding, uint8_t& channel) override;
+    int trackFlags(uint16_t track, netmd::TrackProtection& flags) override;
+    int trackTitle(uint16_t track, std::string& title) override;
+    bool spUploadSupported() override;
+    bool otfEncodeSupported() override;
+    bool tocManipSupported() override;
+    bool pcm2MonoSupported() override;
+    int enablePcm2Mono() override;
+    void disablePcm2Mono() override;
+    int sendAudioFile(const std::string& filename, const std::string& title, netmd::DiskFormat otf) override;
+    int setTrackTitle(uint16_t trackNo, const std::string& title) override;
+    int discCapacity(netmd::DiscCapacity& dcap) override;
+    netmd::Groups groups() override;
+    int prepareTOCManip() override;
+    netmd::NetMDByteVector readUTOCSector(netmd::UTOCSector s) override;
+    int writeUTOCSector(netmd::UTOCSector s, const netmd::NetMDByteVector& data) override;
+    int finalizeTOC(bool reset = false, uint8_t resetWait = 15) override;
+
+protected:
+    /// one track on the simulated disc
+    struct STrack
+    {
+        std::string            mTitle;      ///< raw title
+        netmd::AudioEncoding   mEnc;        ///< encoding
+        uint8_t                mChannels;   ///< channel count
+        netmd::TrackProtection mProt;       ///< protection
+        uint32_t               mSoundGroups;///< used disc space
+    };
+
+    /// audio format found in a wave file
+    struct SWaveInfo
+    {
+        uint16_t mFormat;       ///< format tag
+        uint16_t mChannels;     ///< channel count
+        uint32_t mByteRate;     ///< bytes per second
+        uint16_t mBlockAlign;   ///< block size
+        uint32_t mDataSize;     ///< size of data chunk
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      simulate latency and injected faults for one command
+    //!
+    //! @param[in]  what   command name for the log
+    //! @param[in]  delay  add command latency
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int command(const char* what, bool delay = true);
+
+    //--------------------------------------------------------------------------
+    //! @brief      device goes away for a while
+    //!
+    //! @param[in]  ms    time until device is back
+    //--------------------------------------------------------------------------
+    void disconnect(int ms);
+
+    //--------------------------------------------------------------------------
+    //! @brief      write log line
+    //!
+    //! @param[in]  severity  The severity
+    //! @param[in]  msg       The message
+    //--------------------------------------------------------------------------
+    void log(int severity, const std::string& msg);
+
+    //--------------------------------------------------------------------------
+    //! @brief      check track number
+    //!
+    //! @param[in]  track  The track (0-based)
+    //!
+    //! @return     true if valid
+    //--------------------------------------------------------------------------
+    bool validTrack(int track) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      used disc space
+    //!
+    //! @return     sound groups
+    //--------------------------------------------------------------------------
+    uint32_t usedSoundGroups() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      raw disc title with group header (if there are groups)
+    //!
+    //! @return     raw title
+    //--------------------------------------------------------------------------
+    std::string rawDiscTitle() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      split raw disc title into disc title and groups
+    //!
+    //! @param[in]  raw   The raw title
+    //--------------------------------------------------------------------------
+    void parseDiscTitle(const std::string& raw);
+
+    //--------------------------------------------------------------------------
+    //! @brief      read wave header
+    //!
+    //! @param[in]  filename  The file name
+    //! @param[out] info      The wave information
+    //!
+    //! @return     file size, -1 on error
+    //--------------------------------------------------------------------------
+    static int64_t readWaveInfo(const std::string& filename, SWaveInfo& info);
+
+    //--------------------------------------------------------------------------
+    //! @brief      parse wave header
+    //!
+    //! @param      is    input positioned at the start of the header
+    //! @param[out] info  The wave information (untouched if no wave)
+    //--------------------------------------------------------------------------
+    static void parseWaveInfo(std::istream& is, SWaveInfo& info);
+
+    //--------------------------------------------------------------------------
+    //! @brief      create track entry for audio data and check disc space
+    //!
+    //! @param[in]  wi     wave info of the data
+    //! @param[in]  size   data size (incl. header)
+    //! @param[in]  title  The title
+    //! @param[in]  otf    on-the-fly encoding format
+    //! @param[out] trk    The track
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int prepareTrack(const SWaveInfo& wi, int64_t size, const std::string& title,
+                     netmd::DiskFormat otf, STrack& trk);
+
+    //--------------------------------------------------------------------------
+    //! @brief      write transfer progress line (as libnetmd++ does)
+    //!
+    //! @param[in]  sent  bytes sent
+    //! @param[in]  size  bytes total
+    //--------------------------------------------------------------------------
+    void logProgress(int64_t sent, int64_t size);
+
+    //--------------------------------------------------------------------------
+    //! @brief      time factor for encoding (LP2 stores twice as long ...)
+    //!
+    //! @param[in]  trk   The track
+    //!
+    //! @return     factor
+    //--------------------------------------------------------------------------
+    static int timeFactor(const STrack& trk);
+
+private:
+    /// audio area starts behind lead-in (cluster 0x32)
+    static constexpr uint32_t AUDIO_START = 0x32 * 176;
+
+    /// ATRAC3 wave format tag
+    static constexpr uint16_t WAVE_FORMAT_ATRAC3 = 0x270;
+
+    /// SP data rate (ATRAC1 292 kbit/s)
+    static constexpr double SP_BYTES_PER_SEC = 292000.0 / 8.0;
+
+    /// configuration
+    SConfig mCfg;
+
+    /// log output
+    std::ostream* mpLog;
+
+    /// log level
+    int mLogLevel;
+
+    /// device session is open
+    bool mbOpen;
+
+    /// PCM to mono conversion active
+    bool mbMono;
+
+    /// device is back at
+    std::chrono::steady_clock::time_point mBackAt;
+
+    /// fault injection
+    std::mt19937 mRnd;
+
+    /// disc title (without group header)
+    std::string mDiscTitle;
+
+    /// groups (1-based track numbers)
+    netmd::Groups mGroups;
+
+    /// tracks on disc
+    std::vector<STrack> mTracks;
+
+    /// time stamp sector (not interpreted)
+    netmd::NetMDByteVector mTStamps;
+};
@@ -0,0 +1,817 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cnetmdtrace.h"
+#include <QThread>
+#include <QtDebug>
+
+using namespace netmd;
+using Op = CNetMdTrace::Op;
+
+// QDataStream helpers for libnetmd++ types
+
+static QDataStream& operator<<(QDataStream& ds, const std::string& s)
+{
+    return ds << QByteArray(s.data(), static_cast<int>(s.size()));
+}
+
+static QDataStream& operator>>(QDataStream& ds, std::string& s)
+{
+    QByteArray ba;
+    ds >> ba;
+    s = ba.toStdString();
+    return ds;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const NetMDByteVector& v)
+{
+    return ds << QByteArray(reinterpret_cast<const char*>(v.data()), static_cast<int>(v.size()));
+}
+
+static QDataStream& operator>>(QDataStream& ds, NetMDByteVector& v)
+{
+    QByteArray ba;
+    ds >> ba;
+    v.assign(ba.constBegin(), ba.constEnd());
+    return ds;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const TrackTime& t)
+{
+    return ds << qint32(t.mMinutes) << qint32(t.mSeconds) << qint32(t.mTenthSecs);
+}
+
+static QDataStream& operator>>(QDataStream& ds, TrackTime& t)
+{
+    qint32 m, s, h;
+    ds >> m >> s >> h;
+    t = {m, s, h};
+    return ds;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const AudioEncoding& e)
+{
+    return ds << static_cast<quint8>(e);
+}
+
+static QDataStream& operator>>(QDataStream& ds, AudioEncoding& e)
+{
+    quint8 v;
+    ds >> v;
+    e = static_cast<AudioEncoding>(v);
+    return ds;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const TrackProtection& p)
+{
+    return ds << static_cast<quint8>(p);
+}
+
+static QDataStream& operator>>(QDataStream& ds, TrackProtection& p)
+{
+    quint8 v;
+    ds >> v;
+    p = static_cast<TrackProtection>(v);
+    return ds;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const NetMdTime& t)
+{
+    return ds << quint16(t.hour) << quint8(t.minute) << quint8(t.second) << quint8(t.frame);
+}
+
+static QDataStream& operator>>(QDataStream& ds, NetMdTime& t)
+{
+    return ds >> t.hour >> t.minute >> t.second >> t.frame;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const DiscCapacity& c)
+{
+    return ds << c.recorded << c.total << c.available;
+}
+
+static QDataStream& operator>>(QDataStream& ds, DiscCapacity& c)
+{
+    return ds >> c.recorded >> c.total >> c.available;
+}
+
+static QDataStream& operator<<(QDataStream& ds, const Groups& groups)
+{
+    ds << quint32(groups.size());
+
+    for (const auto& g : groups)
+    {
+        ds << qint32(g.mGid) << qint16(g.mFirst) << qint16(g.mLast) << g.mName;
+    }
+    return ds;
+}
+
+static QDataStream& operator>>(QDataStream& ds, Groups& groups)
+{
+    quint32 count = 0;
+    ds >> count;
+    groups.clear();
+
+    for (quint32 i = 0; (i < count) && (ds.status() == QDataStream::Ok); i++)
+    {
+        qint32 gid;
+        Group  g;
+        ds >> gid >> g.mFirst >> g.mLast >> g.mName;
+        g.mGid = gid;
+        groups.push_back(g);
+    }
+    return ds;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      pack values into byte array
+//!
+//! @param[in]  t     values
+//!
+//! @return     packed values
+//--------------------------------------------------------------------------
+template<typename... T>
+static QByteArray pack(const T&... t)
+{
+    QByteArray  ba;
+    QDataStream ds(&ba, QIODevice::WriteOnly);
+    int dummy[] = {0, ((ds << t), 0)...};
+    Q_UNUSED(dummy)
+    return ba;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      unpack recorded results
+//!
+//! @param[in]  r     record (may be nullptr)
+//! @param[out] t     values
+//!
+//! @return     recorded return value, NETMDERR_USB if there is no record
+//--------------------------------------------------------------------------
+template<typename... T>
+static int played(const CNetMdTrace::SRecord* r, T&... t)
+{
+    if (r == nullptr)
+    {
+        return NETMDERR_USB;
+    }
+
+    QDataStream ds(r->mOut);
+    int dummy[] = {0, ((ds >> t), 0)...};
+    Q_UNUSED(dummy)
+    return r->mRet;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      dev       device to record (recorder takes ownership)
+//! @param[in]  fileName  trace file name
+//--------------------------------------------------------------------------
+CNetMdRecorder::CNetMdRecorder(CNetMdDevice* dev, const QString& fileName)
+    : mpDev(dev), mFile(fileName), mpLogOut(nullptr), mLogTee(this)
+{
+    if (mFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        mStream.setDevice(&mFile);
+        mStream.setVersion(QDataStream::Qt_5_0);
+        mStream << CNetMdTrace::MAGIC << CNetMdTrace::VERSION;
+        qInfo() << "Recording NetMD session to" << fileName;
+    }
+    else
+    {
+        qWarning() << "Can't open trace file" << fileName << "- session isn't recorded!";
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object.
+//--------------------------------------------------------------------------
+CNetMdRecorder::~CNetMdRecorder()
+{
+    mFile.close();
+    delete mpDev;
+}
+
+void CNetMdRecorder::setLogStream(std::ostream& os)
+{
+    mpLogOut = &os;
+    mpDev->setLogStream(mLogTee);
+}
+
+void CNetMdRecorder::setLogLevel(int severity)
+{
+    mpDev->setLogLevel(severity);
+}
+
+int CNetMdRecorder::initDevice()
+{
+    begin();
+    int ret = mpDev->initDevice();
+    end(Op::INIT_DEVICE, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+std::string CNetMdRecorder::getDeviceName() const
+{
+    begin();
+    std::string ret = mpDev->getDeviceName();
+    end(Op::DEVICE_NAME, NETMDERR_NO_ERROR, QByteArray(), pack(ret));
+    return ret;
+}
+
+int CNetMdRecorder::trackCount()
+{
+    begin();
+    int ret = mpDev->trackCount();
+    end(Op::TRACK_COUNT, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::discFlags()
+{
+    begin();
+    int ret = mpDev->discFlags();
+    end(Op::DISC_FLAGS, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::eraseDisc()
+{
+    begin();
+    int ret = mpDev->eraseDisc();
+    end(Op::ERASE_DISC, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::trackTime(int trackNo, TrackTime& trackTime)
+{
+    begin();
+    int ret = mpDev->trackTime(trackNo, trackTime);
+    end(Op::TRACK_TIME, ret, pack(qint32(trackNo)), pack(trackTime));
+    return ret;
+}
+
+int CNetMdRecorder::discTitle(std::string& title)
+{
+    begin();
+    int ret = mpDev->discTitle(title);
+    end(Op::DISC_TITLE, ret, QByteArray(), pack(title));
+    return ret;
+}
+
+int CNetMdRecorder::setDiscTitle(const std::string& title)
+{
+    begin();
+    int ret = mpDev->setDiscTitle(title);
+    end(Op::SET_DISC_TITLE, ret, pack(title), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::setGroupTitle(uint16_t group, const std::string& title)
+{
+    begin();
+    int ret = mpDev->setGroupTitle(group, title);
+    end(Op::SET_GROUP_TITLE, ret, pack(group, title), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::createGroup(const std::string& title, int first, int last)
+{
+    begin();
+    int ret = mpDev->createGroup(title, first, last);
+    end(Op::CREATE_GROUP, ret, pack(title, qint32(first), qint32(last)), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::deleteGroup(int group)
+{
+    begin();
+    int ret = mpDev->deleteGroup(group);
+    end(Op::DELETE_GROUP, ret, pack(qint32(group)), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::deleteTrack(uint16_t track)
+{
+    begin();
+    int ret = mpDev->deleteTrack(track);
+    end(Op::DELETE_TRACK, ret, pack(track), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::trackBitRate(uint16_t track, AudioEncoding& encoding, uint8_t& channel)
+{
+    begin();
+    int ret = mpDev->trackBitRate(track, encoding, channel);
+    end(Op::TRACK_BITRATE, ret, pack(track), pack(encoding, channel));
+    return ret;
+}
+
+int CNetMdRecorder::trackFlags(uint16_t track, TrackProtection& flags)
+{
+    begin();
+    int ret = mpDev->trackFlags(track, flags);
+    end(Op::TRACK_FLAGS, ret, pack(track), pack(flags));
+    return ret;
+}
+
+int CNetMdRecorder::trackTitle(uint16_t track, std::string& title)
+{
+    begin();
+    int ret = mpDev->trackTitle(track, title);
+    end(Op::TRACK_TITLE, ret, pack(track), pack(title));
+    return ret;
+}
+
+bool CNetMdRecorder::spUploadSupported()
+{
+    begin();
+    bool ret = mpDev->spUploadSupported();
+    end(Op::SP_UPLOAD_SUPPORTED, ret ? 1 : 0, QByteArray(), QByteArray());
+    return ret;
+}
+
+bool CNetMdRecorder::otfEncodeSupported()
+{
+    begin();
+    bool ret = mpDev->otfEncodeSupported();
+    end(Op::OTF_ENCODE_SUPPORTED, ret ? 1 : 0, QByteArray(), QByteArray());
+    return ret;
+}
+
+bool CNetMdRecorder::tocManipSupported()
+{
+    begin();
+    bool ret = mpDev->tocManipSupported();
+    end(Op::TOC_MANIP_SUPPORTED, ret ? 1 : 0, QByteArray(), QByteArray());
+    return ret;
+}
+
+bool CNetMdRecorder::pcm2MonoSupported()
+{
+    begin();
+    bool ret = mpDev->pcm2MonoSupported();
+    end(Op::PCM2MONO_SUPPORTED, ret ? 1 : 0, QByteArray(), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::enablePcm2Mono()
+{
+    begin();
+    int ret = mpDev->enablePcm2Mono();
+    end(Op::ENABLE_PCM2MONO, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+void CNetMdRecorder::disablePcm2Mono()
+{
+    begin();
+    mpDev->disablePcm2Mono();
+    end(Op::DISABLE_PCM2MONO, NETMDERR_NO_ERROR, QByteArray(), QByteArray());
+}
+
+int CNetMdRecorder::sendAudioFile(const std::string& filename, const std::string& title, DiskFormat otf)
+{
+    begin();
+    int ret = mpDev->sendAudioFile(filename, title, otf);
+    end(Op::SEND_AUDIO_FILE, ret, pack(title, quint8(otf)), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::setTrackTitle(uint16_t trackNo, const std::string& title)
+{
+    begin();
+    int ret = mpDev->setTrackTitle(trackNo, title);
+    end(Op::SET_TRACK_TITLE, ret, pack(trackNo, title), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::discCapacity(DiscCapacity& dcap)
+{
+    begin();
+    int ret = mpDev->discCapacity(dcap);
+    end(Op::DISC_CAPACITY, ret, QByteArray(), pack(dcap));
+    return ret;
+}
+
+Groups CNetMdRecorder::groups()
+{
+    begin();
+    Groups ret = mpDev->groups();
+    end(Op::GROUPS, NETMDERR_NO_ERROR, QByteArray(), pack(ret));
+    return ret;
+}
+
+int CNetMdRecorder::prepareTOCManip()
+{
+    begin();
+    int ret = mpDev->prepareTOCManip();
+    end(Op::PREPARE_TOC_MANIP, ret, QByteArray(), QByteArray());
+    return ret;
+}
+
+NetMDByteVector CNetMdRecorder::readUTOCSector(UTOCSector s)
+{
+    begin();
+    NetMDByteVector ret = mpDev->readUTOCSector(s);
+    end(Op::READ_UTOC_SECTOR, NETMDERR_NO_ERROR, pack(quint16(s)), pack(ret));
+    return ret;
+}
+
+int CNetMdRecorder::writeUTOCSector(UTOCSector s, const NetMDByteVector& data)
+{
+    begin();
+    int ret = mpDev->writeUTOCSector(s, data);
+    end(Op::WRITE_UTOC_SECTOR, ret, pack(quint16(s), data), QByteArray());
+    return ret;
+}
+
+int CNetMdRecorder::finalizeTOC(bool reset, uint8_t resetWait)
+{
+    begin();
+    int ret = mpDev->finalizeTOC(reset, resetWait);
+    end(Op::FINALIZE_TOC, ret, pack(reset, resetWait), QByteArray());
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      call starts, reset timer and log capture
+//--------------------------------------------------------------------------
+void CNetMdRecorder::begin() const
+{
+    mLog.clear();
+    mTimer.start();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      call has ended, write record
+//!
+//! @param[in]  op    The call
+//! @param[in]  ret   The return value
+//! @param[in]  in    packed arguments
+//! @param[in]  out   packed results
+//--------------------------------------------------------------------------
+void CNetMdRecorder::end(Op op, int ret, const QByteArray& in, const QByteArray& out) const
+{
+    if (mFile.isOpen())
+    {
+        mStream << static_cast<quint8>(op) << static_cast<quint32>(mTimer.nsecsElapsed() / 1000)
+                << static_cast<qint32>(ret) << in << out << mLog;
+        mFile.flush();
+    }
+    mLog.clear();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      log character from device, forwarded to log stream
+//!
+//! @param[in]  c     character
+//!
+//! @return     character or EOF
+//--------------------------------------------------------------------------
+CNetMdRecorder::int_type CNetMdRecorder::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        return traits_type::not_eof(c);
+    }
+
+    char ch = traits_type::to_char_type(c);
+
+    if (mpLogOut != nullptr)
+    {
+        mpLogOut->put(ch);
+    }
+
+    mLine += ch;
+
+    if ((ch == '\n') || (ch == '\r'))
+    {
+        quint32 offs = mTimer.isValid() ? static_cast<quint32>(mTimer.nsecsElapsed() / 1000) : 0;
+        mLog.append(qMakePair(offs, mLine));
+        mLine.clear();
+    }
+
+    return c;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      flush log stream
+//!
+//! @return     0
+//--------------------------------------------------------------------------
+int CNetMdRecorder::sync()
+{
+    if (mpLogOut != nullptr)
+    {
+        mpLogOut->flush();
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param[in]  fileName  trace file name
+//! @param[in]  scale     time scale (1.0 -> original timing, 0 -> no delay)
+//--------------------------------------------------------------------------
+CNetMdReplayDevice::CNetMdReplayDevice(const QString& fileName, double scale)
+    : mCursor(0), mScale(qMax(0.0, scale)), mpLog(nullptr)
+{
+    QFile f(fileName);
+
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Can't open trace file" << fileName;
+        return;
+    }
+
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic   = 0;
+    quint16 version = 0;
+    ds >> magic >> version;
+
+    if ((magic != CNetMdTrace::MAGIC) || (version != CNetMdTrace::VERSION))
+    {
+        qWarning() << fileName << "isn't a NetMD trace file (or has an unsupported version)!";
+        return;
+    }
+
+    while (!ds.atEnd())
+    {
+        quint8 op;
+        CNetMdTrace::SRecord r;
+        ds >> op >> r.mDurUs >> r.mRet >> r.mIn >> r.mOut >> r.mLog;
+
+        if (ds.status() != QDataStream::Ok)
+        {
+            qWarning() << "Trace file" << fileName << "is truncated after" << mRecords.size() << "records.";
+            break;
+        }
+
+        r.mOp = static_cast<Op>(op);
+        mRecords.append(r);
+    }
+
+    qInfo() << "Replaying" << mRecords.size() << "NetMD calls from" << fileName << "with time scale" << mScale;
+}
+
+void CNetMdReplayDevice::setLogStream(std::ostream& os)
+{
+    mpLog = &os;
+}
+
+void CNetMdReplayDevice::setLogLevel(int severity)
+{
+    // log output is replayed as recorded
+    Q_UNUSED(severity)
+}
+
+int CNetMdReplayDevice::initDevice()
+{
+    return played(replay(Op::INIT_DEVICE, QByteArray()));
+}
+
+std::string CNetMdReplayDevice::getDeviceName() const
+{
+    std::string ret;
+    played(replay(Op::DEVICE_NAME, QByteArray()), ret);
+    return ret;
+}
+
+int CNetMdReplayDevice::trackCount()
+{
+    return played(replay(Op::TRACK_COUNT, QByteArray()));
+}
+
+int CNetMdReplayDevice::discFlags()
+{
+    return played(replay(Op::DISC_FLAGS, QByteArray()));
+}
+
+int CNetMdReplayDevice::eraseDisc()
+{
+    return played(replay(Op::ERASE_DISC, QByteArray()));
+}
+
+int CNetMdReplayDevice::trackTime(int trackNo, TrackTime& trackTime)
+{
+    return played(replay(Op::TRACK_TIME, pack(qint32(trackNo))), trackTime);
+}
+
+int CNetMdReplayDevice::discTitle(std::string& title)
+{
+    return played(replay(Op::DISC_TITLE, QByteArray()), title);
+}
+
+int CNetMdReplayDevice::setDiscTitle(const std::string& title)
+{
+    return played(replay(Op::SET_DISC_TITLE, pack(title)));
+}
+
+int CNetMdReplayDevice::setGroupTitle(uint16_t group, const std::string& title)
+{
+    return played(replay(Op::SET_GROUP_TITLE, pack(group, title)));
+}
+
+int CNetMdReplayDevice::createGroup(const std::string& title, int first, int last)
+{
+    return played(replay(Op::CREATE_GROUP, pack(title, qint32(first), qint32(last))));
+}
+
+int CNetMdReplayDevice::deleteGroup(int group)
+{
+    return played(replay(Op::DELETE_GROUP, pack(qint32(group))));
+}
+
+int CNetMdReplayDevice::deleteTrack(uint16_t track)
+{
+    return played(replay(Op::DELETE_TRACK, pack(track)));
+}
+
+int CNetMdReplayDevice::trackBitRate(uint16_t track, AudioEncoding& encoding, uint8_t& channel)
+{
+    return played(replay(Op::TRACK_BITRATE, pack(track)), encoding, channel);
+}
+
+int CNetMdReplayDevice::trackFlags(uint16_t track, TrackProtection& flags)
+{
+    return played(replay(Op::TRACK_FLAGS, pack(track)), flags);
+}
+
+int CNetMdReplayDevice::trackTitle(uint16_t track, std::string& title)
+{
+    return played(replay(Op::TRACK_TITLE, pack(track)), title);
+}
+
+bool CNetMdReplayDevice::spUploadSupported()
+{
+    return played(replay(Op::SP_UPLOAD_SUPPORTED, QByteArray())) == 1;
+}
+
+bool CNetMdReplayDevice::otfEncodeSupported()
+{
+    return played(replay(Op::OTF_ENCODE_SUPPORTED, QByteArray())) == 1;
+}
+
+bool CNetMdReplayDevice::tocManipSupported()
+{
+    return played(replay(Op::TOC_MANIP_SUPPORTED, QByteArray())) == 1;
+}
+
+bool CNetMdReplayDevice::pcm2MonoSupported()
+{
+    return played(replay(Op::PCM2MONO_SUPPORTED, QByteArray())) == 1;
+}
+
+int CNetMdReplayDevice::enablePcm2Mono()
+{
+    return played(replay(Op::ENABLE_PCM2MONO, QByteArray()));
+}
+
+void CNetMdReplayDevice::disablePcm2Mono()
+{
+    replay(Op::DISABLE_PCM2MONO, QByteArray());
+}
+
+int CNetMdReplayDevice::sendAudioFile(const std::string& filename, const std::string& title, DiskFormat otf)
+{
+    // file names differ between machines, the title identifies the call
+    Q_UNUSED(filename)
+    return played(replay(Op::SEND_AUDIO_FILE, pack(title, quint8(otf))));
+}
+
+int CNetMdReplayDevice::setTrackTitle(uint16_t trackNo, const std::string& title)
+{
+    return played(replay(Op::SET_TRACK_TITLE, pack(trackNo, title)));
+}
+
+int CNetMdReplayDevice::discCapacity(DiscCapacity& dcap)
+{
+    return played(replay(Op::DISC_CAPACITY, QByteArray()), dcap);
+}
+
+Groups CNetMdReplayDevice::groups()
+{
+    Groups ret;
+    played(replay(Op::GROUPS, QByteArray()), ret);
+    return ret;
+}
+
+int CNetMdReplayDevice::prepareTOCManip()
+{
+    return played(replay(Op::PREPARE_TOC_MANIP, QByteArray()));
+}
+
+NetMDByteVector CNetMdReplayDevice::readUTOCSector(UTOCSector s)
+{
+    NetMDByteVector ret;
+    played(replay(Op::READ_UTOC_SECTOR, pack(quint16(s))), ret);
+    return ret;
+}
+
+int CNetMdReplayDevice::writeUTOCSector(UTOCSector s, const NetMDByteVector& data)
+{
+    return played(replay(Op::WRITE_UTOC_SECTOR, pack(quint16(s), data)));
+}
+
+int CNetMdReplayDevice::finalizeTOC(bool reset, uint8_t resetWait)
+{
+    return played(replay(Op::FINALIZE_TOC, pack(reset, resetWait)));
+}
+
+//--------------------------------------------------------------------------
+//! @brief      find next matching record and play its timing and log
+//!
+//! @param[in]  op    The call
+//! @param[in]  in    packed arguments
+//!
+//! @return     record, nullptr if there is none
+//--------------------------------------------------------------------------
+const CNetMdTrace::SRecord* CNetMdReplayDevice::replay(Op op, const QByteArray& in) const
+{
+    auto find = [&](int from, int to, bool args)->int {
+        for (int i = from; i < to; i++)
+        {
+            if ((mRecords.at(i).mOp == op) && (!args || (mRecords.at(i).mIn == in)))
+            {
+                return i;
+            }
+        }
+        return -1;
+    };
+
+    // same call with same arguments ahead, behind; then same call only
+    int idx = find(mCursor, mRecords.size(), true);
+
+    if (idx < 0)
+    {
+        idx = find(0, mCursor, true);
+    }
+
+    if (idx < 0)
+    {
+        idx = find(mCursor, mRecords.size(), false);
+    }
+
+    if (idx < 0)
+    {
+        idx = find(0, mCursor, false);
+    }
+
+    if (idx < 0)
+    {
+        qWarning() << "No recorded call for opcode" << static_cast<int>(op);
+        return nullptr;
+    }
+
+    mCursor = idx + 1;
+
+    const CNetMdTrace::SRecord& r = mRecords.at(idx);
+    QElapsedTimer timer;
+    timer.start();
+
+    auto waitUntil = [&](quint32 us) {
+        qint64 target = static_cast<qint64>(us * mScale);
+        qint64 now    = timer.nsecsElapsed() / 1000;
+
+        if (target > now)
+        {
+            QThread::usleep(static_cast<unsigned long>(target - now));
+        }
+    };
+
+    for (const auto& l : r.mLog)
+    {
+        waitUntil(l.first);
+
+        if (mpLog != nullptr)
+        {
+            mpLog->write(l.second.constData(), l.second.size());
+            mpLog->flush();
+        }
+    }
+
+    waitUntil(r.mDurUs);
+    return &r;
+}
@@ -0,0 +1,277 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QPair>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <streambuf>
+#include <ostream>
+#include "cnetmddevice.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Trace file format shared by recorder and replay device.
+//!             A trace is a header (magic, version) followed by one record
+//!             per device call: opcode, duration, return value, packed
+//!             arguments, packed results and the log lines written during
+//!             the call (with their time offset). All data is written
+//!             with QDataStream.
+//------------------------------------------------------------------------------
+class CNetMdTrace
+{
+public:
+    /// recorded device calls
+    enum class Op : quint8
+    {
+        INIT_DEVICE,
+        DEVICE_NAME,
+        TRACK_COUNT,
+        DISC_FLAGS,
+        ERASE_DISC,
+        TRACK_TIME,
+        DISC_TITLE,
+        SET_DISC_TITLE,
+        SET_GROUP_TITLE,
+        CREATE_GROUP,
+        DELETE_GROUP,
+        DELETE_TRACK,
+        TRACK_BITRATE,
+        TRACK_FLAGS,
+        TRACK_TITLE,
+        SP_UPLOAD_SUPPORTED,
+        OTF_ENCODE_SUPPORTED,
+        TOC_MANIP_SUPPORTED,
+        PCM2MONO_SUPPORTED,
+        ENABLE_PCM2MONO,
+        DISABLE_PCM2MONO,
+        SEND_AUDIO_FILE,
+        SET_TRACK_TITLE,
+        DISC_CAPACITY,
+        GROUPS,
+        PREPARE_TOC_MANIP,
+        READ_UTOC_SECTOR,
+        WRITE_UTOC_SECTOR,
+        FINALIZE_TOC
+    };
+
+    /// log line written during a call: offset in us and raw text
+    using LogLine = QPair<quint32, QByteArray>;
+
+    /// one device call
+    struct SRecord
+    {
+        Op               mOp;       ///< call
+        quint32          mDurUs;    ///< duration in us
+        qint32           mRet;      ///< return value
+        QByteArray       mIn;       ///< packed arguments
+        QByteArray       mOut;      ///< packed results
+        QVector<LogLine> mLog;      ///< log output
+    };
+
+    /// trace file magic ("NMTR")
+    static constexpr quint32 MAGIC = 0x4e4d5452;
+
+    /// trace file version
+    static constexpr quint16 VERSION = 1;
+};
+
+//------------------------------------------------------------------------------
+//! @brief      Records all calls to a NetMD device (and the log output they
+//!             produce) into a trace file, passing them through unchanged.
+//------------------------------------------------------------------------------
+class CNetMdRecorder : public CNetMdDevice, protected std::streambuf
+{
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      dev       device to record (recorder takes ownership)
+    //! @param[in]  fileName  trace file name
+    //--------------------------------------------------------------------------
+    CNetMdRecorder(CNetMdDevice* dev, const QString& fileName);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object.
+    //--------------------------------------------------------------------------
+    ~CNetMdRecorder() override;
+
+    void setLogStream(std::ostream& os) override;
+    void setLogLevel(int severity) override;
+    int initDevice() override;
+    std::string getDeviceName() const override;
+    int trackCount() override;
+    int discFlags() override;
+    int eraseDisc() override;
+    int trackTime(int trackNo, netmd::TrackTime& trackTime) override;
+    int discTitle(std::string& title) override;
+    int setDiscTitle(const std::string& title) override;
+    int setGroupTitle(uint16_t group, const std::string& title) override;
+    int createGroup(const std::string& title, int first, int last) override;
+    int deleteGroup(int group) override;
+    int deleteTrack(uint16_t track) override;
+    int trackBitRate(uint16_t track, netmd::AudioEncoding& encoding, uint8_t& channel) override;
+    int trackFlags(uint16_t track, netmd::TrackProtection& flags) override;
+    int trackTitle(uint16_t track, std::string& title) override;
+    bool spUploadSupported() override;
+    bool otfEncodeSupported() override;
+    bool tocManipSupported() override;
+    bool pcm2MonoSupported() override;
+    int enablePcm2Mono() override;
+    void disablePcm2Mono() override;
+    int sendAudioFile(const std::string& filename, const std::string& title, netmd::DiskFormat otf) override;
+    int setTrackTitle(uint16_t trackNo, const std::string& title) override;
+    int discCapacity(netmd::DiscCapacity& dcap) override;
+    netmd::Groups groups() override;
+    int prepareTOCManip() override;
+    netmd::NetMDByteVector readUTOCSector(netmd::UTOCSector s) override;
+    int writeUTOCSector(netmd::UTOCSector s, const netmd::NetMDByteVector& data) override;
+    int finalizeTOC(bool reset = false, uint8_t resetWait = 15) override;
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      call starts, reset timer and log capture
+    //--------------------------------------------------------------------------
+    void begin() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      call has ended, write record
+    //!
+    //! @param[in]  op    The call
+    //! @param[in]  ret   The return value
+    //! @param[in]  in    packed arguments
+    //! @param[in]  out   packed results
+    //--------------------------------------------------------------------------
+    void end(CNetMdTrace::Op op, int ret, const QByteArray& in, const QByteArray& out) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      log character from device, forwarded to log stream
+    //!
+    //! @param[in]  c     character
+    //!
+    //! @return     character or EOF
+    //--------------------------------------------------------------------------
+    int_type overflow(int_type c) override;
+
+    //--------------------------------------------------------------------------
+    //! @brief      flush log stream
+    //!
+    //! @return     0
+    //--------------------------------------------------------------------------
+    int sync() override;
+
+private:
+    /// recorded device
+    CNetMdDevice* mpDev;
+
+    /// trace file
+    mutable QFile mFile;
+
+    /// trace stream
+    mutable QDataStream mStream;
+
+    /// call timer
+    mutable QElapsedTimer mTimer;
+
+    /// log lines of current call
+    mutable QVector<CNetMdTrace::LogLine> mLog;
+
+    /// current log line
+    QByteArray mLine;
+
+    /// log stream of the application
+    std::ostream* mpLogOut;
+
+    /// log stream handed to the device
+    std::ostream mLogTee;
+};
+
+//------------------------------------------------------------------------------
+//! @brief      Plays back a recorded trace as NetMD device. Calls are
+//!             matched by opcode and arguments, the results, return values,
+//!             log output and timing (optionally scaled) are the recorded
+//!             ones.
+//------------------------------------------------------------------------------
+class CNetMdReplayDevice : public CNetMdDevice
+{
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param[in]  fileName  trace file name
+    //! @param[in]  scale     time scale (1.0 -> original timing, 0 -> no delay)
+    //--------------------------------------------------------------------------
+    CNetMdReplayDevice(const QString& fileName, double scale = 1.0);
+
+    void setLogStream(std::ostream& os) override;
+    void setLogLevel(int severity) override;
+    int initDevice() override;
+    std::string getDeviceName() const override;
+    int trackCount() override;
+    int discFlags() override;
+    int eraseDisc() override;
+    int trackTime(int trackNo, netmd::TrackTime& trackTime) override;
+    int discTitle(std::string& title) override;
+    int setDiscTitle(const std::string& title) override;
+    int setGroupTitle(uint16_t group, const std::string& title) override;
+    int createGroup(const std::string& title, int first, int last) override;
+    int deleteGroup(int group) override;
+    int deleteTrack(uint16_t track) override;
+    int trackBitRate(uint16_t track, netmd::AudioEncoding& encoding, uint8_t& channel) override;
+    int trackFlags(uint16_t track, netmd::TrackProtection& flags) override;
+    int trackTitle(uint16_t track, std::string& title) override;
+    bool spUploadSupported() override;
+    bool otfEncodeSupported() override;
+    bool tocManipSupported() override;
+    bool pcm2MonoSupported() override;
+    int enablePcm2Mono() override;
+    void disablePcm2Mono() override;
+    int sendAudioFile(const std::string& filename, const std::string& title, netmd::DiskFormat otf) override;
+    int setTrackTitle(uint16_t trackNo, const std::string& title) override;
+    int discCapacity(netmd::DiscCapacity& dcap) override;
+    netmd::Groups groups() override;
+    int prepareTOCManip() override;
+    netmd::NetMDByteVector readUTOCSector(netmd::UTOCSector s) override;
+    int writeUTOCSector(netmd::UTOCSector s, const netmd::NetMDByteVector& data) override;
+    int finalizeTOC(bool reset = false, uint8_t resetWait = 15) override;
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      find next matching record and play its timing and log
+    //!
+    //! @param[in]  op    The call
+    //! @param[in]  in    packed arguments
+    //!
+    //! @return     record, nullptr if there is none
+    //--------------------------------------------------------------------------
+    const CNetMdTrace::SRecord* replay(CNetMdTrace::Op op, const QByteArray& in) const;
+
+private:
+    /// all records
+    QVector<CNetMdTrace::SRecord> mRecords;
+
+    /// next record to look at
+    mutable int mCursor;
+
+    /// time scale
+    double mScale;
+
+    /// log output
+    std::ostream* mpLog;
+};
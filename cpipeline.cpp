@@ -0,0 +1,1135 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cpipeline.h"
+#include "helpers.h"
+#include <QFile>
+#include <QThread>
+#include <QtDebug>
+#include <algorithm>
+#include <cmath>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      pRipper     The ripper / decoder
+//! @param      pNetMD      The NetMD device
+//! @param      pMirrors    additional recorders (may be nullptr)
+//! @param      pCache      artifact cache
+//! @param      pPlacement  placement policy (gets speed samples)
+//! @param      parent      The parent
+//--------------------------------------------------------------------------
+CPipeline::CPipeline(CJackTheRipper* pRipper, CNetMD* pNetMD, CNetMdMirrors* pMirrors,
+                     CArtifactCache* pCache, CPlacementPolicy* pPlacement, QObject* parent)
+    : QObject(parent), mpRipper(pRipper), mpNetMD(pNetMD), mpMirrors(pMirrors),
+      mpCache(pCache), mpPlacement(pPlacement),
+      mConcurrency{1, qMax(1, QThread::idealThreadCount() / 2), 1},
+      mQueueLimit(DEF_QUEUE_LIMIT), mbRunning(false), mbSpeculative(false),
+      mbPending(false), mRipIdx(-1), mXferIdx(-1), mCommit(0), mbTocEdit(false),
+      mXferStart(0)
+{
+    mClock.start();
+
+    connect(mpRipper, &CJackTheRipper::finished, this, &CPipeline::ripDone);
+    connect(mpRipper, &CJackTheRipper::progress, this, [this](int percent) {
+        if (mRipIdx != -1)
+        {
+            emit progress(Stage::RIP, percent);
+        }
+    });
+
+    connect(mpCache, &CArtifactCache::done, this, &CPipeline::cacheDone);
+    connect(mpNetMD, &CNetMD::finished, this, [this](bool, int ret) { transferDone(ret); });
+    connect(mpNetMD, &CNetMD::progress, this, [this](int percent) {
+        if ((mXferIdx != -1) || mbTocEdit)
+        {
+            emit progress(Stage::TRANSFER, percent);
+        }
+    });
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of tracks a stage works on in parallel
+//!             (transfer is always 1, CD rip is always 1)
+//!
+//! @param[in]  stage  The stage
+//! @param[in]  count  The count
+//--------------------------------------------------------------------------
+void CPipeline::setConcurrency(Stage stage, int count)
+{
+    // one device, one transfer
+    mConcurrency[static_cast<int>(stage)] = (stage == Stage::TRANSFER) ? 1 : qMax(1, count);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get number of tracks a stage works on in parallel
+//!
+//! @param[in]  stage  The stage
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CPipeline::concurrency(Stage stage) const
+{
+    return mConcurrency[static_cast<int>(stage)];
+}
+
+//--------------------------------------------------------------------------
+//! @brief      set number of tracks which may wait between two stages
+//!
+//! @param[in]  count  The count (0 -> unbounded)
+//--------------------------------------------------------------------------
+void CPipeline::setQueueLimit(int count)
+{
+    mQueueLimit = qMax(0, count);
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start transfer; results of a background preparation are
+//!             taken over, a running background rip is waited for
+//!
+//! @param[in]  tracks  source tracks (index 0 is the disc entry)
+//! @param[in]  queue   work queue
+//! @param[in]  cfg     settings
+//!
+//! @return     true if started (or waiting)
+//--------------------------------------------------------------------------
+bool CPipeline::start(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg)
+{
+    if (mbRunning || queue.isEmpty())
+    {
+        return false;
+    }
+
+    if (mbSpeculative && (mRipIdx != -1))
+    {
+        // let the ripper finish the track it works on
+        qInfo() << "Wait for background rip to finish ...";
+        mPendTracks = tracks;
+        mPendQueue  = queue;
+        mPendCfg    = cfg;
+        mbPending   = true;
+        return true;
+    }
+
+    TransferQueue specQueue;
+    bool wasSpeculative = mbSpeculative;
+
+    if (wasSpeculative)
+    {
+        specQueue = mQueue;
+    }
+
+    setup(tracks, queue, cfg);
+    mbSpeculative = false;
+
+    QStringList keep;
+
+    if (wasSpeculative)
+    {
+        adopt(specQueue);
+
+        for (const auto& j : mQueue)
+        {
+            keep << j.mFileName;
+        }
+    }
+
+    // background decodes of dropped tracks belong to the old queue,
+    // the ones of adopted tracks go on
+    mpRipper->cancel(keep);
+    mpRipper->setLowPriority(false);
+    cleanTrash();
+
+    for (auto* pEnc : mIdleEnc + mEncoders.keys())
+    {
+        pEnc->setLowPriority(false);
+    }
+
+    // adopted tracks skip stages
+    for (int i = 0; i < mQueue.size(); i++)
+    {
+        if (mQueue.at(i).mStep == WorkStep::RIPPED)
+        {
+            mEncQ.append(i);
+        }
+    }
+
+    mbRunning = true;
+
+    qInfo() << "Start transfer of" << mQueue.size() << "track(s), mode:" << static_cast<const char*>(mCfg.mMode);
+
+    prefetch();
+    schedule();
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start background preparation (rip / encode only,
+//!             low priority)
+//!
+//! @param[in]  tracks  source tracks (index 0 is the disc entry)
+//! @param[in]  queue   work queue
+//! @param[in]  cfg     settings
+//!
+//! @return     true if started
+//--------------------------------------------------------------------------
+bool CPipeline::prepare(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg)
+{
+    if (busy() || queue.isEmpty())
+    {
+        return false;
+    }
+
+    setup(tracks, queue, cfg);
+    mbSpeculative = true;
+    mpRipper->setLowPriority(true);
+
+    qInfo() << "Start background preparation of" << mQueue.size() << "track(s), mode:"
+            << static_cast<const char*>(mCfg.mMode);
+
+    prefetch();
+    schedule();
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop background preparation and drop its results
+//--------------------------------------------------------------------------
+void CPipeline::stop()
+{
+    if (!mbSpeculative)
+    {
+        return;
+    }
+
+    qInfo() << "Stop background preparation.";
+
+    mpRipper->cancel();
+    killEncoders();
+    cancelCacheJobs();
+
+    for (const auto& s : mQueue)
+    {
+        mTrash << s.mFileName << (s.mFileName + ".aea") << (s.mFileName + ".at3");
+    }
+
+    mQueue.clear();
+    mRipQ.clear();
+    mEncQ.clear();
+    mRipIdx        = -1;
+    mbSpeculative  = false;
+    mbPending      = false;
+
+    cleanTrash();
+    mpRipper->removeTemp();
+    mpRipper->setLowPriority(false);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is a transfer or a background preparation active
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CPipeline::busy() const
+{
+    return mbRunning || mbSpeculative;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is background preparation active
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CPipeline::preparing() const
+{
+    return mbSpeculative;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get work queue of current run
+//!
+//! @return     work queue
+//--------------------------------------------------------------------------
+const CPipeline::TransferQueue& CPipeline::queue() const
+{
+    return mQueue;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of tracks which passed a stage (or are in it)
+//!
+//! @param[in]  stage  The stage
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CPipeline::done(Stage stage) const
+{
+    WorkStep before = (stage == Stage::RIP) ? WorkStep::NONE
+                    : (stage == Stage::ENCODE) ? WorkStep::RIPPED : WorkStep::ENCODED;
+    int count = 0;
+
+    for (const auto& j : mQueue)
+    {
+        if (static_cast<uint8_t>(j.mStep) > static_cast<uint8_t>(before))
+        {
+            count ++;
+        }
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of work units of a stage
+//!
+//! @param[in]  stage  The stage
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CPipeline::total(Stage stage) const
+{
+    // DAO rips and encodes the disc in one go
+    if (mCfg.mMode.isDao() && (stage != Stage::TRANSFER))
+    {
+        return 1;
+    }
+    else if (mCfg.mMode.tocManip() && (stage == Stage::TRANSFER))
+    {
+        return 1;
+    }
+    return mQueue.size();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      reset run state, set up stage queues
+//!
+//! @param[in]  tracks  source tracks
+//! @param[in]  queue   work queue
+//! @param[in]  cfg     settings
+//--------------------------------------------------------------------------
+void CPipeline::setup(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg)
+{
+    mpRipper->setAudioTracks(tracks);
+
+    mCfg       = cfg;
+    mQueue     = queue;
+    mRipIdx    = -1;
+    mXferIdx   = -1;
+    mCommit    = 0;
+    mbTocEdit  = false;
+    mbPending  = false;
+    mRipQ.clear();
+    mEncQ.clear();
+
+    for (int i = 0; i < mQueue.size(); i++)
+    {
+        mRipQ.append(i);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      take over results of background preparation (files of
+//!             dropped tracks go to trash, the caller cleans up; pending
+//!             background decodes of adopted tracks are picked up by
+//!             the rip stage)
+//!
+//! @param[in]  specQueue  The background work queue
+//--------------------------------------------------------------------------
+void CPipeline::adopt(const TransferQueue& specQueue)
+{
+    using XEncCmd = CXEnc::XEncCmd;
+    QMap<CXEnc*, int> encoders = mEncoders;
+    QMap<int, SCacheJob> cacheJobs = mCacheJobs;
+    int adopted = 0;
+
+    mEncoders.clear();
+    mCacheJobs.clear();
+
+    for (int i = 0; i < specQueue.size(); i++)
+    {
+        const c2n::SRipTrack& s = specQueue.at(i);
+        int used = -1;
+
+        // file track still in (or done by) the decoder pool
+        bool decoding = (s.mStep == WorkStep::NONE) && !s.mIsCD && mpRipper->prefetched(s.mFileName);
+
+        if (((s.mStep != WorkStep::NONE) && (s.mStep != WorkStep::FAILED)) || decoding)
+        {
+            for (int k = 0; k < mQueue.size(); k++)
+            {
+                c2n::SRipTrack& j = mQueue[k];
+
+                if ((j.mStep != WorkStep::NONE) || (j.mKey != s.mKey))
+                {
+                    continue;
+                }
+
+                j.mFileName = s.mFileName;
+                j.mPcmHash  = s.mPcmHash;
+
+                if ((s.mStep == WorkStep::RIPPED)
+                    || ((s.mStep == WorkStep::ENCODED) && (mCfg.mMode.xencCmd(s.mOtf) == XEncCmd::NONE)))
+                {
+                    // PCM data available -> route can still be chosen
+                    j.mStep = ripped(j);
+                }
+                else if (!decoding)
+                {
+                    // encoded (or in encoder) on host
+                    j.mStep = s.mStep;
+                    j.mOtf  = s.mOtf;
+                }
+
+                used = k;
+                adopted ++;
+                break;
+            }
+        }
+
+        // running encoder keeps working for the new queue
+        for (auto it = encoders.begin(); it != encoders.end(); it++)
+        {
+            if (it.value() == i)
+            {
+                if (used != -1)
+                {
+                    mEncoders.insert(it.key(), used);
+                }
+                else
+                {
+                    qInfo() << "Stop encoder of dropped track" << s.mTitle;
+                    it.key()->kill();
+                    it.key()->waitForFinished();
+                    mEncStart.remove(it.key());
+                    mIdleEnc.append(it.key());
+                }
+                break;
+            }
+        }
+
+        // running cache copy keeps working for the new queue
+        for (auto it = cacheJobs.begin(); it != cacheJobs.end(); it++)
+        {
+            if (it.value().mIdx == i)
+            {
+                if (used != -1)
+                {
+                    mCacheJobs.insert(it.key(), {used, it.value().mStage, it.value().mbFetch});
+                }
+                else
+                {
+                    mpCache->cancel(it.key());
+                }
+            }
+        }
+
+        if (used == -1)
+        {
+            // not part of the transfer -> drop it
+            mTrash << s.mFileName << (s.mFileName + ".aea") << (s.mFileName + ".at3");
+        }
+    }
+
+    qInfo() << "Adopted" << adopted << "track(s) from background preparation.";
+}
+
+//--------------------------------------------------------------------------
+//! @brief      feed all stages
+//--------------------------------------------------------------------------
+void CPipeline::schedule()
+{
+    if (!busy())
+    {
+        return;
+    }
+
+    scheduleRip();
+    scheduleEncode();
+    scheduleTransfer();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start next rip if possible
+//--------------------------------------------------------------------------
+void CPipeline::scheduleRip()
+{
+    if (mRipIdx != -1)
+    {
+        return;
+    }
+
+    if (mCfg.mMode.isDao())
+    {
+        // whole disc in one file
+        if (!mQueue.isEmpty() && (mQueue.at(0).mStep == WorkStep::NONE))
+        {
+            mRipQ.clear();
+            mRipIdx = 0;
+            mQueue[0].mStep = WorkStep::RIP;
+            emit stageStarted(Stage::RIP, 0);
+            mpRipper->extractTrack(-1, mQueue.at(0).mFileName, &mCfg.mParanoia);
+        }
+        return;
+    }
+
+    while (!mRipQ.isEmpty())
+    {
+        int idx = mRipQ.first();
+
+        // backpressure: don't rip ahead too far, but never block the track
+        // the transfer waits for
+        if (mbRunning && (mQueueLimit > 0) && (idx != mCommit)
+            && (waiting(WorkStep::RIPPED, WorkStep::ENCODED) >= mQueueLimit))
+        {
+            break;
+        }
+
+        mRipQ.removeFirst();
+        c2n::SRipTrack& j = mQueue[idx];
+
+        if (j.mStep != WorkStep::NONE)
+        {
+            // adopted from background preparation
+            continue;
+        }
+
+        int job = mpCache->fetch(j.mPcmKey, j.mFileName);
+
+        mRipIdx = idx;
+        emit stageStarted(Stage::RIP, idx);
+
+        j.mStep = WorkStep::RIP;
+
+        if (job != CArtifactCache::NO_JOB)
+        {
+            // no rip needed, wait for the copy
+            mCacheJobs.insert(job, {idx, Stage::RIP, true});
+        }
+        else
+        {
+            mpRipper->extractTrack(j.mCDTrackNo, j.mFileName, &mCfg.mParanoia);
+        }
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start encoders if possible
+//--------------------------------------------------------------------------
+void CPipeline::scheduleEncode()
+{
+    if (mCfg.mMode.isDao())
+    {
+        // whole disc, encoder splits tracks
+        if (!mQueue.isEmpty() && (mQueue.at(0).mStep == WorkStep::RIPPED) && mEncoders.isEmpty())
+        {
+            mEncQ.clear();
+            mQueue[0].mStep = WorkStep::ENCODE;
+
+            CXEnc* pEnc = encoder();
+            mEncoders.insert(pEnc, 0);
+            mEncStart.insert(pEnc, mClock.elapsed());
+            emit stageStarted(Stage::ENCODE, 0);
+            pEnc->start(mCfg.mMode.xencCmd(mQueue.at(0).mOtf), mQueue,
+                        static_cast<double>(mCfg.mDiscBlocks) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC),
+                        mCfg.mAt3Tool);
+        }
+        return;
+    }
+
+    std::sort(mEncQ.begin(), mEncQ.end());
+
+    while (!mEncQ.isEmpty() && (mEncoders.size() < concurrency(Stage::ENCODE)))
+    {
+        int idx = mEncQ.first();
+
+        // backpressure: don't encode ahead too far, but never block
+        // the track the transfer waits for
+        if (mbRunning && (mQueueLimit > 0) && (idx != mCommit)
+            && (waiting(WorkStep::ENCODED, WorkStep::ENCODED) >= mQueueLimit))
+        {
+            break;
+        }
+
+        mEncQ.removeFirst();
+        c2n::SRipTrack& j = mQueue[idx];
+
+        if (j.mStep != WorkStep::RIPPED)
+        {
+            continue;
+        }
+
+        int job = mpCache->fetch(atracKey(j), j.mFileName);
+
+        if (job != CArtifactCache::NO_JOB)
+        {
+            // no encoder needed, wait for the copy
+            j.mStep = WorkStep::ENCODE;
+            mCacheJobs.insert(job, {idx, Stage::ENCODE, true});
+            emit stageStarted(Stage::ENCODE, idx);
+            continue;
+        }
+
+        j.mStep = WorkStep::ENCODE;
+
+        CXEnc* pEnc = encoder();
+        mEncoders.insert(pEnc, idx);
+        mEncStart.insert(pEnc, mClock.elapsed());
+        emit stageStarted(Stage::ENCODE, idx);
+        pEnc->start(mCfg.mMode.xencCmd(j.mOtf), j.mFileName, j.mLength, mCfg.mAt3Tool);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      start next transfer if possible
+//--------------------------------------------------------------------------
+void CPipeline::scheduleTransfer()
+{
+    if (!mbRunning || (mXferIdx != -1) || mbTocEdit || (mCommit >= mQueue.size()))
+    {
+        return;
+    }
+
+    c2n::SRipTrack& j = mQueue[mCommit];
+
+    // keep track order: wait until next track is ready
+    if (j.mStep != WorkStep::ENCODED)
+    {
+        return;
+    }
+
+    CNetMD::NetMDStartup startup(mCfg.mMode.netMDCmd(j.mOtf), j.mFileName, j.mTitle);
+
+    if (mCfg.mMode.tocManip())
+    {
+        startup.msTitle = "DAO All in One!";
+    }
+
+    j.mStep    = WorkStep::TRANSFER;
+    mXferIdx   = mCommit;
+    mXferStart = mClock.elapsed();
+    emit stageStarted(Stage::TRANSFER, mXferIdx);
+    mpNetMD->start(startup);
+
+    if (mpMirrors != nullptr)
+    {
+        mpMirrors->transfer(startup);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      ripper has finished
+//!
+//! @param[in]  ok    true if the wave file is complete
+//--------------------------------------------------------------------------
+void CPipeline::ripDone(bool ok)
+{
+    if (mRipIdx == -1)
+    {
+        return;
+    }
+
+    for (const auto& cj : mCacheJobs)
+    {
+        if (cj.mStage == Stage::RIP)
+        {
+            // rip stage waits for the cache, not for the ripper
+            return;
+        }
+    }
+
+    int idx = mRipIdx;
+    c2n::SRipTrack& j = mQueue[idx];
+
+    if ((j.mStep == WorkStep::RIP) && !ok)
+    {
+        mRipIdx = -1;
+        qWarning() << "Can't rip / decode track" << j.mTitle;
+        j.mStep = WorkStep::FAILED;
+        mTrash << j.mFileName;
+        emit stageDone(Stage::RIP, idx);
+
+        if (mbRunning)
+        {
+            fail(RIP_FAILED);
+            return;
+        }
+
+        // background work: the transfer will try again
+        cleanTrash();
+
+        if (mbPending)
+        {
+            mbPending = false;
+            start(mPendTracks, mPendQueue, mPendCfg);
+            return;
+        }
+
+        schedule();
+        return;
+    }
+
+    if ((j.mStep == WorkStep::RIP) && !mCfg.mMode.isDao())
+    {
+        int job = mpCache->store(j.mPcmKey, j.mFileName);
+
+        if (job != CArtifactCache::NO_JOB)
+        {
+            // rip stage stays busy until the PCM hash is known
+            mCacheJobs.insert(job, {idx, Stage::RIP, false});
+            return;
+        }
+    }
+
+    ripComplete(idx);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      PCM data of a track is there (ripped or from cache)
+//!
+//! @param[in]  idx   index of track in work queue
+//--------------------------------------------------------------------------
+void CPipeline::ripComplete(int idx)
+{
+    c2n::SRipTrack& j = mQueue[idx];
+    mRipIdx = -1;
+
+    if (j.mStep == WorkStep::RIP)
+    {
+        j.mStep = ripped(j);
+
+        if (j.mStep == WorkStep::RIPPED)
+        {
+            mEncQ.append(idx);
+        }
+    }
+
+    emit stageDone(Stage::RIP, idx);
+
+    if (mbPending)
+    {
+        // background rip done -> now start the real thing
+        mbPending = false;
+        start(mPendTracks, mPendQueue, mPendCfg);
+        return;
+    }
+
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      an encoder has finished
+//!
+//! @param      pEnc  The encoder
+//--------------------------------------------------------------------------
+void CPipeline::encodeDone(CXEnc* pEnc)
+{
+    if (!mEncoders.contains(pEnc))
+    {
+        // killed
+        return;
+    }
+
+    int    idx  = mEncoders.take(pEnc);
+    qint64 wall = mClock.elapsed() - mEncStart.take(pEnc);
+    mIdleEnc.append(pEnc);
+
+    if (mCfg.mMode.isDao())
+    {
+        // encoder wrote all tracks
+        for (auto& j : mQueue)
+        {
+            j.mStep = WorkStep::ENCODED;
+        }
+    }
+    else
+    {
+        c2n::SRipTrack& j = mQueue[idx];
+
+        if (mCfg.mAt3Tool.isEmpty())
+        {
+            mpPlacement->addSample(mCfg.mDevice, mCfg.mMode, CPlacementPolicy::Metric::HOST_ENCODE,
+                                   j.mLength, wall);
+        }
+
+        int job = pEnc->succeeded() ? mpCache->store(atracKey(j), j.mFileName) : CArtifactCache::NO_JOB;
+
+        if (job != CArtifactCache::NO_JOB)
+        {
+            // track goes on when the copy has finished
+            mCacheJobs.insert(job, {idx, Stage::ENCODE, false});
+            schedule();
+            return;
+        }
+
+        j.mStep = WorkStep::ENCODED;
+    }
+
+    emit stageDone(Stage::ENCODE, idx);
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      an artifact cache job has finished
+//!
+//! @param[in]  job   The job id
+//! @param[in]  ok    cache hit (fetch) / file stored (store)
+//! @param[in]  hash  content hash
+//--------------------------------------------------------------------------
+void CPipeline::cacheDone(int job, bool ok, const QByteArray& hash)
+{
+    if (!mCacheJobs.contains(job))
+    {
+        // not ours
+        return;
+    }
+
+    SCacheJob cj = mCacheJobs.take(job);
+    c2n::SRipTrack& j = mQueue[cj.mIdx];
+
+    if (cj.mStage == Stage::RIP)
+    {
+        if (cj.mbFetch && !ok)
+        {
+            // entry was dropped -> rip the track
+            j.mStep = WorkStep::NONE;
+            mRipIdx = -1;
+            mRipQ.prepend(cj.mIdx);
+            schedule();
+            return;
+        }
+
+        j.mPcmHash = hash;
+        ripComplete(cj.mIdx);
+        return;
+    }
+
+    if (cj.mbFetch && !ok)
+    {
+        // entry was dropped -> encode the track
+        j.mStep = WorkStep::RIPPED;
+        mEncQ.append(cj.mIdx);
+    }
+    else
+    {
+        j.mStep = WorkStep::ENCODED;
+        emit stageDone(Stage::ENCODE, cj.mIdx);
+    }
+
+    schedule();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      NetMD command has finished
+//!
+//! @param[in]  ret   The result
+//--------------------------------------------------------------------------
+void CPipeline::transferDone(int ret)
+{
+    if (!mbRunning || ((mXferIdx == -1) && !mbTocEdit))
+    {
+        // not ours
+        return;
+    }
+
+    qInfo() << "Transfer done, ret:" << ret;
+
+    if (ret < 0)
+    {
+        fail(ret);
+        return;
+    }
+
+    if (mbTocEdit)
+    {
+        mbTocEdit = false;
+
+        for (auto& j : mQueue)
+        {
+            j.mStep = WorkStep::DONE;
+        }
+
+        emit stageDone(Stage::TRANSFER, 0);
+        finish(ret);
+        return;
+    }
+
+    int idx = mXferIdx;
+    c2n::SRipTrack& j = mQueue[idx];
+    mXferIdx = -1;
+    j.mStep  = WorkStep::DONE;
+
+    if (mCfg.mMode.tocManip())
+    {
+        CNetMD::TocData tocData;
+
+        // add disc name / -length to TOC data
+        tocData.append({static_cast<const char*>(utf8ToMd(mCfg.mDiscTitle)),
+                        static_cast<uint32_t>(std::round((static_cast<double>(mCfg.mDiscBlocks) * 1000.0)
+                                                         / static_cast<double>(CDIO_CD_FRAMES_PER_SEC))),
+                        mQueue.at(0).mUxTStamp});
+
+        for (const auto& t : mQueue)
+        {
+            // add track name / -length to TOC data
+            tocData.append({static_cast<const char*>(utf8ToMd(t.mTitle)),
+                            static_cast<uint32_t>(std::round(t.mLength * 1000.0)), t.mUxTStamp});
+        }
+
+        // start TOC manipulation
+        mbTocEdit = true;
+        emit tocEditStarted();
+        mpNetMD->start(tocData, mCfg.mDevReset, mCfg.mMode.isMono());
+
+        if (mpMirrors != nullptr)
+        {
+            mpMirrors->tocEdit(tocData, mCfg.mDevReset, mCfg.mMode.isMono());
+        }
+        return;
+    }
+
+    mpPlacement->addSample(mCfg.mDevice, mCfg.mMode,
+                           j.mOtf ? CPlacementPolicy::Metric::USB_OTF : CPlacementPolicy::Metric::USB_HOST_ENC,
+                           j.mLength, mClock.elapsed() - mXferStart);
+
+    mCommit ++;
+    emit stageDone(Stage::TRANSFER, idx);
+    emit trackCommitted(idx);
+
+    if (mCommit >= mQueue.size())
+    {
+        finish(ret);
+    }
+    else
+    {
+        schedule();
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      all done, clean up
+//!
+//! @param[in]  ret   result of last device command
+//--------------------------------------------------------------------------
+void CPipeline::finish(int ret)
+{
+    int tracks = mQueue.size();
+
+    for (const auto& j : mQueue)
+    {
+        if (QFile::exists(j.mFileName))
+        {
+            qInfo() << "Delete temp. file" << j.mFileName;
+            QFile::remove(j.mFileName);
+        }
+    }
+
+    mQueue.clear();
+    mRipQ.clear();
+    mEncQ.clear();
+    mRipIdx   = -1;
+    mXferIdx  = -1;
+    mbRunning = false;
+
+    mpRipper->removeTemp();
+    cleanTrash();
+
+    emit finished(ret, tracks);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      transfer failed, drop everything
+//!
+//! @param[in]  ret   result of failed device command
+//--------------------------------------------------------------------------
+void CPipeline::fail(int ret)
+{
+    for (auto& t : mQueue)
+    {
+        // mark all tracks as failed
+        t.mStep = WorkStep::FAILED;
+        mTrash << t.mFileName << (t.mFileName + ".aea") << (t.mFileName + ".at3");
+    }
+
+    mpRipper->cancel();
+    killEncoders();
+    cancelCacheJobs();
+
+    mQueue.clear();
+    mRipQ.clear();
+    mEncQ.clear();
+    mRipIdx   = -1;
+    mXferIdx  = -1;
+    mbTocEdit = false;
+    mbRunning = false;
+
+    mpRipper->removeTemp();
+    cleanTrash();
+
+    emit failed(ret);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get idle (or new) encoder
+//!
+//! @return     encoder
+//--------------------------------------------------------------------------
+CXEnc* CPipeline::encoder()
+{
+    CXEnc* pEnc;
+
+    if (!mIdleEnc.isEmpty())
+    {
+        pEnc = mIdleEnc.takeFirst();
+    }
+    else
+    {
+        pEnc = new CXEnc(this);
+        connect(pEnc, &CXEnc::fileDone, this, [this, pEnc]() { encodeDone(pEnc); });
+        connect(pEnc, &CXEnc::progress, this, [this, pEnc](int percent) {
+            // show the encoder the transfer waits for first
+            if (mEncoders.contains(pEnc)
+                && (mEncoders.value(pEnc) == *std::min_element(mEncoders.cbegin(), mEncoders.cend())))
+            {
+                emit progress(Stage::ENCODE, percent);
+            }
+        });
+    }
+
+    pEnc->setLowPriority(mbSpeculative);
+    return pEnc;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop all running encoders
+//--------------------------------------------------------------------------
+void CPipeline::killEncoders()
+{
+    QList<CXEnc*> running = mEncoders.keys();
+    mEncoders.clear();
+    mEncStart.clear();
+
+    for (auto* pEnc : running)
+    {
+        pEnc->kill();
+        pEnc->waitForFinished();
+        mIdleEnc.append(pEnc);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      drop all running cache jobs
+//--------------------------------------------------------------------------
+void CPipeline::cancelCacheJobs()
+{
+    for (int job : mCacheJobs.keys())
+    {
+        mpCache->cancel(job);
+    }
+
+    mCacheJobs.clear();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      let ripper decode queued file / cue tracks in parallel
+//--------------------------------------------------------------------------
+void CPipeline::prefetch()
+{
+    QVector<QPair<int, QString>> jobs;
+
+    if (mCfg.mMode.isDao())
+    {
+        return;
+    }
+
+    for (const auto& j : mQueue)
+    {
+        // cached tracks aren't decoded at all
+        if (!j.mIsCD && (j.mStep == WorkStep::NONE) && !mpCache->contains(j.mPcmKey))
+        {
+            jobs.append(qMakePair(static_cast<int>(j.mCDTrackNo), j.mFileName));
+        }
+    }
+
+    mpRipper->setDecoderCount(concurrency(Stage::RIP));
+    mpRipper->prefetch(jobs);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      step of a track after rip
+//!
+//! @param[in]  j     work queue entry
+//!
+//! @return     RIPPED or ENCODED (no encoding needed)
+//--------------------------------------------------------------------------
+CPipeline::WorkStep CPipeline::ripped(const c2n::SRipTrack& j) const
+{
+    return (mCfg.mMode.xencCmd(j.mOtf) == CXEnc::XEncCmd::NONE) ? WorkStep::ENCODED : WorkStep::RIPPED;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      count tracks in step
+//!
+//! @param[in]  first  first step to count
+//! @param[in]  last   last step to count
+//!
+//! @return     count
+//--------------------------------------------------------------------------
+int CPipeline::waiting(WorkStep first, WorkStep last) const
+{
+    int count = 0;
+
+    for (int i = mCommit; i < mQueue.size(); i++)
+    {
+        uint8_t step = static_cast<uint8_t>(mQueue.at(i).mStep);
+
+        if ((step >= static_cast<uint8_t>(first)) && (step <= static_cast<uint8_t>(last)))
+        {
+            count ++;
+        }
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      artifact cache key of encoded track
+//!
+//! @param[in]  j     work queue entry
+//!
+//! @return     key string (empty if not cacheable)
+//--------------------------------------------------------------------------
+QString CPipeline::atracKey(const c2n::SRipTrack& j) const
+{
+    return CArtifactCache::atracKey(j.mPcmHash, mCfg.mMode.xencCmd(j.mOtf), !mCfg.mAt3Tool.isEmpty());
+}
+
+//--------------------------------------------------------------------------
+//! @brief      delete left over files
+//--------------------------------------------------------------------------
+void CPipeline::cleanTrash()
+{
+    for (const auto& f : mTrash)
+    {
+        if (QFile::exists(f))
+        {
+            qInfo() << "Delete temp. file" << f;
+            QFile::remove(f);
+        }
+    }
+    mTrash.clear();
+}
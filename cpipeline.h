@@ -0,0 +1,474 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "defines.h"
+#include "transfermode.h"
+#include "cjacktheripper.h"
+#include "cnetmd.h"
+#include "cnetmdmirrors.h"
+#include "cxenc.h"
+#include "cartifactcache.h"
+#include "cplacementpolicy.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Runs the rip -> encode -> transfer flow of a work queue.
+//!             Each stage takes its tracks from an explicit queue and has its
+//!             own concurrency limit; tracks waiting between stages are
+//!             bounded so a fast stage can't run away from a slow one.
+//!             Tracks reach the MD strictly in queue order. The engine knows
+//!             nothing about widgets, the UI follows through signals.
+//------------------------------------------------------------------------------
+class CPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    using WorkStep      = c2n::WorkStep;
+    using TransferQueue = c2n::TransferQueue;
+
+    /// pipeline stages
+    enum class Stage : uint8_t
+    {
+        RIP,        ///< rip CD track / decode file
+        ENCODE,     ///< host encoder
+        TRANSFER    ///< NetMD transfer (incl. TOC edit)
+    };
+
+    /// settings of one run
+    struct SConfig
+    {
+        TransferMode              mMode;        ///< transfer mode
+        CJackTheRipper::SParanoia mParanoia;    ///< CD paranoia settings
+        QString                   mAt3Tool;     ///< at3tool location (optional)
+        QString                   mDiscTitle;   ///< disc title (TOC edit)
+        long                      mDiscBlocks;  ///< audio length in CDDA blocks
+        QString                   mDevice;      ///< NetMD device name
+        bool                      mDevReset;    ///< reset device after TOC edit
+    };
+
+    /// default number of tracks which may wait between two stages
+    static constexpr int DEF_QUEUE_LIMIT = 8;
+
+    /// failed() result if a track couldn't be ripped / decoded
+    static constexpr int RIP_FAILED = -2000;
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      pRipper     The ripper / decoder
+    //! @param      pNetMD      The NetMD device
+    //! @param      pMirrors    additional recorders (may be nullptr)
+    //! @param      pCache      artifact cache
+    //! @param      pPlacement  placement policy (gets speed samples)
+    //! @param      parent      The parent
+    //--------------------------------------------------------------------------
+    CPipeline(CJackTheRipper* pRipper, CNetMD* pNetMD, CNetMdMirrors* pMirrors,
+              CArtifactCache* pCache, CPlacementPolicy* pPlacement, QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of tracks a stage works on in parallel
+    //!             (transfer is always 1, CD rip is always 1)
+    //!
+    //! @param[in]  stage  The stage
+    //! @param[in]  count  The count
+    //--------------------------------------------------------------------------
+    void setConcurrency(Stage stage, int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get number of tracks a stage works on in parallel
+    //!
+    //! @param[in]  stage  The stage
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int concurrency(Stage stage) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      set number of tracks which may wait between two stages
+    //!
+    //! @param[in]  count  The count (0 -> unbounded)
+    //--------------------------------------------------------------------------
+    void setQueueLimit(int count);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start transfer; results of a background preparation are
+    //!             taken over, a running background rip is waited for
+    //!
+    //! @param[in]  tracks  source tracks (index 0 is the disc entry)
+    //! @param[in]  queue   work queue
+    //! @param[in]  cfg     settings
+    //!
+    //! @return     true if started (or waiting)
+    //--------------------------------------------------------------------------
+    bool start(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg);
+
+    //--------------------------------------------------------------------------
+    //! @brief      start background preparation (rip / encode only,
+    //!             low priority)
+    //!
+    //! @param[in]  tracks  source tracks (index 0 is the disc entry)
+    //! @param[in]  queue   work queue
+    //! @param[in]  cfg     settings
+    //!
+    //! @return     true if started
+    //--------------------------------------------------------------------------
+    bool prepare(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg);
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop background preparation and drop its results
+    //--------------------------------------------------------------------------
+    void stop();
+
+    //--------------------------------------------------------------------------
+    //! @brief      is a transfer or a background preparation active
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool busy() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      is background preparation active
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool preparing() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      get work queue of current run
+    //!
+    //! @return     work queue
+    //--------------------------------------------------------------------------
+    const TransferQueue& queue() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of tracks which passed a stage (or are in it)
+    //!
+    //! @param[in]  stage  The stage
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int done(Stage stage) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of work units of a stage
+    //!
+    //! @param[in]  stage  The stage
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int total(Stage stage) const;
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      a stage started to work on a track
+    //!
+    //! @param[in]  stage  The stage
+    //! @param[in]  idx    index in queue()
+    //--------------------------------------------------------------------------
+    void stageStarted(CPipeline::Stage stage, int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      a stage is done with a track
+    //!
+    //! @param[in]  stage  The stage
+    //! @param[in]  idx    index in queue()
+    //--------------------------------------------------------------------------
+    void stageDone(CPipeline::Stage stage, int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      progress of a stage
+    //!
+    //! @param[in]  stage    The stage
+    //! @param[in]  percent  The percent
+    //--------------------------------------------------------------------------
+    void progress(CPipeline::Stage stage, int percent);
+
+    //--------------------------------------------------------------------------
+    //! @brief      track was written to MD (queue order)
+    //!
+    //! @param[in]  idx   index in queue()
+    //--------------------------------------------------------------------------
+    void trackCommitted(int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      DAO transfer done, TOC edit started
+    //--------------------------------------------------------------------------
+    void tocEditStarted();
+
+    //--------------------------------------------------------------------------
+    //! @brief      all tracks are on the MD
+    //!
+    //! @param[in]  ret     result of last device command
+    //! @param[in]  tracks  number of transferred tracks
+    //--------------------------------------------------------------------------
+    void finished(int ret, int tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      transfer failed, all work was dropped
+    //!
+    //! @param[in]  ret   result of failed device command (or RIP_FAILED)
+    //--------------------------------------------------------------------------
+    void failed(int ret);
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      reset run state, set up stage queues
+    //!
+    //! @param[in]  tracks  source tracks
+    //! @param[in]  queue   work queue
+    //! @param[in]  cfg     settings
+    //--------------------------------------------------------------------------
+    void setup(const c2n::AudioTracks& tracks, const TransferQueue& queue, const SConfig& cfg);
+
+    //--------------------------------------------------------------------------
+    //! @brief      take over results of background preparation (files of
+    //!             dropped tracks go to trash, the caller cleans up; pending
+    //!             background decodes of adopted tracks are picked up by
+    //!             the rip stage)
+    //!
+    //! @param[in]  specQueue  The background work queue
+    //--------------------------------------------------------------------------
+    void adopt(const TransferQueue& specQueue);
+
+    //--------------------------------------------------------------------------
+    //! @brief      feed all stages
+    //--------------------------------------------------------------------------
+    void schedule();
+
+    //--------------------------------------------------------------------------
+    //! @brief      start next rip if possible
+    //--------------------------------------------------------------------------
+    void scheduleRip();
+
+    //--------------------------------------------------------------------------
+    //! @brief      start encoders if possible
+    //--------------------------------------------------------------------------
+    void scheduleEncode();
+
+    //--------------------------------------------------------------------------
+    //! @brief      start next transfer if possible
+    //--------------------------------------------------------------------------
+    void scheduleTransfer();
+
+    //--------------------------------------------------------------------------
+    //! @brief      ripper has finished
+    //!
+    //! @param[in]  ok    true if the wave file is complete
+    //--------------------------------------------------------------------------
+    void ripDone(bool ok);
+
+    //--------------------------------------------------------------------------
+    //! @brief      PCM data of a track is there (ripped or from cache)
+    //!
+    //! @param[in]  idx   index of track in work queue
+    //--------------------------------------------------------------------------
+    void ripComplete(int idx);
+
+    //--------------------------------------------------------------------------
+    //! @brief      an encoder has finished
+    //!
+    //! @param      pEnc  The encoder
+    //--------------------------------------------------------------------------
+    void encodeDone(CXEnc* pEnc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      an artifact cache job has finished
+    //!
+    //! @param[in]  job   The job id
+    //! @param[in]  ok    cache hit (fetch) / file stored (store)
+    //! @param[in]  hash  content hash
+    //--------------------------------------------------------------------------
+    void cacheDone(int job, bool ok, const QByteArray& hash);
+
+    //--------------------------------------------------------------------------
+    //! @brief      NetMD command has finished
+    //!
+    //! @param[in]  ret   The result
+    //--------------------------------------------------------------------------
+    void transferDone(int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      all done, clean up
+    //!
+    //! @param[in]  ret   result of last device command
+    //--------------------------------------------------------------------------
+    void finish(int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      transfer failed, drop everything
+    //!
+    //! @param[in]  ret   result of failed device command
+    //--------------------------------------------------------------------------
+    void fail(int ret);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get idle (or new) encoder
+    //!
+    //! @return     encoder
+    //--------------------------------------------------------------------------
+    CXEnc* encoder();
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop all running encoders
+    //--------------------------------------------------------------------------
+    void killEncoders();
+
+    //--------------------------------------------------------------------------
+    //! @brief      drop all running cache jobs
+    //--------------------------------------------------------------------------
+    void cancelCacheJobs();
+
+    //--------------------------------------------------------------------------
+    //! @brief      let ripper decode queued file / cue tracks in parallel
+    //--------------------------------------------------------------------------
+    void prefetch();
+
+    //--------------------------------------------------------------------------
+    //! @brief      step of a track after rip
+    //!
+    //! @param[in]  j     work queue entry
+    //!
+    //! @return     RIPPED or ENCODED (no encoding needed)
+    //--------------------------------------------------------------------------
+    WorkStep ripped(const c2n::SRipTrack& j) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      count tracks in step
+    //!
+    //! @param[in]  first  first step to count
+    //! @param[in]  last   last step to count
+    //!
+    //! @return     count
+    //--------------------------------------------------------------------------
+    int waiting(WorkStep first, WorkStep last) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      artifact cache key of encoded track
+    //!
+    //! @param[in]  j     work queue entry
+    //!
+    //! @return     key string (empty if not cacheable)
+    //--------------------------------------------------------------------------
+    QString atracKey(const c2n::SRipTrack& j) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      delete left over files
+    //--------------------------------------------------------------------------
+    void cleanTrash();
+
+private:
+    /// number of stages
+    static constexpr int STAGES = 3;
+
+    /// cache copy a track waits for
+    struct SCacheJob
+    {
+        int   mIdx;     ///< track in work queue
+        Stage mStage;   ///< RIP (PCM) or ENCODE (ATRAC)
+        bool  mbFetch;  ///< fetch (true) or store (false)
+    };
+
+    /// ripper / decoder
+    CJackTheRipper* mpRipper;
+
+    /// NetMD device
+    CNetMD* mpNetMD;
+
+    /// additional recorders (may be nullptr)
+    CNetMdMirrors* mpMirrors;
+
+    /// artifact cache
+    CArtifactCache* mpCache;
+
+    /// placement policy
+    CPlacementPolicy* mpPlacement;
+
+    /// parallel work per stage
+    int mConcurrency[STAGES];
+
+    /// max. tracks waiting between two stages
+    int mQueueLimit;
+
+    /// settings of current run
+    SConfig mCfg;
+
+    /// work queue of current run
+    TransferQueue mQueue;
+
+    /// transfer is running
+    bool mbRunning;
+
+    /// background preparation is running
+    bool mbSpeculative;
+
+    /// transfer requested while background rip was running
+    bool mbPending;
+
+    /// requested transfer
+    c2n::AudioTracks mPendTracks;
+
+    /// requested work queue
+    TransferQueue mPendQueue;
+
+    /// requested settings
+    SConfig mPendCfg;
+
+    /// tracks waiting for rip (queue order)
+    QList<int> mRipQ;
+
+    /// tracks waiting for encoder (queue order)
+    QList<int> mEncQ;
+
+    /// track in ripper (-1 -> none)
+    int mRipIdx;
+
+    /// running encoders -> track
+    QMap<CXEnc*, int> mEncoders;
+
+    /// start time of running encoders
+    QHash<CXEnc*, qint64> mEncStart;
+
+    /// idle encoders
+    QList<CXEnc*> mIdleEnc;
+
+    /// running cache jobs -> track
+    QMap<int, SCacheJob> mCacheJobs;
+
+    /// track in transfer (-1 -> none)
+    int mXferIdx;
+
+    /// next track to be transferred
+    int mCommit;
+
+    /// TOC edit is running
+    bool mbTocEdit;
+
+    /// clock for speed samples
+    QElapsedTimer mClock;
+
+    /// start time of current transfer
+    qint64 mXferStart;
+
+    /// files to be deleted
+    QStringList mTrash;
+};
@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cplacementpolicy.h"
+#include <QSettings>
+#include <QRegularExpression>
+#include <QtDebug>
+#include <algorithm>
+
+//--------------------------------------------------------------------------
+//! @brief      add one measurement
+//!
+//! @param[in]  device    device name (as reported by NetMD)
+//! @param[in]  mode      transfer mode
+//! @param[in]  metric    what was measured
+//! @param[in]  audioSec  audio length in seconds
+//! @param[in]  wallMs    needed time in milliseconds
+//--------------------------------------------------------------------------
+void CPlacementPolicy::addSample(const QString& device, const TransferMode& mode, Metric metric,
+                                 double audioSec, qint64 wallMs)
+{
+    if (!mode.isLP() || (audioSec < MIN_SAMPLE_SEC) || (wallMs <= 0))
+    {
+        return;
+    }
+
+    bool known;
+    double sample = (audioSec * 1000.0) / static_cast<double>(wallMs);
+    double value  = speed(device, mode, metric, known);
+
+    value = known ? ((1.0 - EMA_WEIGHT) * value + EMA_WEIGHT * sample) : sample;
+
+    QSettings set;
+    set.setValue(key(device, mode, metric), value);
+
+    qInfo() << "Placement sample" << key(device, mode, metric) << "x-realtime:" << sample << "-> stored:" << value;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get route per track which should minimize completion time
+//!
+//! @param[in]  device   device name
+//! @param[in]  mode     transfer mode (TAO LP only)
+//! @param[in]  lengths  track lengths in seconds (queue order)
+//!
+//! @return     route per track
+//--------------------------------------------------------------------------
+QVector<CPlacementPolicy::Route> CPlacementPolicy::plan(const QString& device, const TransferMode& mode,
+                                                        const QVector<double>& lengths) const
+{
+    QVector<Route> routes(lengths.size(), Route::HOST_ENC);
+
+    if (!mode.isTao() || !mode.isLP() || lengths.isEmpty())
+    {
+        return routes;
+    }
+
+    bool encKnown, usbKnown, otfKnown;
+    double enc = speed(device, mode, Metric::HOST_ENCODE , encKnown);
+    double usb = speed(device, mode, Metric::USB_HOST_ENC, usbKnown);
+    double otf = speed(device, mode, Metric::USB_OTF     , otfKnown);
+
+    // Simulate both resources: the host encoder works on one track
+    // at a time, the USB link transfers one track at a time in queue
+    // order. Each track takes the route which finishes it earlier.
+    double cpuFree = 0.0, usbFree = 0.0;
+
+    for (int i = 0; i < lengths.size(); i++)
+    {
+        double len     = lengths.at(i);
+        double encDone = cpuFree + len / enc;
+        double hostEnd = std::max(usbFree, encDone) + len / usb;
+        double otfEnd  = usbFree + len / otf;
+
+        // nothing measured for on-the-fly on this device so far:
+        // first track goes on-the-fly (it would wait for the encoder anyway)
+        bool useOtf = (!otfKnown && (i == 0)) || (otfEnd < hostEnd);
+
+        if (useOtf)
+        {
+            routes[i] = Route::DEVICE_OTF;
+            usbFree   = otfEnd;
+        }
+        else
+        {
+            cpuFree = encDone;
+            usbFree = hostEnd;
+        }
+    }
+
+    qInfo() << "Placement for" << device << mode.name() << "- encode:" << enc << "usb:" << usb << "otf:" << otf
+            << "estimated time:" << usbFree << "s";
+
+    return routes;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      get stored speed
+//!
+//! @param[in]  device  The device
+//! @param[in]  mode    The mode
+//! @param[in]  metric  The metric
+//! @param[out] known   set to true if value was measured before
+//!
+//! @return     speed as x realtime
+//--------------------------------------------------------------------------
+double CPlacementPolicy::speed(const QString& device, const TransferMode& mode, Metric metric, bool& known) const
+{
+    QSettings set;
+    QString k = key(device, mode, metric);
+    double  def;
+
+    // conservative defaults until we measured something
+    switch (metric)
+    {
+    case Metric::HOST_ENCODE:
+        def = 8.0;
+        break;
+    case Metric::USB_HOST_ENC:
+        def = (mode.multi() == 4) ? 8.0 : 4.0;
+        break;
+    default:
+        def = 1.0;
+        break;
+    }
+
+    known = set.contains(k);
+    double val = set.value(k, def).toDouble();
+    return (val > 0.0) ? val : def;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create settings key
+//!
+//! @param[in]  device  The device
+//! @param[in]  mode    The mode
+//! @param[in]  metric  The metric
+//!
+//! @return     settings key
+//--------------------------------------------------------------------------
+QString CPlacementPolicy::key(const QString& device, const TransferMode& mode, Metric metric)
+{
+    static const QRegularExpression rxInvalid("[^A-Za-z0-9]+");
+    const char* name;
+
+    switch (metric)
+    {
+    case Metric::HOST_ENCODE:
+        // encoder speed depends on host only
+        return QString("placement/host/%1_encode").arg(mode.name());
+    case Metric::USB_HOST_ENC:
+        name = "usb";
+        break;
+    default:
+        name = "otf";
+        break;
+    }
+
+    QString dev = device;
+    dev.replace(rxInvalid, "_");
+    return QString("placement/%1/%2_%3").arg(dev).arg(mode.name()).arg(name);
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QString>
+#include <QVector>
+#include "transfermode.h"
+
+//------------------------------------------------------------------------------
+//! @brief      Decides where LP encoding takes place (host encoder or device
+//!             on-the-fly). Speeds (x realtime) are measured while
+//!             transferring and stored per device and mode in the settings.
+//------------------------------------------------------------------------------
+class CPlacementPolicy
+{
+public:
+    /// where is the LP encoding done
+    enum class Route : uint8_t
+    {
+        HOST_ENC,   ///< encode on host, upload ATRAC data
+        DEVICE_OTF  ///< upload PCM, device encodes on-the-fly
+    };
+
+    /// measured value
+    enum class Metric : uint8_t
+    {
+        HOST_ENCODE,    ///< host encoder speed
+        USB_HOST_ENC,   ///< USB transfer of host encoded data
+        USB_OTF         ///< USB transfer with device side encoding
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      add one measurement
+    //!
+    //! @param[in]  device    device name (as reported by NetMD)
+    //! @param[in]  mode      transfer mode
+    //! @param[in]  metric    what was measured
+    //! @param[in]  audioSec  audio length in seconds
+    //! @param[in]  wallMs    needed time in milliseconds
+    //--------------------------------------------------------------------------
+    void addSample(const QString& device, const TransferMode& mode, Metric metric,
+                   double audioSec, qint64 wallMs);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get route per track which should minimize completion time
+    //!
+    //! @param[in]  device   device name
+    //! @param[in]  mode     transfer mode (TAO LP only)
+    //! @param[in]  lengths  track lengths in seconds (queue order)
+    //!
+    //! @return     route per track
+    //--------------------------------------------------------------------------
+    QVector<Route> plan(const QString& device, const TransferMode& mode,
+                        const QVector<double>& lengths) const;
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      get stored speed
+    //!
+    //! @param[in]  device  The device
+    //! @param[in]  mode    The mode
+    //! @param[in]  metric  The metric
+    //! @param[out] known   set to true if value was measured before
+    //!
+    //! @return     speed as x realtime
+    //--------------------------------------------------------------------------
+    double speed(const QString& device, const TransferMode& mode, Metric metric, bool& known) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      create settings key
+    //!
+    //! @param[in]  device  The device
+    //! @param[in]  mode    The mode
+    //! @param[in]  metric  The metric
+    //!
+    //! @return     settings key
+    //--------------------------------------------------------------------------
+    static QString key(const QString& device, const TransferMode& mode, Metric metric);
+
+private:
+    /// weight of a new sample
+    static constexpr double EMA_WEIGHT = 0.3;
+
+    /// ignore very short measurements (seconds of audio)
+    static constexpr double MIN_SAMPLE_SEC = 10.0;
+};
@@ -15,7 +15,9 @@
  * You should have received a copy of the GNU General Public License
  */
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <sstream>
+#include <algorithm>
 #include "ctocmanip.h"
 #include "defines.h"
 
@@ -24,9 +26,9 @@ using namespace netmd;
 //--------------------------------------------------------------------------
 //! @brief      constructs the object
 //!
-//! @param[in]  api    NetMD API pointer
+//! @param[in]  api    NetMD device pointer
 //--------------------------------------------------------------------------
-CTocManip::CTocManip(netmd_pp* api)
+CTocManip::CTocManip(CNetMdDevice* api)
     : mpApi(api)
 {
 }
@@ -149,3 +151,376 @@ int CTocManip::manipulateTOC(const TitleVector &trackData, bool resetDev, bool m
 
     return ret;
 }
+
+//--------------------------------------------------------------------------
+//! @brief      read titles, modes and lengths of all tracks from the
+//!             UTOC sectors 0 (addresses) and 1 (half width titles)
+//!
+//! @param[out] tracks  the tracks found
+//! @param[out] pHash   optional SHA1 of both sectors
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CTocManip::scanDisc(ScanVector& tracks, QByteArray* pHash)
+{
+    tracks.clear();
+
+    if (!mpApi)
+    {
+        qCritical() << "NetMD Api not initialized!";
+        return -1;
+    }
+
+    int ret = mpApi->prepareTOCManip();
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        ret = readScan(tracks, pHash);
+    }
+
+    // read only access: never leave the device in TOC edit mode
+    int fin = mpApi->finalizeTOC(false);
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        ret = fin;
+    }
+
+    if (ret != NETMDERR_NO_ERROR)
+    {
+        tracks.clear();
+
+        if (pHash)
+        {
+            pHash->clear();
+        }
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      parse tracks from UTOC sectors (TOC edit mode is active)
+//!
+//! @param[out] tracks  the tracks found
+//! @param[out] pHash   optional SHA1 of both sectors
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CTocManip::readScan(ScanVector& tracks, QByteArray* pHash)
+{
+    NetMDByteVector pos    = mpApi->readUTOCSector(UTOCSector::POS_ADDR);
+    NetMDByteVector titles = mpApi->readUTOCSector(UTOCSector::HW_TITLES);
+
+    if ((pos.size() != SECTOR_SIZE) || (titles.size() != SECTOR_SIZE))
+    {
+        qWarning() << "Can't read UTOC sectors for disc scan!";
+        return NETMDERR_USB;
+    }
+
+    if (pHash)
+    {
+        QCryptographicHash h(QCryptographicHash::Sha1);
+        h.addData(reinterpret_cast<const char*>(pos.data()), static_cast<int>(pos.size()));
+        h.addData(reinterpret_cast<const char*>(titles.data()), static_cast<int>(titles.size()));
+        *pHash = h.result();
+    }
+
+    int trackCount = pos.at(LAST_TNO);
+
+    for (int t = 1; t <= trackCount; t++)
+    {
+        TrackScan track = {std::string(), 0, 0, 0};
+        uint8_t cell    = pos.at(TRACK_PTR + t - 1);
+
+        // follow the parts chain; a valid chain has no more than 255 links
+        while ((cell != 0) && (track.mParts < 255))
+        {
+            const uint8_t* p = &pos.at(CELL_TABLE + cell * 8);
+
+            if (track.mParts == 0)
+            {
+                track.mMode = p[3];
+            }
+
+            uint32_t start = soundGroup(&p[0]);
+            uint32_t end   = soundGroup(&p[4]);
+
+            if (end < start)
+            {
+                qWarning() << "Broken UTOC part" << cell << "in track" << t;
+                return NETMDERR_OTHER;
+            }
+
+            track.mSoundGroups += end - start + 1;
+            track.mParts ++;
+            cell = p[7];
+        }
+
+        if ((cell != 0) || (track.mParts == 0))
+        {
+            qWarning() << "Broken UTOC parts chain in track" << t;
+            return NETMDERR_OTHER;
+        }
+
+        track.mTitle = cellTitle(titles, titles.at(TRACK_PTR + t - 1));
+        tracks.append(track);
+    }
+
+    return NETMDERR_NO_ERROR;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      rebuild half width title sector with all titles given,
+//!             drop stale full width titles, write changed sectors
+//!             and finalize the TOC
+//!
+//! @param[in]  titles    all titles, index 0 is the raw disc title
+//! @param[in]  resetDev  reset device after TOC edit
+//! @param[out] changed   set to true if a sector was written
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CTocManip::rewriteTitles(const RawTitles& titles, bool resetDev, bool& changed)
+{
+    changed = false;
+
+    if (!mpApi)
+    {
+        qCritical() << "NetMD Api not initialized!";
+        return -1;
+    }
+
+    int ret = mpApi->prepareTOCManip();
+
+    if (ret == NETMDERR_NO_ERROR)
+    {
+        ret = writeTitles(titles, changed);
+    }
+
+    // leave TOC edit mode in any case, reset only if something was written
+    int fin = mpApi->finalizeTOC(changed && resetDev);
+    return (ret != NETMDERR_NO_ERROR) ? ret : fin;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      rebuild and write half width title sector, drop full width
+//!             titles of changed entries (TOC edit mode is active)
+//!
+//! @param[in]  titles    all titles, index 0 is the raw disc title
+//! @param[out] changed   set to true if a sector was written
+//!
+//! @return     NetMdErr
+//--------------------------------------------------------------------------
+int CTocManip::writeTitles(const RawTitles& titles, bool& changed)
+{
+    int ret;
+    NetMDByteVector pos   = mpApi->readUTOCSector(UTOCSector::POS_ADDR);
+    NetMDByteVector old   = mpApi->readUTOCSector(UTOCSector::HW_TITLES);
+    NetMDByteVector fwOld = mpApi->readUTOCSector(UTOCSector::FW_TITLES);
+
+    if ((pos.size() != SECTOR_SIZE) || (old.size() != SECTOR_SIZE) || (fwOld.size() != SECTOR_SIZE))
+    {
+        qWarning() << "Can't read UTOC sectors for title rewrite!";
+        return NETMDERR_USB;
+    }
+
+    if (titles.size() != (static_cast<std::size_t>(pos.at(LAST_TNO)) + 1))
+    {
+        qWarning() << "Title count" << titles.size() - 1 << "doesn't match UTOC track count" << pos.at(LAST_TNO);
+        return NETMDERR_OTHER;
+    }
+
+    NetMDByteVector sec = old;
+
+    if (!encodeTitles(titles, sec))
+    {
+        qWarning() << "Not enough UTOC title cells for all titles!";
+        return NETMDERR_OTHER;
+    }
+
+    // a full width title would hide the new half width title
+    // on the device -> keep it only if the entry is unchanged
+    RawTitles fwTitles(titles.size());
+    bool fwDropped = false;
+
+    for (std::size_t t = 0; t < titles.size(); t++)
+    {
+        uint8_t cell = fwOld.at(DISC_TITLE_PTR + t);
+
+        if (cell == 0)
+        {
+            continue;
+        }
+
+        if (cellTitle(old, old.at(DISC_TITLE_PTR + t)) == titles.at(t))
+        {
+            fwTitles[t] = cellTitle(fwOld, cell);
+        }
+        else
+        {
+            fwDropped = true;
+        }
+    }
+
+    NetMDByteVector fwSec = fwOld;
+
+    if (fwDropped && !encodeTitles(fwTitles, fwSec))
+    {
+        qWarning() << "Can't rebuild UTOC full width title sector!";
+        return NETMDERR_OTHER;
+    }
+
+    if ((sec == old) && (fwSec == fwOld))
+    {
+        qInfo() << "UTOC titles unchanged, nothing to write.";
+        return NETMDERR_NO_ERROR;
+    }
+
+    if (sec != old)
+    {
+        if ((ret = mpApi->writeUTOCSector(UTOCSector::HW_TITLES, sec)) != NETMDERR_NO_ERROR)
+        {
+            qWarning() << "Can't write TOC sector" << static_cast<int>(UTOCSector::HW_TITLES) << "!";
+            return ret;
+        }
+        changed = true;
+    }
+
+    if (fwSec != fwOld)
+    {
+        qInfo() << "Dropping full width titles of changed UTOC entries.";
+
+        if ((ret = mpApi->writeUTOCSector(UTOCSector::FW_TITLES, fwSec)) != NETMDERR_NO_ERROR)
+        {
+            qWarning() << "Can't write TOC sector" << static_cast<int>(UTOCSector::FW_TITLES) << "!";
+            return ret;
+        }
+        changed = true;
+    }
+
+    return NETMDERR_NO_ERROR;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      linear sound group from 3 byte UTOC address
+//!
+//! @param[in]  p     pointer to address
+//!
+//! @return     sound group
+//--------------------------------------------------------------------------
+uint32_t CTocManip::soundGroup(const uint8_t* p)
+{
+    // 14 bit cluster, 6 bit sector, 4 bit sound group;
+    // a cluster has 32 audio sectors, a sector pair 11 sound groups
+    uint32_t cluster = (static_cast<uint32_t>(p[0]) << 6) | (p[1] >> 2);
+    uint32_t sector  = ((p[1] & 0x03) << 4) | (p[2] >> 4);
+    uint32_t group   = p[2] & 0x0f;
+
+    return (cluster * 176) + ((sector / 2) * 11) + group;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      3 byte UTOC address from linear sound group
+//!
+//! @param[in]  sg    sound group
+//! @param[out] p     pointer to address
+//--------------------------------------------------------------------------
+void CTocManip::address(uint32_t sg, uint8_t* p)
+{
+    uint32_t cluster = sg / 176;
+    uint32_t sector  = ((sg % 176) / 11) * 2;
+    uint32_t group   = (sg % 176) % 11;
+
+    p[0] = static_cast<uint8_t>(cluster >> 6);
+    p[1] = static_cast<uint8_t>(((cluster & 0x3f) << 2) | (sector >> 4));
+    p[2] = static_cast<uint8_t>(((sector & 0x0f) << 4) | group);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      collect title from a chain of title cells
+//!
+//! @param[in]  sec   title sector
+//! @param[in]  cell  first cell
+//!
+//! @return     raw title
+//--------------------------------------------------------------------------
+std::string CTocManip::cellTitle(const NetMDByteVector& sec, uint8_t cell)
+{
+    std::string title;
+    int links = 0;
+
+    // title cells: 7 characters + link
+    while ((cell != 0) && (links++ < 255) && (sec.size() == SECTOR_SIZE))
+    {
+        const uint8_t* p = &sec.at(CELL_TABLE + cell * 8);
+
+        for (std::size_t c = 0; (c < CELL_CHARS) && (p[c] != 0); c++)
+        {
+            title += static_cast<char>(p[c]);
+        }
+        cell = p[7];
+    }
+
+    return title;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      put all titles into a half width title sector
+//!             (pointers and cell table are rebuilt)
+//!
+//! @param[in]  titles  all titles, index 0 is the raw disc title
+//! @param      sec     title sector
+//!
+//! @return     false if titles don't fit
+//--------------------------------------------------------------------------
+bool CTocManip::encodeTitles(const RawTitles& titles, NetMDByteVector& sec)
+{
+    if ((sec.size() != SECTOR_SIZE) || (titles.size() > 256))
+    {
+        return false;
+    }
+
+    // clear pointers and cells, cell 0 isn't used
+    std::fill(sec.begin() + DISC_TITLE_PTR, sec.begin() + DISC_TITLE_PTR + 256, 0);
+    std::fill(sec.begin() + CELL_TABLE + 8, sec.end(), 0);
+
+    std::size_t cell = 1;
+
+    for (std::size_t t = 0; t < titles.size(); t++)
+    {
+        const std::string& title = titles.at(t);
+
+        if (title.empty())
+        {
+            continue;
+        }
+
+        std::size_t cells = (title.size() + CELL_CHARS - 1) / CELL_CHARS;
+
+        if ((cell + cells) > 256)
+        {
+            return false;
+        }
+
+        sec[DISC_TITLE_PTR + t] = static_cast<uint8_t>(cell);
+
+        for (std::size_t c = 0; c < cells; c++, cell++)
+        {
+            uint8_t*    p   = &sec[CELL_TABLE + cell * 8];
+            std::size_t off = c * CELL_CHARS;
+            title.copy(reinterpret_cast<char*>(p), CELL_CHARS, off);
+            p[7] = (c + 1 < cells) ? static_cast<uint8_t>(cell + 1) : 0;
+        }
+    }
+
+    // chain remaining cells into free list
+    sec[EMPTY_PTR] = (cell < 256) ? static_cast<uint8_t>(cell) : 0;
+
+    for (; cell < 256; cell++)
+    {
+        sec[CELL_TABLE + cell * 8 + 7] = (cell < 255) ? static_cast<uint8_t>(cell + 1) : 0;
+    }
+
+    return true;
+}
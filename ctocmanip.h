@@ -15,8 +15,9 @@
  * You should have received a copy of the GNU General Public License
  */
 #pragma once
-#include <netmd++.h>
+#include "cnetmddevice.h"
 #include <QVector>
+#include <QByteArray>
 #include <ctime>
 
 //------------------------------------------------------------------------------
@@ -41,12 +42,45 @@ public:
     //--------------------------------------------------------------------------
     using TitleVector = QVector<TitleDescr>;
 
+    //--------------------------------------------------------------------------
+    //! @brief      track as read from UTOC
+    //--------------------------------------------------------------------------
+    struct TrackScan
+    {
+        std::string mTitle;         //!< raw track title (MD charset)
+        uint8_t     mMode;          //!< track mode byte of first part
+        uint32_t    mSoundGroups;   //!< length in sound groups (all parts)
+        int         mParts;         //!< number of parts (fragments)
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      all tracks as read from UTOC (index 0 is track 1)
+    //--------------------------------------------------------------------------
+    using ScanVector = QVector<TrackScan>;
+
+    //--------------------------------------------------------------------------
+    //! @brief      raw titles (MD charset), index 0 is the disc title
+    //--------------------------------------------------------------------------
+    using RawTitles = std::vector<std::string>;
+
+    /// UTOC track mode: track isn't write protected
+    static constexpr uint8_t MODE_WRITABLE = 0x80;
+
+    /// UTOC track mode: track contains SP audio
+    static constexpr uint8_t MODE_AUDIO = 0x04;
+
+    /// UTOC track mode: stereo track
+    static constexpr uint8_t MODE_STEREO = 0x02;
+
+    /// sound groups per second (SP stereo, 512 samples at 44.1kHz)
+    static constexpr double SOUND_GROUPS_PER_SEC = 44100.0 / 512.0;
+
     //--------------------------------------------------------------------------
     //! @brief      constructs the object
     //!
-    //! @param[in]  api    NetMD API pointer
+    //! @param[in]  api    NetMD device pointer
     //--------------------------------------------------------------------------
-    CTocManip(netmd::netmd_pp* api = nullptr);
+    CTocManip(CNetMdDevice* api = nullptr);
 
     //--------------------------------------------------------------------------
     //! @brief      do the TOC manipulation
@@ -59,6 +93,31 @@ public:
     //--------------------------------------------------------------------------
     int manipulateTOC(const TitleVector& trackData, bool resetDev, bool mono);
 
+    //--------------------------------------------------------------------------
+    //! @brief      read titles, modes and lengths of all tracks from the
+    //!             UTOC sectors 0 (addresses) and 1 (half width titles);
+    //!             TOC edit mode is always left afterwards
+    //!
+    //! @param[out] tracks  the tracks found
+    //! @param[out] pHash   optional SHA1 of both sectors
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int scanDisc(ScanVector& tracks, QByteArray* pHash = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      rebuild half width title sector with all titles given,
+    //!             drop stale full width titles, write changed sectors
+    //!             and finalize the TOC
+    //!
+    //! @param[in]  titles    all titles, index 0 is the raw disc title
+    //! @param[in]  resetDev  reset device after TOC edit
+    //! @param[out] changed   set to true if a sector was written
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int rewriteTitles(const RawTitles& titles, bool resetDev, bool& changed);
+
     //--------------------------------------------------------------------------
     //! @brief      add data to byte vector
     //!
@@ -68,7 +127,90 @@ public:
     //--------------------------------------------------------------------------
     static void addArrayData(netmd::NetMDByteVector &vec, const char *data, size_t dataSz);
 
+    //--------------------------------------------------------------------------
+    //! @brief      parse tracks from UTOC sectors (TOC edit mode is active)
+    //!
+    //! @param[out] tracks  the tracks found
+    //! @param[out] pHash   optional SHA1 of both sectors
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int readScan(ScanVector& tracks, QByteArray* pHash);
+
+    //--------------------------------------------------------------------------
+    //! @brief      rebuild and write half width title sector, drop full width
+    //!             titles of changed entries (TOC edit mode is active)
+    //!
+    //! @param[in]  titles    all titles, index 0 is the raw disc title
+    //! @param[out] changed   set to true if a sector was written
+    //!
+    //! @return     NetMdErr
+    //--------------------------------------------------------------------------
+    int writeTitles(const RawTitles& titles, bool& changed);
+
+    //--------------------------------------------------------------------------
+    //! @brief      linear sound group from 3 byte UTOC address
+    //!
+    //! @param[in]  p     pointer to address
+    //!
+    //! @return     sound group
+    //--------------------------------------------------------------------------
+    static uint32_t soundGroup(const uint8_t* p);
+
+    //--------------------------------------------------------------------------
+    //! @brief      3 byte UTOC address from linear sound group
+    //!
+    //! @param[in]  sg    sound group
+    //! @param[out] p     pointer to address
+    //--------------------------------------------------------------------------
+    static void address(uint32_t sg, uint8_t* p);
+
+    //--------------------------------------------------------------------------
+    //! @brief      collect title from a chain of title cells
+    //!
+    //! @param[in]  sec   title sector
+    //! @param[in]  cell  first cell
+    //!
+    //! @return     raw title
+    //--------------------------------------------------------------------------
+    static std::string cellTitle(const netmd::NetMDByteVector& sec, uint8_t cell);
+
+    //--------------------------------------------------------------------------
+    //! @brief      put all titles into a half width title sector
+    //!             (pointers and cell table are rebuilt)
+    //!
+    //! @param[in]  titles  all titles, index 0 is the raw disc title
+    //! @param      sec     title sector
+    //!
+    //! @return     false if titles don't fit
+    //--------------------------------------------------------------------------
+    static bool encodeTitles(const RawTitles& titles, netmd::NetMDByteVector& sec);
+
+    /// size of one UTOC sector
+    static constexpr std::size_t SECTOR_SIZE = 2352;
+
+    /// offset of first track pointer (track n -> TRACK_PTR + n - 1)
+    static constexpr std::size_t TRACK_PTR = 0x2f;
+
+    /// offset of free cell pointer
+    static constexpr std::size_t EMPTY_PTR = 0x2d;
+
+    /// offset of free area pointer in sector 0
+    static constexpr std::size_t FREE_AREA_PTR = 0x2e;
+
+    /// offset of disc title pointer in sector 1
+    static constexpr std::size_t DISC_TITLE_PTR = 0x2e;
+
+    /// characters in one title cell
+    static constexpr std::size_t CELL_CHARS = 7;
+
+    /// offset of the 8 byte cell table
+    static constexpr std::size_t CELL_TABLE = 0x130;
+
+    /// offset of last track number in sector 0
+    static constexpr std::size_t LAST_TNO = 0x1f;
+
 private:
     /// net md api pointer
-    netmd::netmd_pp* mpApi;
+    CNetMdDevice* mpApi;
 };
@@ -10,7 +10,6 @@
 | $Id$
 \*************************************************************/
 #include "ctranslit.h"
-#include "mdtitle.h"
 
 /********************************************************************\
  *  This translit stuff only works, if you save this file in        *
@@ -22,128 +21,260 @@
  *  To do this, check out the project settings!                     *
 \********************************************************************/
 
-/* -----------------------------------------------------------------\
-|  Method: CTranslit / constructor
-|  Begin: 08.02.2010 / 11:05:00
-|  Author: Jo2003
-|  Description: init translation tables
-|
-|  Parameters: pointer to parent object
-|
-|  Returns: --
-\----------------------------------------------------------------- */
+// russian cyrillic (lower case, upper case is created)
+static const CTranslit::SEntry s_Cyrillic[] = {
+    {"а", "a"},  {"б", "b"},  {"в", "v"},   {"г", "g"},   {"д", "d"},
+    {"е", "e"},  {"ё", "e"},  {"ж", "zh"},  {"з", "z"},   {"и", "i"},
+    {"й", "j"},  {"к", "k"},  {"л", "l"},   {"м", "m"},   {"н", "n"},
+    {"о", "o"},  {"п", "p"},  {"р", "r"},   {"с", "s"},   {"т", "t"},
+    {"у", "u"},  {"ф", "f"},  {"х", "h"},   {"ц", "c"},   {"ш", "sh"},
+    {"щ", "sch"},{"ч", "ch"}, {"ы", "y"},   {"ъ", "´"},   {"ь", "'"},
+    {"э", "e'"}, {"ю", "yu"}, {"я", "ya"}
+};
+
+// latin accents / umlauts
+static const CTranslit::SEntry s_Latin[] = {
+    {"à", "a"},  {"À", "A"},  {"á", "a"},  {"Á", "A"},  {"â", "a"},
+    {"Â", "A"},  {"å", "a"},  {"Ã", "A"},  {"ä", "ae"}, {"Ä", "Ae"},
+    {"æ", "ae"}, {"Æ", "Ae"},
+    {"ç", "c"},  {"Ç", "C"},
+    {"ê", "e"},  {"Ê", "E"},  {"é", "e"},  {"É", "E"},  {"ë", "e"},
+    {"Ë", "E"},  {"è", "e"},  {"È", "E"},
+    {"ï", "i"},  {"Ï", "I"},  {"í", "i"},  {"Í", "I"},  {"î", "i"},
+    {"Î", "I"},  {"ì", "i"},  {"Ì", "I"},
+    {"ñ", "n"},  {"Ñ", "N"},
+    {"œ", "oe"}, {"Œ", "Oe"},
+    {"ö", "oe"}, {"Ö", "Oe"}, {"ô", "o"},  {"Ô", "O"},  {"ò", "o"},
+    {"Ò", "O"},  {"ó", "o"},  {"Ó", "O"},  {"õ", "o"},  {"Õ", "O"},
+    {"ø", "oe"}, {"Ø", "Oe"},
+    {"š", "s"},  {"Š", "S"},
+    {"ú", "u"},  {"Ú", "U"},  {"ù", "u"},  {"Ù", "U"},  {"ü", "ue"},
+    {"Ü", "Ue"}, {"û", "u"},  {"Û", "U"},
+    {"ý", "y"},  {"Ý", "Y"},  {"ÿ", "y"},  {"Ÿ", "Y"},
+    {"ž", "z"},  {"Ž", "Z"},
+    {"Ð", "D"},  {"ß", "ss"},
+
+    // decomposed umlauts (e.g. file names on macOS)
+    {"a\xcc\x88", "ae"}, {"A\xcc\x88", "Ae"},
+    {"o\xcc\x88", "oe"}, {"O\xcc\x88", "Oe"},
+    {"u\xcc\x88", "ue"}, {"U\xcc\x88", "Ue"}
+};
+
+// greek (lower case, upper case is created)
+static const CTranslit::SEntry s_Greek[] = {
+    {"α", "a"},  {"β", "v"},  {"γ", "g"},  {"δ", "d"},  {"ε", "e"},
+    {"ζ", "z"},  {"η", "i"},  {"θ", "th"}, {"ι", "i"},  {"κ", "k"},
+    {"λ", "l"},  {"μ", "m"},  {"ν", "n"},  {"ξ", "x"},  {"ο", "o"},
+    {"π", "p"},  {"ρ", "r"},  {"σ", "s"},  {"ς", "s"},  {"τ", "t"},
+    {"υ", "y"},  {"φ", "f"},  {"χ", "ch"}, {"ψ", "ps"}, {"ω", "o"},
+    {"ά", "a"},  {"έ", "e"},  {"ή", "i"},  {"ί", "i"},  {"ό", "o"},
+    {"ύ", "y"},  {"ώ", "o"},  {"ϊ", "i"},  {"ϋ", "y"},  {"ΐ", "i"},
+    {"ΰ", "y"},  {"ου", "ou"}, {"ού", "ou"}
+};
+
+// polish / czech diacritics (lower case, upper case is created)
+static const CTranslit::SEntry s_PolishCzech[] = {
+    {"ą", "a"},  {"ć", "c"},  {"ę", "e"},  {"ł", "l"},  {"ń", "n"},
+    {"ś", "s"},  {"ź", "z"},  {"ż", "z"},  {"č", "c"},  {"ď", "d"},
+    {"ě", "e"},  {"ň", "n"},  {"ř", "r"},  {"ť", "t"},  {"ů", "u"}
+};
+
+// typographic quotes / dashes
+static const CTranslit::SEntry s_Quotes[] = {
+    {"’", "'"},  {"‘", "'"},  {"‚", "'"},  {"‹", "'"},  {"›", "'"},
+    {"“", "\""}, {"”", "\""}, {"„", "\""}, {"«", "\""}, {"»", "\""},
+    {"…", "..."},{"–", "-"},  {"—", "-"}
+};
+
+//--------------------------------------------------------------------------
+//! @brief      get process wide instance
+//!
+//! @return     transliteration engine
+//--------------------------------------------------------------------------
+const CTranslit& CTranslit::instance()
+{
+    // built on first use, thread safe since C++11
+    static const CTranslit s_Translit;
+    return s_Translit;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance (builds the trie)
+//--------------------------------------------------------------------------
 CTranslit::CTranslit()
 {
-   // fill map (cyrillic -> latin) ...
-   mCyr2Lat[QString::fromUtf8("а")] = "a";
-   mCyr2Lat[QString::fromUtf8("б")] = "b";
-   mCyr2Lat[QString::fromUtf8("в")] = "v";
-   mCyr2Lat[QString::fromUtf8("г")] = "g";
-   mCyr2Lat[QString::fromUtf8("д")] = "d";
-   mCyr2Lat[QString::fromUtf8("е")] = "e";
-   mCyr2Lat[QString::fromUtf8("ё")] = "e";
-   mCyr2Lat[QString::fromUtf8("ж")] = "zh";
-   mCyr2Lat[QString::fromUtf8("з")] = "z";
-   mCyr2Lat[QString::fromUtf8("и")] = "i";
-   mCyr2Lat[QString::fromUtf8("й")] = "j";
-   mCyr2Lat[QString::fromUtf8("к")] = "k";
-   mCyr2Lat[QString::fromUtf8("л")] = "l";
-   mCyr2Lat[QString::fromUtf8("м")] = "m";
-   mCyr2Lat[QString::fromUtf8("н")] = "n";
-   mCyr2Lat[QString::fromUtf8("о")] = "o";
-   mCyr2Lat[QString::fromUtf8("п")] = "p";
-   mCyr2Lat[QString::fromUtf8("р")] = "r";
-   mCyr2Lat[QString::fromUtf8("с")] = "s";
-   mCyr2Lat[QString::fromUtf8("т")] = "t";
-   mCyr2Lat[QString::fromUtf8("у")] = "u";
-   mCyr2Lat[QString::fromUtf8("ф")] = "f";
-   mCyr2Lat[QString::fromUtf8("х")] = "h";
-   mCyr2Lat[QString::fromUtf8("ц")] = "c";
-   mCyr2Lat[QString::fromUtf8("ш")] = "sh";
-   mCyr2Lat[QString::fromUtf8("щ")] = "sch";
-   mCyr2Lat[QString::fromUtf8("ч")] = "ch";
-   mCyr2Lat[QString::fromUtf8("ы")] = "y";
-   mCyr2Lat[QString::fromUtf8("ъ")] = "´";
-   mCyr2Lat[QString::fromUtf8("ь")] = "'";
-   mCyr2Lat[QString::fromUtf8("э")] = "e'";
-   mCyr2Lat[QString::fromUtf8("ю")] = "yu";
-   mCyr2Lat[QString::fromUtf8("я")] = "ya";
-
-   // upper case
-   QMap<QString, QString> tmpMap;
-   for (auto key : mCyr2Lat.keys())
-   {
-       QString val = mCyr2Lat.value(key);
-       val[0] = val[0].toUpper();
-       key[0] = key[0].toUpper();
-
-       tmpMap.insert(key, val);
-   }
-
-   for (const auto& k : tmpMap.keys())
-   {
-       mCyr2Lat.insert(k, tmpMap.value(k));
-   }
+    // root node
+    mNodes.append(SNode{QHash<ushort, int>(), 0, QVector<QString>()});
+
+    addTable(CYRILLIC, s_Cyrillic, sizeof(s_Cyrillic) / sizeof(s_Cyrillic[0]), true);
+    addTable(LATIN, s_Latin, sizeof(s_Latin) / sizeof(s_Latin[0]), false);
+    addTable(GREEK, s_Greek, sizeof(s_Greek) / sizeof(s_Greek[0]), true);
+    addTable(POLISH_CZECH, s_PolishCzech, sizeof(s_PolishCzech) / sizeof(s_PolishCzech[0]), true);
+    addTable(QUOTES, s_Quotes, sizeof(s_Quotes) / sizeof(s_Quotes[0]), false);
 }
 
-/* -----------------------------------------------------------------\
-|  Method: CyrToLat
-|  Begin: 08.02.2010 / 11:05:00
-|  Author: Jo2003
-|  Description: make translit cyrillic --> latin
-|
-|  Parameters: ref. to cyrillic string
-|
-|  Returns: latin string
-\----------------------------------------------------------------- */
-QString CTranslit::CyrToLat(const QString &str, bool fileName)
+//--------------------------------------------------------------------------
+//! @brief      add table to trie
+//!
+//! @param[in]  table    table bit
+//! @param[in]  pTab     table entries
+//! @param[in]  count    number of entries
+//! @param[in]  upper    also add capitalized entries
+//--------------------------------------------------------------------------
+void CTranslit::addTable(Table table, const SEntry* pTab, size_t count, bool upper)
 {
-    QString sOut = str;
+    for (size_t i = 0; i < count; i++)
+    {
+        QString from = QString::fromUtf8(pTab[i].mFrom);
+        QString to   = QString::fromUtf8(pTab[i].mTo);
+
+        insert(table, from, to);
+
+        if (upper)
+        {
+            QString uFrom = from;
+            uFrom[0]      = uFrom[0].toUpper();
 
-    auto uniCodeToks = unicodeSplit(str);
-    for (const auto& c : uniCodeToks)
+            // some letters don't have an upper case form
+            if (uFrom != from)
+            {
+                to[0] = to[0].toUpper();
+                insert(table, uFrom, to);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add one sequence to trie
+//!
+//! @param[in]  table  table bit
+//! @param[in]  from   source sequence
+//! @param[in]  to     replacement
+//--------------------------------------------------------------------------
+void CTranslit::insert(Table table, const QString& from, const QString& to)
+{
+    int node = 0;
+
+    for (const auto& c : from)
     {
-        if (mCyr2Lat.keys().contains(c))
+        int next = mNodes.at(node).mNext.value(c.unicode(), -1);
+
+        if (next == -1)
         {
-            sOut.replace(c, mCyr2Lat.value(c));
+            next = mNodes.size();
+            mNodes.append(SNode{QHash<ushort, int>(), 0, QVector<QString>()});
+            mNodes[node].mNext.insert(c.unicode(), next);
         }
+
+        node = next;
     }
 
-    if (fileName)
+    SNode& n = mNodes[node];
+
+    if (n.mOut.isEmpty())
     {
-        sOut.replace(" ", "_");
-        sOut.replace("'", "");
-        sOut.replace("´", "");
-        sOut = sOut.toUpper();
+        n.mOut.resize(tableIndex(QUOTES) + 1);
     }
 
-    return sOut;
+    n.mTables |= table;
+    n.mOut[tableIndex(table)] = to;
 }
 
-/* -----------------------------------------------------------------\
-|  Method: LatToCyr
-|  Begin: 08.02.2010 / 11:05:00
-|  Author: Jo2003
-|  Description: make translit latin --> cyrillic
-|
-|  Parameters: ref. to latin string
-|
-|  Returns: cyrillic string
-\----------------------------------------------------------------- */
-QString CTranslit::LatToCyr(const QString &str, bool fileName)
+//--------------------------------------------------------------------------
+//! @brief      index of table bit
+//!
+//! @param[in]  table  table bit
+//!
+//! @return     index
+//--------------------------------------------------------------------------
+int CTranslit::tableIndex(Table table)
+{
+    int idx = 0;
+
+    while ((static_cast<uint32_t>(table) >> (idx + 1)) != 0)
+    {
+        idx++;
+    }
+    return idx;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      transliterate string
+//!
+//! @param[in]  str     The string
+//! @param[in]  tables  tables to use (ORed Table values)
+//!
+//! @return     transliterated string
+//--------------------------------------------------------------------------
+QString CTranslit::apply(const QString& str, uint32_t tables) const
 {
-    QString sOut = str;
+    QString out;
+    out.reserve(str.size() + str.size() / 4);
 
-    auto toks = mCyr2Lat.values();
+    const QChar* pData = str.constData();
+    int          size  = str.size();
 
-    for (const auto& tok : toks)
+    for (int i = 0; i < size;)
     {
-        if (sOut.contains(tok))
+        const QString* pRepl = nullptr;
+        int matchLen = 0;
+        int node     = 0;
+
+        // walk as deep as possible, remember the longest match
+        for (int j = i; j < size; j++)
+        {
+            int next = mNodes.at(node).mNext.value(pData[j].unicode(), -1);
+
+            if (next == -1)
+            {
+                break;
+            }
+
+            node = next;
+            const SNode& n = mNodes.at(node);
+
+            if (n.mTables & tables)
+            {
+                for (int t = 0; t < n.mOut.size(); t++)
+                {
+                    if ((n.mTables & tables) & (1u << t))
+                    {
+                        pRepl = &n.mOut.at(t);
+                        break;
+                    }
+                }
+                matchLen = j - i + 1;
+            }
+        }
+
+        if (pRepl != nullptr)
         {
-            sOut.replace(tok, mCyr2Lat.key(tok));
+            out += *pRepl;
+            i   += matchLen;
+        }
+        else
+        {
+            out += pData[i];
+            i++;
         }
     }
 
+    return out;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      make translit cyrillic --> latin
+//!
+//! @param[in]  str       cyrillic string
+//! @param[in]  fileName  make string usable as file name
+//!
+//! @return     latin string
+//--------------------------------------------------------------------------
+QString CTranslit::CyrToLat(const QString &str, bool fileName) const
+{
+    QString sOut = apply(str, CYRILLIC);
+
     if (fileName)
     {
         sOut.replace(" ", "_");
@@ -11,24 +11,107 @@
 \*************************************************************/
 #pragma once
 #include <QString>
-#include <QMap>
+#include <QVector>
+#include <QHash>
+#include <cstdint>
 
-/********************************************************************\
-|  Class: CTranslit
-|  Date:  08.02.2010 / 11:00:28
-|  Author: Jo2003
-|  Description: class to make translit between latin and cyrillic
-|
-\********************************************************************/
+//------------------------------------------------------------------------------
+//! @brief      Transliteration into MD safe latin text. All tables are merged
+//!             into one trie which is built once and never changed afterwards,
+//!             so one instance can be used from any thread. Replacement is
+//!             done in a single pass, always using the longest match.
+//------------------------------------------------------------------------------
 class CTranslit
 {
 public:
+    /// transliteration tables
+    enum Table : uint32_t
+    {
+        CYRILLIC     = (1 << 0),    ///< russian cyrillic
+        LATIN        = (1 << 1),    ///< latin accents / umlauts
+        GREEK        = (1 << 2),    ///< greek
+        POLISH_CZECH = (1 << 3),    ///< polish / czech diacritics
+        QUOTES       = (1 << 4),    ///< typographic quotes / dashes
+        ALL          = CYRILLIC | LATIN | GREEK | POLISH_CZECH | QUOTES
+    };
+
+    /// one table entry (UTF-8)
+    struct SEntry
+    {
+        const char* mFrom;  ///< source sequence
+        const char* mTo;    ///< replacement
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      get process wide instance
+    //!
+    //! @return     transliteration engine
+    //--------------------------------------------------------------------------
+    static const CTranslit& instance();
+
+    //--------------------------------------------------------------------------
+    //! @brief      transliterate string
+    //!
+    //! @param[in]  str     The string
+    //! @param[in]  tables  tables to use (ORed Table values)
+    //!
+    //! @return     transliterated string
+    //--------------------------------------------------------------------------
+    QString apply(const QString& str, uint32_t tables = ALL) const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      make translit cyrillic --> latin
+    //!
+    //! @param[in]  str       cyrillic string
+    //! @param[in]  fileName  make string usable as file name
+    //!
+    //! @return     latin string
+    //--------------------------------------------------------------------------
+    QString CyrToLat(const QString& str, bool fileName = true) const;
+
+protected:
+    /// one trie node
+    struct SNode
+    {
+        QHash<ushort, int> mNext;       ///< child nodes by UTF-16 code unit
+        uint32_t           mTables;     ///< tables having a replacement here
+        QVector<QString>   mOut;        ///< replacement per table bit
+    };
+
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance (builds the trie)
+    //--------------------------------------------------------------------------
     CTranslit();
 
-    QString CyrToLat (const QString &str, bool fileName = true);
-    QString LatToCyr (const QString &str, bool fileName = true);
+    //--------------------------------------------------------------------------
+    //! @brief      add table to trie
+    //!
+    //! @param[in]  table    table bit
+    //! @param[in]  pTab     table entries
+    //! @param[in]  count    number of entries
+    //! @param[in]  upper    also add capitalized entries
+    //--------------------------------------------------------------------------
+    void addTable(Table table, const SEntry* pTab, size_t count, bool upper);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add one sequence to trie
+    //!
+    //! @param[in]  table  table bit
+    //! @param[in]  from   source sequence
+    //! @param[in]  to     replacement
+    //--------------------------------------------------------------------------
+    void insert(Table table, const QString& from, const QString& to);
+
+    //--------------------------------------------------------------------------
+    //! @brief      index of table bit
+    //!
+    //! @param[in]  table  table bit
+    //!
+    //! @return     index
+    //--------------------------------------------------------------------------
+    static int tableIndex(Table table);
 
 private:
-    QMap<QString, QString> mCyr2Lat;
+    /// trie nodes, index 0 is the root
+    QVector<SNode> mNodes;
 };
-
@@ -17,7 +17,8 @@
 #include "cueparser.h"
 #include <QFile>
 #include <QFileInfo>
-#include <QRegExp>
+#include <QTextCodec>
+#include <QHash>
 #include <QDir>
 #include <QMimeDatabase>
 #include <QMimeType>
@@ -65,13 +66,24 @@ bool CueParser::findAudioFile(const QString& path, QString& fileName) const
     }
     else
     {
-        QMimeDatabase mimeDb;
-        QFileInfo fi(fileName);
-        QDir audioDir(path);
-        audioDir.setNameFilters({fi.completeBaseName() + ".*"});
+        // the mime database is thread safe, the folder is listed once per cue sheet
+        static const QMimeDatabase mimeDb;
 
-        for (const auto& f : audioDir.entryInfoList())
+        if (mListedDir != path)
         {
+            mDirList   = QDir(path).entryInfoList(QDir::Files);
+            mListedDir = path;
+        }
+
+        QString prefix = QFileInfo(fileName).completeBaseName() + ".";
+
+        for (const auto& f : mDirList)
+        {
+            if (!f.fileName().startsWith(prefix, Qt::CaseInsensitive))
+            {
+                continue;
+            }
+
             QMimeType mt = mimeDb.mimeTypeForFile(f);
             if (mt.isValid())
             {
@@ -89,50 +101,119 @@ bool CueParser::findAudioFile(const QString& path, QString& fileName) const
 }
 
 //--------------------------------------------------------------------------
-//! @brief      parse the cue file
+//! @brief      decode raw cue sheet content; honors BOMs, tries UTF-8
+//!             and falls back to the local 8 bit code page
 //!
-//! @param[in]  cueFileName  The cue file name
+//! @param[in]  raw   The raw file content
 //!
-//! @return     0 on success; < 0 on error
+//! @return     decoded text
 //--------------------------------------------------------------------------
-int CueParser::parse(const QString &cueFileName)
+QString CueParser::decode(const QByteArray& raw)
 {
-    int ret = 0;
+    if (raw.startsWith("\xEF\xBB\xBF"))
+    {
+        return QString::fromUtf8(raw.constData() + 3, raw.size() - 3);
+    }
+    else if (raw.startsWith("\xFF\xFE"))
+    {
+        return QTextCodec::codecForName("UTF-16LE")->toUnicode(raw.mid(2));
+    }
+    else if (raw.startsWith("\xFE\xFF"))
+    {
+        return QTextCodec::codecForName("UTF-16BE")->toUnicode(raw.mid(2));
+    }
 
-    // You thought this would be nice? You're wrong!
+    // most rippers write UTF-8 without BOM these days
+    QTextCodec::ConverterState state;
+    QString text = QTextCodec::codecForName("UTF-8")->toUnicode(raw.constData(), raw.size(), &state);
 
-    // disc year
-    QRegExp rxpYear("^REM\\s+DATE\\s+(.*)$");
+    if (state.invalidChars == 0)
+    {
+        return text;
+    }
 
-    // get title string
-    QRegExp rxpTitle("^TITLE\\s+(.*)$");
+    return QTextCodec::codecForLocale()->toUnicode(raw);
+}
 
-    // get performer
-    QRegExp rxpPerf("^PERFORMER\\s+(.*)$");
+//--------------------------------------------------------------------------
+//! @brief      parse cue sheet time (mm:ss:ff, 75 frames per second)
+//!
+//! @param[in]  str   The time string
+//! @param[out] ms    time in ms
+//!
+//! @return     true on success
+//--------------------------------------------------------------------------
+bool CueParser::parseTime(const QStringRef& str, uint32_t& ms)
+{
+    uint32_t part[3] = {0, 0, 0};
+    int      idx     = 0;
+    bool     digit   = false;
 
-    // get track
-    QRegExp rxpTrack("^TRACK\\s+([0-9]+)\\s+([A-Za-z]+)$");
+    for (const QChar& c : str)
+    {
+        if (c.isDigit())
+        {
+            part[idx] = part[idx] * 10 + static_cast<uint32_t>(c.digitValue());
+            digit     = true;
+        }
+        else if ((c == QChar(':')) && digit && (idx < 2))
+        {
+            idx++;
+            digit = false;
+        }
+        else
+        {
+            return false;
+        }
+    }
 
-    // get INDEX 01
-    QRegExp rxpIndex("^INDEX\\s+01\\s+([0-9:]+)$");
+    if ((idx != 2) || !digit)
+    {
+        return false;
+    }
 
-    // get audio file
-    QRegExp rxpFile("^FILE\\s+(.*)\\s+(.+)$");
+    ms = part[0] * 60 * 1000 + part[1] * 1000 + (part[2] * 1000 + 37) / 75;
+    return true;
+}
 
-    // pre-filter
-    QRegExp rxpUse("^(REM\\s+DATE|TITLE|PERFORMER|TRACK|INDEX\\s+01|FILE).*$");
+//--------------------------------------------------------------------------
+//! @brief      parse the cue file
+//!
+//! @param[in]  cueFileName  The cue file name
+//!
+//! @return     0 on success; < 0 on error
+//--------------------------------------------------------------------------
+int CueParser::parse(const QString &cueFileName)
+{
+    int ret = 0;
+
+    // information taken from one audio file
+    struct SAudio
+    {
+        uint32_t    mConv;
+        int         mLengthMs;
+        audio::STag mTag;
+    };
 
     QFile cueFile(cueFileName);
     QFileInfo cfi(cueFileName);
 
     bool inTrack = false;
-    Track track;
-    QString file, lastFile;
+    Track track = {-1, TrackType::DATA, "", "", "", 0, 0, 0, 0, 0, 0};
+    QString file;
     TrackType ttype = TrackType::DATA;
-    int audLengthMs = 0;
-    uint32_t audConv = 0;
     mDiscData = {"", "", 0, -1, {}};
-    audio::STag tag;
+    mCueFile  = cueFileName;
+    mCuePath  = cfi.canonicalPath();
+    mListedDir.clear();
+    mDirList.clear();
+    SAudio audInfo = {0, 0, {}};
+    QHash<QString, SAudio> probed;
+
+    // pregap state of current track
+    bool     hasIdx00 = false;
+    uint32_t idx00Ms  = 0;
+    QString  idx00File;
 
     try
     {
@@ -141,130 +222,247 @@ int CueParser::parse(const QString &cueFileName)
             mCueThrow(-1, "Can't open cue file " << cueFileName);
         }
 
-        QTextStream in(&cueFile);
+        QString text = decode(cueFile.readAll());
+        cueFile.close();
+
+        int pos = 0;
 
-        while (!in.atEnd())
+        while (pos < text.size())
         {
-            QString line = in.readLine().trimmed();
+            // line ends with '\n', '\r' or "\r\n"
+            int eol = pos;
+            while ((eol < text.size()) && (text.at(eol) != QChar('\n')) && (text.at(eol) != QChar('\r')))
+            {
+                eol++;
+            }
 
-            // check for needed information
-            if (rxpUse.indexIn(line) > -1) // pre-filter!
+            QStringRef line = text.midRef(pos, eol - pos).trimmed();
+            pos = eol + 1;
+
+            if ((eol < text.size()) && (text.at(eol) == QChar('\r'))
+                && (pos < text.size()) && (text.at(pos) == QChar('\n')))
             {
-                if (rxpFile.indexIn(line) > -1) // Audio file
-                {
-                    lastFile = file;
-                    file = rxpFile.cap(1).replace(QChar('"'), "");
+                pos++;
+            }
 
-                    // remove any directory part
-                    QFileInfo afi(file);
-                    file = afi.fileName();
+            // split line: keyword, up to two arguments and
+            // the position where the arguments start
+            QStringRef tok[3];
+            int count = 0;
+            int args  = line.size();
+            int i     = 0;
 
-                    if (!findAudioFile(cfi.canonicalPath(), file))
-                    {
-                        mCueThrow(-5, "Can't find audio file " << file);
-                    }
+            while ((i < line.size()) && (count < 3))
+            {
+                while ((i < line.size()) && line.at(i).isSpace())
+                {
+                    i++;
+                }
 
-                    if (lastFile != file)
-                    {
-                        // get additional information from audio file
-                        if (audio::checkAudioFile(cfi.canonicalPath() + "/" + file, audConv, audLengthMs, &tag) != 0)
-                        {
-                            mCueThrow(-4, "Can't recognize audio file " << file);
-                        }
-                    }
+                if (i >= line.size())
+                {
+                    break;
                 }
-                else if (rxpYear.indexIn(line) > -1) // year
+
+                if (count == 1)
                 {
-                    mDiscData.mYear = rxpYear.cap(1).toInt();
-                    qInfo() << "Found year" << mDiscData.mYear << "in cue sheet file!";
+                    args = i;
                 }
-                else if (rxpTitle.indexIn(line) > -1) // title (disc or track)
+
+                int s;
+                if (line.at(i) == QChar('"'))
                 {
-                    if (inTrack)
-                    {
-                        track.mTitle = rxpTitle.cap(1).replace(QChar('"'), "");
-                    }
-                    else
+                    s = ++i;
+                    while ((i < line.size()) && (line.at(i) != QChar('"')))
                     {
-                        mDiscData.mTitle = rxpTitle.cap(1).replace(QChar('"'), "");
+                        i++;
                     }
+                    tok[count++] = line.mid(s, i - s);
+                    i++;
                 }
-                else if (rxpPerf.indexIn(line) > -1) // performer / artist (disc or track)
+                else
                 {
-                    if (inTrack)
+                    s = i;
+                    while ((i < line.size()) && !line.at(i).isSpace())
                     {
-                        track.mPerformer = rxpPerf.cap(1).replace(QChar('"'), "");
+                        i++;
                     }
-                    else
+                    tok[count++] = line.mid(s, i - s);
+                }
+            }
+
+            if (count == 0)
+            {
+                continue;
+            }
+            else if (tok[0] == QLatin1String("FILE"))  // Audio file
+            {
+                // file name is everything up to the type
+                QString argStr = line.mid(args).toString().remove(QChar('"'));
+                int typePos = argStr.size() - 1;
+                while ((typePos > 0) && !argStr.at(typePos).isSpace())
+                {
+                    typePos--;
+                }
+
+                if (typePos < 1)
+                {
+                    mCueThrow(-2, "Can't parse line: " << line.toString());
+                }
+
+                // remove any directory part
+                file = QFileInfo(argStr.left(typePos).trimmed()).fileName();
+
+                if (!findAudioFile(mCuePath, file))
+                {
+                    mCueThrow(-5, "Can't find audio file " << file);
+                }
+
+                // get additional information from audio file (once per file)
+                if (!probed.contains(file))
+                {
+                    SAudio a = {0, 0, {}};
+                    if (audio::checkAudioFile(mCuePath + "/" + file, a.mConv, a.mLengthMs, &a.mTag) != 0)
                     {
-                        mDiscData.mPerformer = rxpPerf.cap(1).replace(QChar('"'), "");
+                        mCueThrow(-4, "Can't recognize audio file " << file);
                     }
+                    probed.insert(file, a);
                 }
-                else if (rxpTrack.indexIn(line) > -1) // track
+                audInfo = probed.value(file);
+            }
+            else if (tok[0] == QLatin1String("REM"))
+            {
+                if ((count > 2) && (tok[1] == QLatin1String("DATE")))  // year
                 {
-                    if (inTrack)
-                    {
-                        // store track
-                        mDiscData.mTracks.append(track);
+                    mDiscData.mYear = tok[2].toInt();
+                    qInfo() << "Found year" << mDiscData.mYear << "in cue sheet file!";
+                }
+            }
+            else if ((tok[0] == QLatin1String("TITLE")) || (tok[0] == QLatin1String("PERFORMER")))
+            {
+                if (count < 2)
+                {
+                    mCueThrow(-2, "Can't parse line: " << line.toString());
+                }
 
-                        // cleanup track structure
-                        track = {-1, TrackType::DATA, "", "", "", 0, 0, 0, 0, 0};
+                // disc or track
+                QString& dst = (tok[0] == QLatin1String("TITLE"))
+                        ? (inTrack ? track.mTitle     : mDiscData.mTitle)
+                        : (inTrack ? track.mPerformer : mDiscData.mPerformer);
+                dst = line.mid(args).toString().remove(QChar('"'));
+            }
+            else if (tok[0] == QLatin1String("TRACK"))
+            {
+                bool ok = false;
+                int  no = (count > 2) ? tok[1].toInt(&ok) : -1;
+
+                if (!ok)
+                {
+                    mCueThrow(-2, "Can't parse line: " << line.toString());
+                }
+
+                if (inTrack)
+                {
+                    // store track
+                    mDiscData.mTracks.append(track);
+
+                    // cleanup track structure
+                    track = {-1, TrackType::DATA, "", "", "", 0, 0, 0, 0, 0, 0};
+                }
+
+                inTrack  = true;
+                hasIdx00 = false;
+                track.mNo = no;
+                ttype = (tok[2].compare(QLatin1String("AUDIO"), Qt::CaseInsensitive) == 0) ? TrackType::AUDIO : TrackType::DATA;
+            }
+            else if (tok[0] == QLatin1String("PREGAP"))
+            {
+                // silence which isn't part of any audio file
+                uint32_t ms;
+                if ((count > 1) && parseTime(tok[1], ms))
+                {
+                    track.mPregapMs = ms;
+                    qInfo() << "Track" << track.mNo << "has" << ms << "ms pregap silence, which will be skipped.";
+                }
+            }
+            else if (tok[0] == QLatin1String("INDEX"))
+            {
+                uint32_t msec;
+                int idxNo = (count > 2) ? tok[1].toInt() : -1;
+
+                if ((idxNo == 0) || (idxNo == 1))
+                {
+                    if (!parseTime(tok[2], msec))
+                    {
+                        mCueThrow(-3, "Wrong index format: " << tok[2].toString());
                     }
+                }
+                else if (count < 3)
+                {
+                    mCueThrow(-2, "Can't parse line: " << line.toString());
+                }
 
-                    inTrack = true;
-                    track.mNo = rxpTrack.cap(1).toUInt();
-                    ttype = (rxpTrack.cap(2).toUpper() == "AUDIO") ? TrackType::AUDIO : TrackType::DATA;
+                if (idxNo == 0)
+                {
+                    hasIdx00  = true;
+                    idx00Ms   = msec;
+                    idx00File = file;
                 }
-                else if (rxpIndex.indexIn(line) > -1) // index 01
+                else if (idxNo == 1)
                 {
+                    Track* pPrev = mDiscData.mTracks.isEmpty() ? nullptr : &mDiscData.mTracks.last();
+
                     // file mentioned before INDEX 01 is the track file
                     track.mAudioFile  = file;
-                    track.mConversion = audConv;
-                    track.mEndMs      = static_cast<uint32_t>(audLengthMs);
+                    track.mConversion = audInfo.mConv;
+                    track.mEndMs      = static_cast<uint32_t>(audInfo.mLengthMs);
                     track.mType       = ttype;
+                    track.mStartMs    = msec;
 
                     // add missing information
                     if (track.mTitle.isEmpty())
                     {
-                        track.mTitle = !tag.mTitle.isEmpty() ? tag.mTitle : titleFromFileName(file);
+                        track.mTitle = !audInfo.mTag.mTitle.isEmpty() ? audInfo.mTag.mTitle : titleFromFileName(file);
                     }
 
                     if (track.mPerformer.isEmpty())
                     {
-                        track.mPerformer = !tag.mArtist.isEmpty() ? tag.mArtist : mDiscData.mPerformer;
+                        track.mPerformer = !audInfo.mTag.mArtist.isEmpty() ? audInfo.mTag.mArtist : mDiscData.mPerformer;
                     }
 
-                    QString idx = rxpIndex.cap(1);
-                    auto idxs = idx.split(QChar(':'));
-                    if (idxs.size() == 3)
+                    if (hasIdx00)
                     {
-                        uint32_t msec = idxs.at(0).toUInt() * 60 * 1000; // minutes
-                        msec += idxs.at(1).toUInt() * 1000;              // seconds
-                        msec += idxs.at(2).toUInt() * 10;                // 100ths of seconds
-                        track.mStartMs = msec;
-
-                        // we must mark the end of the former track
-                        if (!mDiscData.mTracks.isEmpty() && msec)
+                        if (idx00File == file)
                         {
-                            mDiscData.mTracks[mDiscData.mTracks.size() - 1].mEndMs = msec;
+                            track.mPregapMs = msec - qMin(msec, idx00Ms);
+
+                            // gap at the start of a new file can't be played
+                            // with the former track, so don't drop it
+                            if ((pPrev != nullptr) && (pPrev->mAudioFile != file))
+                            {
+                                track.mStartMs = idx00Ms;
+                            }
+                        }
+                        else if (pPrev != nullptr)
+                        {
+                            // gap is at the end of the former file
+                            track.mPregapMs = msec + (pPrev->mEndMs - qMin(pPrev->mEndMs, idx00Ms));
                         }
                     }
-                    else
+
+                    // we must mark the end of the former track,
+                    // a gap in the same file stays with it (as on CD)
+                    if ((pPrev != nullptr) && (pPrev->mAudioFile == file))
                     {
-                        mCueThrow(-3, "Wrong index format: " << idx);
+                        pPrev->mEndMs = track.mStartMs;
                     }
                 }
-                else
-                {
-                    mCueThrow(-2, "Can't parse line: " << line);
-                }
             }
             else
             {
-                qDebug() << "Ignore line" << line;
+                qDebug() << "Ignore line" << line.toString();
             }
         }
-        cueFile.close();
 
         // mind the last track
         if (inTrack)
@@ -279,21 +477,13 @@ int CueParser::parse(const QString &cueFileName)
             mDiscData.mTracks.append(track);
         }
 
-        // compute disc length and LBA stuff
-        uint32_t lba = 0;
-        lastFile = "";
+        // compute disc length and LBA stuff (relative to the audio file)
         for (auto& t : mDiscData.mTracks)
         {
-            if (lastFile != t.mAudioFile)
-            {
-                // new file means we start from 0
-                lba = 0;
-            }
-            lastFile = t.mAudioFile;
-            t.mStartLba = lba;
-            t.mLbaCount = qRound((static_cast<double>(t.mEndMs - t.mStartMs) / 1000.0) * 75.0);
-            lba += t.mLbaCount;
-            mDiscData.mLenInMs += t.mEndMs - t.mStartMs;
+            uint32_t endLba = qRound((static_cast<double>(t.mEndMs) / 1000.0) * 75.0);
+            t.mStartLba     = qRound((static_cast<double>(t.mStartMs) / 1000.0) * 75.0);
+            t.mLbaCount     = (endLba > t.mStartLba) ? (endLba - t.mStartLba) : 0;
+            mDiscData.mLenInMs += t.mEndMs - qMin(t.mEndMs, t.mStartMs);
         }
 
         qDebug().noquote() << Qt::endl << static_cast<QString>(mDiscData);
@@ -420,3 +610,83 @@ bool CueParser::isValid() const
 {
     return mValid;
 }
+
+//--------------------------------------------------------------------------
+//! @brief      create source list entries from parsed cue sheet
+//!
+//! @return     disc entry (index 0) and all tracks; empty if not valid
+//--------------------------------------------------------------------------
+c2n::AudioTracks CueParser::audioTracks() const
+{
+    c2n::STrackInfo cueInfo;
+    c2n::AudioTracks tracks;
+    QDateTime tStamp;
+    tracks.setListType(c2n::AudioTracks::CUE_SHEET);
+
+    if (!mValid)
+    {
+        return tracks;
+    }
+
+    // disc info
+    if (!mDiscData.mPerformer.isEmpty())
+    {
+        cueInfo.mTitle = mDiscData.mPerformer + " - ";
+    }
+    cueInfo.mTitle += mDiscData.mTitle;
+
+    // in case no title is stored, use file name
+    if (cueInfo.mTitle.isEmpty())
+    {
+        cueInfo.mTitle = titleFromFileName(mCueFile);
+    }
+
+    if (cueInfo.mTitle.isEmpty())
+    {
+        cueInfo.mTitle = tr("<untitled>");
+    }
+    cueInfo.mLbCount = qRound((static_cast<double>(mDiscData.mLenInMs) / 1000.0) * 75.0);
+    tracks.append(cueInfo);
+
+    if (mDiscData.mYear > 0)
+    {
+        tStamp.setDate(QDate(mDiscData.mYear, 11, 11));
+        tStamp.setTime(QTime(11, 11, 11));
+    }
+
+    // tracks ...
+    for (const auto& t : mDiscData.mTracks)
+    {
+        cueInfo.mFileName   = mCuePath + "/" + t.mAudioFile;
+        cueInfo.mStartLba   = t.mStartLba;
+        cueInfo.mLbCount    = t.mLbaCount;
+        cueInfo.mCDTrackNo  = t.mNo;
+        cueInfo.mConversion = t.mConversion;
+        cueInfo.mTType      = t.mType;
+        cueInfo.mTitle      = "";
+        if (tStamp.isValid())
+        {
+            cueInfo.mTStamp = tStamp;
+        }
+
+        if (!t.mPerformer.isEmpty() && (t.mPerformer != mDiscData.mPerformer))
+        {
+            cueInfo.mTitle  = t.mPerformer + " - ";
+        }
+        cueInfo.mTitle     += t.mTitle;
+
+        // in case no title is stored, use file name
+        if (cueInfo.mTitle.isEmpty())
+        {
+            cueInfo.mTitle = titleFromFileName(cueInfo.mFileName);
+        }
+
+        if (cueInfo.mTitle.isEmpty())
+        {
+            cueInfo.mTitle = tr("<untitled>");
+        }
+        tracks.append(cueInfo);
+    }
+
+    return tracks;
+}
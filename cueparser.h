@@ -16,15 +16,20 @@
  */
 #pragma once
 #include "audio.h"
+#include <QCoreApplication>
+#include <QFileInfo>
 #include <QString>
 #include <QTextStream>
 #include <QVector>
 
 //------------------------------------------------------------------------------
-//! @brief      This class describes a simple cue parser.
+//! @brief      This class describes a simple cue parser. The sheet is read
+//!             in one go and split by a hand-written single pass lexer.
 //------------------------------------------------------------------------------
 class CueParser
 {
+    Q_DECLARE_TR_FUNCTIONS(CueParser)
+
 public:
 
     //--------------------------------------------------------------------------
@@ -47,6 +52,7 @@ public:
         uint32_t mStartLba;   ///< start sector relative to pseudo CD
         uint32_t mLbaCount;   ///< length in LBA
         uint32_t mConversion; ///< any conversion needed?
+        uint32_t mPregapMs;   ///< pregap (INDEX 00 / PREGAP) in ms
 
         //----------------------------------------------------------------------
         //! @brief      Qstring conversion operator.
@@ -61,6 +67,11 @@ public:
                << " ms, lba start: " << mStartLba << ", count: " << mLbaCount
                << ", conv.: " << QString::number(mConversion, 16) << "h";
 
+            if (mPregapMs > 0)
+            {
+                ts << ", pregap: " << mPregapMs << " ms";
+            }
+
             return s;
         }
     };
@@ -175,13 +186,53 @@ public:
     //--------------------------------------------------------------------------
     bool findAudioFile(const QString& path, QString& fileName) const;
 
+    //--------------------------------------------------------------------------
+    //! @brief      create source list entries from parsed cue sheet
+    //!
+    //! @return     disc entry (index 0) and all tracks; empty if not valid
+    //--------------------------------------------------------------------------
+    c2n::AudioTracks audioTracks() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      decode raw cue sheet content; honors BOMs, tries UTF-8
+    //!             and falls back to the local 8 bit code page
+    //!
+    //! @param[in]  raw   The raw file content
+    //!
+    //! @return     decoded text
+    //--------------------------------------------------------------------------
+    static QString decode(const QByteArray& raw);
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      parse cue sheet time (mm:ss:ff, 75 frames per second)
+    //!
+    //! @param[in]  str   The time string
+    //! @param[out] ms    time in ms
+    //!
+    //! @return     true on success
+    //--------------------------------------------------------------------------
+    static bool parseTime(const QStringRef& str, uint32_t& ms);
+
 private:
     /// stores disc information
     Disc  mDiscData{"", "", 0, -1, {}};
 
     /// stores an empty track
-    Track mEmptyTrack{-1, TrackType::DATA, "", "", "", 0, 0, 0, 0, 0};
+    Track mEmptyTrack{-1, TrackType::DATA, "", "", "", 0, 0, 0, 0, 0, 0};
 
     /// validness flag
     bool mValid{false};
+
+    /// canonical path of the cue sheet
+    QString mCuePath;
+
+    /// cue sheet file name
+    QString mCueFile;
+
+    /// folder listed last by findAudioFile()
+    mutable QString mListedDir;
+
+    /// files in that folder
+    mutable QFileInfoList mDirList;
 };
@@ -0,0 +1,234 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include "cusbhotplug.h"
+#include <QtDebug>
+
+//--------------------------------------------------------------------------
+//! @brief      Constructs a new instance.
+//!
+//! @param      parent  The parent
+//--------------------------------------------------------------------------
+CUsbHotplug::CUsbHotplug(QObject* parent)
+    : QThread(parent), mpCtx(nullptr), mHandle(0), mbRegistered(false), mbStop(false)
+{
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Destroys the object.
+//--------------------------------------------------------------------------
+CUsbHotplug::~CUsbHotplug()
+{
+    stopWatching();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      register hotplug callback and start event thread
+//!
+//! @return     0 -> ok; -1 -> hotplug not supported on this platform
+//--------------------------------------------------------------------------
+int CUsbHotplug::startWatching()
+{
+    if (mbRegistered)
+    {
+        return 0;
+    }
+
+    if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG))
+    {
+        qInfo() << "USB hotplug not supported, NetMD devices must be loaded manually.";
+        return -1;
+    }
+
+    if (libusb_init(&mpCtx) != LIBUSB_SUCCESS)
+    {
+        qWarning() << "Can't init libusb context for hotplug!";
+        mpCtx = nullptr;
+        return -1;
+    }
+
+    // device filtering is done in the callback since
+    // a registration can only match one vendor / product id
+    int ret = libusb_hotplug_register_callback(mpCtx,
+                                               static_cast<libusb_hotplug_event>(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT),
+                                               static_cast<libusb_hotplug_flag>(0),
+                                               LIBUSB_HOTPLUG_MATCH_ANY,
+                                               LIBUSB_HOTPLUG_MATCH_ANY,
+                                               LIBUSB_HOTPLUG_MATCH_ANY,
+                                               &CUsbHotplug::hotplugCallback,
+                                               this,
+                                               &mHandle);
+
+    if (ret != LIBUSB_SUCCESS)
+    {
+        qWarning() << "Can't register USB hotplug callback:" << libusb_error_name(ret);
+        libusb_exit(mpCtx);
+        mpCtx = nullptr;
+        return -1;
+    }
+
+    mbRegistered = true;
+    mbStop       = false;
+    start();
+    return 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop event thread, deregister callback
+//--------------------------------------------------------------------------
+void CUsbHotplug::stopWatching()
+{
+    if (!mbRegistered)
+    {
+        return;
+    }
+
+    mbStop = true;
+
+    // event loop returns latest after its timeout
+    wait();
+    libusb_hotplug_deregister_callback(mpCtx, mHandle);
+
+    libusb_exit(mpCtx);
+    mpCtx        = nullptr;
+    mbRegistered = false;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      thread function
+//--------------------------------------------------------------------------
+void CUsbHotplug::run()
+{
+    while (!mbStop)
+    {
+        timeval tv = {0, 250000};
+        libusb_handle_events_timeout_completed(mpCtx, &tv, nullptr);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      libusb hotplug callback
+//!
+//! @param      ctx        The libusb context
+//! @param      dev        The device
+//! @param[in]  event      The event
+//! @param      user_data  pointer to CUsbHotplug instance
+//!
+//! @return     0 (keep callback registered)
+//--------------------------------------------------------------------------
+int LIBUSB_CALL CUsbHotplug::hotplugCallback(libusb_context*, libusb_device* dev,
+                                             libusb_hotplug_event event, void* user_data)
+{
+    CUsbHotplug* pThis = static_cast<CUsbHotplug*>(user_data);
+    libusb_device_descriptor desc;
+
+    if ((libusb_get_device_descriptor(dev, &desc) != LIBUSB_SUCCESS) || !netMdDevice(desc.idVendor, desc.idProduct))
+    {
+        return 0;
+    }
+
+    if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED)
+    {
+        qInfo("USB device %04x:%04x arrived", desc.idVendor, desc.idProduct);
+        emit pThis->deviceArrived();
+    }
+    else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT)
+    {
+        qInfo("USB device %04x:%04x left", desc.idVendor, desc.idProduct);
+        emit pThis->deviceLeft();
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      is device one of the known NetMD devices
+//!
+//! @param[in]  vid   The vendor id
+//! @param[in]  pid   The product id
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CUsbHotplug::netMdDevice(uint16_t vid, uint16_t pid)
+{
+    struct SUsbId
+    {
+        uint16_t mVid;  //!< vendor id
+        uint16_t mPid;  //!< product id
+    };
+
+    // supported devices as listed in netmd++.h
+    static constexpr SUsbId NETMD_DEVICES[] = {
+        {0x054c, 0x0034}, // Sony PCLK-XX
+        {0x054c, 0x0036}, // Sony NetMD Walkman
+        {0x054c, 0x006f}, // Sony NW-E7
+        {0x054c, 0x0075}, // Sony MZ-N1
+        {0x054c, 0x007c}, // Sony NetMD Walkman
+        {0x054c, 0x0080}, // Sony LAM-1
+        {0x054c, 0x0081}, // Sony MDS-JE780 / JB980
+        {0x054c, 0x0084}, // Sony MZ-N505
+        {0x054c, 0x0085}, // Sony MZ-S1
+        {0x054c, 0x0086}, // Sony MZ-N707
+        {0x054c, 0x008e}, // Sony CMT-C7NT
+        {0x054c, 0x0097}, // Sony PCGA-MDN1
+        {0x054c, 0x00ad}, // Sony CMT-L7HD
+        {0x054c, 0x00c6}, // Sony MZ-N10
+        {0x054c, 0x00c7}, // Sony MZ-N910
+        {0x054c, 0x00c8}, // Sony MZ-N710 / NE810 / NF810
+        {0x054c, 0x00c9}, // Sony MZ-N510 / NF610
+        {0x054c, 0x00ca}, // Sony MZ-NE410 / DN430 / NF520
+        {0x054c, 0x00e7}, // Sony CMT-M333NT / M373NT
+        {0x054c, 0x00eb}, // Sony MZ-NE810 / NE910
+        {0x054c, 0x0101}, // Sony LAM
+        {0x054c, 0x0113}, // Aiwa AM-NX1
+        {0x054c, 0x0119}, // Sony CMT-SE9
+        {0x054c, 0x011a}, // Sony CMT-SE7
+        {0x054c, 0x013f}, // Sony MDS-S500
+        {0x054c, 0x0148}, // Sony MDS-A1
+        {0x054c, 0x014c}, // Aiwa AM-NX9
+        {0x054c, 0x017e}, // Sony MZ-NH1
+        {0x054c, 0x0180}, // Sony MZ-NH3D
+        {0x054c, 0x0182}, // Sony MZ-NH900
+        {0x054c, 0x0184}, // Sony MZ-NH700 / NH800
+        {0x054c, 0x0186}, // Sony MZ-NH600
+        {0x054c, 0x0187}, // Sony MZ-NH600D
+        {0x054c, 0x0188}, // Sony MZ-N920
+        {0x054c, 0x018a}, // Sony LAM-3
+        {0x054c, 0x01e9}, // Sony MZ-DH10P
+        {0x054c, 0x0219}, // Sony MZ-RH10
+        {0x054c, 0x021b}, // Sony MZ-RH910
+        {0x054c, 0x021d}, // Sony CMT-AH10
+        {0x054c, 0x022c}, // Sony CMT-AH10
+        {0x054c, 0x023c}, // Sony DS-HMD1
+        {0x054c, 0x0286}, // Sony MZ-RH1
+        {0x04dd, 0x7202}, // Sharp IM-MT880H / MT899H
+        {0x04dd, 0x9013}, // Sharp IM-DR400 / DR410
+        {0x04dd, 0x9014}, // Sharp IM-DR80 / DR420 / DR580
+        {0x04da, 0x23b3}, // Panasonic SJ-MR250
+        {0x04da, 0x23b6}, // Panasonic SJ-MR270
+        {0x0b28, 0x1004}, // Kenwood MDX-J9
+    };
+
+    for (const auto& id : NETMD_DEVICES)
+    {
+        if ((id.mVid == vid) && (id.mPid == pid))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
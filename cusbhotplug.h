@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#pragma once
+#include <QThread>
+#include <atomic>
+#include <libusb-1.0/libusb.h>
+
+//------------------------------------------------------------------------------
+//! @brief      Watches the USB bus for NetMD recorders (libusb hotplug).
+//!             Events are handled in an own thread, signals are emitted
+//!             from there (use queued connections).
+//------------------------------------------------------------------------------
+class CUsbHotplug : public QThread
+{
+    Q_OBJECT
+
+public:
+    //--------------------------------------------------------------------------
+    //! @brief      Constructs a new instance.
+    //!
+    //! @param      parent  The parent
+    //--------------------------------------------------------------------------
+    explicit CUsbHotplug(QObject* parent = nullptr);
+
+    //--------------------------------------------------------------------------
+    //! @brief      Destroys the object.
+    //--------------------------------------------------------------------------
+    virtual ~CUsbHotplug();
+
+    //--------------------------------------------------------------------------
+    //! @brief      register hotplug callback and start event thread
+    //!
+    //! @return     0 -> ok; -1 -> hotplug not supported on this platform
+    //--------------------------------------------------------------------------
+    int startWatching();
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop event thread, deregister callback
+    //--------------------------------------------------------------------------
+    void stopWatching();
+
+    //--------------------------------------------------------------------------
+    //! @brief      thread function
+    //--------------------------------------------------------------------------
+    void run() override;
+
+signals:
+    //--------------------------------------------------------------------------
+    //! @brief      a possible NetMD device was plugged in
+    //--------------------------------------------------------------------------
+    void deviceArrived();
+
+    //--------------------------------------------------------------------------
+    //! @brief      a possible NetMD device was removed
+    //--------------------------------------------------------------------------
+    void deviceLeft();
+
+protected:
+    //--------------------------------------------------------------------------
+    //! @brief      libusb hotplug callback
+    //!
+    //! @param      ctx        The libusb context
+    //! @param      dev        The device
+    //! @param[in]  event      The event
+    //! @param      user_data  pointer to CUsbHotplug instance
+    //!
+    //! @return     0 (keep callback registered)
+    //--------------------------------------------------------------------------
+    static int LIBUSB_CALL hotplugCallback(libusb_context* ctx, libusb_device* dev,
+                                           libusb_hotplug_event event, void* user_data);
+
+    //--------------------------------------------------------------------------
+    //! @brief      is device one of the known NetMD devices
+    //!
+    //! @param[in]  vid   The vendor id
+    //! @param[in]  pid   The product id
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    static bool netMdDevice(uint16_t vid, uint16_t pid);
+
+private:
+    /// libusb context
+    libusb_context* mpCtx;
+
+    /// callback handle
+    libusb_hotplug_callback_handle mHandle;
+
+    /// callback registered
+    bool mbRegistered;
+
+    /// stop event thread
+    std::atomic<bool> mbStop;
+};
@@ -25,23 +25,23 @@
 #include <cmath>
 
 CXEnc::CXEnc(QObject *parent)
-    : CCliProcess(parent), mCurrCmd(XEncCmd::NONE), mLength(0), mbAltEnc(false), mProgressIt(0)
+    : CCliProcess(parent), mCurrCmd(XEncCmd::NONE), mLength(0), mbAltEnc(false), mbOk(false), mProgressIt(0)
 {
     connect(this, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &CXEnc::finishCopy);
     mProgUpd.setInterval(1100);
     mProgUpd.setSingleShot(false);
-    connect(&mProgUpd, &QTimer::timeout, this, &CXEnc::extractPercent);
+    connect(&mProgUpd, &QTimer::timeout, this, &CXEnc::altEncProgress);
 }
 
 int CXEnc::start(XEncCmd cmd, const QString& tmpFileName, double trackLength, const QString &at3tool)
 {
     QStringList params;
-    mLog.clear();
     mCurrCmd       = cmd;
     mLength        = trackLength;
     mbAltEnc       = (!at3tool.isEmpty() && (mCurrCmd != XEncCmd::DAO_SP_ENCODE));
     mAtracFileName = tmpFileName + (mbAltEnc ? ".at3" : ".aea");
     mSrcFileName   = tmpFileName;
+    mbOk           = false;
 
     switch (cmd)
     {
@@ -111,6 +111,16 @@ int CXEnc::start(CXEnc::XEncCmd cmd, const c2n::TransferQueue &queue, double dis
     return start(cmd, queue.at(0).mFileName, discLength, at3tool);
 }
 
+//--------------------------------------------------------------------------
+//! @brief      did the last encoder run end without error
+//!
+//! @return     true if so
+//--------------------------------------------------------------------------
+bool CXEnc::succeeded() const
+{
+    return mbOk;
+}
+
 int CXEnc::atrac3WaveHeader(QFile& waveFile, XEncCmd cmd, size_t dataSz, int length)
 {
     int ret = -1;
@@ -357,31 +367,38 @@ int CXEnc::splitAtrac1()
 }
 
 //--------------------------------------------------------------------------
-//! @brief      extract percentage from log file
+//! @brief      parse one encoder output line
+//!
+//! @param[in]  line  The output line
 //--------------------------------------------------------------------------
-void CXEnc::extractPercent()
+void CXEnc::parseLine(const QString& line)
 {
-    if (mbAltEnc)
+    // alternate encoder progress is faked through timer
+    if (!mbAltEnc)
     {
-        mLog += QString::fromUtf8(readAllStandardOutput());
-
-        // show some progress even if we don't know it
-        emit progress(mProgressIt);
-        mProgressIt += 10;
-        if (mProgressIt > 90)
-        {
-            mProgressIt = 10;
-        }
+        CCliProcess::parseLine(line);
     }
-    else
+}
+
+//--------------------------------------------------------------------------
+//! @brief      fake progress for alternate encoder (no progress output)
+//--------------------------------------------------------------------------
+void CXEnc::altEncProgress()
+{
+    // show some progress even if we don't know it
+    emit progress(mProgressIt);
+    mProgressIt += 10;
+    if (mProgressIt > 90)
     {
-        CCliProcess::extractPercent();
+        mProgressIt = 10;
     }
 }
 
 void CXEnc::finishCopy(int exitCode, ExitStatus exitStatus)
 {
-    if ((exitCode == 0) && (exitStatus == ExitStatus::NormalExit))
+    mbOk = (exitCode == 0) && (exitStatus == ExitStatus::NormalExit);
+
+    if (mbOk)
     {
         switch(mCurrCmd)
         {
@@ -475,9 +492,13 @@ void CXEnc::finishCopy(int exitCode, ExitStatus exitStatus)
         mProgUpd.stop();
     }
 
-    if (!mLog.isEmpty())
+    flushOutput();
+
+    QString log = logTail();
+
+    if (!log.isEmpty())
     {
-        qDebug().noquote() << Qt::endl << static_cast<const char*>(mLog.toUtf8());
+        qDebug().noquote() << Qt::endl << static_cast<const char*>(log.toUtf8());
     }
 
     emit fileDone(false);
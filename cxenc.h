@@ -100,6 +100,13 @@ public:
     //--------------------------------------------------------------------------
     int start(XEncCmd cmd, const c2n::TransferQueue& queue, double discLength, const QString& at3tool = "");
 
+    //--------------------------------------------------------------------------
+    //! @brief      did the last encoder run end without error
+    //!
+    //! @return     true if so
+    //--------------------------------------------------------------------------
+    bool succeeded() const;
+
 protected:
     //--------------------------------------------------------------------------
     //! @brief      create atrac3 WAVE header
@@ -141,11 +148,18 @@ protected:
     //--------------------------------------------------------------------------
     int splitAtrac1();
 
+    //--------------------------------------------------------------------------
+    //! @brief      parse one encoder output line
+    //!
+    //! @param[in]  line  The output line
+    //--------------------------------------------------------------------------
+    void parseLine(const QString& line) override;
+
 protected slots:
     //--------------------------------------------------------------------------
-    //! @brief      extract percentage from log file
+    //! @brief      fake progress for alternate encoder (no progress output)
     //--------------------------------------------------------------------------
-    void extractPercent() override;
+    void altEncProgress();
 
 private slots:
     //--------------------------------------------------------------------------
@@ -183,6 +197,9 @@ protected:
     /// do we use the alternate encoder?
     bool mbAltEnc;
 
+    /// last encoder run was successful
+    bool mbOk;
+
     /// stores current progress step
     int mProgressIt;
 
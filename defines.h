@@ -54,6 +54,10 @@ struct SRipTrack
     WorkStep        mStep;
     bool            mIsCD;
     std::time_t     mUxTStamp;
+    bool            mOtf;       ///< encode on-the-fly (device) instead of host
+    QString         mKey;       ///< identifies the source (background preparation)
+    QString         mPcmKey;    ///< artifact cache key of ripped PCM
+    QByteArray      mPcmHash;   ///< content hash of ripped PCM
 };
 
 using TransferQueue = QVector<SRipTrack>;
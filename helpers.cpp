@@ -19,99 +19,16 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <cstdlib>
+#include <cdio/cdio.h>
 #include "defines.h"
+#include "audio.h"
 #include "mdtitle.h"
 #include "ctranslit.h"
 
 static QStringList s_TempNames;
 static uint32_t s_Seed = 0;
 
-static QMap<QString, QString> s_UmlautEnc = {
-    {"à", "a"},
-    {"À", "A"},
-    {"á", "a"},
-    {"Á", "A"},
-    {"â", "a"},
-    {"Â", "A"},
-    {"å", "a"},
-    {"Ã", "A"},
-    {"ä", "ae"},
-    {"Ä", "Ae"},
-
-    {"æ", "ae"},
-    {"Æ", "Ae"},
-
-    {"ç", "c"},
-    {"Ç", "C"},
-
-    {"ê", "e"},
-    {"Ê", "E"},
-    {"é", "e"},
-    {"É", "E"},
-    {"ë", "e"},
-    {"Ë", "E"},
-    {"è", "e"},
-    {"È", "E"},
-
-    {"ï", "i"},
-    {"Ï", "I"},
-    {"í", "i"},
-    {"Í", "I"},
-    {"î", "i"},
-    {"Î", "I"},
-    {"ì", "i"},
-    {"Ì", "I"},
-
-    {"ñ", "n"},
-    {"Ñ", "N"},
-
-    {"œ", "oe"},
-    {"Œ", "Oe"},
-
-    {"ö", "oe"},
-    {"Ö", "Oe"},
-    {"ô", "o"},
-    {"Ô", "O"},
-    {"ò", "o"},
-    {"Ò", "O"},
-    {"ó", "o"},
-    {"Ó", "O"},
-    {"õ", "o"},
-    {"Õ", "O"},
-    {"ø", "oe"},
-    {"Ø", "Oe"},
-
-    {"š", "s"},
-    {"Š", "S"},
-
-    {"ú", "u"},
-    {"Ú", "U"},
-    {"ù", "u"},
-    {"Ù", "U"},
-    {"ü", "ue"},
-    {"Ü", "Ue"},
-    {"û", "u"},
-    {"Û", "U"},
-
-    {"ý", "y"},
-    {"Ý", "Y"},
-    {"ÿ", "y"},
-    {"Ÿ", "Y"},
-
-    {"ž", "z"},
-    {"Ž", "Z"},
-
-    {"Ð", "D"},
-    {"ß", "ss"},
-
-    {"’", "'"},
-    {"‘", "'"},
-    {"…", "..."},
-    {"“", "\""},
-    {"”", "\""},
-};
-
-int putNum(uint32_t num, QFile &f, size_t sz)
+int putNum(uint32_t num, QIODevice &f, size_t sz)
 {
     unsigned int i;
     char c;
@@ -129,58 +46,44 @@ int putNum(uint32_t num, QFile &f, size_t sz)
 
 QString &deUmlaut(QString &s)
 {
-    for (const auto& k : s_UmlautEnc.keys())
-    {
-        s.replace(k, s_UmlautEnc.value(k));
-    }
+    s = CTranslit::instance().apply(s, CTranslit::LATIN | CTranslit::POLISH_CZECH | CTranslit::QUOTES);
     return s;
 }
 
-QByteArray utf8ToMd(const QString& from)
+//------------------------------------------------------------------------------
+//! @brief      Shift_JIS codec (looked up once)
+//!
+//! @return     codec; nullptr if not available
+//------------------------------------------------------------------------------
+static QTextCodec* mdCodec()
 {
-    QString tmpStr = from;
-    QByteArray baEncoded;
-
-    // cyrillic to latin1
-    CTranslit translit;
-    tmpStr = translit.CyrToLat(tmpStr, false);
+    static QTextCodec* pCodec = QTextCodec::codecForName("Shift_JIS");
+    return pCodec;
+}
 
-    // encode all accents / umlaut to safe tokens
-    deUmlaut(tmpStr);
+QByteArray utf8ToMd(const QString& from)
+{
+    // transliterate cyrillic, greek, accents, quotes, ... in one go
+    QString tmpStr = CTranslit::instance().apply(from);
 
     tmpStr = sanitizeHalfWidthTitle(tmpStr);
 
-    QTextCodec *pCodec = QTextCodec::codecForName("Shift_JIS");
-    QTextEncoder *pEnc = pCodec->makeEncoder();
-    if (pEnc)
+    if (QTextCodec *pCodec = mdCodec())
     {
-        baEncoded = pEnc->fromUnicode(tmpStr);
-        delete pEnc;
-    }
-    else
-    {
-        baEncoded = tmpStr.toLatin1();
+        return pCodec->fromUnicode(tmpStr);
     }
 
-    return baEncoded;
+    return tmpStr.toLatin1();
 }
 
 QString mdToUtf8(const QByteArray& ba)
 {
-    QString ret;
-    QTextCodec *pCodec = QTextCodec::codecForName("Shift_JIS");
-    QTextDecoder *pDec = pCodec->makeDecoder();
-
-    if (pDec)
-    {
-        ret = pDec->toUnicode(ba);
-        delete pDec;
-    }
-    else
+    if (QTextCodec *pCodec = mdCodec())
     {
-        ret = QString::fromLatin1(ba);
+        return pCodec->toUnicode(ba);
     }
-    return ret;
+
+    return QString::fromLatin1(ba);
 }
 
 //------------------------------------------------------------------------------
@@ -199,6 +102,63 @@ QString titleFromFileName(const QString& fName)
     return ret.trimmed();
 }
 
+//------------------------------------------------------------------------------
+//! @brief      probe an audio file and create its source list entry
+//!             (tag and track data are reset for every file)
+//!
+//! @param[in]  url       absolute path of the audio file
+//! @param[in]  noArtist  don't put the artist into the track title
+//! @param[out] trackInfo source list entry
+//! @param[out] pAlbum    optional album tag
+//!
+//! @return     true if file contains audio
+//------------------------------------------------------------------------------
+bool probeAudioFile(const QString& url, bool noArtist, c2n::STrackInfo& trackInfo, QString* pAlbum)
+{
+    int length = 0;
+    audio::STag tag = {"", "", "", 0, -1};
+    c2n::STrackInfo info;
+
+    if (audio::checkAudioFile(url, info.mConversion, length, &tag) != 0)
+    {
+        return false;
+    }
+
+    info.mFileName = url;
+    info.mStartLba = 0;
+    info.mLbCount  = qRound((static_cast<double>(length) / 1000.0) * static_cast<double>(CDIO_CD_FRAMES_PER_SEC));
+
+    if (!tag.mTitle.isEmpty())
+    {
+        if (!tag.mArtist.isEmpty() && !noArtist)
+        {
+            info.mTitle = QString("%1 - %2").arg(tag.mArtist).arg(tag.mTitle);
+        }
+        else
+        {
+            info.mTitle = tag.mTitle;
+        }
+    }
+    else
+    {
+        info.mTitle = titleFromFileName(url);
+    }
+
+    if (tag.mYear > 0)
+    {
+        qInfo() << "Found year" << tag.mYear << "files ID tags!";
+        info.mTStamp = QDateTime(QDate(tag.mYear, 11, 11), QTime(11, 11, 11));
+    }
+
+    if (pAlbum != nullptr)
+    {
+        *pAlbum = tag.mAlbum;
+    }
+
+    trackInfo = info;
+    return true;
+}
+
 //--------------------------------------------------------------------------
 //! @brief      get uint from array
 //!
@@ -27,7 +27,7 @@
 /// \param sz size of bytes to write
 /// \return 0 -> ok; else -> -1
 ///
-int putNum(uint32_t num, QFile &f, size_t sz);
+int putNum(uint32_t num, QIODevice &f, size_t sz);
 
 ///
 /// \brief UTF-8 to MiniDisc text
@@ -59,6 +59,19 @@ QString& deUmlaut(QString& s);
 //------------------------------------------------------------------------------
 QString titleFromFileName(const QString& fName);
 
+//------------------------------------------------------------------------------
+//! @brief      probe an audio file and create its source list entry
+//!             (tag and track data are reset for every file)
+//!
+//! @param[in]  url       absolute path of the audio file
+//! @param[in]  noArtist  don't put the artist into the track title
+//! @param[out] trackInfo source list entry
+//! @param[out] pAlbum    optional album tag
+//!
+//! @return     true if file contains audio
+//------------------------------------------------------------------------------
+bool probeAudioFile(const QString& url, bool noArtist, c2n::STrackInfo& trackInfo, QString* pAlbum = nullptr);
+
 //--------------------------------------------------------------------------
 //! @brief      get uint from array
 //!
@@ -15,11 +15,15 @@
  * You should have received a copy of the GNU General Public License
  */
 #include "mainwindow.h"
+#include "cbatchrunner.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QTimer>
 #include <QFile>
 #include <QDir>
 #include <QDateTime>
+#include <QMutex>
 #include <QtGlobal>
 #ifdef Q_OS_MAC
     #include "cdrutil.h"
@@ -28,6 +32,7 @@
 
 const QString g_logFileName = QString("%1/cd2netmd_gui.log").arg(QDir::tempPath());
 static QFile  s_logFile(g_logFileName);
+static QMutex s_logMutex;
 c2n::LogLevel g_LogFilter = c2n::LogLevel::INFO;
 
 bool log(QtMsgType type)
@@ -59,6 +64,9 @@ void logger(QtMsgType type, const QMessageLogContext &context, const QString &ms
     if (!log(type))
         return;
 
+    // cue import and device threads log as well
+    QMutexLocker lock(&s_logMutex);
+
     QString t = QDateTime::currentDateTime().toLocalTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
     QString message;
     QTextStream mss(&message);
@@ -104,11 +112,33 @@ int main(int argc, char *argv[])
     // qputenv("QT_QPA_PLATFORM", "windows:darkmode=2");
 
     qRegisterMetaType<c2n::AudioTracks>("c2n::AudioTracks");
+    qRegisterMetaType<CNetMD::NetMDCmd>("CNetMD::NetMDCmd");
+    qRegisterMetaType<SDiscSnapshot>("SDiscSnapshot");
 #ifdef Q_OS_MAC
     qRegisterMetaType<CDRUtil::CDTextData>("CDRUtil::CDTextData");
 #endif // Q_OS_MAC
     s_logFile.open(QIODevice::Text | QIODevice::Truncate | QIODevice::WriteOnly);
     qInstallMessageHandler(logger);
+
+    if (CBatchRunner::requested(argc, argv))
+    {
+        // headless: no widgets, progress as JSON lines on stdout
+        QCoreApplication c(argc, argv);
+        QCoreApplication::setOrganizationName("Jo2003");
+        QCoreApplication::setOrganizationDomain("coujo.de");
+        QCoreApplication::setApplicationName(c2n::PROGRAM_NAME);
+        CBatchRunner runner;
+
+        if ((exitCode = runner.parse(c.arguments())) < 0)
+        {
+            QObject::connect(&runner, &CBatchRunner::done, &c, &QCoreApplication::exit, Qt::QueuedConnection);
+            QTimer::singleShot(0, &runner, &CBatchRunner::start);
+            exitCode = c.exec();
+        }
+        s_logFile.close();
+        return exitCode;
+    }
+
     QApplication a(argc, argv);
     QCoreApplication::setOrganizationName("Jo2003");
     QCoreApplication::setOrganizationDomain("coujo.de");
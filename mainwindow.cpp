@@ -18,12 +18,11 @@
 #include "ui_mainwindow.h"
 #include <QMessageBox>
 #include <QStringListModel>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QSettings>
 #include <QTimer>
 #include <QFileDialog>
 #include <QDesktopServices>
+#include <QMenu>
 #include "cueparser.h"
 #include "helpers.h"
 
@@ -31,11 +30,12 @@ using namespace c2n;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow), mpRipper(nullptr),
-      mpNetMD(nullptr), mpXEnc(nullptr), mpMDmodel(nullptr),
+      mpNetMD(nullptr), mpPipeline(nullptr), mpJobQueue(nullptr),
+      mpJobStatus(nullptr), mpMDmodel(nullptr),
       mpSettings(nullptr), mSpUpload(false), mTocManip(false),
       mPcm2Mono(false), mpSpUpload(nullptr), mpOtfEncode(nullptr),
       mpTocManip(nullptr), mpPcm2Mono(nullptr),
-      mTransferMode(TransferMode::TM_UNKNOWN)
+      mTransferMode(TransferMode::TM_UNKNOWN), mbOtfReq(false), mbAutoOtfReq(false)
 {
     ui->setupUi(this);
 
@@ -52,22 +52,28 @@ MainWindow::MainWindow(QWidget *parent)
         connect(mpRipper->cddb(), &CCDDB::entries, this, &MainWindow::catchCDDBEntries);
         connect(mpRipper->cddb(), &CCDDB::match, this, &MainWindow::catchCDDBEntry);
         connect(mpRipper, &CJackTheRipper::match, this, &MainWindow::catchCDDBEntry);
-        connect(mpRipper, &CJackTheRipper::finished, this, &MainWindow::ripFinished);
         connect(mpRipper, &CJackTheRipper::parseCue, this, &MainWindow::parseCueFile);
     }
 
     if ((mpNetMD = new CNetMD(this)) != nullptr)
     {
         connect(mpNetMD, &CNetMD::progress, ui->progressMDTransfer, &QProgressBar::setValue);
-        connect(mpNetMD, &CNetMD::jsonOut, this, &MainWindow::catchJson);
-        connect(mpNetMD, &CNetMD::finished, this, &MainWindow::transferFinished);
+        connect(mpNetMD, &CNetMD::discOut, this, &MainWindow::catchDiscInfo);
+        connect(mpNetMD, &CNetMD::tracksOut, this, &MainWindow::catchTracks);
+        connect(mpNetMD, &CNetMD::deviceArrived, this, &MainWindow::mdDeviceArrived);
+        connect(mpNetMD, &CNetMD::deviceLeft, this, &MainWindow::mdDeviceLeft);
+        connect(mpNetMD, &CNetMD::cmdDone, this, &MainWindow::mdCmdDone);
+        mpNetMD->watchDevices();
+
+        if (mpSettings != nullptr)
+        {
+            // settings dialog is modeless, take over UTOC scan option when closed
+            connect(mpSettings, &QDialog::finished, [this](int) {
+                mpNetMD->setUtocScan(mpSettings->utocScan());
+            });
+        }
     }
 
-    if ((mpXEnc = new CXEnc(this)) != nullptr)
-    {
-        connect(mpXEnc, &CXEnc::progress, ui->progressExtEnc, &QProgressBar::setValue);
-        connect(mpXEnc, &CXEnc::fileDone, this, &MainWindow::encodeFinished);
-    }
 
     connect(ui->treeView, &CMDTreeView::addGroup, this, &MainWindow::addMDGroup);
     connect(ui->treeView, &CMDTreeView::delGroup, this, &MainWindow::delMDGroup);
@@ -89,6 +95,119 @@ MainWindow::MainWindow(QWidget *parent)
     ui->statusbar->addPermanentWidget(mpOtfEncode);
     ui->statusbar->addPermanentWidget(mpCDDevice);
     ui->statusbar->addPermanentWidget(mpMDDevice);
+
+    if ((mpPipeline = new CPipeline(mpRipper, mpNetMD, nullptr, &mCache, &mPlacement, this)) != nullptr)
+    {
+        connect(mpPipeline, &CPipeline::stageStarted, [this](CPipeline::Stage stage, int) {
+            pipelineStage(stage, true);
+        });
+
+        connect(mpPipeline, &CPipeline::stageDone, [this](CPipeline::Stage stage, int) {
+            pipelineStage(stage, false);
+        });
+
+        // ripper and device progress is connected directly
+        connect(mpPipeline, &CPipeline::progress, [this](CPipeline::Stage stage, int percent) {
+            if (stage == CPipeline::Stage::ENCODE)
+            {
+                ui->progressExtEnc->setValue(percent);
+            }
+        });
+
+        connect(mpPipeline, &CPipeline::tocEditStarted, [this]() {
+            ui->progressMDTransfer->setValue(0);
+            countLabel(ui->labMDTransfer, CPipeline::Stage::TRANSFER, tr("TOC edit"));
+        });
+
+        connect(mpPipeline, &CPipeline::trackCommitted, [this](int idx) {
+            const c2n::SRipTrack& j = mpPipeline->queue().at(idx);
+            addMDTrack(mpMDmodel->discConf()->mTrkCount, j.mTitle, j.mLength);
+        });
+
+        connect(mpPipeline, &CPipeline::finished, this, &MainWindow::transferDone);
+        connect(mpPipeline, &CPipeline::failed, this, &MainWindow::transferFailed);
+    }
+
+    if ((mpJobQueue = new CJobQueue(mpNetMD, nullptr, &mCache, &mPlacement, CJobQueue::defaultStore(), this)) != nullptr)
+    {
+        mpJobStatus = new StatusWidget(this, ":buttons/transfer", tr("Jobs: -"), tr("Job queue (right click for details)"));
+        mpJobStatus->setContextMenuPolicy(Qt::CustomContextMenu);
+        ui->statusbar->addPermanentWidget(mpJobStatus);
+
+        connect(mpJobStatus, &StatusWidget::customContextMenuRequested, this, &MainWindow::jobQueueMenu);
+        connect(mpJobQueue, &CJobQueue::changed, this, &MainWindow::jobQueueChanged);
+
+        // other jobs go on while the operator swaps discs
+        connect(mpJobQueue, &CJobQueue::mdRequest, [this](QString target) {
+            QTimer::singleShot(100, this, [this, target]() {
+                if (QMessageBox::information(this, tr("Job Queue"), tr("Please insert writeable MD '%1' and press OK.").arg(target),
+                                             QMessageBox::Ok | QMessageBox::Cancel) == QMessageBox::Ok)
+                {
+                    mpJobQueue->mdReady();
+                }
+                else
+                {
+                    mpJobQueue->setRunning(false);
+                }
+            });
+        });
+
+        connect(mpJobQueue, &CJobQueue::cdRequest, [this](int id, QString title) {
+            QTimer::singleShot(100, this, [this, id, title]() {
+                if (QMessageBox::information(this, tr("Job Queue"), tr("Job %1: please insert CD '%2' and press OK.").arg(id).arg(title),
+                                             QMessageBox::Ok | QMessageBox::Cancel) == QMessageBox::Ok)
+                {
+                    mpJobQueue->cdReady();
+                }
+                else
+                {
+                    mpJobQueue->setRunning(false);
+                }
+            });
+        });
+
+        // progress bars belong to a direct transfer
+        connect(mpJobQueue, &CJobQueue::progress, [this](int, CPipeline::Stage stage, int percent) {
+            if (!mpPipeline->busy())
+            {
+                switch (stage)
+                {
+                case CPipeline::Stage::RIP:
+                    ui->progressRip->setValue(percent);
+                    break;
+                case CPipeline::Stage::ENCODE:
+                    ui->progressExtEnc->setValue(percent);
+                    break;
+                case CPipeline::Stage::TRANSFER:
+                    ui->progressMDTransfer->setValue(percent);
+                    break;
+                }
+            }
+        });
+
+        connect(mpJobQueue, &CJobQueue::jobDone, [this](int id, int ret, int tracks) {
+            if (ret < 0)
+            {
+                delayedPopUp(ePopUp::WARNING, tr("Job Queue"), tr("Job %1 failed (%2), the queue is paused. "
+                                                                  "Check the MD and restart the queue!").arg(id).arg(ret));
+            }
+            else
+            {
+                statusBar()->showMessage(tr("Job %1: %2 track(s) transferred.").arg(id).arg(tracks), 10000);
+            }
+        });
+
+        connect(mpJobQueue, &CJobQueue::idle, [this]() {
+            delayedPopUp(ePopUp::INFORMATION, tr("Job Queue"), tr("All queued jobs are done!"));
+        });
+
+        jobQueueChanged();
+    }
+
+    mStagedEdits.clear();
+    mEditTimer.setSingleShot(true);
+    mEditTimer.setInterval(1000);
+    connect(&mEditTimer, &QTimer::timeout, this, &MainWindow::commitEdits);
 }
 
 MainWindow::~MainWindow()
@@ -98,6 +217,21 @@ MainWindow::~MainWindow()
 
 void MainWindow::closeEvent(QCloseEvent *e)
 {
+    if (mpJobQueue->holds(CJobQueue::Resource::RECORDER)
+        && (QMessageBox::question(this, tr("Question"), tr("A queued job is writing to the MD. Do you really want to quit?")) != QMessageBox::Yes))
+    {
+        e->ignore();
+        return;
+    }
+
+    stopSpeculation();
+
+    if ((mStagedEdits.count() > 0) && !mpNetMD->busy())
+    {
+        commitEdits();
+        mpNetMD->wait();
+    }
+
     QSettings set;
     set.setValue("mainwindow", geometry());
     QMainWindow::closeEvent(e);
@@ -174,6 +308,10 @@ void MainWindow::revertCDEntries()
 //--------------------------------------------------------------------------
 void MainWindow::catchCDDBEntry(c2n::AudioTracks tracks)
 {
+    // source changed -> background work is useless
+    stopSpeculation();
+    mProbeQueue.clear();
+
     // remove all data tracks from model
     for (auto it = tracks.begin(); it != tracks.end();)
     {
@@ -207,26 +345,31 @@ void MainWindow::catchCDDBEntry(c2n::AudioTracks tracks)
 
     CCDItemModel *pModel = ui->tableViewCD->myModel();
 
-    if (pModel != nullptr)
+    // same source (e.g. CDDB match) -> only titles change
+    if ((pModel == nullptr) || !pModel->updateTitles(tracks))
     {
-        delete pModel;
-    }
+        if (pModel != nullptr)
+        {
+            delete pModel;
+        }
 
-    pModel = new CCDItemModel(tracks, this);
+        pModel = new CCDItemModel(tracks, this);
 
-    ui->tableViewCD->setModel(pModel);
-    int width = ui->tableViewCD->width();
+        ui->tableViewCD->setModel(pModel);
+        int width = ui->tableViewCD->width();
 
-    ui->tableViewCD->setColumnWidth(0, (width / 100) * 80);
-    ui->tableViewCD->setColumnWidth(1, (width / 100) * 18);
+        ui->tableViewCD->setColumnWidth(0, (width / 100) * 80);
+        ui->tableViewCD->setColumnWidth(1, (width / 100) * 18);
+    }
 
     mpCDDevice->setText(mpRipper->deviceInfo().isEmpty() ? tr("Please re-load CD") : mpRipper->deviceInfo());
     enableDialogItems(true);
+    startSpeculation();
 }
 
-void MainWindow::catchJson(QString j)
+void MainWindow::catchDiscInfo(SDiscSnapshot disc)
 {
-    recreateTreeView(j);
+    recreateTreeView(disc);
     bool otf = !!mpMDmodel->discConf()->mOTFEnc;
 
     mpSettings->enaDisaOtf(mpSettings->onthefly(true), otf);
@@ -266,6 +409,7 @@ void MainWindow::catchJson(QString j)
     int idx = ui->cbxTranferMode->currentIndex();
     idx = (idx < 0) ? 0 : idx;
 
+    ui->cbxTranferMode->blockSignals(true);
     ui->cbxTranferMode->clear();
 
     for (int m = TransferMode::TM_TAO_START; m < TransferMode::TM_DAO_END; m++)
@@ -279,339 +423,221 @@ void MainWindow::catchJson(QString j)
     }
 
     ui->cbxTranferMode->setCurrentIndex(idx);
+    ui->cbxTranferMode->blockSignals(false);
+    on_cbxTranferMode_currentIndexChanged(ui->cbxTranferMode->currentIndex());
 
     enableDialogItems(true);
 }
 
+void MainWindow::catchTracks(SDiscSnapshot tracks)
+{
+    if (mpMDmodel != nullptr)
+    {
+        mpMDmodel->updateTracks(tracks);
+    }
+}
+
+void MainWindow::mdDetailsNeeded(int first, int last)
+{
+    CNetMD::NetMDStartup startUp(CNetMD::NetMDCmd::TRACK_DETAILS);
+    startUp.miFirst = first;
+    startUp.miLast  = last;
+    mpNetMD->start(startUp);
+}
+
 void MainWindow::on_pushInitCD_clicked()
 {
+    stopSpeculation();
     enableDialogItems(false);
     mpRipper->init(mpSettings->cddb());
 }
 
 void MainWindow::on_pushLoadMD_clicked()
 {
+    commitEdits();
     enableDialogItems(false);
     mpNetMD->start({CNetMD::NetMDCmd::DISCINFO});
 }
 
+void MainWindow::mdDeviceArrived()
+{
+    // give the device some time to settle
+    QTimer::singleShot(1500, this, [this]() {
+        if (ui->pushLoadMD->isEnabled() && !mpNetMD->busy())
+        {
+            on_pushLoadMD_clicked();
+        }
+    });
+}
+
+void MainWindow::mdDeviceLeft()
+{
+    if (ui->pushLoadMD->isEnabled() && !mpNetMD->busy())
+    {
+        recreateTreeView(SDiscSnapshot::noDisc());
+    }
+}
+
+void MainWindow::mdCmdDone(CNetMD::NetMDCmd cmd, int ret)
+{
+    // transfer results are handled by the pipeline,
+    // missing track details just stay missing
+    if ((CNetMD::priority(cmd) == CNetMD::Prio::HIGH) && (cmd != CNetMD::NetMDCmd::TRACK_DETAILS) && (ret < 0))
+    {
+        delayedPopUp(ePopUp::WARNING, tr("MD Edit Error!"), tr("The MD edit failed and might not be shown correctly. Please re-load the MD!"));
+    }
+}
+
 void MainWindow::mdTitling(CMDTreeModel::ItemRole role, QString title, int no)
 {
     qDebug("Role: %d, Title: %s, Number: %d", static_cast<int>(role), static_cast<const char*>(title.toUtf8()), no);
+
+    // edits are collected and sent when the user pauses
     switch(role)
     {
     case CMDTreeModel::ItemRole::DISC:
-        mpNetMD->start({CNetMD::NetMDCmd::RENAME_DISC, "", title});
+        mStagedEdits.mbDiscTitle = true;
+        mStagedEdits.mDiscTitle  = title;
         break;
     case CMDTreeModel::ItemRole::TRACK:
-        mpNetMD->start({CNetMD::NetMDCmd::RENAME_TRACK, title, "", "", static_cast<int16_t>(no)});
+        mStagedEdits.mTracks.insert(no - 1, title);
         break;
     case CMDTreeModel::ItemRole::GROUP:
-        mpNetMD->start({CNetMD::NetMDCmd::RENAME_GROUP, "", "", title, -1, -1, static_cast<int16_t>(no)});
+        mStagedEdits.mGroupNames.insert(no, title);
         break;
     default:
-        break;
+        return;
     }
+
+    mEditTimer.start();
 }
 
-void MainWindow::ripFinished()
+//--------------------------------------------------------------------------
+//! @brief      send staged MD edits to NetMD device
+//--------------------------------------------------------------------------
+void MainWindow::commitEdits()
 {
-    using XEncCmd = CXEnc::XEncCmd;
-    XEncCmd xencCmd = mTransferMode.xencCmd(mpSettings->onthefly());
-    bool    noEnc   = xencCmd == XEncCmd::NONE;
+    mEditTimer.stop();
 
-    qInfo() << "Transfer Mode:" << static_cast<const char*>(mTransferMode) << "noEnc:" << noEnc;
-
-    if (mTransferMode.isDao()) // DAO active
+    if (mStagedEdits.count() > 0)
     {
-        if (mWorkQueue.at(0).mStep == WorkStep::RIP)
-        {
-            if (xencCmd != XEncCmd::NONE)
-            {
-                // encoding needed
-                mWorkQueue[0].mStep = WorkStep::RIPPED;
-            }
-            else
-            {
-                mWorkQueue[0].mStep = WorkStep::ENCODED;
-            }
-        }
-
-        if (mWorkQueue.at(0).mStep == WorkStep::NONE)
-        {
-            mWorkQueue[0].mStep = WorkStep::RIP;
-            ui->progressRip->setValue(0);
-            mpRipper->extractTrack(-1, mWorkQueue.at(0).mFileName, mpSettings->paranoia());
-        }
-    }
-    else
-    {
-        for (auto& j : mWorkQueue)
-        {
-            if (j.mStep == WorkStep::RIP)
-            {
-                j.mStep = noEnc ? WorkStep::ENCODED : WorkStep::RIPPED;
-                break;
-            }
-        }
-
-        for (auto& j : mWorkQueue)
-        {
-            if (j.mStep == WorkStep::NONE)
-            {
-                j.mStep = WorkStep::RIP;
-                ui->progressRip->setValue(0);
-                mpRipper->extractTrack(j.mCDTrackNo, j.mFileName, mpSettings->paranoia());
-                break;
-            }
-        }
-    }
-
-    countLabel(ui->labelCDRip, WorkStep::NONE, tr("CD-RIP"));
-
-    // do we need encoding?
-    if (noEnc)
-    {
-        // no encoding
-        transferFinished(true, 0);
-    }
-    else
-    {
-        // encoding
-        encodeFinished(true);
+        mpNetMD->start(mStagedEdits, mpSettings->devReset());
+        mStagedEdits.clear();
     }
 }
 
-void MainWindow::encodeFinished(bool checkBusy)
+//--------------------------------------------------------------------------
+//! @brief      pipeline stage started / finished a track
+//!
+//! @param[in]  stage    The stage
+//! @param[in]  started  true if started
+//--------------------------------------------------------------------------
+void MainWindow::pipelineStage(CPipeline::Stage stage, bool started)
 {
-    if (!checkBusy || !mpXEnc->busy())
+    switch (stage)
     {
-        using XEncCmd = CXEnc::XEncCmd;
-        XEncCmd xencCmd = mTransferMode.xencCmd(mpSettings->onthefly());
-
-        if (mTransferMode.isDao())
+    case CPipeline::Stage::RIP:
+        if (started)
         {
-            if (mWorkQueue.at(0).mStep == WorkStep::ENCODE)
-            {
-                // atracdenc always misses 100% ;)
-                ui->progressExtEnc->setValue(100);
-
-                // mark all tracks as encoded
-                for (auto& j : mWorkQueue)
-                {
-                    j.mStep = WorkStep::ENCODED;
-                }
-                transferFinished(true, 0);
-                return;
-            }
-
-            if (mWorkQueue.at(0).mStep == WorkStep::RIPPED)
-            {
-                mWorkQueue[0].mStep = WorkStep::ENCODE;
-                ui->progressExtEnc->setValue(0);
-                mpXEnc->start(xencCmd, mWorkQueue,
-                              static_cast<double>(ui->tableViewCD->myModel()->audioLength())
-                              / static_cast<double>(CDIO_CD_FRAMES_PER_SEC),
-                              mpSettings->at3tool());
-            }
+            ui->progressRip->setValue(0);
         }
-        else
+        countLabel(ui->labelCDRip, stage, tr("CD-RIP"));
+        break;
+    case CPipeline::Stage::ENCODE:
+        if (started)
         {
-            for (auto& j : mWorkQueue)
-            {
-                if (j.mStep == WorkStep::ENCODE)
-                {
-                    j.mStep = WorkStep::ENCODED;
-
-                    // atracdenc always misses 100% ;)
-                    ui->progressExtEnc->setValue(100);
-                    break;
-                }
-            }
-
-            for (auto& j : mWorkQueue)
-            {
-                if (j.mStep == WorkStep::RIPPED)
-                {
-                    j.mStep = WorkStep::ENCODE;
-                    ui->progressExtEnc->setValue(0);
-                    mpXEnc->start(xencCmd, j.mFileName, j.mLength,
-                                  mpSettings->at3tool());
-                    break;
-                }
-            }
+            ui->progressExtEnc->setValue(0);
         }
-
-        countLabel(ui->labelExtEnc, WorkStep::RIPPED, tr("External-Encoder"));
-        transferFinished(true, 0);
+        countLabel(ui->labelExtEnc, stage, tr("External-Encoder"));
+        break;
+    case CPipeline::Stage::TRANSFER:
+        if (started)
+        {
+            ui->progressMDTransfer->setValue(0);
+        }
+        countLabel(ui->labMDTransfer, stage, tr("MD-Transfer"));
+        break;
     }
 }
 
 //--------------------------------------------------------------------------
-//! @brief      one transfer finished
+//! @brief      all tracks were transferred
 //!
-//! @param[in]  checkBusy  The check busy
-//! @param[in]  ret        if given return value from last transfer
+//! @param[in]  ret     return value of last device command
+//! @param[in]  tracks  number of transferred tracks
 //--------------------------------------------------------------------------
-void MainWindow::transferFinished(bool checkBusy, int ret)
+void MainWindow::transferDone(int ret, int tracks)
 {
-    qInfo() << "checkBusy:" << checkBusy << "ret:" << ret;
-    if ((!checkBusy || !mpNetMD->busy()) && !mWorkQueue.isEmpty())
+    qInfo() << "Transfer of" << tracks << "track(s) done, ret:" << ret;
+
+    if (mTransferMode.tocManip())
     {
-        QString labText = tr("MD-Transfer");
-        int dc = 0;
-        using NetMDCmd = CNetMD::NetMDCmd;
-        NetMDCmd netMdCmd  = mTransferMode.netMDCmd(mpSettings->onthefly());
+        ui->progressMDTransfer->setValue(100);
 
-        if (ret < 0)
+        // add to MD list
+        if (ret != CNetMD::TOCMANIP_DEV_RESET) // TOC Manipulation done, device reset done
         {
-            for (auto& t : mWorkQueue)
-            {
-                // mark all tracks as failed
-                t.mStep = WorkStep::FAILED;
-
-                if (QFile::exists(t.mFileName))
-                {
-                    QFile::remove(t.mFileName);
-                }
-            }
-
-            mpRipper->removeTemp();
-            enableDialogItems(true);
-            delayedPopUp(ePopUp::CRITICAL, tr("Transfer Error!"), tr("Error while track transfer. Sorry!"));
-            return;
+            addMDTrack(1, tr("Re-insert MD for content!"), 60.00);
         }
+    }
 
-        if (mTransferMode.tocManip())
+    if (mTransferMode.isLP())
+    {
+        if (mpSettings->lpTrackGroup())
         {
-            if (mWorkQueue.at(0).mStep == WorkStep::DONE)
-            {
-                ui->progressMDTransfer->setValue(100);
-
-                for (auto& t : mWorkQueue)
-                {
-                    // mark all tracks as done
-                    t.mStep = WorkStep::DONE;
-                }
-
-                // add to MD list
-                if (ret != CNetMD::TOCMANIP_DEV_RESET) // TOC Manipulation done, device reset done
-                {
-                    addMDTrack(1, tr("Re-insert MD for content!"), 60.00);
-                }
-            }
-            else if (mWorkQueue.at(0).mStep == WorkStep::TRANSFER)
-            {
-                mWorkQueue[0].mStep = WorkStep::DONE;
-
-                CNetMD::TocData tocData;
-
-                // add disc name / -length to TOC data
-                tocData.append({static_cast<const char*>(utf8ToMd(ui->lineCDTitle->text())),
-                                blocksToMs(ui->tableViewCD->myModel()->audioLength()), mWorkQueue[0].mUxTStamp});
-
-                for (auto& t : mWorkQueue)
-                {
-                    // add track name / -length to TOC data
-                    tocData.append({static_cast<const char*>(utf8ToMd(t.mTitle)),
-                                    static_cast<uint32_t>(std::round(t.mLength * 1000.0)), t.mUxTStamp});
-                }
-
-                labText = tr("TOC edit");
-
-                // start TOC manipulation
-                mpNetMD->start(tocData, mpSettings->devReset(), mTransferMode.isMono());
-            }
-            else if (mWorkQueue.at(0).mStep == WorkStep::ENCODED)
-            {
-                auto& disc = mWorkQueue[0];
-                disc.mStep = WorkStep::TRANSFER;
-
-                ui->progressMDTransfer->setValue(0);
-                mpNetMD->start({netMdCmd, disc.mFileName, "DAO All in One!"});
-            }
+            addMDGroup(ui->lineCDTitle->text(),
+                       static_cast<int16_t>(mpMDmodel->discConf()->mTrkCount - tracks + 1),
+                       static_cast<int16_t>(mpMDmodel->discConf()->mTrkCount));
         }
-        else
+    }
+    else
+    {
+        if (mpSettings->spMdTitle())
         {
-            for (auto& j : mWorkQueue)
+            // title is already set on DAO SP mode through TOC edit
+            if (!mTransferMode.tocManip())
             {
-                if (j.mStep == WorkStep::TRANSFER)
-                {
-                    j.mStep = WorkStep::DONE;
-                    addMDTrack(mpMDmodel->discConf()->mTrkCount, j.mTitle, j.mLength);
-                    break;
-                }
+                // set disc title
+                mStagedEdits.mbDiscTitle = true;
+                mStagedEdits.mDiscTitle  = ui->lineCDTitle->text();
+                setMDTitle(ui->lineCDTitle->text());
             }
-
-            for (auto& j : mWorkQueue)
+            else if (ret != CNetMD::TOCMANIP_DEV_RESET)
             {
-                if (j.mStep == WorkStep::ENCODED)
-                {
-                    j.mStep = WorkStep::TRANSFER;
-                    ui->progressMDTransfer->setValue(0);
-                    mpNetMD->start({netMdCmd, j.mFileName, j.mTitle});
-                    break;
-                }
+                setMDTitle("DAO TOC Edit");
             }
         }
+    }
 
-        for (auto& j : mWorkQueue)
-        {
-            if (j.mStep == WorkStep::DONE)
-            {
-                dc ++;
-            }
-        }
+    // group and disc title in one go
+    commitEdits();
 
-        countLabel(ui->labMDTransfer, WorkStep::ENCODED, labText);
+    enableDialogItems(true);
+    QString info = tr("All (selected) tracks were transferred to MiniDisc!");
+    if (mTransferMode.tocManip() && (ret != CNetMD::TOCMANIP_DEV_RESET))
+    {
+        info += QString("<br><b>%1</b> %2").arg(tr("TOC edit done!")).arg("Please re-insert the minidisc in your device as soon as possible!");
+    }
+    delayedPopUp(ePopUp::INFORMATION, tr("Success"), info);
+}
 
-        if (dc == mWorkQueue.size())
-        {
-            if (mTransferMode.isLP())
-            {
-                if (mpSettings->lpTrackGroup())
-                {
-                    addMDGroup(ui->lineCDTitle->text(),
-                               static_cast<int16_t>(mpMDmodel->discConf()->mTrkCount - mWorkQueue.size() + 1),
-                               static_cast<int16_t>(mpMDmodel->discConf()->mTrkCount));
-                }
-            }
-            else
-            {
-                if (mpSettings->spMdTitle())
-                {
-                    // title is already set on DAO SP mode through TOC edit
-                    if (!mTransferMode.tocManip())
-                    {
-                        // set disc title
-                        mpNetMD->start({CNetMD::NetMDCmd::RENAME_DISC, "", ui->lineCDTitle->text()});
-                        setMDTitle(ui->lineCDTitle->text());
-                    }
-                    else if (ret != CNetMD::TOCMANIP_DEV_RESET)
-                    {
-                        setMDTitle("DAO TOC Edit");
-                    }
-                }
-            }
+//--------------------------------------------------------------------------
+//! @brief      transfer failed
+//!
+//! @param[in]  ret   return value of failed device command
+//--------------------------------------------------------------------------
+void MainWindow::transferFailed(int ret)
+{
+    qInfo() << "Transfer failed, ret:" << ret;
+    enableDialogItems(true);
 
-            for (auto& j : mWorkQueue)
-            {
-                if (QFile::exists(j.mFileName))
-                {
-                    qInfo() << "Delete temp. file" << j.mFileName;
-                    QFile::remove(j.mFileName);
-                }
-            }
-            mWorkQueue.clear();
-            mpRipper->removeTemp();
-            enableDialogItems(true);
-            QString info = tr("All (selected) tracks were transferred to MiniDisc!");
-            if (mTransferMode.tocManip() && (ret != CNetMD::TOCMANIP_DEV_RESET))
-            {
-                info += QString("<br><b>%1</b> %2").arg(tr("TOC edit done!")).arg("Please re-insert the minidisc in your device as soon as possible!");
-            }
-            delayedPopUp(ePopUp::INFORMATION, tr("Success"), info);
-        }
+    if (ret == CPipeline::RIP_FAILED)
+    {
+        delayedPopUp(ePopUp::CRITICAL, tr("Rip Error!"), tr("A track couldn't be ripped / decoded. Sorry!"));
+    }
+    else
+    {
+        delayedPopUp(ePopUp::CRITICAL, tr("Transfer Error!"), tr("Error while track transfer. Sorry!"));
     }
 }
 
@@ -630,58 +656,38 @@ void MainWindow::addMDTrack(int number, const QString &title, double length)
     // get the used time (space) on disc
     time_t tUsed = qRound(length / static_cast<double>(mTransferMode.multi()));
 
-    nlohmann::json mdJson = mpMDmodel->exportJson();
-
-    nlohmann::json trk;
-    trk["no"]      = number;
-    trk["name"]    = t.toStdString();
-    trk["bitrate"] = mTransferMode.trackMode();
-    trk["time"]    = timeString.toStdString();
-    mdJson["tracks"].push_back(trk);
-
-    mdJson["trk_count"] = mpMDmodel->discConf()->mTrkCount + 1;
-    mdJson["t_used"]    = mpMDmodel->discConf()->mUsedTime + tUsed;
-    mdJson["t_free"]    = mpMDmodel->discConf()->mFreeTime - tUsed;
-
-    recreateTreeView(QString::fromStdString(mdJson.dump()));
+    mpMDmodel->insertTrack(number, t, mTransferMode.trackMode(), timeString, static_cast<int>(tUsed));
+    updateFreeTimeLabel();
 }
 
 void MainWindow::addMDGroup(const QString &title, int16_t first, int16_t last)
 {
     QString t = title;
     deUmlaut(t);
-    mpNetMD->start({CNetMD::NetMDCmd::ADD_GROUP, "", "", t, first, last});
-
-    nlohmann::json group;
-    group["name"]  = t.toStdString();
-    group["first"] = first;
-    group["last"]  = first == last ? -1 : last;
+    mStagedEdits.mNewGroups.append({t, first, last});
+    mEditTimer.start();
 
-    nlohmann::json mdJson = mpMDmodel->exportJson();
-    mdJson["groups"].push_back(group);
+    QModelIndex idx = mpMDmodel->insertGroup(t, first, last);
 
-    recreateTreeView(QString::fromStdString(mdJson.dump()));
+    if (idx.isValid())
+    {
+        ui->treeView->expand(idx);
+    }
+    else
+    {
+        // model was reset
+        ui->treeView->expandAll();
+    }
 }
 
 void MainWindow::delMDGroup(int16_t number)
 {
+    commitEdits();
     CNetMD::NetMDStartup startUp(CNetMD::NetMDCmd::DEL_GROUP);
     startUp.miGroup = number + 1;
     mpNetMD->start(startUp);
 
-    nlohmann::json mdJson = mpMDmodel->exportJson();
-
-    nlohmann::json::iterator it;
-
-    for (it = mdJson["groups"].begin(); it != mdJson["groups"].end(); it++)
-    {
-        if (it->at("no").get<int>() == number)
-        {
-            mdJson["groups"].erase(it);
-            break;
-        }
-    }
-    recreateTreeView(QString::fromStdString(mdJson.dump()));
+    mpMDmodel->removeGroup(number);
 }
 
 void MainWindow::delTrack(int16_t track)
@@ -689,6 +695,7 @@ void MainWindow::delTrack(int16_t track)
     if (QMessageBox::question(this, tr("Question"),
                               tr("Do you really want to delete MD track %1? This can't be undone!").arg(track + 1)) == QMessageBox::Yes)
     {
+        commitEdits();
         enableDialogItems(false);
         CNetMD::NetMDStartup startUp(CNetMD::NetMDCmd::DEL_TRACK);
         startUp.miFirst = track;
@@ -700,9 +707,7 @@ void MainWindow::setMDTitle(const QString &title)
 {
     QString t = title;
     deUmlaut(t);
-    nlohmann::json mdJson = mpMDmodel->exportJson();
-    mdJson["title"] = t.toStdString();
-    recreateTreeView(QString::fromStdString(mdJson.dump()));
+    mpMDmodel->setTitle(t);
 }
 
 void MainWindow::enableDialogItems(bool ena)
@@ -768,19 +773,33 @@ void MainWindow::enableDialogItems(bool ena)
     {
         ui->pushTransfer->setEnabled(ena);
     }
+
+    ui->pushQueue->setEnabled(ena && (ui->tableViewCD->model() != nullptr)
+                              && (ui->tableViewCD->model()->rowCount() > 0));
+
+    // queued jobs keep the drive / recorder they use
+    if (ena && (mpJobQueue != nullptr))
+    {
+        bool rec = mpJobQueue->holds(CJobQueue::Resource::RECORDER);
+        ui->pushInitCD->setEnabled(!mpJobQueue->holds(CJobQueue::Resource::DRIVE));
+        ui->pushLoadMD->setEnabled(!rec);
+        ui->treeView->setEnabled(!rec);
+    }
 }
 
-void MainWindow::recreateTreeView(const QString &json)
+void MainWindow::recreateTreeView(const SDiscSnapshot &disc)
 {
     mpMDmodel = static_cast<CMDTreeModel*>(ui->treeView->model());
     if (mpMDmodel != nullptr)
     {
         disconnect(mpMDmodel, &CMDTreeModel::editTitle, this, &MainWindow::mdTitling);
+        disconnect(mpMDmodel, &CMDTreeModel::detailsNeeded, this, &MainWindow::mdDetailsNeeded);
         delete mpMDmodel;
     }
 
-    mpMDmodel = new CMDTreeModel(json, this);
+    mpMDmodel = new CMDTreeModel(disc, this);
     connect(mpMDmodel, &CMDTreeModel::editTitle, this, &MainWindow::mdTitling);
+    connect(mpMDmodel, &CMDTreeModel::detailsNeeded, this, &MainWindow::mdDetailsNeeded);
 
     ui->treeView->setModel(mpMDmodel);
     ui->treeView->expandAll();
@@ -794,30 +813,81 @@ void MainWindow::recreateTreeView(const QString &json)
     mpMDDevice->setText(mpMDmodel->discConf()->mDevice.isEmpty() ? tr("Please re-load MD") : mpMDmodel->discConf()->mDevice);
 }
 
-void MainWindow::countLabel(QLabel *pLabel, MainWindow::WorkStep step, const QString &text)
+//--------------------------------------------------------------------------
+//! @brief      job queue content or state changed
+//--------------------------------------------------------------------------
+void MainWindow::jobQueueChanged()
 {
-    int count = 0;
-    for (auto& j : mWorkQueue)
+    int pending = mpJobQueue->pending();
+
+    if (mpJobQueue->jobs().isEmpty())
     {
-        if (static_cast<uint8_t>(j.mStep) > static_cast<uint8_t>(step))
-        {
-            count ++;
-        }
+        mpJobStatus->setText(tr("Jobs: -"));
+    }
+    else
+    {
+        mpJobStatus->setText(tr("Jobs: %1/%2%3").arg(pending).arg(mpJobQueue->jobs().size())
+                             .arg(mpJobQueue->running() ? "" : tr(" (paused)")));
     }
-    int all = mWorkQueue.size();
-
 
-    if (mTransferMode.isDao() && ((step == MainWindow::WorkStep::NONE) || (step == MainWindow::WorkStep::RIPPED)))
+    // don't interfere with a direct transfer
+    if (ui->pushSettings->isEnabled())
     {
-        all = 1;
+        enableDialogItems(true);
     }
-    else if (mTransferMode.tocManip() && (step == MainWindow::WorkStep::ENCODED))
+}
+
+//--------------------------------------------------------------------------
+//! @brief      show job queue context menu
+//!
+//! @param[in]  pos   position in status widget
+//--------------------------------------------------------------------------
+void MainWindow::jobQueueMenu(const QPoint& pos)
+{
+    QMenu menu(this);
+    QAction* pAct = menu.addAction(mpJobQueue->running() ? tr("&Pause Queue") : tr("&Start Queue"));
+    pAct->setEnabled(mpJobQueue->pending() > 0);
+    connect(pAct, &QAction::triggered, [this]() {
+        mpJobQueue->setRunning(!mpJobQueue->running());
+    });
+
+    menu.addSeparator();
+
+    for (const auto& j : mpJobQueue->jobs())
     {
-        all = 1;
+        QString txt = tr("Job %1: %2 -> %3 (%4)").arg(j.mId).arg(j.mTracks.at(0).mTitle)
+                .arg(j.mTarget).arg(CJobQueue::stateName(j.mState));
+
+        if ((j.mState == CJobQueue::State::FAILED) && (j.mResult == CJobQueue::RES_INTERRUPTED))
+        {
+            txt += tr(" - interrupted, check MD!");
+        }
+
+        if ((j.mState == CJobQueue::State::WAITING) || (j.mState == CJobQueue::State::PREPARING))
+        {
+            int id = j.mId;
+            connect(menu.addMenu(txt)->addAction(tr("&Remove Job")), &QAction::triggered, [this, id]() {
+                mpJobQueue->remove(id);
+            });
+        }
+        else
+        {
+            menu.addAction(txt)->setEnabled(false);
+        }
     }
 
+    menu.addSeparator();
+    pAct = menu.addAction(tr("Remove &Finished Jobs"));
+    pAct->setEnabled(mpJobQueue->pending() < mpJobQueue->jobs().size());
+    connect(pAct, &QAction::triggered, mpJobQueue, &CJobQueue::clearFinished);
+
+    menu.exec(mpJobStatus->mapToGlobal(pos));
+}
+
+void MainWindow::countLabel(QLabel *pLabel, CPipeline::Stage stage, const QString &text)
+{
     pLabel->clear();
-    pLabel->setText(tr("%1: %2/%3").arg(text).arg(count).arg(all));
+    pLabel->setText(tr("%1: %2/%3").arg(text).arg(mpPipeline->done(stage)).arg(mpPipeline->total(stage)));
 }
 
 void MainWindow::loadSettings()
@@ -836,12 +906,20 @@ void MainWindow::loadSettings()
     {
         ui->tableViewCD->setStyleSheet(styles::CD_TAB_STYLED);
     }
+
+    if (mpNetMD != nullptr)
+    {
+        mpNetMD->setUtocScan(mpSettings->utocScan());
+    }
 }
 
 void MainWindow::eraseDisc()
 {
     if (QMessageBox::question(this, tr("Question"), tr("Do you really want to erase the MD? This can't be undone!")) == QMessageBox::Yes)
     {
+        // staged edits are obsolete
+        mEditTimer.stop();
+        mStagedEdits.clear();
         enableDialogItems(false);
         mpNetMD->start({CNetMD::NetMDCmd::ERASE_DISC});
     }
@@ -874,10 +952,131 @@ void MainWindow::on_pushTransfer_clicked()
         revertCDEntries();
     }
 
+    commitEdits();
+
+    // must be read before dialog items get disabled
+    mbOtfReq     = mpSettings->onthefly();
+    mbAutoOtfReq = mpSettings->autoPlacement();
+
+    // the recorder belongs to the queue -> wait in line
+    if (mpJobQueue->pending() > 0)
+    {
+        queueJob();
+        return;
+    }
+
     enableDialogItems(false);
-    c2n::AudioTracks trks = ui->tableViewCD->myModel()->audioTracks();
+    startTransfer();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      Called when push queue clicked.
+//--------------------------------------------------------------------------
+void MainWindow::on_pushQueue_clicked()
+{
+    QSettings set;
+
+    if (mTransferMode.isDao() && !set.value("dont_show_dao_info", false).toBool())
+    {
+        CDaoConfDlg* pDaoConf = new CDaoConfDlg(this);
+
+        if (pDaoConf)
+        {
+            bool leave = pDaoConf->exec() != QDialog::Accepted;
+            delete pDaoConf;
+
+            if (leave)
+            {
+                return;
+            }
+        }
+    }
+
+    if (mTransferMode.isDao() && (mTracksBackup.listType() == c2n::AudioTracks::CD))
+    {
+        revertCDEntries();
+    }
+
+    commitEdits();
+
+    mbOtfReq     = mpSettings->onthefly();
+    mbAutoOtfReq = mpSettings->autoPlacement();
+
+    queueJob();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add selection as job to the job queue
+//--------------------------------------------------------------------------
+void MainWindow::queueJob()
+{
+    c2n::AudioTracks trks;
+    TransferQueue    queue = workQueue(trks);
+
+    if (queue.isEmpty())
+    {
+        return;
+    }
+
+    // job lanes do their own background work
+    stopSpeculation();
+
+    mpJobQueue->setDecoderCount(mpSettings->decoderCount());
+    mpJobQueue->setSizeCheck(mpSettings->sizeCheck());
+
+    int id = mpJobQueue->add(trks, queue, pipelineConfig(), mpSettings->lpTrackGroup(), mpSettings->spMdTitle());
+    statusBar()->showMessage(tr("Job %1 queued.").arg(id), 5000);
+    mpJobQueue->setRunning(true);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create work queue from selection and start transfer
+//--------------------------------------------------------------------------
+void MainWindow::startTransfer()
+{
+    c2n::AudioTracks trks;
+    TransferQueue    queue = workQueue(trks);
+    double selectionTime   = 0;
+
+    for (const auto& j : queue)
+    {
+        selectionTime += j.mLength;
+    }
+
+    // check selection with available time
+    selectionTime /= mTransferMode.multi();
+
+    if (mpSettings->sizeCheck() && (selectionTime > mpMDmodel->discConf()->mFreeTime))
+    {
+        // not enough space left on device, background work goes on
+        time_t need = selectionTime - mpMDmodel->discConf()->mFreeTime;
+        QString t = QString("%1:%2:%3").arg(need / 3600).arg((need % 3600) / 60, 2, 10, QChar('0')).arg(need % 60, 2, 10, QChar('0'));
+
+        enableDialogItems(true);
+        delayedPopUp(ePopUp::WARNING, tr("Error"), tr("No space left on MD to transfer your selected titles. You need %1 more.").arg(t), 100);
+    }
+    else if (!queue.isEmpty())
+    {
+        mpPipeline->start(trks, queue, pipelineConfig());
+    }
+    else
+    {
+        enableDialogItems(true);
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create work queue from selection
+//!
+//! @param[out] trks  source tracks (disc entry at index 0)
+//!
+//! @return     work queue
+//--------------------------------------------------------------------------
+MainWindow::TransferQueue MainWindow::workQueue(c2n::AudioTracks& trks)
+{
+    trks = ui->tableViewCD->myModel()->audioTracks();
     trks.prepend({ui->lineCDTitle->text(), "", "", 0, 0, ui->tableViewCD->myModel()->audioLength()});
-    mpRipper->setAudioTracks(trks);
+    mCache.setBudget(mpSettings->artifactCache() ? mpSettings->artifactCacheBudget() : 0);
     bool isCD = (trks.listType() == c2n::AudioTracks::CD);
 
     QModelIndexList selected = ui->tableViewCD->selectionModel()->selectedRows();
@@ -885,12 +1084,12 @@ void MainWindow::on_pushTransfer_clicked()
     // no selection or drag'n'drop mode means all!
     if (selected.isEmpty() || (trks.listType() == c2n::AudioTracks::FILES) || mTransferMode.isDao())
     {
+        ui->tableViewCD->myModel()->fetchAll();
         ui->tableViewCD->selectAll();
         selected = ui->tableViewCD->selectionModel()->selectedRows();
     }
 
-    double selectionTime = 0;
-    mWorkQueue.clear();
+    TransferQueue workQueue;
 
     // Multiple rows can be selected
     for(const auto& r : selected)
@@ -899,32 +1098,56 @@ void MainWindow::on_pushTransfer_clicked()
         QString trackTitle = r.data().toString();
         double  trackTime  = r.sibling(r.row(), 1).data(Qt::UserRole).toDouble();
         std::time_t tStamp = r.sibling(r.row(), 1).data(CCDItemModel::TSTAMP_ROLE).toDateTime().toTime_t();
-        selectionTime += trackTime;
-        mWorkQueue.append({trackNo,
-                           trackTitle,
-                           QDir::tempPath() + tempFileName("/cd2netmd.XXXXXX.tmp"),
-                           trackTime,
-                           WorkStep::NONE,
-                           isCD,
-                           tStamp});
+        workQueue.append({trackNo,
+                          trackTitle,
+                          QDir::tempPath() + tempFileName("/cd2netmd.XXXXXX.tmp"),
+                          trackTime,
+                          WorkStep::NONE,
+                          isCD,
+                          tStamp,
+                          mbOtfReq,
+                          trackKey(trks.at(r.row() + 1)),
+                          mTransferMode.isTao() ? CArtifactCache::pcmKey(trks, r.row() + 1) : QString(),
+                          QByteArray()});
     }
 
-    // check selection with available time
-    selectionTime /= mTransferMode.multi();
-
-    if (mpSettings->sizeCheck() && (selectionTime > mpMDmodel->discConf()->mFreeTime))
+    if (!workQueue.isEmpty() && mbAutoOtfReq && mTransferMode.isTao() && mTransferMode.isLP())
     {
-        // not enough space left on device
-        time_t need = selectionTime - mpMDmodel->discConf()->mFreeTime;
-        QString t = QString("%1:%2:%3").arg(need / 3600).arg((need % 3600) / 60, 2, 10, QChar('0')).arg(need % 60, 2, 10, QChar('0'));
-        mWorkQueue.clear();
-        enableDialogItems(true);
-        delayedPopUp(ePopUp::WARNING, tr("Error"), tr("No space left on MD to transfer your selected titles. You need %1 more.").arg(t), 100);
-    }
-    else if (!mWorkQueue.isEmpty())
-    {
-        ripFinished();
+        QVector<double> lengths;
+
+        for (const auto& j : workQueue)
+        {
+            lengths.append(j.mLength);
+        }
+
+        QVector<CPlacementPolicy::Route> routes = mPlacement.plan(mpMDmodel->discConf()->mDevice, mTransferMode, lengths);
+
+        for (int i = 0; i < workQueue.size(); i++)
+        {
+            workQueue[i].mOtf = (routes.at(i) == CPlacementPolicy::Route::DEVICE_OTF);
+            qInfo() << "Track" << workQueue.at(i).mTitle << (workQueue.at(i).mOtf ? "on-the-fly" : "host encoder");
+        }
     }
+
+    return workQueue;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      collect pipeline settings from UI and settings dialog
+//!
+//! @return     pipeline settings
+//--------------------------------------------------------------------------
+CPipeline::SConfig MainWindow::pipelineConfig()
+{
+    mpPipeline->setConcurrency(CPipeline::Stage::RIP, mpSettings->decoderCount());
+
+    return {mTransferMode,
+            *mpSettings->paranoia(),
+            mpSettings->at3tool(),
+            ui->lineCDTitle->text(),
+            ui->tableViewCD->myModel()->audioLength(),
+            mpMDmodel->discConf()->mDevice,
+            mpSettings->devReset()};
 }
 
 void MainWindow::on_pushAbout_clicked()
@@ -956,86 +1179,77 @@ void MainWindow::on_pushLoadImg_clicked()
 //--------------------------------------------------------------------------
 void MainWindow::catchDropped(QStringList sl)
 {
-    int length;
-    int wholeLength = 0;
-    audio::STag tag;
-    c2n::STrackInfo trackInfo;
-    c2n::AudioTracks tracks;
+    bool idle = mProbeQueue.isEmpty();
+    mProbeQueue += sl;
 
-    if (ui->tableViewCD->myModel() != nullptr)
+    // probe in batches so the list grows while the GUI stays responsive
+    if (idle)
     {
-        tracks      = ui->tableViewCD->myModel()->audioTracks();
-        wholeLength = ui->tableViewCD->myModel()->audioLength();
+        QTimer::singleShot(0, this, &MainWindow::probeDropped);
     }
+}
 
-    if (tracks.listType() != c2n::AudioTracks::FILES)
-    {
-        tracks.clear();
-        tracks.setListType(c2n::AudioTracks::FILES);
-        ui->lineCDTitle->clear();
-        wholeLength = 0;
-    }
+//--------------------------------------------------------------------------
+//! @brief      probe next batch of dropped files, add them to the list
+//--------------------------------------------------------------------------
+void MainWindow::probeDropped()
+{
+    int batchLength = 0;
+    c2n::STrackInfo trackInfo;
+    c2n::AudioTracks tracks;
+    CCDItemModel* pModel = ui->tableViewCD->myModel();
+
+    tracks.setListType(c2n::AudioTracks::FILES);
 
-    for (const auto& url : sl)
+    for (int i = 0; (i < PROBE_BATCH) && !mProbeQueue.isEmpty(); i++)
     {
-        if (audio::checkAudioFile(url, trackInfo.mConversion, length, &tag) == 0)
+        if (probeAudioFile(mProbeQueue.takeFirst(), mpSettings->noArtistInTitle(), trackInfo))
         {
-            QDateTime tStamp;
-            trackInfo.mFileName = url;
-            trackInfo.mStartLba = 0;
-            trackInfo.mTStamp   = QDateTime::currentDateTime();
-            trackInfo.mLbCount  = qRound((static_cast<double>(length) / 1000.0) * static_cast<double>(CDIO_CD_FRAMES_PER_SEC));
-            wholeLength        += trackInfo.mLbCount;
-
-            if (!tag.mTitle.isEmpty())
-            {
-                if (!tag.mArtist.isEmpty() && !mpSettings->noArtistInTitle())
-                {
-                    trackInfo.mTitle = QString("%1 - %2").arg(tag.mArtist).arg(tag.mTitle);
-                }
-                else
-                {
-                    trackInfo.mTitle = tag.mTitle;
-                }
-            }
-            else
-            {
-                trackInfo.mTitle = titleFromFileName(url);
-            }
-
-            if (tag.mYear > 0)
-            {
-                qInfo() << "Found year" << tag.mYear << "files ID tags!";
-                tStamp.setDate(QDate(tag.mYear, 11, 11));
-                tStamp.setTime(QTime(11, 11, 11));
-                trackInfo.mTStamp = tStamp;
-            }
-
+            batchLength += trackInfo.mLbCount;
             tracks.append(trackInfo);
         }
     }
 
-    if (wholeLength > 0)
+    if (batchLength > 0)
     {
-        // disc "title"
-        trackInfo.mFileName = "";
-        trackInfo.mStartLba = 0;
-        trackInfo.mLbCount  = wholeLength;
-        if (ui->lineCDTitle->text().isEmpty())
+        if ((pModel != nullptr) && (pModel->listType() == c2n::AudioTracks::FILES))
         {
-            trackInfo.mTitle = tr("(Maybe) Various Artists - Dropped Hits (%1)").arg(QDateTime::currentDateTime().toString());
+            // add to existing file list
+            stopSpeculation();
+            pModel->appendTracks(tracks);
+
+            if (!mTracksBackup.isEmpty())
+            {
+                mTracksBackup[0].mLbCount += batchLength;
+                mTracksBackup += tracks;
+            }
+
+            audioLength(pModel->audioLength());
         }
         else
         {
-            trackInfo.mTitle = ui->lineCDTitle->text();
+            // disc "title"
+            trackInfo.mFileName = "";
+            trackInfo.mStartLba = 0;
+            trackInfo.mLbCount  = batchLength;
+            trackInfo.mTitle    = tr("(Maybe) Various Artists - Dropped Hits (%1)").arg(QDateTime::currentDateTime().toString());
+            tracks.prepend(trackInfo);
+
+            // new source drops pending probes -> keep ours
+            QStringList pending = mProbeQueue;
+            mpRipper->setDeviceInfo("Drag'n'Drop");
+            catchCDDBEntry(tracks);
+            mProbeQueue = pending;
         }
-        tracks.prepend(trackInfo);
     }
 
-    if (!tracks.isEmpty())
+    if (!mProbeQueue.isEmpty())
     {
-        mpRipper->setDeviceInfo("Drag'n'Drop");
-        catchCDDBEntry(tracks);
+        QTimer::singleShot(0, this, &MainWindow::probeDropped);
+    }
+    else
+    {
+        startSpeculation();
     }
 }
 
@@ -1061,91 +1275,12 @@ void MainWindow::audioLength(long blocks)
 //--------------------------------------------------------------------------
 int MainWindow::parseCueFile(QString fileName)
 {
-    int ret = -1;
-    c2n::STrackInfo cueInfo;
-    c2n::AudioTracks tracks;
-    QFileInfo fi(fileName);
-    QDateTime tStamp;
-    tracks.setListType(c2n::AudioTracks::CUE_SHEET);
-
-
-    CueParser* pParser = new CueParser(fileName);
-    if (pParser)
-    {
-        if (pParser->isValid())
-        {
-            // all well ...
-            ret = 0;
-
-            // disc info
-            QString discArtist = pParser->discPerfromer();
-            if (!discArtist.isEmpty())
-            {
-                cueInfo.mTitle = discArtist + " - ";
-            }
-            cueInfo.mTitle += pParser->discTitle();
-
-            // in case no title is stored, use file name
-            if (cueInfo.mTitle.isEmpty())
-            {
-                cueInfo.mTitle = titleFromFileName(fileName);
-            }
-
-            if (cueInfo.mTitle.isEmpty())
-            {
-                cueInfo.mTitle = tr("<untitled>");
-            }
-            cueInfo.mLbCount = qRound((static_cast<double>(pParser->discLength()) / 1000.0) * 75.0);
-            tracks.append(cueInfo);
-
-            if (pParser->discYear() > 0)
-            {
-                tStamp.setDate(QDate(pParser->discYear(), 11, 11));
-                tStamp.setTime(QTime(11, 11, 11));
-            }
-
-            // tracks ...
-            for (int i = 1; i <= pParser->trackCount(); i++)
-            {
-                const CueParser::Track& t = pParser->track(i);
-
-                cueInfo.mFileName   = fi.canonicalPath() + "/" + t.mAudioFile;
-                cueInfo.mStartLba   = t.mStartLba;
-                cueInfo.mLbCount    = t.mLbaCount;
-                cueInfo.mCDTrackNo  = t.mNo;
-                cueInfo.mConversion = t.mConversion;
-                cueInfo.mTType      = t.mType;
-                cueInfo.mTitle      = "";
-                if (tStamp.isValid())
-                {
-                    cueInfo.mTStamp = tStamp;
-                }
-
-                if (!t.mPerformer.isEmpty() && (t.mPerformer != discArtist))
-                {
-                    cueInfo.mTitle  = t.mPerformer + " - ";
-                }
-                cueInfo.mTitle     += t.mTitle;
-
-                // in case no title is stored, use file name
-                if (cueInfo.mTitle.isEmpty())
-                {
-                    cueInfo.mTitle = titleFromFileName(cueInfo.mFileName);
-                }
-
-                if (cueInfo.mTitle.isEmpty())
-                {
-                    cueInfo.mTitle = tr("<untitled>");
-                }
-                tracks.append(cueInfo);
-            }
-        }
-        delete pParser;
-    }
+    CueParser parser(fileName);
+    c2n::AudioTracks tracks = parser.audioTracks();
 
     mpRipper->setDeviceInfo("Cue Sheet");
     catchCDDBEntry(tracks);
-    return ret;
+    return parser.isValid() ? 0 : -1;
 }
 
 void MainWindow::on_pushHelp_clicked()
@@ -1198,6 +1333,90 @@ void MainWindow::delayedPopUp(ePopUp tp, const QString& caption, const QString&
     }
 }
 
+//--------------------------------------------------------------------------
+//! @brief      start background rip / encode of loaded source (if enabled)
+//--------------------------------------------------------------------------
+void MainWindow::startSpeculation()
+{
+    CCDItemModel* pModel = ui->tableViewCD->myModel();
+
+    // queued jobs use the encoders already
+    if (!mpSettings->preEncode() || !mTransferMode.isTao() || mpPipeline->busy() || (mpJobQueue->pending() > 0)
+        || (pModel == nullptr) || (pModel->rowCount() == 0)
+        || mpRipper->busy() || !mProbeQueue.isEmpty())
+    {
+        return;
+    }
+
+    c2n::AudioTracks trks = pModel->audioTracks();
+    trks.prepend({ui->lineCDTitle->text(), "", "", 0, 0, pModel->audioLength()});
+    mCache.setBudget(mpSettings->artifactCache() ? mpSettings->artifactCacheBudget() : 0);
+
+    bool   isCD   = (trks.listType() == c2n::AudioTracks::CD);
+    bool   otf    = mpSettings->autoPlacement() ? false : mpSettings->onthefly();
+    qint64 budget = mpSettings->preEncodeBudget();
+    qint64 used   = 0;
+    TransferQueue workQueue;
+
+    for (int i = 1; i < trks.size(); i++)
+    {
+        const c2n::STrackInfo& t = trks.at(i);
+
+        // PCM size is the worst case
+        used += static_cast<qint64>(t.mLbCount) * CDIO_CD_FRAMESIZE_RAW;
+
+        if (used > budget)
+        {
+            break;
+        }
+
+        workQueue.append({static_cast<int16_t>(isCD ? t.mCDTrackNo : i),
+                          t.mTitle,
+                          QDir::tempPath() + tempFileName("/cd2netmd.XXXXXX.tmp"),
+                          static_cast<double>(t.mLbCount) / static_cast<double>(CDIO_CD_FRAMES_PER_SEC),
+                          WorkStep::NONE,
+                          isCD,
+                          t.mTStamp.toTime_t(),
+                          otf,
+                          trackKey(t),
+                          CArtifactCache::pcmKey(trks, i),
+                          QByteArray()});
+    }
+
+    if (!workQueue.isEmpty())
+    {
+        mpPipeline->prepare(trks, workQueue, pipelineConfig());
+    }
+}
+
+//--------------------------------------------------------------------------
+//! @brief      stop background rip / encode and drop its results
+//--------------------------------------------------------------------------
+void MainWindow::stopSpeculation()
+{
+    if (!mpPipeline->preparing())
+    {
+        return;
+    }
+
+    mpPipeline->stop();
+
+    ui->progressRip->setValue(0);
+    ui->progressExtEnc->setValue(0);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create key which identifies a track source
+//!
+//! @param[in]  t     track info
+//!
+//! @return     key string
+//--------------------------------------------------------------------------
+QString MainWindow::trackKey(const c2n::STrackInfo& t)
+{
+    return QString("%1|%2|%3|%4").arg(t.mFileName).arg(t.mCDTrackNo).arg(t.mStartLba).arg(t.mLbCount);
+}
+
 //--------------------------------------------------------------------------
 //! @brief      transfer mode changed
 //!
@@ -1205,8 +1424,17 @@ void MainWindow::delayedPopUp(ePopUp tp, const QString& caption, const QString&
 //--------------------------------------------------------------------------
 void MainWindow::on_cbxTranferMode_currentIndexChanged(int index)
 {
-    mTransferMode = ui->cbxTranferMode->itemData(index).toInt();
+    TransferMode newMode = ui->cbxTranferMode->itemData(index).toInt();
+
+    if (static_cast<TransferMode::ETransferMode>(newMode) != static_cast<TransferMode::ETransferMode>(mTransferMode))
+    {
+        // results are bound to transfer mode
+        stopSpeculation();
+    }
+
+    mTransferMode = newMode;
     updateFreeTimeLabel();
+    startSpeculation();
 }
 
 //--------------------------------------------------------------------------
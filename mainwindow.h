@@ -33,6 +33,10 @@
 #include "cdaoconfdlg.h"
 #include "statuswidget.h"
 #include "transfermode.h"
+#include "cplacementpolicy.h"
+#include "cartifactcache.h"
+#include "cpipeline.h"
+#include "cjobqueue.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -127,18 +131,18 @@ protected:
     //--------------------------------------------------------------------------
     //! @brief      recreate MD content tree view
     //!
-    //! @param[in]  json  The json
+    //! @param[in]  disc  The disc snapshot
     //--------------------------------------------------------------------------
-    void recreateTreeView(const QString& json);
+    void recreateTreeView(const SDiscSnapshot& disc);
     
     //--------------------------------------------------------------------------
     //! @brief      update count label
     //!
     //! @param      pLabel  The label
-    //! @param[in]  step    The step
+    //! @param[in]  stage   The pipeline stage
     //! @param[in]  text    The text
     //--------------------------------------------------------------------------
-    void countLabel(QLabel *pLabel, WorkStep step, const QString& text);
+    void countLabel(QLabel *pLabel, CPipeline::Stage stage, const QString& text);
 
     //--------------------------------------------------------------------------
     //! @brief      revert track order changes for DAO
@@ -155,6 +159,56 @@ protected:
     //--------------------------------------------------------------------------
     void delayedPopUp(ePopUp tp, const QString& caption, const QString& msg, int wait = 500);
 
+    //--------------------------------------------------------------------------
+    //! @brief      create work queue from selection and start transfer
+    //--------------------------------------------------------------------------
+    void startTransfer();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create work queue from selection
+    //!
+    //! @param[out] trks  source tracks (disc entry at index 0)
+    //!
+    //! @return     work queue
+    //--------------------------------------------------------------------------
+    TransferQueue workQueue(c2n::AudioTracks& trks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      add selection as job to the job queue
+    //--------------------------------------------------------------------------
+    void queueJob();
+
+    //--------------------------------------------------------------------------
+    //! @brief      collect pipeline settings from UI and settings dialog
+    //!
+    //! @return     pipeline settings
+    //--------------------------------------------------------------------------
+    CPipeline::SConfig pipelineConfig();
+
+    //--------------------------------------------------------------------------
+    //! @brief      start background rip / encode of loaded source (if enabled)
+    //--------------------------------------------------------------------------
+    void startSpeculation();
+
+    //--------------------------------------------------------------------------
+    //! @brief      stop background rip / encode and drop its results
+    //--------------------------------------------------------------------------
+    void stopSpeculation();
+
+    //--------------------------------------------------------------------------
+    //! @brief      create key which identifies a track source
+    //!
+    //! @param[in]  t     track info
+    //!
+    //! @return     key string
+    //--------------------------------------------------------------------------
+    static QString trackKey(const c2n::STrackInfo& t);
+
+    //--------------------------------------------------------------------------
+    //! @brief      send staged MD edits to NetMD device
+    //--------------------------------------------------------------------------
+    void commitEdits();
+
 private slots:
     //--------------------------------------------------------------------------
     //! @brief      load settings
@@ -176,11 +230,26 @@ private slots:
     void catchCDDBEntry(c2n::AudioTracks tracks);
     
     //--------------------------------------------------------------------------
-    //! @brief      get json data from MD
+    //! @brief      get disc info from MD
     //!
-    //! @param[in]  <unnamed>  json data as string
+    //! @param[in]  disc  disc snapshot (header, tracks may follow)
     //--------------------------------------------------------------------------
-    void catchJson(QString);
+    void catchDiscInfo(SDiscSnapshot disc);
+
+    //--------------------------------------------------------------------------
+    //! @brief      get track batch from MD (after catchDiscInfo())
+    //!
+    //! @param[in]  tracks  snapshot holding the track batch
+    //--------------------------------------------------------------------------
+    void catchTracks(SDiscSnapshot tracks);
+
+    //--------------------------------------------------------------------------
+    //! @brief      MD view needs protection / time of tracks
+    //!
+    //! @param[in]  first  first track (0-based)
+    //! @param[in]  last   last track (0-based)
+    //--------------------------------------------------------------------------
+    void mdDetailsNeeded(int first, int last);
 
     //--------------------------------------------------------------------------
     //! @brief      Called when push initialize cd clicked.
@@ -192,6 +261,24 @@ private slots:
     //--------------------------------------------------------------------------
     void on_pushLoadMD_clicked();
 
+    //--------------------------------------------------------------------------
+    //! @brief      NetMD device was plugged in -> load MD if idle
+    //--------------------------------------------------------------------------
+    void mdDeviceArrived();
+
+    //--------------------------------------------------------------------------
+    //! @brief      NetMD device was removed -> clear MD view if idle
+    //--------------------------------------------------------------------------
+    void mdDeviceLeft();
+
+    //--------------------------------------------------------------------------
+    //! @brief      a NetMD command finished
+    //!
+    //! @param[in]  cmd   The command
+    //! @param[in]  ret   return value of command
+    //--------------------------------------------------------------------------
+    void mdCmdDone(CNetMD::NetMDCmd cmd, int ret);
+
     //--------------------------------------------------------------------------
     //! @brief      MD titling
     //!
@@ -207,24 +294,44 @@ private slots:
     void on_pushTransfer_clicked();
 
     //--------------------------------------------------------------------------
-    //! @brief      rip of one track finsihed
+    //! @brief      Called when push queue clicked.
     //--------------------------------------------------------------------------
-    void ripFinished();
-    
+    void on_pushQueue_clicked();
+
+    //--------------------------------------------------------------------------
+    //! @brief      job queue content or state changed
     //--------------------------------------------------------------------------
-    //! @brief      one encode finished.
+    void jobQueueChanged();
+
+    //--------------------------------------------------------------------------
+    //! @brief      show job queue context menu
     //!
-    //! @param[in]  checkBusy  The check busy
+    //! @param[in]  pos   position in status widget
     //--------------------------------------------------------------------------
-    void encodeFinished(bool checkBusy = false);
-    
+    void jobQueueMenu(const QPoint& pos);
+
+    //--------------------------------------------------------------------------
+    //! @brief      pipeline stage started / finished a track
+    //!
+    //! @param[in]  stage    The stage
+    //! @param[in]  started  true if started
+    //--------------------------------------------------------------------------
+    void pipelineStage(CPipeline::Stage stage, bool started);
+
+    //--------------------------------------------------------------------------
+    //! @brief      all tracks were transferred
+    //!
+    //! @param[in]  ret     return value of last device command
+    //! @param[in]  tracks  number of transferred tracks
+    //--------------------------------------------------------------------------
+    void transferDone(int ret, int tracks);
+
     //--------------------------------------------------------------------------
-    //! @brief      one transfer finished
+    //! @brief      transfer failed
     //!
-    //! @param[in]  checkBusy  The check busy
-    //! @param[in]  ret        if given return value from last transfer
+    //! @param[in]  ret   return value of failed device command
     //--------------------------------------------------------------------------
-    void transferFinished(bool checkBusy, int ret);
+    void transferFailed(int ret);
     
     //--------------------------------------------------------------------------
     //! @brief      Adds a md group.
@@ -276,6 +383,11 @@ private slots:
     //--------------------------------------------------------------------------
     void catchDropped(QStringList sl);
 
+    //--------------------------------------------------------------------------
+    //! @brief      probe next batch of dropped files, add them to the list
+    //--------------------------------------------------------------------------
+    void probeDropped();
+
     //--------------------------------------------------------------------------
     //! @brief      catch new audio length in list
     //!
@@ -316,15 +428,18 @@ private:
     /// NetMD handling pointer
     CNetMD         *mpNetMD;
     
-    /// external encoder pointer
-    CXEnc          *mpXEnc;
+    /// rip -> encode -> transfer engine
+    CPipeline      *mpPipeline;
+
+    /// queued jobs (many sources / MDs)
+    CJobQueue      *mpJobQueue;
+
+    /// job queue status
+    StatusWidget   *mpJobStatus;
     
     /// tree model for MD
     CMDTreeModel   *mpMDmodel;
     
-    /// job list
-    TransferQueue   mWorkQueue;
-    
     /// MD device info
     StatusWidget   *mpMDDevice;
     
@@ -360,4 +475,28 @@ private:
 
     /// chosen transfer mode
     TransferMode mTransferMode;
+
+    /// host encoder vs. on-the-fly decision
+    CPlacementPolicy mPlacement;
+
+    /// ripped / encoded tracks from earlier runs
+    CArtifactCache mCache;
+
+    /// on-the-fly setting at transfer request
+    bool mbOtfReq;
+
+    /// auto placement setting at transfer request
+    bool mbAutoOtfReq;
+
+    /// MD edits not yet sent to device
+    CNetMD::SBulkEdit mStagedEdits;
+
+    /// commits staged edits when user stops editing
+    QTimer mEditTimer;
+
+    /// dropped files not yet probed
+    QStringList mProbeQueue;
+
+    /// files probed per event loop turn
+    static constexpr int PROBE_BATCH = 64;
 };
@@ -17,498 +17,585 @@
 #include "mdtitle.h"
 #include "defines.h"
 #include <QString>
-#include <QMap>
 #include <QChar>
-#include <QTextEncoder>
+#include <QTextCodec>
+#include <QtDebug>
+#include <algorithm>
 
 /*
  * This code was highly inspired by webminidisc! Many thanks for this!
  */
 
-const static QMap<QString, QString> s_FullToHalfWidth = {
-    {"－", "-"},
-    {"ｰ", "-"},
-    {"ァ", "ｧ"},
-    {"ア", "ｱ"},
-    {"ィ", "ｨ"},
-    {"イ", "ｲ"},
-    {"ゥ", "ｩ"},
-    {"ウ", "ｳ"},
-    {"ェ", "ｪ"},
-    {"エ", "ｴ"},
-    {"ォ", "ｫ"},
-    {"オ", "ｵ"},
-    {"カ", "ｶ"},
-    {"ガ", "ｶﾞ"},
-    {"キ", "ｷ"},
-    {"ギ", "ｷﾞ"},
-    {"ク", "ｸ"},
-    {"グ", "ｸﾞ"},
-    {"ケ", "ｹ"},
-    {"ゲ", "ｹﾞ"},
-    {"コ", "ｺ"},
-    {"ゴ", "ｺﾞ"},
-    {"サ", "ｻ"},
-    {"ザ", "ｻﾞ"},
-    {"シ", "ｼ"},
-    {"ジ", "ｼﾞ"},
-    {"ス", "ｽ"},
-    {"ズ", "ｽﾞ"},
-    {"セ", "ｾ"},
-    {"ゼ", "ｾﾞ"},
-    {"ソ", "ｿ"},
-    {"ゾ", "ｿﾞ"},
-    {"タ", "ﾀ"},
-    {"ダ", "ﾀﾞ"},
-    {"チ", "ﾁ"},
-    {"ヂ", "ﾁﾞ"},
-    {"ッ", "ｯ"},
-    {"ツ", "ﾂ"},
-    {"ヅ", "ﾂﾞ"},
-    {"テ", "ﾃ"},
-    {"デ", "ﾃﾞ"},
-    {"ト", "ﾄ"},
-    {"ド", "ﾄﾞ"},
-    {"ナ", "ﾅ"},
-    {"ニ", "ﾆ"},
-    {"ヌ", "ﾇ"},
-    {"ネ", "ﾈ"},
-    {"ノ", "ﾉ"},
-    {"ハ", "ﾊ"},
-    {"バ", "ﾊﾞ"},
-    {"パ", "ﾊﾟ"},
-    {"ヒ", "ﾋ"},
-    {"ビ", "ﾋﾞ"},
-    {"ピ", "ﾋﾟ"},
-    {"フ", "ﾌ"},
-    {"ブ", "ﾌﾞ"},
-    {"プ", "ﾌﾟ"},
-    {"ヘ", "ﾍ"},
-    {"ベ", "ﾍﾞ"},
-    {"ペ", "ﾍﾟ"},
-    {"ホ", "ﾎ"},
-    {"ボ", "ﾎﾞ"},
-    {"ポ", "ﾎﾟ"},
-    {"マ", "ﾏ"},
-    {"ミ", "ﾐ"},
-    {"ム", "ﾑ"},
-    {"メ", "ﾒ"},
-    {"モ", "ﾓ"},
-    {"ャ", "ｬ"},
-    {"ヤ", "ﾔ"},
-    {"ュ", "ｭ"},
-    {"ユ", "ﾕ"},
-    {"ョ", "ｮ"},
-    {"ヨ", "ﾖ"},
-    {"ラ", "ﾗ"},
-    {"リ", "ﾘ"},
-    {"ル", "ﾙ"},
-    {"レ", "ﾚ"},
-    {"ロ", "ﾛ"},
-    {"ワ", "ﾜ"},
-    {"ヲ", "ｦ"},
-    {"ン", "ﾝ"},
-    {"ー", "-"},
-    {"ヮ", "ヮ"},
-    {"ヰ", "ヰ"},
-    {"ヱ", "ヱ"},
-    {"ヵ", "ヵ"},
-    {"ヶ", "ヶ"},
-    {"ヴ", "ｳﾞ"},
-    {"ヽ", "ヽ"},
-    {"ヾ", "ヾ"},
-    {"・", "･"},
-    {"「", "｢"},
-    {"」", "｣"},
-    {"。", "｡"},
-    {"、", "､"},
-    {"！", "!"},
-    {"＂", "\""},
-    {"＃", "#"},
-    {"＄", "$"},
-    {"％", "%"},
-    {"＆", "&"},
-    {"＇", "'"},
-    {"（", "("},
-    {"）", ")"},
-    {"＊", "*"},
-    {"＋", "+"},
-    {"，", ","},
-    {"．", "."},
-    {"／", "/"},
-    {"：", ":"},
-    {"；", ";"},
-    {"＜", "<"},
-    {"＝", "="},
-    {"＞", ">"},
-    {"？", "?"},
-    {"＠", "@"},
-    {"Ａ", "A"},
-    {"Ｂ", "B"},
-    {"Ｃ", "C"},
-    {"Ｄ", "D"},
-    {"Ｅ", "E"},
-    {"Ｆ", "F"},
-    {"Ｇ", "G"},
-    {"Ｈ", "H"},
-    {"Ｉ", "I"},
-    {"Ｊ", "J"},
-    {"Ｋ", "K"},
-    {"Ｌ", "L"},
-    {"Ｍ", "M"},
-    {"Ｎ", "N"},
-    {"Ｏ", "O"},
-    {"Ｐ", "P"},
-    {"Ｑ", "Q"},
-    {"Ｒ", "R"},
-    {"Ｓ", "S"},
-    {"Ｔ", "T"},
-    {"Ｕ", "U"},
-    {"Ｖ", "V"},
-    {"Ｗ", "W"},
-    {"Ｘ", "X"},
-    {"Ｙ", "Y"},
-    {"Ｚ", "Z"},
-    {"［", "["},
-    {"＼", "\\"},
-    {"］", "]"},
-    {"＾", "^"},
-    {"＿", "_"},
-    {"｀", "`"},
-    {"ａ", "a"},
-    {"ｂ", "b"},
-    {"ｃ", "c"},
-    {"ｄ", "d"},
-    {"ｅ", "e"},
-    {"ｆ", "f"},
-    {"ｇ", "g"},
-    {"ｈ", "h"},
-    {"ｉ", "i"},
-    {"ｊ", "j"},
-    {"ｋ", "k"},
-    {"ｌ", "l"},
-    {"ｍ", "m"},
-    {"ｎ", "n"},
-    {"ｏ", "o"},
-    {"ｐ", "p"},
-    {"ｑ", "q"},
-    {"ｒ", "r"},
-    {"ｓ", "s"},
-    {"ｔ", "t"},
-    {"ｕ", "u"},
-    {"ｖ", "v"},
-    {"ｗ", "w"},
-    {"ｘ", "x"},
-    {"ｙ", "y"},
-    {"ｚ", "z"},
-    {"｛", "{"},
-    {"｜", "|"},
-    {"｝", "}"},
-    {"～", "~"},
-    {"\u3000", " "},
-    {"０", "0"},
-    {"１", "1"},
-    {"２", "2"},
-    {"３", "3"},
-    {"４", "4"},
-    {"５", "5"},
-    {"６", "6"},
-    {"７", "7"},
-    {"８", "8"},
-    {"９", "9"},
-    {"ぁ", "ｧ"},
-    {"あ", "ｱ"},
-    {"ぃ", "ｨ"},
-    {"い", "ｲ"},
-    {"ぅ", "ｩ"},
-    {"う", "ｳ"},
-    {"ぇ", "ｪ"},
-    {"え", "ｴ"},
-    {"ぉ", "ｫ"},
-    {"お", "ｵ"},
-    {"か", "ｶ"},
-    {"が", "ｶﾞ"},
-    {"き", "ｷ"},
-    {"ぎ", "ｷﾞ"},
-    {"く", "ｸ"},
-    {"ぐ", "ｸﾞ"},
-    {"け", "ｹ"},
-    {"げ", "ｹﾞ"},
-    {"こ", "ｺ"},
-    {"ご", "ｺﾞ"},
-    {"さ", "ｻ"},
-    {"ざ", "ｻﾞ"},
-    {"し", "ｼ"},
-    {"じ", "ｼﾞ"},
-    {"す", "ｽ"},
-    {"ず", "ｽﾞ"},
-    {"せ", "ｾ"},
-    {"ぜ", "ｾﾞ"},
-    {"そ", "ｿ"},
-    {"ぞ", "ｿﾞ"},
-    {"た", "ﾀ"},
-    {"だ", "ﾀﾞ"},
-    {"ち", "ﾁ"},
-    {"ぢ", "ﾁﾞ"},
-    {"っ", "ｯ"},
-    {"つ", "ﾂ"},
-    {"づ", "ﾂﾞ"},
-    {"て", "ﾃ"},
-    {"で", "ﾃﾞ"},
-    {"と", "ﾄ"},
-    {"ど", "ﾄﾞ"},
-    {"な", "ﾅ"},
-    {"に", "ﾆ"},
-    {"ぬ", "ﾇ"},
-    {"ね", "ﾈ"},
-    {"の", "ﾉ"},
-    {"は", "ﾊ"},
-    {"ば", "ﾊﾞ"},
-    {"ぱ", "ﾊﾟ"},
-    {"ひ", "ﾋ"},
-    {"び", "ﾋﾞ"},
-    {"ぴ", "ﾋﾟ"},
-    {"ふ", "ﾌ"},
-    {"ぶ", "ﾌﾞ"},
-    {"ぷ", "ﾌﾟ"},
-    {"へ", "ﾍ"},
-    {"べ", "ﾍﾞ"},
-    {"ぺ", "ﾍﾟ"},
-    {"ほ", "ﾎ"},
-    {"ぼ", "ﾎﾞ"},
-    {"ぽ", "ﾎﾟ"},
-    {"ま", "ﾏ"},
-    {"み", "ﾐ"},
-    {"む", "ﾑ"},
-    {"め", "ﾒ"},
-    {"も", "ﾓ"},
-    {"ゃ", "ｬ"},
-    {"や", "ﾔ"},
-    {"ゅ", "ｭ"},
-    {"ゆ", "ﾕ"},
-    {"ょ", "ｮ"},
-    {"よ", "ﾖ"},
-    {"ら", "ﾗ"},
-    {"り", "ﾘ"},
-    {"る", "ﾙ"},
-    {"れ", "ﾚ"},
-    {"ろ", "ﾛ"},
-    {"わ", "ﾜ"},
-    {"を", "ｦ"},
-    {"ん", "ﾝ"},
-    {"ゎ", "ヮ"},
-    {"ゐ", "ヰ"},
-    {"ゑ", "ヱ"},
-    {"ゕ", "ヵ"},
-    {"ゖ", "ヶ"},
-    {"ゔ", "ｳﾞ"},
-    {"ゝ", "ヽ"},
-    {"ゞ", "ヾ"}
+/// one width mapping (up to two UTF-16 code units, 0 -> unused)
+struct SWidthMap
+{
+    uint16_t mKey;
+    uint16_t mVal[2];
+};
+
+// Constant tables sorted by UTF-16 code unit. Titles are converted code
+// unit by code unit, so mappings from more than one unit can't match.
+
+static const SWidthMap s_FullToHalfWidth[] = {
+    {0x3000, {0x0020, 0x0000}}, // ideographic space -> ' '
+    {0x3001, {0xFF64, 0x0000}}, // 、 -> ､
+    {0x3002, {0xFF61, 0x0000}}, // 。 -> ｡
+    {0x300C, {0xFF62, 0x0000}}, // 「 -> ｢
+    {0x300D, {0xFF63, 0x0000}}, // 」 -> ｣
+    {0x3041, {0xFF67, 0x0000}}, // ぁ -> ｧ
+    {0x3042, {0xFF71, 0x0000}}, // あ -> ｱ
+    {0x3043, {0xFF68, 0x0000}}, // ぃ -> ｨ
+    {0x3044, {0xFF72, 0x0000}}, // い -> ｲ
+    {0x3045, {0xFF69, 0x0000}}, // ぅ -> ｩ
+    {0x3046, {0xFF73, 0x0000}}, // う -> ｳ
+    {0x3047, {0xFF6A, 0x0000}}, // ぇ -> ｪ
+    {0x3048, {0xFF74, 0x0000}}, // え -> ｴ
+    {0x3049, {0xFF6B, 0x0000}}, // ぉ -> ｫ
+    {0x304A, {0xFF75, 0x0000}}, // お -> ｵ
+    {0x304B, {0xFF76, 0x0000}}, // か -> ｶ
+    {0x304C, {0xFF76, 0xFF9E}}, // が -> ｶﾞ
+    {0x304D, {0xFF77, 0x0000}}, // き -> ｷ
+    {0x304E, {0xFF77, 0xFF9E}}, // ぎ -> ｷﾞ
+    {0x304F, {0xFF78, 0x0000}}, // く -> ｸ
+    {0x3050, {0xFF78, 0xFF9E}}, // ぐ -> ｸﾞ
+    {0x3051, {0xFF79, 0x0000}}, // け -> ｹ
+    {0x3052, {0xFF79, 0xFF9E}}, // げ -> ｹﾞ
+    {0x3053, {0xFF7A, 0x0000}}, // こ -> ｺ
+    {0x3054, {0xFF7A, 0xFF9E}}, // ご -> ｺﾞ
+    {0x3055, {0xFF7B, 0x0000}}, // さ -> ｻ
+    {0x3056, {0xFF7B, 0xFF9E}}, // ざ -> ｻﾞ
+    {0x3057, {0xFF7C, 0x0000}}, // し -> ｼ
+    {0x3058, {0xFF7C, 0xFF9E}}, // じ -> ｼﾞ
+    {0x3059, {0xFF7D, 0x0000}}, // す -> ｽ
+    {0x305A, {0xFF7D, 0xFF9E}}, // ず -> ｽﾞ
+    {0x305B, {0xFF7E, 0x0000}}, // せ -> ｾ
+    {0x305C, {0xFF7E, 0xFF9E}}, // ぜ -> ｾﾞ
+    {0x305D, {0xFF7F, 0x0000}}, // そ -> ｿ
+    {0x305E, {0xFF7F, 0xFF9E}}, // ぞ -> ｿﾞ
+    {0x305F, {0xFF80, 0x0000}}, // た -> ﾀ
+    {0x3060, {0xFF80, 0xFF9E}}, // だ -> ﾀﾞ
+    {0x3061, {0xFF81, 0x0000}}, // ち -> ﾁ
+    {0x3062, {0xFF81, 0xFF9E}}, // ぢ -> ﾁﾞ
+    {0x3063, {0xFF6F, 0x0000}}, // っ -> ｯ
+    {0x3064, {0xFF82, 0x0000}}, // つ -> ﾂ
+    {0x3065, {0xFF82, 0xFF9E}}, // づ -> ﾂﾞ
+    {0x3066, {0xFF83, 0x0000}}, // て -> ﾃ
+    {0x3067, {0xFF83, 0xFF9E}}, // で -> ﾃﾞ
+    {0x3068, {0xFF84, 0x0000}}, // と -> ﾄ
+    {0x3069, {0xFF84, 0xFF9E}}, // ど -> ﾄﾞ
+    {0x306A, {0xFF85, 0x0000}}, // な -> ﾅ
+    {0x306B, {0xFF86, 0x0000}}, // に -> ﾆ
+    {0x306C, {0xFF87, 0x0000}}, // ぬ -> ﾇ
+    {0x306D, {0xFF88, 0x0000}}, // ね -> ﾈ
+    {0x306E, {0xFF89, 0x0000}}, // の -> ﾉ
+    {0x306F, {0xFF8A, 0x0000}}, // は -> ﾊ
+    {0x3070, {0xFF8A, 0xFF9E}}, // ば -> ﾊﾞ
+    {0x3071, {0xFF8A, 0xFF9F}}, // ぱ -> ﾊﾟ
+    {0x3072, {0xFF8B, 0x0000}}, // ひ -> ﾋ
+    {0x3073, {0xFF8B, 0xFF9E}}, // び -> ﾋﾞ
+    {0x3074, {0xFF8B, 0xFF9F}}, // ぴ -> ﾋﾟ
+    {0x3075, {0xFF8C, 0x0000}}, // ふ -> ﾌ
+    {0x3076, {0xFF8C, 0xFF9E}}, // ぶ -> ﾌﾞ
+    {0x3077, {0xFF8C, 0xFF9F}}, // ぷ -> ﾌﾟ
+    {0x3078, {0xFF8D, 0x0000}}, // へ -> ﾍ
+    {0x3079, {0xFF8D, 0xFF9E}}, // べ -> ﾍﾞ
+    {0x307A, {0xFF8D, 0xFF9F}}, // ぺ -> ﾍﾟ
+    {0x307B, {0xFF8E, 0x0000}}, // ほ -> ﾎ
+    {0x307C, {0xFF8E, 0xFF9E}}, // ぼ -> ﾎﾞ
+    {0x307D, {0xFF8E, 0xFF9F}}, // ぽ -> ﾎﾟ
+    {0x307E, {0xFF8F, 0x0000}}, // ま -> ﾏ
+    {0x307F, {0xFF90, 0x0000}}, // み -> ﾐ
+    {0x3080, {0xFF91, 0x0000}}, // む -> ﾑ
+    {0x3081, {0xFF92, 0x0000}}, // め -> ﾒ
+    {0x3082, {0xFF93, 0x0000}}, // も -> ﾓ
+    {0x3083, {0xFF6C, 0x0000}}, // ゃ -> ｬ
+    {0x3084, {0xFF94, 0x0000}}, // や -> ﾔ
+    {0x3085, {0xFF6D, 0x0000}}, // ゅ -> ｭ
+    {0x3086, {0xFF95, 0x0000}}, // ゆ -> ﾕ
+    {0x3087, {0xFF6E, 0x0000}}, // ょ -> ｮ
+    {0x3088, {0xFF96, 0x0000}}, // よ -> ﾖ
+    {0x3089, {0xFF97, 0x0000}}, // ら -> ﾗ
+    {0x308A, {0xFF98, 0x0000}}, // り -> ﾘ
+    {0x308B, {0xFF99, 0x0000}}, // る -> ﾙ
+    {0x308C, {0xFF9A, 0x0000}}, // れ -> ﾚ
+    {0x308D, {0xFF9B, 0x0000}}, // ろ -> ﾛ
+    {0x308E, {0x30EE, 0x0000}}, // ゎ -> ヮ
+    {0x308F, {0xFF9C, 0x0000}}, // わ -> ﾜ
+    {0x3090, {0x30F0, 0x0000}}, // ゐ -> ヰ
+    {0x3091, {0x30F1, 0x0000}}, // ゑ -> ヱ
+    {0x3092, {0xFF66, 0x0000}}, // を -> ｦ
+    {0x3093, {0xFF9D, 0x0000}}, // ん -> ﾝ
+    {0x3094, {0xFF73, 0xFF9E}}, // ゔ -> ｳﾞ
+    {0x3095, {0x30F5, 0x0000}}, // ゕ -> ヵ
+    {0x3096, {0x30F6, 0x0000}}, // ゖ -> ヶ
+    {0x309D, {0x30FD, 0x0000}}, // ゝ -> ヽ
+    {0x309E, {0x30FE, 0x0000}}, // ゞ -> ヾ
+    {0x30A1, {0xFF67, 0x0000}}, // ァ -> ｧ
+    {0x30A2, {0xFF71, 0x0000}}, // ア -> ｱ
+    {0x30A3, {0xFF68, 0x0000}}, // ィ -> ｨ
+    {0x30A4, {0xFF72, 0x0000}}, // イ -> ｲ
+    {0x30A5, {0xFF69, 0x0000}}, // ゥ -> ｩ
+    {0x30A6, {0xFF73, 0x0000}}, // ウ -> ｳ
+    {0x30A7, {0xFF6A, 0x0000}}, // ェ -> ｪ
+    {0x30A8, {0xFF74, 0x0000}}, // エ -> ｴ
+    {0x30A9, {0xFF6B, 0x0000}}, // ォ -> ｫ
+    {0x30AA, {0xFF75, 0x0000}}, // オ -> ｵ
+    {0x30AB, {0xFF76, 0x0000}}, // カ -> ｶ
+    {0x30AC, {0xFF76, 0xFF9E}}, // ガ -> ｶﾞ
+    {0x30AD, {0xFF77, 0x0000}}, // キ -> ｷ
+    {0x30AE, {0xFF77, 0xFF9E}}, // ギ -> ｷﾞ
+    {0x30AF, {0xFF78, 0x0000}}, // ク -> ｸ
+    {0x30B0, {0xFF78, 0xFF9E}}, // グ -> ｸﾞ
+    {0x30B1, {0xFF79, 0x0000}}, // ケ -> ｹ
+    {0x30B2, {0xFF79, 0xFF9E}}, // ゲ -> ｹﾞ
+    {0x30B3, {0xFF7A, 0x0000}}, // コ -> ｺ
+    {0x30B4, {0xFF7A, 0xFF9E}}, // ゴ -> ｺﾞ
+    {0x30B5, {0xFF7B, 0x0000}}, // サ -> ｻ
+    {0x30B6, {0xFF7B, 0xFF9E}}, // ザ -> ｻﾞ
+    {0x30B7, {0xFF7C, 0x0000}}, // シ -> ｼ
+    {0x30B8, {0xFF7C, 0xFF9E}}, // ジ -> ｼﾞ
+    {0x30B9, {0xFF7D, 0x0000}}, // ス -> ｽ
+    {0x30BA, {0xFF7D, 0xFF9E}}, // ズ -> ｽﾞ
+    {0x30BB, {0xFF7E, 0x0000}}, // セ -> ｾ
+    {0x30BC, {0xFF7E, 0xFF9E}}, // ゼ -> ｾﾞ
+    {0x30BD, {0xFF7F, 0x0000}}, // ソ -> ｿ
+    {0x30BE, {0xFF7F, 0xFF9E}}, // ゾ -> ｿﾞ
+    {0x30BF, {0xFF80, 0x0000}}, // タ -> ﾀ
+    {0x30C0, {0xFF80, 0xFF9E}}, // ダ -> ﾀﾞ
+    {0x30C1, {0xFF81, 0x0000}}, // チ -> ﾁ
+    {0x30C2, {0xFF81, 0xFF9E}}, // ヂ -> ﾁﾞ
+    {0x30C3, {0xFF6F, 0x0000}}, // ッ -> ｯ
+    {0x30C4, {0xFF82, 0x0000}}, // ツ -> ﾂ
+    {0x30C5, {0xFF82, 0xFF9E}}, // ヅ -> ﾂﾞ
+    {0x30C6, {0xFF83, 0x0000}}, // テ -> ﾃ
+    {0x30C7, {0xFF83, 0xFF9E}}, // デ -> ﾃﾞ
+    {0x30C8, {0xFF84, 0x0000}}, // ト -> ﾄ
+    {0x30C9, {0xFF84, 0xFF9E}}, // ド -> ﾄﾞ
+    {0x30CA, {0xFF85, 0x0000}}, // ナ -> ﾅ
+    {0x30CB, {0xFF86, 0x0000}}, // ニ -> ﾆ
+    {0x30CC, {0xFF87, 0x0000}}, // ヌ -> ﾇ
+    {0x30CD, {0xFF88, 0x0000}}, // ネ -> ﾈ
+    {0x30CE, {0xFF89, 0x0000}}, // ノ -> ﾉ
+    {0x30CF, {0xFF8A, 0x0000}}, // ハ -> ﾊ
+    {0x30D0, {0xFF8A, 0xFF9E}}, // バ -> ﾊﾞ
+    {0x30D1, {0xFF8A, 0xFF9F}}, // パ -> ﾊﾟ
+    {0x30D2, {0xFF8B, 0x0000}}, // ヒ -> ﾋ
+    {0x30D3, {0xFF8B, 0xFF9E}}, // ビ -> ﾋﾞ
+    {0x30D4, {0xFF8B, 0xFF9F}}, // ピ -> ﾋﾟ
+    {0x30D5, {0xFF8C, 0x0000}}, // フ -> ﾌ
+    {0x30D6, {0xFF8C, 0xFF9E}}, // ブ -> ﾌﾞ
+    {0x30D7, {0xFF8C, 0xFF9F}}, // プ -> ﾌﾟ
+    {0x30D8, {0xFF8D, 0x0000}}, // ヘ -> ﾍ
+    {0x30D9, {0xFF8D, 0xFF9E}}, // ベ -> ﾍﾞ
+    {0x30DA, {0xFF8D, 0xFF9F}}, // ペ -> ﾍﾟ
+    {0x30DB, {0xFF8E, 0x0000}}, // ホ -> ﾎ
+    {0x30DC, {0xFF8E, 0xFF9E}}, // ボ -> ﾎﾞ
+    {0x30DD, {0xFF8E, 0xFF9F}}, // ポ -> ﾎﾟ
+    {0x30DE, {0xFF8F, 0x0000}}, // マ -> ﾏ
+    {0x30DF, {0xFF90, 0x0000}}, // ミ -> ﾐ
+    {0x30E0, {0xFF91, 0x0000}}, // ム -> ﾑ
+    {0x30E1, {0xFF92, 0x0000}}, // メ -> ﾒ
+    {0x30E2, {0xFF93, 0x0000}}, // モ -> ﾓ
+    {0x30E3, {0xFF6C, 0x0000}}, // ャ -> ｬ
+    {0x30E4, {0xFF94, 0x0000}}, // ヤ -> ﾔ
+    {0x30E5, {0xFF6D, 0x0000}}, // ュ -> ｭ
+    {0x30E6, {0xFF95, 0x0000}}, // ユ -> ﾕ
+    {0x30E7, {0xFF6E, 0x0000}}, // ョ -> ｮ
+    {0x30E8, {0xFF96, 0x0000}}, // ヨ -> ﾖ
+    {0x30E9, {0xFF97, 0x0000}}, // ラ -> ﾗ
+    {0x30EA, {0xFF98, 0x0000}}, // リ -> ﾘ
+    {0x30EB, {0xFF99, 0x0000}}, // ル -> ﾙ
+    {0x30EC, {0xFF9A, 0x0000}}, // レ -> ﾚ
+    {0x30ED, {0xFF9B, 0x0000}}, // ロ -> ﾛ
+    {0x30EE, {0x30EE, 0x0000}}, // ヮ -> ヮ
+    {0x30EF, {0xFF9C, 0x0000}}, // ワ -> ﾜ
+    {0x30F0, {0x30F0, 0x0000}}, // ヰ -> ヰ
+    {0x30F1, {0x30F1, 0x0000}}, // ヱ -> ヱ
+    {0x30F2, {0xFF66, 0x0000}}, // ヲ -> ｦ
+    {0x30F3, {0xFF9D, 0x0000}}, // ン -> ﾝ
+    {0x30F4, {0xFF73, 0xFF9E}}, // ヴ -> ｳﾞ
+    {0x30F5, {0x30F5, 0x0000}}, // ヵ -> ヵ
+    {0x30F6, {0x30F6, 0x0000}}, // ヶ -> ヶ
+    {0x30FB, {0xFF65, 0x0000}}, // ・ -> ･
+    {0x30FC, {0x002D, 0x0000}}, // ー -> -
+    {0x30FD, {0x30FD, 0x0000}}, // ヽ -> ヽ
+    {0x30FE, {0x30FE, 0x0000}}, // ヾ -> ヾ
+    {0xFF01, {0x0021, 0x0000}}, // ！ -> !
+    {0xFF02, {0x0022, 0x0000}}, // ＂ -> "
+    {0xFF03, {0x0023, 0x0000}}, // ＃ -> #
+    {0xFF04, {0x0024, 0x0000}}, // ＄ -> $
+    {0xFF05, {0x0025, 0x0000}}, // ％ -> %
+    {0xFF06, {0x0026, 0x0000}}, // ＆ -> &
+    {0xFF07, {0x0027, 0x0000}}, // ＇ -> '
+    {0xFF08, {0x0028, 0x0000}}, // （ -> (
+    {0xFF09, {0x0029, 0x0000}}, // ） -> )
+    {0xFF0A, {0x002A, 0x0000}}, // ＊ -> *
+    {0xFF0B, {0x002B, 0x0000}}, // ＋ -> +
+    {0xFF0C, {0x002C, 0x0000}}, // ， -> ,
+    {0xFF0D, {0x002D, 0x0000}}, // － -> -
+    {0xFF0E, {0x002E, 0x0000}}, // ． -> .
+    {0xFF0F, {0x002F, 0x0000}}, // ／ -> /
+    {0xFF10, {0x0030, 0x0000}}, // ０ -> 0
+    {0xFF11, {0x0031, 0x0000}}, // １ -> 1
+    {0xFF12, {0x0032, 0x0000}}, // ２ -> 2
+    {0xFF13, {0x0033, 0x0000}}, // ３ -> 3
+    {0xFF14, {0x0034, 0x0000}}, // ４ -> 4
+    {0xFF15, {0x0035, 0x0000}}, // ５ -> 5
+    {0xFF16, {0x0036, 0x0000}}, // ６ -> 6
+    {0xFF17, {0x0037, 0x0000}}, // ７ -> 7
+    {0xFF18, {0x0038, 0x0000}}, // ８ -> 8
+    {0xFF19, {0x0039, 0x0000}}, // ９ -> 9
+    {0xFF1A, {0x003A, 0x0000}}, // ： -> :
+    {0xFF1B, {0x003B, 0x0000}}, // ； -> ;
+    {0xFF1C, {0x003C, 0x0000}}, // ＜ -> <
+    {0xFF1D, {0x003D, 0x0000}}, // ＝ -> =
+    {0xFF1E, {0x003E, 0x0000}}, // ＞ -> >
+    {0xFF1F, {0x003F, 0x0000}}, // ？ -> ?
+    {0xFF20, {0x0040, 0x0000}}, // ＠ -> @
+    {0xFF21, {0x0041, 0x0000}}, // Ａ -> A
+    {0xFF22, {0x0042, 0x0000}}, // Ｂ -> B
+    {0xFF23, {0x0043, 0x0000}}, // Ｃ -> C
+    {0xFF24, {0x0044, 0x0000}}, // Ｄ -> D
+    {0xFF25, {0x0045, 0x0000}}, // Ｅ -> E
+    {0xFF26, {0x0046, 0x0000}}, // Ｆ -> F
+    {0xFF27, {0x0047, 0x0000}}, // Ｇ -> G
+    {0xFF28, {0x0048, 0x0000}}, // Ｈ -> H
+    {0xFF29, {0x0049, 0x0000}}, // Ｉ -> I
+    {0xFF2A, {0x004A, 0x0000}}, // Ｊ -> J
+    {0xFF2B, {0x004B, 0x0000}}, // Ｋ -> K
+    {0xFF2C, {0x004C, 0x0000}}, // Ｌ -> L
+    {0xFF2D, {0x004D, 0x0000}}, // Ｍ -> M
+    {0xFF2E, {0x004E, 0x0000}}, // Ｎ -> N
+    {0xFF2F, {0x004F, 0x0000}}, // Ｏ -> O
+    {0xFF30, {0x0050, 0x0000}}, // Ｐ -> P
+    {0xFF31, {0x0051, 0x0000}}, // Ｑ -> Q
+    {0xFF32, {0x0052, 0x0000}}, // Ｒ -> R
+    {0xFF33, {0x0053, 0x0000}}, // Ｓ -> S
+    {0xFF34, {0x0054, 0x0000}}, // Ｔ -> T
+    {0xFF35, {0x0055, 0x0000}}, // Ｕ -> U
+    {0xFF36, {0x0056, 0x0000}}, // Ｖ -> V
+    {0xFF37, {0x0057, 0x0000}}, // Ｗ -> W
+    {0xFF38, {0x0058, 0x0000}}, // Ｘ -> X
+    {0xFF39, {0x0059, 0x0000}}, // Ｙ -> Y
+    {0xFF3A, {0x005A, 0x0000}}, // Ｚ -> Z
+    {0xFF3B, {0x005B, 0x0000}}, // ［ -> [
+    {0xFF3C, {0x005C, 0x0000}}, // ＼ -> backslash
+    {0xFF3D, {0x005D, 0x0000}}, // ］ -> ]
+    {0xFF3E, {0x005E, 0x0000}}, // ＾ -> ^
+    {0xFF3F, {0x005F, 0x0000}}, // ＿ -> _
+    {0xFF40, {0x0060, 0x0000}}, // ｀ -> `
+    {0xFF41, {0x0061, 0x0000}}, // ａ -> a
+    {0xFF42, {0x0062, 0x0000}}, // ｂ -> b
+    {0xFF43, {0x0063, 0x0000}}, // ｃ -> c
+    {0xFF44, {0x0064, 0x0000}}, // ｄ -> d
+    {0xFF45, {0x0065, 0x0000}}, // ｅ -> e
+    {0xFF46, {0x0066, 0x0000}}, // ｆ -> f
+    {0xFF47, {0x0067, 0x0000}}, // ｇ -> g
+    {0xFF48, {0x0068, 0x0000}}, // ｈ -> h
+    {0xFF49, {0x0069, 0x0000}}, // ｉ -> i
+    {0xFF4A, {0x006A, 0x0000}}, // ｊ -> j
+    {0xFF4B, {0x006B, 0x0000}}, // ｋ -> k
+    {0xFF4C, {0x006C, 0x0000}}, // ｌ -> l
+    {0xFF4D, {0x006D, 0x0000}}, // ｍ -> m
+    {0xFF4E, {0x006E, 0x0000}}, // ｎ -> n
+    {0xFF4F, {0x006F, 0x0000}}, // ｏ -> o
+    {0xFF50, {0x0070, 0x0000}}, // ｐ -> p
+    {0xFF51, {0x0071, 0x0000}}, // ｑ -> q
+    {0xFF52, {0x0072, 0x0000}}, // ｒ -> r
+    {0xFF53, {0x0073, 0x0000}}, // ｓ -> s
+    {0xFF54, {0x0074, 0x0000}}, // ｔ -> t
+    {0xFF55, {0x0075, 0x0000}}, // ｕ -> u
+    {0xFF56, {0x0076, 0x0000}}, // ｖ -> v
+    {0xFF57, {0x0077, 0x0000}}, // ｗ -> w
+    {0xFF58, {0x0078, 0x0000}}, // ｘ -> x
+    {0xFF59, {0x0079, 0x0000}}, // ｙ -> y
+    {0xFF5A, {0x007A, 0x0000}}, // ｚ -> z
+    {0xFF5B, {0x007B, 0x0000}}, // ｛ -> {
+    {0xFF5C, {0x007C, 0x0000}}, // ｜ -> |
+    {0xFF5D, {0x007D, 0x0000}}, // ｝ -> }
+    {0xFF5E, {0x007E, 0x0000}}, // ～ -> ~
+    {0xFF70, {0x002D, 0x0000}}  // ｰ -> -
+};
+
+static const SWidthMap s_HalfToFullWidth[] = {
+    {0x0020, {0x3000, 0x0000}}, // ' ' -> ideographic space
+    {0x0021, {0xFF01, 0x0000}}, // ! -> ！
+    {0x0022, {0xFF02, 0x0000}}, // " -> ＂
+    {0x0023, {0xFF03, 0x0000}}, // # -> ＃
+    {0x0024, {0xFF04, 0x0000}}, // $ -> ＄
+    {0x0025, {0xFF05, 0x0000}}, // % -> ％
+    {0x0026, {0xFF06, 0x0000}}, // & -> ＆
+    {0x0027, {0xFF07, 0x0000}}, // ' -> ＇
+    {0x0028, {0xFF08, 0x0000}}, // ( -> （
+    {0x0029, {0xFF09, 0x0000}}, // ) -> ）
+    {0x002A, {0xFF0A, 0x0000}}, // * -> ＊
+    {0x002B, {0xFF0B, 0x0000}}, // + -> ＋
+    {0x002C, {0xFF0C, 0x0000}}, // , -> ，
+    {0x002D, {0xFF0D, 0x0000}}, // - -> －
+    {0x002E, {0xFF0E, 0x0000}}, // . -> ．
+    {0x002F, {0xFF0F, 0x0000}}, // / -> ／
+    {0x0030, {0xFF10, 0x0000}}, // 0 -> ０
+    {0x0031, {0xFF11, 0x0000}}, // 1 -> １
+    {0x0032, {0xFF12, 0x0000}}, // 2 -> ２
+    {0x0033, {0xFF13, 0x0000}}, // 3 -> ３
+    {0x0034, {0xFF14, 0x0000}}, // 4 -> ４
+    {0x0035, {0xFF15, 0x0000}}, // 5 -> ５
+    {0x0036, {0xFF16, 0x0000}}, // 6 -> ６
+    {0x0037, {0xFF17, 0x0000}}, // 7 -> ７
+    {0x0038, {0xFF18, 0x0000}}, // 8 -> ８
+    {0x0039, {0xFF19, 0x0000}}, // 9 -> ９
+    {0x003A, {0xFF1A, 0x0000}}, // : -> ：
+    {0x003B, {0xFF1B, 0x0000}}, // ; -> ；
+    {0x003C, {0xFF1C, 0x0000}}, // < -> ＜
+    {0x003D, {0xFF1D, 0x0000}}, // = -> ＝
+    {0x003E, {0xFF1E, 0x0000}}, // > -> ＞
+    {0x003F, {0xFF1F, 0x0000}}, // ? -> ？
+    {0x0040, {0xFF20, 0x0000}}, // @ -> ＠
+    {0x0041, {0xFF21, 0x0000}}, // A -> Ａ
+    {0x0042, {0xFF22, 0x0000}}, // B -> Ｂ
+    {0x0043, {0xFF23, 0x0000}}, // C -> Ｃ
+    {0x0044, {0xFF24, 0x0000}}, // D -> Ｄ
+    {0x0045, {0xFF25, 0x0000}}, // E -> Ｅ
+    {0x0046, {0xFF26, 0x0000}}, // F -> Ｆ
+    {0x0047, {0xFF27, 0x0000}}, // G -> Ｇ
+    {0x0048, {0xFF28, 0x0000}}, // H -> Ｈ
+    {0x0049, {0xFF29, 0x0000}}, // I -> Ｉ
+    {0x004A, {0xFF2A, 0x0000}}, // J -> Ｊ
+    {0x004B, {0xFF2B, 0x0000}}, // K -> Ｋ
+    {0x004C, {0xFF2C, 0x0000}}, // L -> Ｌ
+    {0x004D, {0xFF2D, 0x0000}}, // M -> Ｍ
+    {0x004E, {0xFF2E, 0x0000}}, // N -> Ｎ
+    {0x004F, {0xFF2F, 0x0000}}, // O -> Ｏ
+    {0x0050, {0xFF30, 0x0000}}, // P -> Ｐ
+    {0x0051, {0xFF31, 0x0000}}, // Q -> Ｑ
+    {0x0052, {0xFF32, 0x0000}}, // R -> Ｒ
+    {0x0053, {0xFF33, 0x0000}}, // S -> Ｓ
+    {0x0054, {0xFF34, 0x0000}}, // T -> Ｔ
+    {0x0055, {0xFF35, 0x0000}}, // U -> Ｕ
+    {0x0056, {0xFF36, 0x0000}}, // V -> Ｖ
+    {0x0057, {0xFF37, 0x0000}}, // W -> Ｗ
+    {0x0058, {0xFF38, 0x0000}}, // X -> Ｘ
+    {0x0059, {0xFF39, 0x0000}}, // Y -> Ｙ
+    {0x005A, {0xFF3A, 0x0000}}, // Z -> Ｚ
+    {0x005B, {0xFF3B, 0x0000}}, // [ -> ［
+    {0x005C, {0xFF3C, 0x0000}}, // backslash -> ＼
+    {0x005D, {0xFF3D, 0x0000}}, // ] -> ］
+    {0x005E, {0xFF3E, 0x0000}}, // ^ -> ＾
+    {0x005F, {0xFF3F, 0x0000}}, // _ -> ＿
+    {0x0060, {0xFF40, 0x0000}}, // ` -> ｀
+    {0x0061, {0xFF41, 0x0000}}, // a -> ａ
+    {0x0062, {0xFF42, 0x0000}}, // b -> ｂ
+    {0x0063, {0xFF43, 0x0000}}, // c -> ｃ
+    {0x0064, {0xFF44, 0x0000}}, // d -> ｄ
+    {0x0065, {0xFF45, 0x0000}}, // e -> ｅ
+    {0x0066, {0xFF46, 0x0000}}, // f -> ｆ
+    {0x0067, {0xFF47, 0x0000}}, // g -> ｇ
+    {0x0068, {0xFF48, 0x0000}}, // h -> ｈ
+    {0x0069, {0xFF49, 0x0000}}, // i -> ｉ
+    {0x006A, {0xFF4A, 0x0000}}, // j -> ｊ
+    {0x006B, {0xFF4B, 0x0000}}, // k -> ｋ
+    {0x006C, {0xFF4C, 0x0000}}, // l -> ｌ
+    {0x006D, {0xFF4D, 0x0000}}, // m -> ｍ
+    {0x006E, {0xFF4E, 0x0000}}, // n -> ｎ
+    {0x006F, {0xFF4F, 0x0000}}, // o -> ｏ
+    {0x0070, {0xFF50, 0x0000}}, // p -> ｐ
+    {0x0071, {0xFF51, 0x0000}}, // q -> ｑ
+    {0x0072, {0xFF52, 0x0000}}, // r -> ｒ
+    {0x0073, {0xFF53, 0x0000}}, // s -> ｓ
+    {0x0074, {0xFF54, 0x0000}}, // t -> ｔ
+    {0x0075, {0xFF55, 0x0000}}, // u -> ｕ
+    {0x0076, {0xFF56, 0x0000}}, // v -> ｖ
+    {0x0077, {0xFF57, 0x0000}}, // w -> ｗ
+    {0x0078, {0xFF58, 0x0000}}, // x -> ｘ
+    {0x0079, {0xFF59, 0x0000}}, // y -> ｙ
+    {0x007A, {0xFF5A, 0x0000}}, // z -> ｚ
+    {0x007B, {0xFF5B, 0x0000}}, // { -> ｛
+    {0x007C, {0xFF5C, 0x0000}}, // | -> ｜
+    {0x007D, {0xFF5D, 0x0000}}, // } -> ｝
+    {0x007E, {0xFF5E, 0x0000}}, // ~ -> ～
+    {0x30EE, {0x30EE, 0x0000}}, // ヮ -> ヮ
+    {0x30F0, {0x30F0, 0x0000}}, // ヰ -> ヰ
+    {0x30F1, {0x30F1, 0x0000}}, // ヱ -> ヱ
+    {0x30F5, {0x30F5, 0x0000}}, // ヵ -> ヵ
+    {0x30F6, {0x30F6, 0x0000}}, // ヶ -> ヶ
+    {0x30FD, {0x30FD, 0x0000}}, // ヽ -> ヽ
+    {0x30FE, {0x30FE, 0x0000}}, // ヾ -> ヾ
+    {0xFF61, {0x3002, 0x0000}}, // ｡ -> 。
+    {0xFF62, {0x300C, 0x0000}}, // ｢ -> 「
+    {0xFF63, {0x300D, 0x0000}}, // ｣ -> 」
+    {0xFF64, {0x3001, 0x0000}}, // ､ -> 、
+    {0xFF65, {0x30FB, 0x0000}}, // ･ -> ・
+    {0xFF66, {0x30F2, 0x0000}}, // ｦ -> ヲ
+    {0xFF67, {0x30A1, 0x0000}}, // ｧ -> ァ
+    {0xFF68, {0x30A3, 0x0000}}, // ｨ -> ィ
+    {0xFF69, {0x30A5, 0x0000}}, // ｩ -> ゥ
+    {0xFF6A, {0x30A7, 0x0000}}, // ｪ -> ェ
+    {0xFF6B, {0x30A9, 0x0000}}, // ｫ -> ォ
+    {0xFF6C, {0x30E3, 0x0000}}, // ｬ -> ャ
+    {0xFF6D, {0x30E5, 0x0000}}, // ｭ -> ュ
+    {0xFF6E, {0x30E7, 0x0000}}, // ｮ -> ョ
+    {0xFF6F, {0x30C3, 0x0000}}, // ｯ -> ッ
+    {0xFF70, {0x30FC, 0x0000}}, // ｰ -> ー
+    {0xFF71, {0x30A2, 0x0000}}, // ｱ -> ア
+    {0xFF72, {0x30A4, 0x0000}}, // ｲ -> イ
+    {0xFF73, {0x30A6, 0x0000}}, // ｳ -> ウ
+    {0xFF74, {0x30A8, 0x0000}}, // ｴ -> エ
+    {0xFF75, {0x30AA, 0x0000}}, // ｵ -> オ
+    {0xFF76, {0x30AB, 0x0000}}, // ｶ -> カ
+    {0xFF77, {0x30AD, 0x0000}}, // ｷ -> キ
+    {0xFF78, {0x30AF, 0x0000}}, // ｸ -> ク
+    {0xFF79, {0x30B1, 0x0000}}, // ｹ -> ケ
+    {0xFF7A, {0x30B3, 0x0000}}, // ｺ -> コ
+    {0xFF7B, {0x30B5, 0x0000}}, // ｻ -> サ
+    {0xFF7C, {0x30B7, 0x0000}}, // ｼ -> シ
+    {0xFF7D, {0x30B9, 0x0000}}, // ｽ -> ス
+    {0xFF7E, {0x30BB, 0x0000}}, // ｾ -> セ
+    {0xFF7F, {0x30BD, 0x0000}}, // ｿ -> ソ
+    {0xFF80, {0x30BF, 0x0000}}, // ﾀ -> タ
+    {0xFF81, {0x30C1, 0x0000}}, // ﾁ -> チ
+    {0xFF82, {0x30C4, 0x0000}}, // ﾂ -> ツ
+    {0xFF83, {0x30C6, 0x0000}}, // ﾃ -> テ
+    {0xFF84, {0x30C8, 0x0000}}, // ﾄ -> ト
+    {0xFF85, {0x30CA, 0x0000}}, // ﾅ -> ナ
+    {0xFF86, {0x30CB, 0x0000}}, // ﾆ -> ニ
+    {0xFF87, {0x30CC, 0x0000}}, // ﾇ -> ヌ
+    {0xFF88, {0x30CD, 0x0000}}, // ﾈ -> ネ
+    {0xFF89, {0x30CE, 0x0000}}, // ﾉ -> ノ
+    {0xFF8A, {0x30CF, 0x0000}}, // ﾊ -> ハ
+    {0xFF8B, {0x30D2, 0x0000}}, // ﾋ -> ヒ
+    {0xFF8C, {0x30D5, 0x0000}}, // ﾌ -> フ
+    {0xFF8D, {0x30D8, 0x0000}}, // ﾍ -> ヘ
+    {0xFF8E, {0x30DB, 0x0000}}, // ﾎ -> ホ
+    {0xFF8F, {0x30DE, 0x0000}}, // ﾏ -> マ
+    {0xFF90, {0x30DF, 0x0000}}, // ﾐ -> ミ
+    {0xFF91, {0x30E0, 0x0000}}, // ﾑ -> ム
+    {0xFF92, {0x30E1, 0x0000}}, // ﾒ -> メ
+    {0xFF93, {0x30E2, 0x0000}}, // ﾓ -> モ
+    {0xFF94, {0x30E4, 0x0000}}, // ﾔ -> ヤ
+    {0xFF95, {0x30E6, 0x0000}}, // ﾕ -> ユ
+    {0xFF96, {0x30E8, 0x0000}}, // ﾖ -> ヨ
+    {0xFF97, {0x30E9, 0x0000}}, // ﾗ -> ラ
+    {0xFF98, {0x30EA, 0x0000}}, // ﾘ -> リ
+    {0xFF99, {0x30EB, 0x0000}}, // ﾙ -> ル
+    {0xFF9A, {0x30EC, 0x0000}}, // ﾚ -> レ
+    {0xFF9B, {0x30ED, 0x0000}}, // ﾛ -> ロ
+    {0xFF9C, {0x30EF, 0x0000}}, // ﾜ -> ワ
+    {0xFF9D, {0x30F3, 0x0000}}  // ﾝ -> ン
 };
 
-const static QMap<QString, QString> s_HalfToFullWidth = {
-    {"!", "！"},
-    {"\"", "＂"},
-    {"#", "＃"},
-    {"$", "＄"},
-    {"%", "％"},
-    {"&", "＆"}, 
-    {"'", "＇"},
-    {"(", "（"},
-    {")", "）"},
-    {"*", "＊"},
-    {"+", "＋"},
-    {",", "，"},
-    {"-", "－"},
-    {".", "．"},
-    {"/", "／"},
-    {":", "："},
-    {";", "；"},
-    {"<", "＜"},
-    {"=", "＝"},
-    {">", "＞"},
-    {"?", "？"},
-    {"@", "＠"},
-    {"A", "Ａ"},
-    {"B", "Ｂ"},
-    {"C", "Ｃ"},
-    {"D", "Ｄ"},
-    {"E", "Ｅ"},
-    {"F", "Ｆ"},
-    {"G", "Ｇ"},
-    {"H", "Ｈ"},
-    {"I", "Ｉ"},
-    {"J", "Ｊ"},
-    {"K", "Ｋ"},
-    {"L", "Ｌ"},
-    {"M", "Ｍ"},
-    {"N", "Ｎ"},
-    {"O", "Ｏ"},
-    {"P", "Ｐ"},
-    {"Q", "Ｑ"},
-    {"R", "Ｒ"},
-    {"S", "Ｓ"},
-    {"T", "Ｔ"},
-    {"U", "Ｕ"},
-    {"V", "Ｖ"},
-    {"W", "Ｗ"},
-    {"X", "Ｘ"},
-    {"Y", "Ｙ"},
-    {"Z", "Ｚ"},
-    {"[", "［"},
-    {"\\", "＼"},
-    {"]", "］"},
-    {"^", "＾"},
-    {"_", "＿"},
-    {"`", "｀"},
-    {"a", "ａ"},
-    {"b", "ｂ"},
-    {"c", "ｃ"},
-    {"d", "ｄ"},
-    {"e", "ｅ"},
-    {"f", "ｆ"},
-    {"g", "ｇ"},
-    {"h", "ｈ"},
-    {"i", "ｉ"},
-    {"j", "ｊ"},
-    {"k", "ｋ"},
-    {"l", "ｌ"},
-    {"m", "ｍ"},
-    {"n", "ｎ"},
-    {"o", "ｏ"},
-    {"p", "ｐ"},
-    {"q", "ｑ"},
-    {"r", "ｒ"},
-    {"s", "ｓ"},
-    {"t", "ｔ"},
-    {"u", "ｕ"},
-    {"v", "ｖ"},
-    {"w", "ｗ"},
-    {"x", "ｘ"},
-    {"y", "ｙ"},
-    {"z", "ｚ"},
-    {"{", "｛"},
-    {"|", "｜"},
-    {"}", "｝"},
-    {"~", "～"},
-    {" ", "\u3000"},
-    {"0", "０"},
-    {"1", "１"},
-    {"2", "２"},
-    {"3", "３"},
-    {"4", "４"},
-    {"5", "５"},
-    {"6", "６"},
-    {"7", "７"},
-    {"8", "８"},
-    {"9", "９"},
-    {"ｧ", "ァ"},
-    {"ｱ", "ア"},
-    {"ｨ", "ィ"},
-    {"ｲ", "イ"},
-    {"ｩ", "ゥ"},
-    {"ｳ", "ウ"},
-    {"ｪ", "ェ"},
-    {"ｴ", "エ"},
-    {"ｫ", "ォ"},
-    {"ｵ", "オ"},
-    {"ｶ", "カ"},
-    {"ｶﾞ", "ガ"},
-    {"ｷ", "キ"},
-    {"ｷﾞ", "ギ"},
-    {"ｸ", "ク"},
-    {"ｸﾞ", "グ"},
-    {"ｹ", "ケ"},
-    {"ｹﾞ", "ゲ"},
-    {"ｺ", "コ"},
-    {"ｺﾞ", "ゴ"},
-    {"ｻ", "サ"},
-    {"ｻﾞ", "ザ"},
-    {"ｼ", "シ"},
-    {"ｼﾞ", "ジ"},
-    {"ｽ", "ス"},
-    {"ｽﾞ", "ズ"},
-    {"ｾ", "セ"},
-    {"ｾﾞ", "ゼ"},
-    {"ｿ", "ソ"},
-    {"ｿﾞ", "ゾ"},
-    {"ﾀ", "タ"},
-    {"ﾀﾞ", "ダ"},
-    {"ﾁ", "チ"},
-    {"ﾁﾞ", "ヂ"},
-    {"ｯ", "ッ"},
-    {"ﾂ", "ツ"},
-    {"ﾂﾞ", "ヅ"},
-    {"ﾃ", "テ"},
-    {"ﾃﾞ", "デ"},
-    {"ﾄ", "ト"},
-    {"ﾄﾞ", "ド"},
-    {"ﾅ", "ナ"},
-    {"ﾆ", "ニ"},
-    {"ﾇ", "ヌ"},
-    {"ﾈ", "ネ"},
-    {"ﾉ", "ノ"},
-    {"ﾊ", "ハ"},
-    {"ﾊﾞ", "バ"},
-    {"ﾊﾟ", "パ"},
-    {"ﾋ", "ヒ"},
-    {"ﾋﾞ", "ビ"},
-    {"ﾋﾟ", "ピ"},
-    {"ﾌ", "フ"},
-    {"ﾌﾞ", "ブ"},
-    {"ﾌﾟ", "プ"},
-    {"ﾍ", "ヘ"},
-    {"ﾍﾞ", "ベ"},
-    {"ﾍﾟ", "ペ"},
-    {"ﾎ", "ホ"},
-    {"ﾎﾞ", "ボ"},
-    {"ﾎﾟ", "ポ"},
-    {"ﾏ", "マ"},
-    {"ﾐ", "ミ"},
-    {"ﾑ", "ム"},
-    {"ﾒ", "メ"},
-    {"ﾓ", "モ"},
-    {"ｬ", "ャ"},
-    {"ﾔ", "ヤ"},
-    {"ｭ", "ュ"},
-    {"ﾕ", "ユ"},
-    {"ｮ", "ョ"},
-    {"ﾖ", "ヨ"},
-    {"ﾗ", "ラ"},
-    {"ﾘ", "リ"},
-    {"ﾙ", "ル"},
-    {"ﾚ", "レ"},
-    {"ﾛ", "ロ"},
-    {"ﾜ", "ワ"},
-    {"ｦ", "ヲ"},
-    {"ﾝ", "ン"},
-    {"ｰ", "ー"},
-    {"ヮ", "ヮ"},
-    {"ヰ", "ヰ"},
-    {"ヱ", "ヱ"},
-    {"ヵ", "ヵ"},
-    {"ヶ", "ヶ"},
-    {"ｳﾞ", "ヴ"},
-    {"ヽ", "ヽ"},
-    {"ヾ", "ヾ"},
-    {"･", "・"},
-    {"｢", "「"},
-    {"｣", "」"},
-    {"｡", "。"},
-    {"､", "、"}
+static const uint16_t s_HalfWidthChars[] = {
+    0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+    0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F,
+    0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+    0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F,
+    0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+    0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+    0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+    0x0058, 0x0059, 0x005A, 0x005B, 0x005C, 0x005D, 0x005E, 0x005F,
+    0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+    0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F,
+    0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+    0x0078, 0x0079, 0x007A, 0x007B, 0x007C, 0x007D, 0x007E, 0x30EE,
+    0x30F0, 0x30F1, 0x30F5, 0x30F6, 0x30FD, 0x30FE, 0xFF61, 0xFF62,
+    0xFF63, 0xFF64, 0xFF65, 0xFF66, 0xFF67, 0xFF68, 0xFF69, 0xFF6A,
+    0xFF6B, 0xFF6C, 0xFF6D, 0xFF6E, 0xFF6F, 0xFF71, 0xFF72, 0xFF73,
+    0xFF74, 0xFF75, 0xFF76, 0xFF77, 0xFF78, 0xFF79, 0xFF7A, 0xFF7B,
+    0xFF7C, 0xFF7D, 0xFF7E, 0xFF7F, 0xFF80, 0xFF81, 0xFF82, 0xFF83,
+    0xFF84, 0xFF85, 0xFF86, 0xFF87, 0xFF88, 0xFF89, 0xFF8A, 0xFF8B,
+    0xFF8C, 0xFF8D, 0xFF8E, 0xFF8F, 0xFF90, 0xFF91, 0xFF92, 0xFF93,
+    0xFF94, 0xFF95, 0xFF96, 0xFF97, 0xFF98, 0xFF99, 0xFF9A, 0xFF9B,
+    0xFF9C, 0xFF9D
 };
 
-const static QString s_HandakutenPossible = "はひふへほハヒフヘホ";
-const static QString s_DakutenPossible = "かきくけこさしすせそたちつてとカキクケコサシスセソタチツテト" + s_HandakutenPossible;
-const static QString s_MultiByteChars = "ガギグゲゴザジズゼゾダヂヅデドバパビピブプベペボポヮヰヱヵヶヴヽヾがぎぐげござじずぜぞだぢづでどばぱびぴぶぷべぺぼぽゎゐゑゕゖゔゝゞ";
+static const uint16_t s_DakutenPossible[] = {
+    0x304B, 0x304D, 0x304F, 0x3051, 0x3053, 0x3055, 0x3057, 0x3059,
+    0x305B, 0x305D, 0x305F, 0x3061, 0x3064, 0x3066, 0x3068, 0x306F,
+    0x3072, 0x3075, 0x3078, 0x307B, 0x30AB, 0x30AD, 0x30AF, 0x30B1,
+    0x30B3, 0x30B5, 0x30B7, 0x30B9, 0x30BB, 0x30BD, 0x30BF, 0x30C1,
+    0x30C4, 0x30C6, 0x30C8, 0x30CF, 0x30D2, 0x30D5, 0x30D8, 0x30DB
+};
+
+static const uint16_t s_HandakutenPossible[] = {
+    0x306F, 0x3072, 0x3075, 0x3078, 0x307B, 0x30CF, 0x30D2, 0x30D5,
+    0x30D8, 0x30DB
+};
+
+static const uint16_t s_MultiByteChars[] = {
+    0x304C, 0x304E, 0x3050, 0x3052, 0x3054, 0x3056, 0x3058, 0x305A,
+    0x305C, 0x305E, 0x3060, 0x3062, 0x3065, 0x3067, 0x3069, 0x3070,
+    0x3071, 0x3073, 0x3074, 0x3076, 0x3077, 0x3079, 0x307A, 0x307C,
+    0x307D, 0x308E, 0x3090, 0x3091, 0x3094, 0x3095, 0x3096, 0x309D,
+    0x309E, 0x30AC, 0x30AE, 0x30B0, 0x30B2, 0x30B4, 0x30B6, 0x30B8,
+    0x30BA, 0x30BC, 0x30BE, 0x30C0, 0x30C2, 0x30C5, 0x30C7, 0x30C9,
+    0x30D0, 0x30D1, 0x30D3, 0x30D4, 0x30D6, 0x30D7, 0x30D9, 0x30DA,
+    0x30DC, 0x30DD, 0x30EE, 0x30F0, 0x30F1, 0x30F4, 0x30F5, 0x30F6,
+    0x30FD, 0x30FE
+};
+
+//------------------------------------------------------------------------------
+//! @brief      find mapping for code unit
+//!
+//! @param[in]  tab   sorted mapping table
+//! @param[in]  c     code unit
+//!
+//! @return     mapping; nullptr if not found
+//------------------------------------------------------------------------------
+template <size_t N>
+static const SWidthMap* findMapping(const SWidthMap (&tab)[N], uint16_t c)
+{
+    const SWidthMap* p = std::lower_bound(tab, tab + N, c,
+                                          [](const SWidthMap& m, uint16_t k) { return m.mKey < k; });
+    return ((p != (tab + N)) && (p->mKey == c)) ? p : nullptr;
+}
+
+//------------------------------------------------------------------------------
+//! @brief      is code unit in set
+//!
+//! @param[in]  tab   sorted code unit table
+//! @param[in]  c     code unit
+//!
+//! @return     true if so
+//------------------------------------------------------------------------------
+template <size_t N>
+static bool inSet(const uint16_t (&tab)[N], uint16_t c)
+{
+    return std::binary_search(tab, tab + N, c);
+}
+
+//------------------------------------------------------------------------------
+//! @brief      append mapped code units
+//!
+//! @param      out   The output string
+//! @param[in]  p     The mapping
+//------------------------------------------------------------------------------
+static void appendMapping(QString& out, const SWidthMap* p)
+{
+    out += QChar(p->mVal[0]);
+
+    if (p->mVal[1] != 0)
+    {
+        out += QChar(p->mVal[1]);
+    }
+}
+
+//------------------------------------------------------------------------------
+//! @brief      Shift_JIS codec (looked up once)
+//!
+//! @return     codec; nullptr if not available
+//------------------------------------------------------------------------------
+static QTextCodec* shiftJisCodec()
+{
+    static QTextCodec* pCodec = QTextCodec::codecForName("Shift_JIS");
+    return pCodec;
+}
 
 size_t getHalfWidthTitleLength(const QString& title)
 {
-    size_t      length   = title.size();
-    QStringList uniChars = unicodeSplit(title);
-    for (const auto& uc : uniChars)
+    size_t length = title.size();
+
+    for (const auto& c : title)
     {
-        if (s_MultiByteChars.contains(uc))
+        if (inSet(s_MultiByteChars, c.unicode()))
         {
             length ++;
         }
@@ -519,32 +606,27 @@ size_t getHalfWidthTitleLength(const QString& title)
 QString sanitizeFullWidthTitle(const QString &title, bool justRemap)
 {
     QString out;
+    out.reserve(title.size());
 
-    QStringList vals     = s_HalfToFullWidth.values();
-    QStringList uniChars = unicodeSplit(title);
-
-    for (const auto& uc : uniChars)
+    for (const auto& c : title)
     {
-        if (s_HalfToFullWidth.contains(uc))
+        if (const SWidthMap* p = findMapping(s_HalfToFullWidth, c.unicode()))
         {
-            out += s_HalfToFullWidth.value(uc);
+            appendMapping(out, p);
         }
         else
         {
-            out += uc;
+            out += c;
         }
     }
 
     if (justRemap) return out;
 
-    QTextCodec *pCodec = QTextCodec::codecForName("Shift_JIS");
-    QTextEncoder *pEnc = pCodec->makeEncoder();
-    QTextDecoder *pDec = pCodec->makeDecoder();
-    if (pEnc && pDec)
+    if (QTextCodec *pCodec = shiftJisCodec())
     {
-        QByteArray ba = pEnc->fromUnicode(out);
+        QByteArray ba = pCodec->fromUnicode(out);
 
-        if (out != pDec->toUnicode(ba))
+        if (out != pCodec->toUnicode(ba))
         {
             qDebug() << "Encode <-> decode test doesn't match -> fallback!";
             out = title;
@@ -557,15 +639,6 @@ QString sanitizeFullWidthTitle(const QString &title, bool justRemap)
         }
     }
 
-    if (pEnc)
-    {
-        delete pEnc;
-    }
-
-    if (pDec)
-    {
-        delete pDec;
-    }
     return out;
 }
 
@@ -591,7 +664,7 @@ QString sanitizeHalfWidthTitle(const QString& title)
         switch(type)
         {
         case CharType::dakuten:
-            if (s_DakutenPossible.contains(c))
+            if (inSet(s_DakutenPossible, c.unicode()))
             {
                 dakutenFix += QChar(c.cell() + 1);
                 type = CharType::normal;
@@ -599,7 +672,7 @@ QString sanitizeHalfWidthTitle(const QString& title)
             }
             // fall through
         case CharType::handakuten:
-            if (s_HandakutenPossible.contains(c))
+            if (inSet(s_HandakutenPossible, c.unicode()))
             {
                 dakutenFix += QChar(c.cell() + 2);
                 type = CharType::normal;
@@ -632,52 +705,41 @@ QString sanitizeHalfWidthTitle(const QString& title)
     // reverse dakutenfix
     std::reverse(dakutenFix.begin(), dakutenFix.end());
 
-    QStringList hwVals = s_FullToHalfWidth.values();
     dakutenFix = dakutenFix.normalized(QString::NormalizationForm_D);
+    tmpTitle.clear();
+    tmpTitle.reserve(dakutenFix.size() * 2);
 
-    for (uint16_t i = 0x0300; i <= 0x036f; i++)
+    for (const auto& c : dakutenFix)
     {
-        dakutenFix.replace(QChar(i), "");
-    }
-    tmpTitle = "";
+        uint16_t uc = c.unicode();
 
-    QStringList uniChars = unicodeSplit(dakutenFix);
-
-    for (const auto& uc : uniChars)
-    {
-        if (s_FullToHalfWidth.contains(uc))
+        if ((uc >= 0x0300) && (uc <= 0x036f))
         {
-            tmpTitle += s_FullToHalfWidth.value(uc);
+            // drop combining diacritical marks
+            continue;
         }
-        else if (hwVals.contains(uc) || (uc[0].cell() < 0x7f))
+        else if (const SWidthMap* p = findMapping(s_FullToHalfWidth, uc))
         {
-            tmpTitle += uc;
+            appendMapping(tmpTitle, p);
+        }
+        else if (inSet(s_HalfWidthChars, uc) || (c.cell() < 0x7f))
+        {
+            tmpTitle += c;
         }
         else
         {
-            qDebug() << "Replace" << uc.unicode() << "with space!";
+            qDebug() << "Replace" << uc << "with space!";
             tmpTitle += QChar(' ');
         }
     }
 
-    QTextCodec *pCodec = QTextCodec::codecForName("Shift_JIS");
-    QTextEncoder *pEnc = pCodec->makeEncoder();
-    if (pEnc)
+    if (QTextCodec *pCodec = shiftJisCodec())
     {
-        if (static_cast<size_t>(pEnc->fromUnicode(tmpTitle).size()) != getHalfWidthTitleLength(title))
+        if (static_cast<size_t>(pCodec->fromUnicode(tmpTitle).size()) != getHalfWidthTitleLength(title))
         {
             qDebug() << "Encoded size doesn't match -> fallback!";
             tmpTitle = title;
         }
-        delete pEnc;
     }
     return tmpTitle;
 }
-
-QStringList unicodeSplit(const QString &src)
-{
-    QStringList ret = src.split(QString());
-    ret.removeFirst();
-    ret.removeLast();
-    return ret;
-}
@@ -43,12 +43,3 @@ QString sanitizeFullWidthTitle(const QString& title, bool justRemap = true);
 //! @return     The checked / fixed string.
 //------------------------------------------------------------------------------
 QString sanitizeHalfWidthTitle(const QString& title);
-
-//------------------------------------------------------------------------------
-//! @brief      split string into unicode tokens
-//!
-//! @param[in]  src   The source string
-//!
-//! @return     string list with unicode tokens
-//------------------------------------------------------------------------------
-QStringList unicodeSplit(const QString& src);
@@ -25,6 +25,7 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include <QFileDialog>
+#include <QThread>
 #include "defines.h"
 
 const int SettingsDlg::READ_SPEEDS[] = {1, 2, 4, 8, 12, 16};
@@ -45,6 +46,7 @@ SettingsDlg::~SettingsDlg()
     set.setValue("loglevel", ui->cbxLogLevel->currentIndex());
     set.setValue("paranoia", ui->checkParanoia->isChecked());
     set.setValue("otf", ui->checkOTFEnc->isChecked());
+    set.setValue("auto_placement", ui->checkAutoPlace->isChecked());
     set.setValue("sp_title", ui->checkSPTitle->isChecked());
     set.setValue("lp_group", ui->checkLPGroup->isChecked());
     set.setValue("cddb", ui->checkCDDB->isChecked());
@@ -52,6 +54,12 @@ SettingsDlg::~SettingsDlg()
     set.setValue("dev_reset", ui->checkDevReset->isChecked());
     set.setValue("read_speed", ui->comboReadSpeed->currentIndex());
     set.setValue("no_artist_title", ui->checkNoArtist->isChecked());
+    set.setValue("pre_encode", ui->checkPreEnc->isChecked());
+    set.setValue("pre_encode_budget", ui->spinPreEncBudget->value());
+    set.setValue("artifact_cache", ui->checkCache->isChecked());
+    set.setValue("artifact_cache_budget", ui->spinCacheBudget->value());
+    set.setValue("decoder_count", ui->spinDecoders->value());
+    set.setValue("utoc_scan", ui->checkUtocScan->isChecked());
     delete ui;
 }
 
@@ -87,6 +95,18 @@ void SettingsDlg::enaDisaOtf(bool check, bool ena)
 {
     ui->checkOTFEnc->setChecked(check);
     ui->checkOTFEnc->setEnabled(ena);
+    ui->checkAutoPlace->setEnabled(ena);
+}
+
+//--------------------------------------------------------------------------
+//! @brief      let the placement policy choose between host encoder
+//!             and on-the-fly encoding (only if device supports OTF)
+//!
+//! @return     true if enabled
+//--------------------------------------------------------------------------
+bool SettingsDlg::autoPlacement() const
+{
+    return ui->checkAutoPlace->isChecked() && ui->checkAutoPlace->isEnabled();
 }
 
 //--------------------------------------------------------------------------
@@ -192,6 +212,66 @@ bool SettingsDlg::noArtistInTitle() const
     return ui->checkNoArtist->isChecked();
 }
 
+//--------------------------------------------------------------------------
+//! @brief      rip / encode in background as soon as source is loaded
+//!
+//! @return     true if enabled
+//--------------------------------------------------------------------------
+bool SettingsDlg::preEncode() const
+{
+    return ui->checkPreEnc->isChecked();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disk space which can be used by background preparation
+//!
+//! @return     budget in bytes
+//--------------------------------------------------------------------------
+qint64 SettingsDlg::preEncodeBudget() const
+{
+    return static_cast<qint64>(ui->spinPreEncBudget->value()) * 1024 * 1024;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      keep ripped / encoded tracks for later transfers
+//!
+//! @return     true if enabled
+//--------------------------------------------------------------------------
+bool SettingsDlg::artifactCache() const
+{
+    return ui->checkCache->isChecked();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      disk space which can be used by the track cache
+//!
+//! @return     budget in bytes
+//--------------------------------------------------------------------------
+qint64 SettingsDlg::artifactCacheBudget() const
+{
+    return static_cast<qint64>(ui->spinCacheBudget->value()) * 1024 * 1024;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      number of parallel decoders for file / cue sources
+//!
+//! @return     decoder count
+//--------------------------------------------------------------------------
+int SettingsDlg::decoderCount() const
+{
+    return ui->spinDecoders->value();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      read track data from UTOC on disc load
+//!
+//! @return     true if enabled
+//--------------------------------------------------------------------------
+bool SettingsDlg::utocScan() const
+{
+    return ui->checkUtocScan->isChecked();
+}
+
 void SettingsDlg::on_comboBox_currentIndexChanged(int index)
 {
     QFile styleFile;
@@ -248,6 +328,11 @@ void SettingsDlg::loadSettings()
         ui->checkOTFEnc->setChecked(set.value("otf").toBool());
     }
 
+    if (set.contains("auto_placement"))
+    {
+        ui->checkAutoPlace->setChecked(set.value("auto_placement").toBool());
+    }
+
     if (set.contains("dev_reset"))
     {
         ui->checkDevReset->setChecked(set.value("dev_reset").toBool());
@@ -314,6 +399,40 @@ void SettingsDlg::loadSettings()
         ui->checkNoArtist->setChecked(false);
     }
 
+    if (set.contains("pre_encode"))
+    {
+        ui->checkPreEnc->setChecked(set.value("pre_encode").toBool());
+    }
+
+    if (set.contains("pre_encode_budget"))
+    {
+        ui->spinPreEncBudget->setValue(set.value("pre_encode_budget").toInt());
+    }
+
+    if (set.contains("artifact_cache"))
+    {
+        ui->checkCache->setChecked(set.value("artifact_cache").toBool());
+    }
+
+    if (set.contains("artifact_cache_budget"))
+    {
+        ui->spinCacheBudget->setValue(set.value("artifact_cache_budget").toInt());
+    }
+
+    if (set.contains("decoder_count"))
+    {
+        ui->spinDecoders->setValue(set.value("decoder_count").toInt());
+    }
+    else
+    {
+        ui->spinDecoders->setValue(qBound(1, QThread::idealThreadCount() / 2, 4));
+    }
+
+    if (set.contains("utoc_scan"))
+    {
+        ui->checkUtocScan->setChecked(set.value("utoc_scan").toBool());
+    }
+
     emit loadingComplete();
 }
 
@@ -86,6 +86,14 @@ public:
     //--------------------------------------------------------------------------
     void enaDisaOtf(bool check, bool ena);
 
+    //--------------------------------------------------------------------------
+    //! @brief      let the placement policy choose between host encoder
+    //!             and on-the-fly encoding (only if device supports OTF)
+    //!
+    //! @return     true if enabled
+    //--------------------------------------------------------------------------
+    bool autoPlacement() const;
+
     //--------------------------------------------------------------------------
     //! @brief      set / enable / diable device reset checkbox
     //!
@@ -159,6 +167,48 @@ public:
     //--------------------------------------------------------------------------
     bool noArtistInTitle() const;
 
+    //--------------------------------------------------------------------------
+    //! @brief      rip / encode in background as soon as source is loaded
+    //!
+    //! @return     true if enabled
+    //--------------------------------------------------------------------------
+    bool preEncode() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      disk space which can be used by background preparation
+    //!
+    //! @return     budget in bytes
+    //--------------------------------------------------------------------------
+    qint64 preEncodeBudget() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      keep ripped / encoded tracks for later transfers
+    //!
+    //! @return     true if enabled
+    //--------------------------------------------------------------------------
+    bool artifactCache() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      disk space which can be used by the track cache
+    //!
+    //! @return     budget in bytes
+    //--------------------------------------------------------------------------
+    qint64 artifactCacheBudget() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      number of parallel decoders for file / cue sources
+    //!
+    //! @return     decoder count
+    //--------------------------------------------------------------------------
+    int decoderCount() const;
+
+    //--------------------------------------------------------------------------
+    //! @brief      read track data from UTOC on disc load
+    //!
+    //! @return     true if enabled
+    //--------------------------------------------------------------------------
+    bool utocScan() const;
+
 private slots:
     //--------------------------------------------------------------------------
     //! @brief      get path to at3tool
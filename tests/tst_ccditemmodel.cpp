@@ -0,0 +1,206 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include <QtTest>
+#include <QTableView>
+#include <QScrollBar>
+#include "ccditemmodel.h"
+
+/// rows of a big file drop
+static constexpr int ROWS = 10000;
+
+/// files probed between two model updates
+static constexpr int PROBE_BATCH = 100;
+
+//------------------------------------------------------------------------------
+//! @brief      tests and benchmarks of the source list model with many rows
+//------------------------------------------------------------------------------
+class TestCDItemModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void lazyRows();
+    void appendBatches();
+    void singleRowEdit();
+    void benchAppend();
+    void benchData();
+    void benchScroll();
+
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      create file tracks
+    //!
+    //! @param[in]  first  number of first track
+    //! @param[in]  count  number of tracks
+    //!
+    //! @return     tracks
+    //--------------------------------------------------------------------------
+    static c2n::AudioTracks fileTracks(int first, int count);
+};
+
+//--------------------------------------------------------------------------
+//! @brief      create file tracks
+//!
+//! @param[in]  first  number of first track
+//! @param[in]  count  number of tracks
+//!
+//! @return     tracks
+//--------------------------------------------------------------------------
+c2n::AudioTracks TestCDItemModel::fileTracks(int first, int count)
+{
+    c2n::AudioTracks tracks;
+    QDateTime tstamp(QDate(2025, 11, 11), QTime(11, 11));
+
+    tracks.setListType(c2n::AudioTracks::FILES);
+    tracks.reserve(count);
+
+    for (int i = first; i < (first + count); i++)
+    {
+        tracks.append(c2n::STrackInfo(QString("Artist %1 - Title %1").arg(i),
+                                      QString("/music/%1.flac").arg(i), "", -1, 0,
+                                      (180 + (i % 240)) * 75, 0, c2n::TrackType::AUDIO, tstamp));
+    }
+
+    return tracks;
+}
+
+void TestCDItemModel::lazyRows()
+{
+    CCDItemModel model(fileTracks(0, ROWS));
+
+    // first batch is shown, the rest is fetched on demand
+    QVERIFY(model.rowCount() < ROWS);
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    int shown = model.rowCount();
+    model.fetchMore(QModelIndex());
+    QVERIFY(model.rowCount() > shown);
+
+    model.fetchAll();
+    QCOMPARE(model.rowCount(), ROWS);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+    QCOMPARE(model.audioTracks().size(), ROWS);
+}
+
+void TestCDItemModel::appendBatches()
+{
+    CCDItemModel model(fileTracks(0, 0));
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+
+    for (int i = 0; i < ROWS; i += PROBE_BATCH)
+    {
+        model.appendTracks(fileTracks(i, PROBE_BATCH));
+    }
+
+    // rows are appended, the model is never reset
+    QVERIFY(inserted.count() > 0);
+    QCOMPARE(reset.count(), 0);
+    QCOMPARE(model.audioTracks().size(), ROWS);
+    QCOMPARE(model.audioTracks().last().mTitle, QString("Artist %1 - Title %1").arg(ROWS - 1));
+
+    model.fetchAll();
+    QCOMPARE(model.rowCount(), ROWS);
+}
+
+void TestCDItemModel::singleRowEdit()
+{
+    CCDItemModel model(fileTracks(0, ROWS));
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+
+    QVERIFY(model.setData(model.index(42, 0), QString("New Title")));
+
+    // only the edited cell is updated
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(changed.at(0).at(0).toModelIndex(), model.index(42, 0));
+    QCOMPARE(changed.at(0).at(1).toModelIndex(), model.index(42, 0));
+    QCOMPARE(reset.count(), 0);
+    QCOMPARE(model.data(model.index(42, 0)).toString(), QString("New Title"));
+}
+
+void TestCDItemModel::benchAppend()
+{
+    QVector<c2n::AudioTracks> batches;
+
+    for (int i = 0; i < ROWS; i += PROBE_BATCH)
+    {
+        batches.append(fileTracks(i, PROBE_BATCH));
+    }
+
+    QBENCHMARK
+    {
+        CCDItemModel model(fileTracks(0, 0));
+
+        for (const auto& b : batches)
+        {
+            model.appendTracks(b);
+        }
+    }
+}
+
+void TestCDItemModel::benchData()
+{
+    CCDItemModel model(fileTracks(0, ROWS));
+    model.fetchAll();
+
+    // what the view asks for when painting a row
+    QBENCHMARK
+    {
+        for (int row = 0; row < ROWS; row++)
+        {
+            model.data(model.index(row, 0), Qt::DisplayRole);
+            model.data(model.index(row, 0), Qt::DecorationRole);
+            model.data(model.index(row, 1), Qt::DisplayRole);
+        }
+    }
+}
+
+void TestCDItemModel::benchScroll()
+{
+    CCDItemModel model(fileTracks(0, ROWS));
+    QTableView view;
+
+    view.setModel(&model);
+    view.resize(800, 600);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QScrollBar* pBar = view.verticalScrollBar();
+
+    // page through the whole list, paint every page
+    QBENCHMARK
+    {
+        pBar->setValue(0);
+
+        while (pBar->value() < pBar->maximum())
+        {
+            pBar->setValue(pBar->value() + pBar->pageStep());
+            view.viewport()->repaint();
+
+            // delayed layout after fetched rows
+            QCoreApplication::processEvents();
+        }
+    }
+
+    // the view fetched all rows on its way down
+    QCOMPARE(model.rowCount(), ROWS);
+}
+
+QTEST_MAIN(TestCDItemModel)
+
+#include "tst_ccditemmodel.moc"
@@ -0,0 +1,201 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include <QtTest>
+#include <QVector>
+#include <algorithm>
+#include "cffmpeg.h"
+
+//------------------------------------------------------------------------------
+//! @brief      ffmpeg wrapper which gets its output from the test
+//------------------------------------------------------------------------------
+class CFFMpegFeed : public CFFMpeg
+{
+public:
+    using CCliProcess::feedOutput;
+};
+
+//------------------------------------------------------------------------------
+//! @brief      tests and benchmarks of the CCliProcess line parser
+//------------------------------------------------------------------------------
+class TestCliProcess : public QObject
+{
+    Q_OBJECT
+
+    /// size of one output chunk as delivered by the process
+    static constexpr int CHUNK_SIZE = 64 * 1024;
+
+private slots:
+    void progress();
+    void chunkBoundaries();
+    void parseThroughput_data();
+    void parseThroughput();
+
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      create a synthetic ffmpeg log, one progress line per
+    //!             second of audio
+    //!
+    //! @param[in]  lines  number of progress lines
+    //!
+    //! @return     log data
+    //--------------------------------------------------------------------------
+    static QByteArray ffmpegLog(int lines);
+
+    //--------------------------------------------------------------------------
+    //! @brief      feed log in chunks, collect progress values
+    //!
+    //! @param[in]  log        The log
+    //! @param[in]  chunkSize  The chunk size
+    //! @param[out] pTail      optional log tail
+    //!
+    //! @return     progress values
+    //--------------------------------------------------------------------------
+    static QVector<int> feed(const QByteArray& log, int chunkSize, QString* pTail = nullptr);
+};
+
+//--------------------------------------------------------------------------
+//! @brief      create a synthetic ffmpeg log, one progress line per
+//!             second of audio
+//!
+//! @param[in]  lines  number of progress lines
+//!
+//! @return     log data
+//--------------------------------------------------------------------------
+QByteArray TestCliProcess::ffmpegLog(int lines)
+{
+    QByteArray log;
+    log.reserve(lines * 80 + 1024);
+
+    log += "ffmpeg version 6.1 Copyright (c) 2000-2023 the FFmpeg developers\n"
+           "  built with gcc 13 (GCC)\n"
+           "Input #0, flac, from 'album.flac':\n"
+           "  Metadata:\n"
+           "    ALBUM           : Synthetic\n";
+
+    log += QString("  Duration: %1:%2:%3.00, start: 0.000000, bitrate: 1411 kb/s\n")
+            .arg(lines / 3600, 2, 10, QChar('0'))
+            .arg((lines / 60) % 60, 2, 10, QChar('0'))
+            .arg(lines % 60, 2, 10, QChar('0'))
+            .toLatin1();
+
+    log += "  Stream #0:0: Audio: flac, 44100 Hz, stereo, s16\n"
+           "Output #0, wav, to 'album.wav':\n"
+           "  Stream #0:0: Audio: pcm_s16le, 44100 Hz, stereo, s16, 1411 kb/s\n";
+
+    for (int i = 0; i < lines; i++)
+    {
+        // progress lines end with carriage return only
+        log += QString("size=%1kB time=%2:%3:%4.00 bitrate=1411.2kbits/s speed=42.1x\r")
+                .arg(i * 172, 10)
+                .arg(i / 3600, 2, 10, QChar('0'))
+                .arg((i / 60) % 60, 2, 10, QChar('0'))
+                .arg(i % 60, 2, 10, QChar('0'))
+                .toLatin1();
+
+        if ((i % 1000) == 999)
+        {
+            log += "[flac @ 0x55d5c8a0] invalid sync code\n";
+        }
+    }
+
+    return log;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      feed log in chunks, collect progress values
+//!
+//! @param[in]  log        The log
+//! @param[in]  chunkSize  The chunk size
+//! @param[out] pTail      optional log tail
+//!
+//! @return     progress values
+//--------------------------------------------------------------------------
+QVector<int> TestCliProcess::feed(const QByteArray& log, int chunkSize, QString* pTail)
+{
+    QVector<int> values;
+    CFFMpegFeed ffmpeg;
+
+    QObject::connect(&ffmpeg, &CCliProcess::progress, [&values](int percent) {
+        values.append(percent);
+    });
+
+    for (int pos = 0; pos < log.size(); pos += chunkSize)
+    {
+        ffmpeg.feedOutput(log.mid(pos, chunkSize));
+    }
+
+    if (pTail != nullptr)
+    {
+        *pTail = ffmpeg.logTail();
+    }
+
+    return values;
+}
+
+void TestCliProcess::progress()
+{
+    QString tail;
+    QVector<int> values = feed(ffmpegLog(10000), CHUNK_SIZE, &tail);
+
+    // first line is at 00:00:00 and doesn't count
+    QCOMPARE(values.size(), 9999);
+    QCOMPARE(values.first(), 0);
+    QCOMPARE(values.last(), 99);
+    QVERIFY(std::is_sorted(values.cbegin(), values.cend()));
+
+    // only a bounded number of lines is kept for the debug dump
+    QVERIFY(tail.count(QChar('\n')) < 1000);
+    QVERIFY(tail.endsWith("invalid sync code"));
+}
+
+void TestCliProcess::chunkBoundaries()
+{
+    QByteArray log = ffmpegLog(500);
+
+    // lines split at any position give the same result
+    QCOMPARE(feed(log, 1), feed(log, CHUNK_SIZE));
+    QCOMPARE(feed(log, 7), feed(log, log.size()));
+}
+
+void TestCliProcess::parseThroughput_data()
+{
+    QTest::addColumn<int>("lines");
+
+    // roughly 1, 4 and 16 MB of log: time must grow linearly
+    QTest::newRow("1 MB")  << 15000;
+    QTest::newRow("4 MB")  << 60000;
+    QTest::newRow("16 MB") << 240000;
+}
+
+void TestCliProcess::parseThroughput()
+{
+    QFETCH(int, lines);
+
+    QByteArray log = ffmpegLog(lines);
+    int count = 0;
+
+    QBENCHMARK
+    {
+        count = feed(log, CHUNK_SIZE).size();
+    }
+
+    QCOMPARE(count, lines - 1);
+}
+
+QTEST_GUILESS_MAIN(TestCliProcess)
+
+#include "tst_cliprocess.moc"
@@ -0,0 +1,261 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QLoggingCategory>
+#include "cueparser.h"
+
+/// CD frames between two track starts
+static constexpr int TRACK_FRAMES = 10;
+
+/// frames of pregap (INDEX 00) before a track
+static constexpr int PREGAP_FRAMES = 4;
+
+/// sample rate of the test wave (mono, 8 bit)
+static constexpr int WAVE_RATE = 8000;
+
+//------------------------------------------------------------------------------
+//! @brief      tests and benchmarks of the cue sheet lexer / parser
+//------------------------------------------------------------------------------
+class TestCueParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void lineEnds_data();
+    void lineEnds();
+    void benchParse_data();
+    void benchParse();
+
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      create cue sheet for one wave file
+    //!
+    //! @param[in]  tracks  number of tracks
+    //! @param[in]  eol     line end
+    //!
+    //! @return     cue sheet content
+    //--------------------------------------------------------------------------
+    static QByteArray cueSheet(int tracks, const QByteArray& eol);
+
+    //--------------------------------------------------------------------------
+    //! @brief      write cue sheet (and wave file if missing) to test folder
+    //!
+    //! @param[in]  name    cue file name
+    //! @param[in]  tracks  number of tracks
+    //! @param[in]  eol     line end
+    //!
+    //! @return     cue file path; empty on error
+    //--------------------------------------------------------------------------
+    QString writeCue(const QString& name, int tracks, const QByteArray& eol);
+
+    //--------------------------------------------------------------------------
+    //! @brief      CUE time (mm:ss:ff) of a frame count
+    //!
+    //! @param[in]  frames  The frames
+    //!
+    //! @return     time string
+    //--------------------------------------------------------------------------
+    static QByteArray cueTime(int frames);
+
+    /// test folder
+    QTemporaryDir mDir;
+};
+
+//--------------------------------------------------------------------------
+//! @brief      CUE time (mm:ss:ff) of a frame count
+//!
+//! @param[in]  frames  The frames
+//!
+//! @return     time string
+//--------------------------------------------------------------------------
+QByteArray TestCueParser::cueTime(int frames)
+{
+    return QString("%1:%2:%3")
+            .arg(frames / (75 * 60), 2, 10, QChar('0'))
+            .arg((frames / 75) % 60, 2, 10, QChar('0'))
+            .arg(frames % 75, 2, 10, QChar('0'))
+            .toLatin1();
+}
+
+//--------------------------------------------------------------------------
+//! @brief      create cue sheet for one wave file
+//!
+//! @param[in]  tracks  number of tracks
+//! @param[in]  eol     line end
+//!
+//! @return     cue sheet content
+//--------------------------------------------------------------------------
+QByteArray TestCueParser::cueSheet(int tracks, const QByteArray& eol)
+{
+    QByteArray cue;
+
+    cue += "REM GENRE Test" + eol;
+    cue += "REM DATE 2025" + eol;
+    cue += "PERFORMER \"Synthetic\"" + eol;
+    cue += "TITLE \"Line End Album\"" + eol;
+    cue += "FILE \"album.wav\" WAVE" + eol;
+
+    for (int t = 1; t <= tracks; t++)
+    {
+        int start = (t - 1) * TRACK_FRAMES;
+
+        cue += "  TRACK " + QByteArray::number(t) + " AUDIO" + eol;
+        cue += "    TITLE \"Track " + QByteArray::number(t) + "\"" + eol;
+        cue += "    PERFORMER \"Artist " + QByteArray::number(t) + "\"" + eol;
+        cue += "    REM COMPOSER \"Composer\"" + eol;
+
+        if (t > 1)
+        {
+            cue += "    INDEX 00 " + cueTime(start - PREGAP_FRAMES) + eol;
+        }
+
+        cue += "    INDEX 01 " + cueTime(start) + eol;
+    }
+
+    return cue;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      write cue sheet (and wave file if missing) to test folder
+//!
+//! @param[in]  name    cue file name
+//! @param[in]  tracks  number of tracks
+//! @param[in]  eol     line end
+//!
+//! @return     cue file path; empty on error
+//--------------------------------------------------------------------------
+QString TestCueParser::writeCue(const QString& name, int tracks, const QByteArray& eol)
+{
+    QFile wave(mDir.filePath("album.wav"));
+    QFile cue(mDir.filePath(name));
+
+    // wave must be a bit longer than all tracks
+    quint32 data = static_cast<quint32>(((tracks + 1) * TRACK_FRAMES * WAVE_RATE) / 75);
+
+    if (wave.size() < data)
+    {
+        QByteArray hdr;
+        QDataStream ds(&hdr, QIODevice::WriteOnly);
+        ds.setByteOrder(QDataStream::LittleEndian);
+
+        ds.writeRawData("RIFF", 4);
+        ds << static_cast<quint32>(36 + data);
+        ds.writeRawData("WAVEfmt ", 8);
+        ds << static_cast<quint32>(16) << static_cast<quint16>(1) << static_cast<quint16>(1)
+           << static_cast<quint32>(WAVE_RATE) << static_cast<quint32>(WAVE_RATE)
+           << static_cast<quint16>(1) << static_cast<quint16>(8);
+        ds.writeRawData("data", 4);
+        ds << data;
+
+        if (!wave.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return QString();
+        }
+
+        wave.write(hdr);
+        wave.write(QByteArray(static_cast<int>(data), static_cast<char>(0x80)));
+        wave.close();
+    }
+
+    if (!cue.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return QString();
+    }
+
+    cue.write(cueSheet(tracks, eol));
+    cue.close();
+    return cue.fileName();
+}
+
+void TestCueParser::initTestCase()
+{
+    QVERIFY(mDir.isValid());
+
+    // the parser dumps every disc
+    QLoggingCategory::setFilterRules("default.debug=false\ndefault.info=false");
+}
+
+void TestCueParser::lineEnds_data()
+{
+    QTest::addColumn<QByteArray>("eol");
+
+    QTest::newRow("LF")   << QByteArray("\n");
+    QTest::newRow("CRLF") << QByteArray("\r\n");
+    QTest::newRow("CR")   << QByteArray("\r");
+}
+
+void TestCueParser::lineEnds()
+{
+    QFETCH(QByteArray, eol);
+
+    QString cueFile = writeCue("lineends.cue", 3, eol);
+    QVERIFY(!cueFile.isEmpty());
+
+    CueParser parser;
+    QCOMPARE(parser.parse(cueFile), 0);
+    QVERIFY(parser.isValid());
+
+    QCOMPARE(parser.trackCount(), 3);
+    QCOMPARE(parser.discTitle(), QString("Line End Album"));
+    QCOMPARE(parser.discPerfromer(), QString("Synthetic"));
+    QCOMPARE(parser.discYear(), 2025);
+
+    for (int t = 1; t <= 3; t++)
+    {
+        const CueParser::Track& trk = parser.track(t);
+        QCOMPARE(trk.mNo, t);
+        QCOMPARE(trk.mTitle, QString("Track %1").arg(t));
+        QCOMPARE(trk.mPerformer, QString("Artist %1").arg(t));
+        QCOMPARE(trk.mStartMs, static_cast<uint32_t>(((t - 1) * TRACK_FRAMES * 1000 + 37) / 75));
+    }
+
+    QCOMPARE(parser.track(2).mPregapMs,
+             static_cast<uint32_t>(((TRACK_FRAMES * 1000 + 37) / 75) - (((TRACK_FRAMES - PREGAP_FRAMES) * 1000 + 37) / 75)));
+}
+
+void TestCueParser::benchParse_data()
+{
+    QTest::addColumn<int>("tracks");
+
+    QTest::newRow("album")   << 20;
+    QTest::newRow("2k rows") << 2000;
+}
+
+void TestCueParser::benchParse()
+{
+    QFETCH(int, tracks);
+
+    QString cueFile = writeCue(QString("bench%1.cue").arg(tracks), tracks, "\r\n");
+    QVERIFY(!cueFile.isEmpty());
+
+    int count = 0;
+
+    QBENCHMARK
+    {
+        CueParser parser;
+        parser.parse(cueFile);
+        count = parser.trackCount();
+    }
+
+    QCOMPARE(count, tracks);
+}
+
+QTEST_GUILESS_MAIN(TestCueParser)
+
+#include "tst_cueparser.moc"
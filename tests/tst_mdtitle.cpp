@@ -0,0 +1,605 @@
+/**
+ * Copyright (C) 2025 Jo2003 (olenka.joerg@gmail.com)
+ * This file is part of NetMD Wizard
+ *
+ * NetMD Wizard is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * NetMD Wizard is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ */
+#include <QtTest>
+#include <QLoggingCategory>
+#include "mdtitle.h"
+
+//------------------------------------------------------------------------------
+//! @brief      expected output for one mapped code unit
+//!             (up to two UTF-16 code units, 0 -> unused)
+//------------------------------------------------------------------------------
+struct SGolden
+{
+    uint16_t mIn;
+    uint16_t mOut[2];
+};
+
+// Golden output of sanitizeFullWidthTitle() for every key of
+// s_HalfToFullWidth in mdtitle.cpp.
+static const SGolden s_GoldenHalfToFull[] = {
+    {0x0020, {0x3000, 0x0000}}, // U+0020 -> U+3000
+    {0x0021, {0xFF01, 0x0000}}, // ! -> ！
+    {0x0022, {0xFF02, 0x0000}}, // " -> ＂
+    {0x0023, {0xFF03, 0x0000}}, // # -> ＃
+    {0x0024, {0xFF04, 0x0000}}, // $ -> ＄
+    {0x0025, {0xFF05, 0x0000}}, // % -> ％
+    {0x0026, {0xFF06, 0x0000}}, // & -> ＆
+    {0x0027, {0xFF07, 0x0000}}, // ' -> ＇
+    {0x0028, {0xFF08, 0x0000}}, // ( -> （
+    {0x0029, {0xFF09, 0x0000}}, // ) -> ）
+    {0x002A, {0xFF0A, 0x0000}}, // * -> ＊
+    {0x002B, {0xFF0B, 0x0000}}, // + -> ＋
+    {0x002C, {0xFF0C, 0x0000}}, // , -> ，
+    {0x002D, {0xFF0D, 0x0000}}, // - -> －
+    {0x002E, {0xFF0E, 0x0000}}, // . -> ．
+    {0x002F, {0xFF0F, 0x0000}}, // / -> ／
+    {0x0030, {0xFF10, 0x0000}}, // 0 -> ０
+    {0x0031, {0xFF11, 0x0000}}, // 1 -> １
+    {0x0032, {0xFF12, 0x0000}}, // 2 -> ２
+    {0x0033, {0xFF13, 0x0000}}, // 3 -> ３
+    {0x0034, {0xFF14, 0x0000}}, // 4 -> ４
+    {0x0035, {0xFF15, 0x0000}}, // 5 -> ５
+    {0x0036, {0xFF16, 0x0000}}, // 6 -> ６
+    {0x0037, {0xFF17, 0x0000}}, // 7 -> ７
+    {0x0038, {0xFF18, 0x0000}}, // 8 -> ８
+    {0x0039, {0xFF19, 0x0000}}, // 9 -> ９
+    {0x003A, {0xFF1A, 0x0000}}, // : -> ：
+    {0x003B, {0xFF1B, 0x0000}}, // ; -> ；
+    {0x003C, {0xFF1C, 0x0000}}, // < -> ＜
+    {0x003D, {0xFF1D, 0x0000}}, // = -> ＝
+    {0x003E, {0xFF1E, 0x0000}}, // > -> ＞
+    {0x003F, {0xFF1F, 0x0000}}, // ? -> ？
+    {0x0040, {0xFF20, 0x0000}}, // @ -> ＠
+    {0x0041, {0xFF21, 0x0000}}, // A -> Ａ
+    {0x0042, {0xFF22, 0x0000}}, // B -> Ｂ
+    {0x0043, {0xFF23, 0x0000}}, // C -> Ｃ
+    {0x0044, {0xFF24, 0x0000}}, // D -> Ｄ
+    {0x0045, {0xFF25, 0x0000}}, // E -> Ｅ
+    {0x0046, {0xFF26, 0x0000}}, // F -> Ｆ
+    {0x0047, {0xFF27, 0x0000}}, // G -> Ｇ
+    {0x0048, {0xFF28, 0x0000}}, // H -> Ｈ
+    {0x0049, {0xFF29, 0x0000}}, // I -> Ｉ
+    {0x004A, {0xFF2A, 0x0000}}, // J -> Ｊ
+    {0x004B, {0xFF2B, 0x0000}}, // K -> Ｋ
+    {0x004C, {0xFF2C, 0x0000}}, // L -> Ｌ
+    {0x004D, {0xFF2D, 0x0000}}, // M -> Ｍ
+    {0x004E, {0xFF2E, 0x0000}}, // N -> Ｎ
+    {0x004F, {0xFF2F, 0x0000}}, // O -> Ｏ
+    {0x0050, {0xFF30, 0x0000}}, // P -> Ｐ
+    {0x0051, {0xFF31, 0x0000}}, // Q -> Ｑ
+    {0x0052, {0xFF32, 0x0000}}, // R -> Ｒ
+    {0x0053, {0xFF33, 0x0000}}, // S -> Ｓ
+    {0x0054, {0xFF34, 0x0000}}, // T -> Ｔ
+    {0x0055, {0xFF35, 0x0000}}, // U -> Ｕ
+    {0x0056, {0xFF36, 0x0000}}, // V -> Ｖ
+    {0x0057, {0xFF37, 0x0000}}, // W -> Ｗ
+    {0x0058, {0xFF38, 0x0000}}, // X -> Ｘ
+    {0x0059, {0xFF39, 0x0000}}, // Y -> Ｙ
+    {0x005A, {0xFF3A, 0x0000}}, // Z -> Ｚ
+    {0x005B, {0xFF3B, 0x0000}}, // [ -> ［
+    {0x005C, {0xFF3C, 0x0000}}, // \ -> ＼
+    {0x005D, {0xFF3D, 0x0000}}, // ] -> ］
+    {0x005E, {0xFF3E, 0x0000}}, // ^ -> ＾
+    {0x005F, {0xFF3F, 0x0000}}, // _ -> ＿
+    {0x0060, {0xFF40, 0x0000}}, // ` -> ｀
+    {0x0061, {0xFF41, 0x0000}}, // a -> ａ
+    {0x0062, {0xFF42, 0x0000}}, // b -> ｂ
+    {0x0063, {0xFF43, 0x0000}}, // c -> ｃ
+    {0x0064, {0xFF44, 0x0000}}, // d -> ｄ
+    {0x0065, {0xFF45, 0x0000}}, // e -> ｅ
+    {0x0066, {0xFF46, 0x0000}}, // f -> ｆ
+    {0x0067, {0xFF47, 0x0000}}, // g -> ｇ
+    {0x0068, {0xFF48, 0x0000}}, // h -> ｈ
+    {0x0069, {0xFF49, 0x0000}}, // i -> ｉ
+    {0x006A, {0xFF4A, 0x0000}}, // j -> ｊ
+    {0x006B, {0xFF4B, 0x0000}}, // k -> ｋ
+    {0x006C, {0xFF4C, 0x0000}}, // l -> ｌ
+    {0x006D, {0xFF4D, 0x0000}}, // m -> ｍ
+    {0x006E, {0xFF4E, 0x0000}}, // n -> ｎ
+    {0x006F, {0xFF4F, 0x0000}}, // o -> ｏ
+    {0x0070, {0xFF50, 0x0000}}, // p -> ｐ
+    {0x0071, {0xFF51, 0x0000}}, // q -> ｑ
+    {0x0072, {0xFF52, 0x0000}}, // r -> ｒ
+    {0x0073, {0xFF53, 0x0000}}, // s -> ｓ
+    {0x0074, {0xFF54, 0x0000}}, // t -> ｔ
+    {0x0075, {0xFF55, 0x0000}}, // u -> ｕ
+    {0x0076, {0xFF56, 0x0000}}, // v -> ｖ
+    {0x0077, {0xFF57, 0x0000}}, // w -> ｗ
+    {0x0078, {0xFF58, 0x0000}}, // x -> ｘ
+    {0x0079, {0xFF59, 0x0000}}, // y -> ｙ
+    {0x007A, {0xFF5A, 0x0000}}, // z -> ｚ
+    {0x007B, {0xFF5B, 0x0000}}, // { -> ｛
+    {0x007C, {0xFF5C, 0x0000}}, // | -> ｜
+    {0x007D, {0xFF5D, 0x0000}}, // } -> ｝
+    {0x007E, {0xFF5E, 0x0000}}, // ~ -> ～
+    {0x30EE, {0x30EE, 0x0000}}, // ヮ -> ヮ
+    {0x30F0, {0x30F0, 0x0000}}, // ヰ -> ヰ
+    {0x30F1, {0x30F1, 0x0000}}, // ヱ -> ヱ
+    {0x30F5, {0x30F5, 0x0000}}, // ヵ -> ヵ
+    {0x30F6, {0x30F6, 0x0000}}, // ヶ -> ヶ
+    {0x30FD, {0x30FD, 0x0000}}, // ヽ -> ヽ
+    {0x30FE, {0x30FE, 0x0000}}, // ヾ -> ヾ
+    {0xFF61, {0x3002, 0x0000}}, // ｡ -> 。
+    {0xFF62, {0x300C, 0x0000}}, // ｢ -> 「
+    {0xFF63, {0x300D, 0x0000}}, // ｣ -> 」
+    {0xFF64, {0x3001, 0x0000}}, // ､ -> 、
+    {0xFF65, {0x30FB, 0x0000}}, // ･ -> ・
+    {0xFF66, {0x30F2, 0x0000}}, // ｦ -> ヲ
+    {0xFF67, {0x30A1, 0x0000}}, // ｧ -> ァ
+    {0xFF68, {0x30A3, 0x0000}}, // ｨ -> ィ
+    {0xFF69, {0x30A5, 0x0000}}, // ｩ -> ゥ
+    {0xFF6A, {0x30A7, 0x0000}}, // ｪ -> ェ
+    {0xFF6B, {0x30A9, 0x0000}}, // ｫ -> ォ
+    {0xFF6C, {0x30E3, 0x0000}}, // ｬ -> ャ
+    {0xFF6D, {0x30E5, 0x0000}}, // ｭ -> ュ
+    {0xFF6E, {0x30E7, 0x0000}}, // ｮ -> ョ
+    {0xFF6F, {0x30C3, 0x0000}}, // ｯ -> ッ
+    {0xFF70, {0x30FC, 0x0000}}, // ｰ -> ー
+    {0xFF71, {0x30A2, 0x0000}}, // ｱ -> ア
+    {0xFF72, {0x30A4, 0x0000}}, // ｲ -> イ
+    {0xFF73, {0x30A6, 0x0000}}, // ｳ -> ウ
+    {0xFF74, {0x30A8, 0x0000}}, // ｴ -> エ
+    {0xFF75, {0x30AA, 0x0000}}, // ｵ -> オ
+    {0xFF76, {0x30AB, 0x0000}}, // ｶ -> カ
+    {0xFF77, {0x30AD, 0x0000}}, // ｷ -> キ
+    {0xFF78, {0x30AF, 0x0000}}, // ｸ -> ク
+    {0xFF79, {0x30B1, 0x0000}}, // ｹ -> ケ
+    {0xFF7A, {0x30B3, 0x0000}}, // ｺ -> コ
+    {0xFF7B, {0x30B5, 0x0000}}, // ｻ -> サ
+    {0xFF7C, {0x30B7, 0x0000}}, // ｼ -> シ
+    {0xFF7D, {0x30B9, 0x0000}}, // ｽ -> ス
+    {0xFF7E, {0x30BB, 0x0000}}, // ｾ -> セ
+    {0xFF7F, {0x30BD, 0x0000}}, // ｿ -> ソ
+    {0xFF80, {0x30BF, 0x0000}}, // ﾀ -> タ
+    {0xFF81, {0x30C1, 0x0000}}, // ﾁ -> チ
+    {0xFF82, {0x30C4, 0x0000}}, // ﾂ -> ツ
+    {0xFF83, {0x30C6, 0x0000}}, // ﾃ -> テ
+    {0xFF84, {0x30C8, 0x0000}}, // ﾄ -> ト
+    {0xFF85, {0x30CA, 0x0000}}, // ﾅ -> ナ
+    {0xFF86, {0x30CB, 0x0000}}, // ﾆ -> ニ
+    {0xFF87, {0x30CC, 0x0000}}, // ﾇ -> ヌ
+    {0xFF88, {0x30CD, 0x0000}}, // ﾈ -> ネ
+    {0xFF89, {0x30CE, 0x0000}}, // ﾉ -> ノ
+    {0xFF8A, {0x30CF, 0x0000}}, // ﾊ -> ハ
+    {0xFF8B, {0x30D2, 0x0000}}, // ﾋ -> ヒ
+    {0xFF8C, {0x30D5, 0x0000}}, // ﾌ -> フ
+    {0xFF8D, {0x30D8, 0x0000}}, // ﾍ -> ヘ
+    {0xFF8E, {0x30DB, 0x0000}}, // ﾎ -> ホ
+    {0xFF8F, {0x30DE, 0x0000}}, // ﾏ -> マ
+    {0xFF90, {0x30DF, 0x0000}}, // ﾐ -> ミ
+    {0xFF91, {0x30E0, 0x0000}}, // ﾑ -> ム
+    {0xFF92, {0x30E1, 0x0000}}, // ﾒ -> メ
+    {0xFF93, {0x30E2, 0x0000}}, // ﾓ -> モ
+    {0xFF94, {0x30E4, 0x0000}}, // ﾔ -> ヤ
+    {0xFF95, {0x30E6, 0x0000}}, // ﾕ -> ユ
+    {0xFF96, {0x30E8, 0x0000}}, // ﾖ -> ヨ
+    {0xFF97, {0x30E9, 0x0000}}, // ﾗ -> ラ
+    {0xFF98, {0x30EA, 0x0000}}, // ﾘ -> リ
+    {0xFF99, {0x30EB, 0x0000}}, // ﾙ -> ル
+    {0xFF9A, {0x30EC, 0x0000}}, // ﾚ -> レ
+    {0xFF9B, {0x30ED, 0x0000}}, // ﾛ -> ロ
+    {0xFF9C, {0x30EF, 0x0000}}, // ﾜ -> ワ
+    {0xFF9D, {0x30F3, 0x0000}}  // ﾝ -> ン
+};
+
+// Golden output of sanitizeHalfWidthTitle() for every key of
+// s_FullToHalfWidth in mdtitle.cpp. This is what the conversion does today,
+// not what the table says: voiced kana are split by the NFD step, the
+// combining (han)dakuten becomes a space; if the Shift_JIS length check
+// fails the title is kept as is.
+static const SGolden s_GoldenFullToHalf[] = {
+    {0x3000, {0x0020, 0x0000}}, // U+3000 -> U+0020
+    {0x3001, {0xFF64, 0x0000}}, // 、 -> ､
+    {0x3002, {0xFF61, 0x0000}}, // 。 -> ｡
+    {0x300C, {0xFF62, 0x0000}}, // 「 -> ｢
+    {0x300D, {0xFF63, 0x0000}}, // 」 -> ｣
+    {0x3041, {0xFF67, 0x0000}}, // ぁ -> ｧ
+    {0x3042, {0xFF71, 0x0000}}, // あ -> ｱ
+    {0x3043, {0xFF68, 0x0000}}, // ぃ -> ｨ
+    {0x3044, {0xFF72, 0x0000}}, // い -> ｲ
+    {0x3045, {0xFF69, 0x0000}}, // ぅ -> ｩ
+    {0x3046, {0xFF73, 0x0000}}, // う -> ｳ
+    {0x3047, {0xFF6A, 0x0000}}, // ぇ -> ｪ
+    {0x3048, {0xFF74, 0x0000}}, // え -> ｴ
+    {0x3049, {0xFF6B, 0x0000}}, // ぉ -> ｫ
+    {0x304A, {0xFF75, 0x0000}}, // お -> ｵ
+    {0x304B, {0xFF76, 0x0000}}, // か -> ｶ
+    {0x304C, {0xFF76, 0x0020}}, // が -> ｶ U+0020
+    {0x304D, {0xFF77, 0x0000}}, // き -> ｷ
+    {0x304E, {0xFF77, 0x0020}}, // ぎ -> ｷ U+0020
+    {0x304F, {0xFF78, 0x0000}}, // く -> ｸ
+    {0x3050, {0xFF78, 0x0020}}, // ぐ -> ｸ U+0020
+    {0x3051, {0xFF79, 0x0000}}, // け -> ｹ
+    {0x3052, {0xFF79, 0x0020}}, // げ -> ｹ U+0020
+    {0x3053, {0xFF7A, 0x0000}}, // こ -> ｺ
+    {0x3054, {0xFF7A, 0x0020}}, // ご -> ｺ U+0020
+    {0x3055, {0xFF7B, 0x0000}}, // さ -> ｻ
+    {0x3056, {0xFF7B, 0x0020}}, // ざ -> ｻ U+0020
+    {0x3057, {0xFF7C, 0x0000}}, // し -> ｼ
+    {0x3058, {0xFF7C, 0x0020}}, // じ -> ｼ U+0020
+    {0x3059, {0xFF7D, 0x0000}}, // す -> ｽ
+    {0x305A, {0xFF7D, 0x0020}}, // ず -> ｽ U+0020
+    {0x305B, {0xFF7E, 0x0000}}, // せ -> ｾ
+    {0x305C, {0xFF7E, 0x0020}}, // ぜ -> ｾ U+0020
+    {0x305D, {0xFF7F, 0x0000}}, // そ -> ｿ
+    {0x305E, {0xFF7F, 0x0020}}, // ぞ -> ｿ U+0020
+    {0x305F, {0xFF80, 0x0000}}, // た -> ﾀ
+    {0x3060, {0xFF80, 0x0020}}, // だ -> ﾀ U+0020
+    {0x3061, {0xFF81, 0x0000}}, // ち -> ﾁ
+    {0x3062, {0xFF81, 0x0020}}, // ぢ -> ﾁ U+0020
+    {0x3063, {0xFF6F, 0x0000}}, // っ -> ｯ
+    {0x3064, {0xFF82, 0x0000}}, // つ -> ﾂ
+    {0x3065, {0xFF82, 0x0020}}, // づ -> ﾂ U+0020
+    {0x3066, {0xFF83, 0x0000}}, // て -> ﾃ
+    {0x3067, {0xFF83, 0x0020}}, // で -> ﾃ U+0020
+    {0x3068, {0xFF84, 0x0000}}, // と -> ﾄ
+    {0x3069, {0xFF84, 0x0020}}, // ど -> ﾄ U+0020
+    {0x306A, {0xFF85, 0x0000}}, // な -> ﾅ
+    {0x306B, {0xFF86, 0x0000}}, // に -> ﾆ
+    {0x306C, {0xFF87, 0x0000}}, // ぬ -> ﾇ
+    {0x306D, {0xFF88, 0x0000}}, // ね -> ﾈ
+    {0x306E, {0xFF89, 0x0000}}, // の -> ﾉ
+    {0x306F, {0xFF8A, 0x0000}}, // は -> ﾊ
+    {0x3070, {0xFF8A, 0x0020}}, // ば -> ﾊ U+0020
+    {0x3071, {0xFF8A, 0x0020}}, // ぱ -> ﾊ U+0020
+    {0x3072, {0xFF8B, 0x0000}}, // ひ -> ﾋ
+    {0x3073, {0xFF8B, 0x0020}}, // び -> ﾋ U+0020
+    {0x3074, {0xFF8B, 0x0020}}, // ぴ -> ﾋ U+0020
+    {0x3075, {0xFF8C, 0x0000}}, // ふ -> ﾌ
+    {0x3076, {0xFF8C, 0x0020}}, // ぶ -> ﾌ U+0020
+    {0x3077, {0xFF8C, 0x0020}}, // ぷ -> ﾌ U+0020
+    {0x3078, {0xFF8D, 0x0000}}, // へ -> ﾍ
+    {0x3079, {0xFF8D, 0x0020}}, // べ -> ﾍ U+0020
+    {0x307A, {0xFF8D, 0x0020}}, // ぺ -> ﾍ U+0020
+    {0x307B, {0xFF8E, 0x0000}}, // ほ -> ﾎ
+    {0x307C, {0xFF8E, 0x0020}}, // ぼ -> ﾎ U+0020
+    {0x307D, {0xFF8E, 0x0020}}, // ぽ -> ﾎ U+0020
+    {0x307E, {0xFF8F, 0x0000}}, // ま -> ﾏ
+    {0x307F, {0xFF90, 0x0000}}, // み -> ﾐ
+    {0x3080, {0xFF91, 0x0000}}, // む -> ﾑ
+    {0x3081, {0xFF92, 0x0000}}, // め -> ﾒ
+    {0x3082, {0xFF93, 0x0000}}, // も -> ﾓ
+    {0x3083, {0xFF6C, 0x0000}}, // ゃ -> ｬ
+    {0x3084, {0xFF94, 0x0000}}, // や -> ﾔ
+    {0x3085, {0xFF6D, 0x0000}}, // ゅ -> ｭ
+    {0x3086, {0xFF95, 0x0000}}, // ゆ -> ﾕ
+    {0x3087, {0xFF6E, 0x0000}}, // ょ -> ｮ
+    {0x3088, {0xFF96, 0x0000}}, // よ -> ﾖ
+    {0x3089, {0xFF97, 0x0000}}, // ら -> ﾗ
+    {0x308A, {0xFF98, 0x0000}}, // り -> ﾘ
+    {0x308B, {0xFF99, 0x0000}}, // る -> ﾙ
+    {0x308C, {0xFF9A, 0x0000}}, // れ -> ﾚ
+    {0x308D, {0xFF9B, 0x0000}}, // ろ -> ﾛ
+    {0x308E, {0x30EE, 0x0000}}, // ゎ -> ヮ
+    {0x308F, {0xFF9C, 0x0000}}, // わ -> ﾜ
+    {0x3090, {0x30F0, 0x0000}}, // ゐ -> ヰ
+    {0x3091, {0x30F1, 0x0000}}, // ゑ -> ヱ
+    {0x3092, {0xFF66, 0x0000}}, // を -> ｦ
+    {0x3093, {0xFF9D, 0x0000}}, // ん -> ﾝ
+    {0x3094, {0xFF73, 0x0020}}, // ゔ -> ｳ U+0020
+    {0x3095, {0x30F5, 0x0000}}, // ゕ -> ヵ
+    {0x3096, {0x30F6, 0x0000}}, // ゖ -> ヶ
+    {0x309D, {0x30FD, 0x0000}}, // ゝ -> ヽ
+    {0x309E, {0x309E, 0x0000}}, // ゞ -> ゞ
+    {0x30A1, {0xFF67, 0x0000}}, // ァ -> ｧ
+    {0x30A2, {0xFF71, 0x0000}}, // ア -> ｱ
+    {0x30A3, {0xFF68, 0x0000}}, // ィ -> ｨ
+    {0x30A4, {0xFF72, 0x0000}}, // イ -> ｲ
+    {0x30A5, {0xFF69, 0x0000}}, // ゥ -> ｩ
+    {0x30A6, {0xFF73, 0x0000}}, // ウ -> ｳ
+    {0x30A7, {0xFF6A, 0x0000}}, // ェ -> ｪ
+    {0x30A8, {0xFF74, 0x0000}}, // エ -> ｴ
+    {0x30A9, {0xFF6B, 0x0000}}, // ォ -> ｫ
+    {0x30AA, {0xFF75, 0x0000}}, // オ -> ｵ
+    {0x30AB, {0xFF76, 0x0000}}, // カ -> ｶ
+    {0x30AC, {0xFF76, 0x0020}}, // ガ -> ｶ U+0020
+    {0x30AD, {0xFF77, 0x0000}}, // キ -> ｷ
+    {0x30AE, {0xFF77, 0x0020}}, // ギ -> ｷ U+0020
+    {0x30AF, {0xFF78, 0x0000}}, // ク -> ｸ
+    {0x30B0, {0xFF78, 0x0020}}, // グ -> ｸ U+0020
+    {0x30B1, {0xFF79, 0x0000}}, // ケ -> ｹ
+    {0x30B2, {0xFF79, 0x0020}}, // ゲ -> ｹ U+0020
+    {0x30B3, {0xFF7A, 0x0000}}, // コ -> ｺ
+    {0x30B4, {0xFF7A, 0x0020}}, // ゴ -> ｺ U+0020
+    {0x30B5, {0xFF7B, 0x0000}}, // サ -> ｻ
+    {0x30B6, {0xFF7B, 0x0020}}, // ザ -> ｻ U+0020
+    {0x30B7, {0xFF7C, 0x0000}}, // シ -> ｼ
+    {0x30B8, {0xFF7C, 0x0020}}, // ジ -> ｼ U+0020
+    {0x30B9, {0xFF7D, 0x0000}}, // ス -> ｽ
+    {0x30BA, {0xFF7D, 0x0020}}, // ズ -> ｽ U+0020
+    {0x30BB, {0xFF7E, 0x0000}}, // セ -> ｾ
+    {0x30BC, {0xFF7E, 0x0020}}, // ゼ -> ｾ U+0020
+    {0x30BD, {0xFF7F, 0x0000}}, // ソ -> ｿ
+    {0x30BE, {0xFF7F, 0x0020}}, // ゾ -> ｿ U+0020
+    {0x30BF, {0xFF80, 0x0000}}, // タ -> ﾀ
+    {0x30C0, {0xFF80, 0x0020}}, // ダ -> ﾀ U+0020
+    {0x30C1, {0xFF81, 0x0000}}, // チ -> ﾁ
+    {0x30C2, {0xFF81, 0x0020}}, // ヂ -> ﾁ U+0020
+    {0x30C3, {0xFF6F, 0x0000}}, // ッ -> ｯ
+    {0x30C4, {0xFF82, 0x0000}}, // ツ -> ﾂ
+    {0x30C5, {0xFF82, 0x0020}}, // ヅ -> ﾂ U+0020
+    {0x30C6, {0xFF83, 0x0000}}, // テ -> ﾃ
+    {0x30C7, {0xFF83, 0x0020}}, // デ -> ﾃ U+0020
+    {0x30C8, {0xFF84, 0x0000}}, // ト -> ﾄ
+    {0x30C9, {0xFF84, 0x0020}}, // ド -> ﾄ U+0020
+    {0x30CA, {0xFF85, 0x0000}}, // ナ -> ﾅ
+    {0x30CB, {0xFF86, 0x0000}}, // ニ -> ﾆ
+    {0x30CC, {0xFF87, 0x0000}}, // ヌ -> ﾇ
+    {0x30CD, {0xFF88, 0x0000}}, // ネ -> ﾈ
+    {0x30CE, {0xFF89, 0x0000}}, // ノ -> ﾉ
+    {0x30CF, {0xFF8A, 0x0000}}, // ハ -> ﾊ
+    {0x30D0, {0xFF8A, 0x0020}}, // バ -> ﾊ U+0020
+    {0x30D1, {0xFF8A, 0x0020}}, // パ -> ﾊ U+0020
+    {0x30D2, {0xFF8B, 0x0000}}, // ヒ -> ﾋ
+    {0x30D3, {0xFF8B, 0x0020}}, // ビ -> ﾋ U+0020
+    {0x30D4, {0xFF8B, 0x0020}}, // ピ -> ﾋ U+0020
+    {0x30D5, {0xFF8C, 0x0000}}, // フ -> ﾌ
+    {0x30D6, {0xFF8C, 0x0020}}, // ブ -> ﾌ U+0020
+    {0x30D7, {0xFF8C, 0x0020}}, // プ -> ﾌ U+0020
+    {0x30D8, {0xFF8D, 0x0000}}, // ヘ -> ﾍ
+    {0x30D9, {0xFF8D, 0x0020}}, // ベ -> ﾍ U+0020
+    {0x30DA, {0xFF8D, 0x0020}}, // ペ -> ﾍ U+0020
+    {0x30DB, {0xFF8E, 0x0000}}, // ホ -> ﾎ
+    {0x30DC, {0xFF8E, 0x0020}}, // ボ -> ﾎ U+0020
+    {0x30DD, {0xFF8E, 0x0020}}, // ポ -> ﾎ U+0020
+    {0x30DE, {0xFF8F, 0x0000}}, // マ -> ﾏ
+    {0x30DF, {0xFF90, 0x0000}}, // ミ -> ﾐ
+    {0x30E0, {0xFF91, 0x0000}}, // ム -> ﾑ
+    {0x30E1, {0xFF92, 0x0000}}, // メ -> ﾒ
+    {0x30E2, {0xFF93, 0x0000}}, // モ -> ﾓ
+    {0x30E3, {0xFF6C, 0x0000}}, // ャ -> ｬ
+    {0x30E4, {0xFF94, 0x0000}}, // ヤ -> ﾔ
+    {0x30E5, {0xFF6D, 0x0000}}, // ュ -> ｭ
+    {0x30E6, {0xFF95, 0x0000}}, // ユ -> ﾕ
+    {0x30E7, {0xFF6E, 0x0000}}, // ョ -> ｮ
+    {0x30E8, {0xFF96, 0x0000}}, // ヨ -> ﾖ
+    {0x30E9, {0xFF97, 0x0000}}, // ラ -> ﾗ
+    {0x30EA, {0xFF98, 0x0000}}, // リ -> ﾘ
+    {0x30EB, {0xFF99, 0x0000}}, // ル -> ﾙ
+    {0x30EC, {0xFF9A, 0x0000}}, // レ -> ﾚ
+    {0x30ED, {0xFF9B, 0x0000}}, // ロ -> ﾛ
+    {0x30EE, {0x30EE, 0x0000}}, // ヮ -> ヮ
+    {0x30EF, {0xFF9C, 0x0000}}, // ワ -> ﾜ
+    {0x30F0, {0x30F0, 0x0000}}, // ヰ -> ヰ
+    {0x30F1, {0x30F1, 0x0000}}, // ヱ -> ヱ
+    {0x30F2, {0xFF66, 0x0000}}, // ヲ -> ｦ
+    {0x30F3, {0xFF9D, 0x0000}}, // ン -> ﾝ
+    {0x30F4, {0xFF73, 0x0020}}, // ヴ -> ｳ U+0020
+    {0x30F5, {0x30F5, 0x0000}}, // ヵ -> ヵ
+    {0x30F6, {0x30F6, 0x0000}}, // ヶ -> ヶ
+    {0x30FB, {0xFF65, 0x0000}}, // ・ -> ･
+    {0x30FC, {0x002D, 0x0000}}, // ー -> -
+    {0x30FD, {0x30FD, 0x0000}}, // ヽ -> ヽ
+    {0x30FE, {0x30FE, 0x0000}}, // ヾ -> ヾ
+    {0xFF01, {0x0021, 0x0000}}, // ！ -> !
+    {0xFF02, {0x0022, 0x0000}}, // ＂ -> "
+    {0xFF03, {0x0023, 0x0000}}, // ＃ -> #
+    {0xFF04, {0x0024, 0x0000}}, // ＄ -> $
+    {0xFF05, {0x0025, 0x0000}}, // ％ -> %
+    {0xFF06, {0x0026, 0x0000}}, // ＆ -> &
+    {0xFF07, {0x0027, 0x0000}}, // ＇ -> '
+    {0xFF08, {0x0028, 0x0000}}, // （ -> (
+    {0xFF09, {0x0029, 0x0000}}, // ） -> )
+    {0xFF0A, {0x002A, 0x0000}}, // ＊ -> *
+    {0xFF0B, {0x002B, 0x0000}}, // ＋ -> +
+    {0xFF0C, {0x002C, 0x0000}}, // ， -> ,
+    {0xFF0D, {0x002D, 0x0000}}, // － -> -
+    {0xFF0E, {0x002E, 0x0000}}, // ． -> .
+    {0xFF0F, {0x002F, 0x0000}}, // ／ -> /
+    {0xFF10, {0x0030, 0x0000}}, // ０ -> 0
+    {0xFF11, {0x0031, 0x0000}}, // １ -> 1
+    {0xFF12, {0x0032, 0x0000}}, // ２ -> 2
+    {0xFF13, {0x0033, 0x0000}}, // ３ -> 3
+    {0xFF14, {0x0034, 0x0000}}, // ４ -> 4
+    {0xFF15, {0x0035, 0x0000}}, // ５ -> 5
+    {0xFF16, {0x0036, 0x0000}}, // ６ -> 6
+    {0xFF17, {0x0037, 0x0000}}, // ７ -> 7
+    {0xFF18, {0x0038, 0x0000}}, // ８ -> 8
+    {0xFF19, {0x0039, 0x0000}}, // ９ -> 9
+    {0xFF1A, {0x003A, 0x0000}}, // ： -> :
+    {0xFF1B, {0x003B, 0x0000}}, // ； -> ;
+    {0xFF1C, {0x003C, 0x0000}}, // ＜ -> <
+    {0xFF1D, {0x003D, 0x0000}}, // ＝ -> =
+    {0xFF1E, {0x003E, 0x0000}}, // ＞ -> >
+    {0xFF1F, {0x003F, 0x0000}}, // ？ -> ?
+    {0xFF20, {0x0040, 0x0000}}, // ＠ -> @
+    {0xFF21, {0x0041, 0x0000}}, // Ａ -> A
+    {0xFF22, {0x0042, 0x0000}}, // Ｂ -> B
+    {0xFF23, {0x0043, 0x0000}}, // Ｃ -> C
+    {0xFF24, {0x0044, 0x0000}}, // Ｄ -> D
+    {0xFF25, {0x0045, 0x0000}}, // Ｅ -> E
+    {0xFF26, {0x0046, 0x0000}}, // Ｆ -> F
+    {0xFF27, {0x0047, 0x0000}}, // Ｇ -> G
+    {0xFF28, {0x0048, 0x0000}}, // Ｈ -> H
+    {0xFF29, {0x0049, 0x0000}}, // Ｉ -> I
+    {0xFF2A, {0x004A, 0x0000}}, // Ｊ -> J
+    {0xFF2B, {0x004B, 0x0000}}, // Ｋ -> K
+    {0xFF2C, {0x004C, 0x0000}}, // Ｌ -> L
+    {0xFF2D, {0x004D, 0x0000}}, // Ｍ -> M
+    {0xFF2E, {0x004E, 0x0000}}, // Ｎ -> N
+    {0xFF2F, {0x004F, 0x0000}}, // Ｏ -> O
+    {0xFF30, {0x0050, 0x0000}}, // Ｐ -> P
+    {0xFF31, {0x0051, 0x0000}}, // Ｑ -> Q
+    {0xFF32, {0x0052, 0x0000}}, // Ｒ -> R
+    {0xFF33, {0x0053, 0x0000}}, // Ｓ -> S
+    {0xFF34, {0x0054, 0x0000}}, // Ｔ -> T
+    {0xFF35, {0x0055, 0x0000}}, // Ｕ -> U
+    {0xFF36, {0x0056, 0x0000}}, // Ｖ -> V
+    {0xFF37, {0x0057, 0x0000}}, // Ｗ -> W
+    {0xFF38, {0x0058, 0x0000}}, // Ｘ -> X
+    {0xFF39, {0x0059, 0x0000}}, // Ｙ -> Y
+    {0xFF3A, {0x005A, 0x0000}}, // Ｚ -> Z
+    {0xFF3B, {0x005B, 0x0000}}, // ［ -> [
+    {0xFF3C, {0x005C, 0x0000}}, // ＼ -> \
+    {0xFF3D, {0x005D, 0x0000}}, // ］ -> ]
+    {0xFF3E, {0x005E, 0x0000}}, // ＾ -> ^
+    {0xFF3F, {0x005F, 0x0000}}, // ＿ -> _
+    {0xFF40, {0x0060, 0x0000}}, // ｀ -> `
+    {0xFF41, {0x0061, 0x0000}}, // ａ -> a
+    {0xFF42, {0x0062, 0x0000}}, // ｂ -> b
+    {0xFF43, {0x0063, 0x0000}}, // ｃ -> c
+    {0xFF44, {0x0064, 0x0000}}, // ｄ -> d
+    {0xFF45, {0x0065, 0x0000}}, // ｅ -> e
+    {0xFF46, {0x0066, 0x0000}}, // ｆ -> f
+    {0xFF47, {0x0067, 0x0000}}, // ｇ -> g
+    {0xFF48, {0x0068, 0x0000}}, // ｈ -> h
+    {0xFF49, {0x0069, 0x0000}}, // ｉ -> i
+    {0xFF4A, {0x006A, 0x0000}}, // ｊ -> j
+    {0xFF4B, {0x006B, 0x0000}}, // ｋ -> k
+    {0xFF4C, {0x006C, 0x0000}}, // ｌ -> l
+    {0xFF4D, {0x006D, 0x0000}}, // ｍ -> m
+    {0xFF4E, {0x006E, 0x0000}}, // ｎ -> n
+    {0xFF4F, {0x006F, 0x0000}}, // ｏ -> o
+    {0xFF50, {0x0070, 0x0000}}, // ｐ -> p
+    {0xFF51, {0x0071, 0x0000}}, // ｑ -> q
+    {0xFF52, {0x0072, 0x0000}}, // ｒ -> r
+    {0xFF53, {0x0073, 0x0000}}, // ｓ -> s
+    {0xFF54, {0x0074, 0x0000}}, // ｔ -> t
+    {0xFF55, {0x0075, 0x0000}}, // ｕ -> u
+    {0xFF56, {0x0076, 0x0000}}, // ｖ -> v
+    {0xFF57, {0x0077, 0x0000}}, // ｗ -> w
+    {0xFF58, {0x0078, 0x0000}}, // ｘ -> x
+    {0xFF59, {0x0079, 0x0000}}, // ｙ -> y
+    {0xFF5A, {0x007A, 0x0000}}, // ｚ -> z
+    {0xFF5B, {0x007B, 0x0000}}, // ｛ -> {
+    {0xFF5C, {0x007C, 0x0000}}, // ｜ -> |
+    {0xFF5D, {0x007D, 0x0000}}, // ｝ -> }
+    {0xFF5E, {0x007E, 0x0000}}, // ～ -> ~
+    {0xFF70, {0x002D, 0x0000}}  // ｰ -> -
+};
+
+//------------------------------------------------------------------------------
+//! @brief      golden tests of the MD title width conversion
+//------------------------------------------------------------------------------
+class TestMdTitle : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void fullWidth_data();
+    void fullWidth();
+    void fullWidthTitle();
+    void halfWidth_data();
+    void halfWidth();
+
+private:
+    //--------------------------------------------------------------------------
+    //! @brief      add one data row per golden entry
+    //!
+    //! @param[in]  tab   golden table
+    //--------------------------------------------------------------------------
+    template <size_t N>
+    static void addRows(const SGolden (&tab)[N]);
+
+    //--------------------------------------------------------------------------
+    //! @brief      expected output as string
+    //!
+    //! @param[in]  g     golden entry
+    //!
+    //! @return     output string
+    //--------------------------------------------------------------------------
+    static QString output(const SGolden& g);
+};
+
+//--------------------------------------------------------------------------
+//! @brief      expected output as string
+//!
+//! @param[in]  g     golden entry
+//!
+//! @return     output string
+//--------------------------------------------------------------------------
+QString TestMdTitle::output(const SGolden& g)
+{
+    QString out(QChar(g.mOut[0]));
+
+    if (g.mOut[1] != 0)
+    {
+        out += QChar(g.mOut[1]);
+    }
+
+    return out;
+}
+
+//--------------------------------------------------------------------------
+//! @brief      add one data row per golden entry
+//!
+//! @param[in]  tab   golden table
+//--------------------------------------------------------------------------
+template <size_t N>
+void TestMdTitle::addRows(const SGolden (&tab)[N])
+{
+    QTest::addColumn<QString>("in");
+    QTest::addColumn<QString>("out");
+
+    for (const auto& g : tab)
+    {
+        QString tag = QString("U+%1").arg(g.mIn, 4, 16, QChar('0')).toUpper();
+        QTest::newRow(qPrintable(tag)) << QString(QChar(g.mIn)) << output(g);
+    }
+}
+
+void TestMdTitle::initTestCase()
+{
+    // the half width conversion logs every replaced character
+    QLoggingCategory::setFilterRules("default.debug=false");
+}
+
+void TestMdTitle::fullWidth_data()
+{
+    addRows(s_GoldenHalfToFull);
+}
+
+void TestMdTitle::fullWidth()
+{
+    QFETCH(QString, in);
+    QFETCH(QString, out);
+
+    QCOMPARE(sanitizeFullWidthTitle(in), out);
+}
+
+void TestMdTitle::fullWidthTitle()
+{
+    QString in;
+    QString out;
+
+    // the remap works per code unit, a whole title gives the same result
+    for (const auto& g : s_GoldenHalfToFull)
+    {
+        in  += QChar(g.mIn);
+        out += output(g);
+    }
+
+    QCOMPARE(sanitizeFullWidthTitle(in), out);
+}
+
+void TestMdTitle::halfWidth_data()
+{
+    addRows(s_GoldenFullToHalf);
+}
+
+void TestMdTitle::halfWidth()
+{
+    QFETCH(QString, in);
+    QFETCH(QString, out);
+
+    QCOMPARE(sanitizeHalfWidthTitle(in), out);
+}
+
+QTEST_GUILESS_MAIN(TestMdTitle)
+
+#include "tst_mdtitle.moc"